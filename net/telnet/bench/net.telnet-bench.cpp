@@ -0,0 +1,480 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-bench.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Throughput benchmarks for `protocol_fsm`, output escaping, and a loopback `stream` round trip.
+ * @remark Each benchmark reports bytes/s via `SetBytesProcessed` and heap allocations per iteration via the `allocs/op` counter.
+ * @remark Corpora are generated deterministically in-process: plain MUD text, IAC-dense binary data, and GMCP-heavy traffic.
+ * @remark Escaping is measured by calling `stream::escape_output` directly, so no syscall or output queue is timed with it.
+ * @remark The idle-session benchmarks report the heap bytes each waiting loopback session holds, with and without `lean_memory`, via the `heap bytes/session` counter.
+ *
+ * @see "net.telnet-protocol_fsm.cppm" for `process_byte`, "net.telnet-stream.cppm" for `stream`
+ */
+
+#include <asio.hpp>
+#include <benchmark/benchmark.h>
+
+import std; //NOLINT For std::vector, std::string_view, std::atomic, std::malloc, std::free, std::memcpy, std::format
+
+import net.telnet; ///< @see "net.telnet.cppm"
+
+namespace {
+    //Counts every global `operator new` so benchmarks can report allocations per operation.
+    std::atomic<std::uint64_t> allocation_count{0};
+
+    //Bytes requested from `operator new` and not yet deleted, so benchmarks can report what a session keeps.
+    std::atomic<std::int64_t> live_bytes{0};
+
+    //Each allocation is prefixed with its size, keeping the block's alignment.
+    constexpr std::size_t allocation_header = alignof(std::max_align_t);
+} //namespace
+
+//NOLINTBEGIN(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory, cppcoreguidelines-pro-bounds-pointer-arithmetic): Replacing the global allocation functions requires raw `malloc`/`free`.
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (auto* base = static_cast<std::byte*>(std::malloc(allocation_header + size))) {
+        std::memcpy(base, &size, sizeof(size));
+        live_bytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        return base + allocation_header;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    std::byte* base = static_cast<std::byte*>(ptr) - allocation_header;
+    std::size_t size = 0;
+    std::memcpy(&size, base, sizeof(size));
+    live_bytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    std::free(base);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { operator delete(ptr); }
+//NOLINTEND(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+namespace {
+    namespace telnet = net::telnet;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using tcp_stream = telnet::stream<asio::ip::tcp::socket>;
+
+    constexpr std::size_t corpus_size = std::size_t{64} * 1024;
+    constexpr std::size_t round_trip_size = std::size_t{4} * 1024;
+
+    constexpr auto iac = static_cast<byte_t>(command::iac);
+
+    ///@brief Reports bytes/s and allocations per iteration for a finished benchmark loop.
+    void report(benchmark::State& state, std::size_t bytes_per_iteration, std::uint64_t allocations_before)
+    {
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes_per_iteration));
+        state.counters["allocs/op"] = benchmark::Counter(
+            static_cast<double>(allocation_count.load(std::memory_order_relaxed) - allocations_before),
+            benchmark::Counter::kAvgIterations
+        );
+    } //report(benchmark::State&, std::size_t, std::uint64_t)
+
+    ///@brief Appends `text` to `corpus` as bytes.
+    void append(std::vector<byte_t>& corpus, std::string_view text)
+    {
+        corpus.insert(corpus.end(), text.begin(), text.end());
+    } //append(std::vector<byte_t>&, std::string_view)
+
+    ///@brief Builds NVT text shaped like MUD room descriptions and chat, with CR LF line ends.
+    std::vector<byte_t> make_plain_text_corpus()
+    {
+        constexpr std::array<std::string_view, 4> lines{
+            "You stand in a small stone courtyard. A fountain gurgles quietly to the north.\r\n",
+            "Exits: north, east, south.\r\n",
+            "[Gossip] Ayla: anyone up for the caverns run tonight?\r\n",
+            "A rat scurries past your feet and vanishes into a crack in the wall.\r\n"
+        };
+        std::vector<byte_t> corpus;
+        corpus.reserve(corpus_size);
+        for (std::size_t i = 0; corpus.size() < corpus_size; ++i) {
+            append(corpus, lines[i % lines.size()]);
+        }
+        return corpus;
+    } //make_plain_text_corpus()
+
+    ///@brief Builds BINARY-mode style data in which roughly one byte in eight is IAC, plus occasional NOP and GA commands.
+    std::vector<byte_t> make_iac_dense_corpus()
+    {
+        std::vector<byte_t> corpus;
+        corpus.reserve(corpus_size);
+        std::uint32_t seed = 0x2545'F491U;
+        while (corpus.size() < corpus_size) {
+            seed ^= seed << 13U;
+            seed ^= seed >> 17U;
+            seed ^= seed << 5U;
+            switch (seed % 16U) {
+                case 0:
+                    [[fallthrough]];
+                case 1:
+                    corpus.insert(corpus.end(), {iac, iac}); //Escaped 0xFF data byte
+                    break;
+                case 2:
+                    corpus.insert(corpus.end(), {iac, static_cast<byte_t>(command::nop)});
+                    break;
+                case 3:
+                    corpus.insert(corpus.end(), {iac, static_cast<byte_t>(command::ga)});
+                    break;
+                default:
+                    corpus.push_back(static_cast<byte_t>('A' + (seed >> 8U) % 26U));
+                    break;
+            }
+        }
+        return corpus;
+    } //make_iac_dense_corpus()
+
+    ///@brief Builds GMCP-heavy traffic: every short text line is followed by an IAC SB GMCP ... IAC SE message.
+    std::vector<byte_t> make_gmcp_corpus()
+    {
+        std::vector<byte_t> corpus;
+        corpus.reserve(corpus_size);
+        for (std::size_t i = 0; corpus.size() < corpus_size; ++i) {
+            append(corpus, "You hit the goblin.\r\n");
+            corpus.insert(corpus.end(), {iac, static_cast<byte_t>(command::sb), static_cast<byte_t>(option::id_num::gmcp)});
+            append(
+                corpus,
+                std::format(R"(Char.Vitals {{"hp":{},"maxhp":1200,"mp":{},"maxmp":800,"ep":100}})", 900 + (i % 300), i % 800)
+            );
+            corpus.insert(corpus.end(), {iac, static_cast<byte_t>(command::se)});
+        }
+        return corpus;
+    } //make_gmcp_corpus()
+
+    ///@brief Builds data with no byte that the escaper or FSM treats specially, so a round trip moves exactly its size.
+    std::vector<byte_t> make_round_trip_payload()
+    {
+        std::vector<byte_t> payload(round_trip_size);
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = static_cast<byte_t>('a' + (i % 26));
+        }
+        return payload;
+    } //make_round_trip_payload()
+
+    ///@brief Registers GMCP (accepted remotely, with subnegotiation) with the default configuration, once.
+    void register_gmcp()
+    {
+        static const bool registered = [] {
+            telnet::default_protocol_fsm_config::registered_options.upsert(
+                option{option::id_num::gmcp, "GMCP", option::always_reject, option::always_accept, /*subneg_supported=*/true}
+            );
+            return true;
+        }();
+        static_cast<void>(registered);
+    } //register_gmcp()
+
+    ///@brief Creates an FSM that has accepted the peer's IAC WILL GMCP and has a do-nothing GMCP subnegotiation handler.
+    telnet::protocol_fsm<> make_gmcp_fsm()
+    {
+        register_gmcp();
+        telnet::protocol_fsm<> fsm;
+        fsm.register_option_handlers(
+            option::id_num::gmcp,
+            std::nullopt,
+            std::nullopt,
+            [](const option& /*opt*/, std::span<const byte_t> /*data*/) -> telnet::awaitables::subnegotiation_awaitable {
+                co_return;
+            }
+        );
+        for (const byte_t byte : {iac, static_cast<byte_t>(command::will_opt), static_cast<byte_t>(option::id_num::gmcp)}) {
+            static_cast<void>(fsm.process_byte(byte));
+        }
+        return fsm;
+    } //make_gmcp_fsm()
+
+    ///@brief Feeds `corpus` to `fsm` one byte at a time, discarding responses as the stream would after sending them.
+    void run_process_byte(benchmark::State& state, telnet::protocol_fsm<>& fsm, const std::vector<byte_t>& corpus)
+    {
+        const std::uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+        for (auto _ : state) {
+            std::size_t forwarded = 0;
+            for (const byte_t byte : corpus) {
+                auto [ec, forward, response] = fsm.process_byte(byte);
+                forwarded += forward ? 1 : 0;
+                benchmark::DoNotOptimize(response);
+            }
+            benchmark::DoNotOptimize(forwarded);
+        }
+        report(state, corpus.size(), allocations_before);
+    } //run_process_byte(benchmark::State&, telnet::protocol_fsm<>&, const std::vector<byte_t>&)
+
+    ///@brief Feeds `corpus` to `fsm` the way `input_processor` does: `process_span` runs, whole subnegotiations via `process_subnegotiation_span`, and `process_byte` for the rest.
+    void run_process_span(benchmark::State& state, telnet::protocol_fsm<>& fsm, const std::vector<byte_t>& corpus)
+    {
+        const std::uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+        for (auto _ : state) {
+            std::span<const byte_t> input(corpus);
+            std::size_t forwarded = 0;
+            while (!input.empty()) {
+                if (const std::size_t run = fsm.process_span(input); run > 0) {
+                    forwarded += run;
+                    input = input.subspan(run);
+                    continue;
+                }
+                if (auto [consumed, ec, response] = fsm.process_subnegotiation_span(input); consumed > 0) {
+                    benchmark::DoNotOptimize(response);
+                    input = input.subspan(consumed);
+                    continue;
+                }
+                auto [ec, forward, response] = fsm.process_byte(input.front());
+                forwarded += forward ? 1 : 0;
+                benchmark::DoNotOptimize(response);
+                input = input.subspan(1);
+            }
+            benchmark::DoNotOptimize(forwarded);
+        }
+        report(state, corpus.size(), allocations_before);
+    } //run_process_span(benchmark::State&, telnet::protocol_fsm<>&, const std::vector<byte_t>&)
+
+    void bm_process_byte_plain_text(benchmark::State& state)
+    {
+        telnet::protocol_fsm<> fsm;
+        run_process_byte(state, fsm, make_plain_text_corpus());
+    }
+
+    void bm_process_byte_iac_dense(benchmark::State& state)
+    {
+        telnet::protocol_fsm<> fsm;
+        run_process_byte(state, fsm, make_iac_dense_corpus());
+    }
+
+    void bm_process_byte_gmcp(benchmark::State& state)
+    {
+        auto fsm = make_gmcp_fsm();
+        run_process_byte(state, fsm, make_gmcp_corpus());
+    }
+
+    void bm_process_span_plain_text(benchmark::State& state)
+    {
+        telnet::protocol_fsm<> fsm;
+        run_process_span(state, fsm, make_plain_text_corpus());
+    }
+
+    void bm_process_span_gmcp(benchmark::State& state)
+    {
+        auto fsm = make_gmcp_fsm();
+        run_process_span(state, fsm, make_gmcp_corpus());
+    }
+
+    /**
+     * @brief A connected loopback pair: a Telnet `stream` on one end and a raw peer socket on the other.
+     * @remark Sets `TCP_NODELAY` on both ends so round trips are not held back by Nagle's algorithm.
+     */
+    struct loopback_pair {
+        asio::io_context context;
+        asio::ip::tcp::socket peer{context};
+        std::optional<tcp_stream> stream;
+
+        loopback_pair()
+        {
+            asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+            peer.connect(acceptor.local_endpoint());
+            stream.emplace(acceptor.accept());
+            peer.set_option(asio::ip::tcp::no_delay(true));
+            stream->lowest_layer().set_option(asio::ip::tcp::no_delay(true));
+        }
+    }; //struct loopback_pair
+
+    /**
+     * @brief Escapes the corpus with `stream::escape_output`, the loop every write runs, into one reused buffer.
+     * @remark No socket or stream is involved, so the time is the escaping alone; only the first iteration grows the buffer, so `allocs/op` stays near 0.
+     */
+    void run_escape(benchmark::State& state, const std::vector<byte_t>& corpus, bool binary)
+    {
+        std::vector<byte_t> escaped;
+        const std::uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+        for (auto _ : state) {
+            escaped.clear();
+            tcp_stream::escape_output(escaped, asio::buffer(corpus), binary);
+            benchmark::DoNotOptimize(escaped.data());
+            benchmark::ClobberMemory();
+        }
+        report(state, corpus.size(), allocations_before);
+    } //run_escape(benchmark::State&, const std::vector<byte_t>&, bool)
+
+    void bm_escape_text(benchmark::State& state) { run_escape(state, make_plain_text_corpus(), false); }
+
+    void bm_escape_binary(benchmark::State& state) { run_escape(state, make_iac_dense_corpus(), true); }
+
+    /**
+     * @brief Times `async_write_some` from the `stream` to the peer, the peer echoing it back, and `async_read_some` on the `stream` until every byte returns.
+     * @remark Drives the `io_context` with `run_one`, since the stream keeps an urgent-data wait outstanding and `run` would never return.
+     */
+    void bm_stream_round_trip(benchmark::State& state)
+    {
+        loopback_pair pair;
+        const std::vector<byte_t> payload = make_round_trip_payload();
+        std::vector<byte_t> echo(payload.size());
+        std::vector<byte_t> received(payload.size());
+
+        const std::uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+        for (auto _ : state) {
+            std::size_t received_bytes = 0;
+            std::error_code failure;
+            bool done = false;
+
+            std::function<void()> read_back = [&] {
+                pair.stream->async_read_some(
+                    asio::buffer(received.data() + received_bytes, received.size() - received_bytes),
+                    [&](const std::error_code& ec, std::size_t bytes) {
+                        received_bytes += bytes;
+                        if (ec || (received_bytes == received.size())) {
+                            failure = ec;
+                            done    = true;
+                            return;
+                        }
+                        read_back();
+                    }
+                );
+            };
+
+            pair.stream->async_write_some(asio::buffer(payload), [&](const std::error_code& ec, std::size_t /*bytes*/) {
+                if (ec) {
+                    failure = ec;
+                    done    = true;
+                }
+            });
+            asio::async_read(pair.peer, asio::buffer(echo), [&](const std::error_code& ec, std::size_t /*bytes*/) {
+                if (ec) {
+                    failure = ec;
+                    done    = true;
+                    return;
+                }
+                asio::async_write(pair.peer, asio::buffer(echo), [&](const std::error_code& write_ec, std::size_t /*bytes*/) {
+                    if (write_ec) {
+                        failure = write_ec;
+                        done    = true;
+                    }
+                });
+                read_back();
+            });
+
+            while (!done) {
+                pair.context.run_one();
+            }
+            if (failure) {
+                state.SkipWithError(failure.message().c_str());
+                break;
+            }
+        }
+        report(state, payload.size(), allocations_before);
+    } //bm_stream_round_trip(benchmark::State&)
+
+    ///@brief `default_protocol_fsm_config` with `lean_memory` enabled.
+    class lean_config : public telnet::default_protocol_fsm_config {
+    public:
+        static constexpr bool lean_memory = true;
+    }; //class lean_config
+
+    /**
+     * @brief Opens `state.range(0)` loopback sessions sharing one set of handlers, lets each read a greeting, and leaves each waiting on a read.
+     * @remark Reports the heap bytes the sessions then hold, per session, next to `sizeof(stream)`; the kernel's socket buffers are not included.
+     * @remark The peers are connected before the baseline is taken, so only the accepted sockets, the streams, and their pending operations count.
+     */
+    template<typename Config>
+    void bm_idle_sessions(benchmark::State& state)
+    {
+        using session_stream = telnet::stream<asio::ip::tcp::socket, Config>;
+        const auto sessions  = static_cast<std::size_t>(state.range(0));
+        const std::string_view greeting = "Welcome to the realm.\r\n";
+
+        register_gmcp();
+        //Closing the sessions cancels their OOB waits, each of which would log.
+        telnet::default_protocol_fsm_config::set_error_logger([](const std::error_code& /*ec*/, const std::string& /*msg*/) {});
+        telnet::protocol_fsm<Config> prototype;
+        prototype.register_option_handlers(
+            option::id_num::gmcp,
+            std::nullopt,
+            std::nullopt,
+            [](const option& /*opt*/, std::span<const byte_t> /*data*/) -> telnet::awaitables::subnegotiation_awaitable {
+                co_return;
+            }
+        );
+
+        double bytes_per_session = 0;
+        for (auto _ : state) {
+            asio::io_context context;
+            asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+            std::vector<asio::ip::tcp::socket> peers;
+            peers.reserve(sessions);
+            for (std::size_t i = 0; i < sessions; ++i) {
+                peers.emplace_back(context).connect(acceptor.local_endpoint());
+                asio::write(peers.back(), asio::buffer(greeting));
+            }
+            std::vector<std::array<byte_t, 64>> buffers(sessions);
+            std::vector<std::unique_ptr<session_stream>> streams;
+            streams.reserve(sessions);
+            std::size_t greeted = 0;
+
+            const std::int64_t bytes_before = live_bytes.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < sessions; ++i) {
+                auto& stream = *streams.emplace_back(std::make_unique<session_stream>(acceptor.accept()));
+                stream.set_option_handlers(prototype.option_handlers());
+                auto& buffer = buffers[i];
+                const auto on_greeting = [&stream, &buffer, &greeted](std::error_code ec, std::size_t /*bytes*/) {
+                    if (ec) {
+                        return;
+                    }
+                    ++greeted;
+                    stream.async_read_some(asio::buffer(buffer), [](std::error_code /*ec*/, std::size_t /*bytes*/) {});
+                };
+                stream.async_read_some(asio::buffer(buffer), on_greeting);
+            }
+            while (greeted < sessions) {
+                context.run_one();
+            }
+            context.poll();
+            const std::int64_t bytes_after = live_bytes.load(std::memory_order_relaxed);
+            bytes_per_session = static_cast<double>(bytes_after - bytes_before) / static_cast<double>(sessions);
+
+            for (auto& peer : peers) {
+                peer.close();
+            }
+            for (auto& stream : streams) {
+                std::error_code ignored;
+                stream->lowest_layer().close(ignored);
+            }
+            context.run();
+        }
+        state.counters["heap bytes/session"] = bytes_per_session;
+        state.counters["sizeof(stream)"]     = static_cast<double>(sizeof(session_stream));
+    } //bm_idle_sessions(benchmark::State&)
+} //namespace
+
+BENCHMARK(bm_process_byte_plain_text);
+BENCHMARK(bm_process_byte_iac_dense);
+BENCHMARK(bm_process_byte_gmcp);
+BENCHMARK(bm_process_span_plain_text);
+BENCHMARK(bm_process_span_gmcp);
+BENCHMARK(bm_escape_text);
+BENCHMARK(bm_escape_binary);
+BENCHMARK(bm_stream_round_trip)->UseRealTime();
+BENCHMARK(bm_idle_sessions<telnet::default_protocol_fsm_config>)->Arg(256)->Iterations(3);
+BENCHMARK(bm_idle_sessions<lean_config>)->Arg(256)->Iterations(3);
+
+BENCHMARK_MAIN();
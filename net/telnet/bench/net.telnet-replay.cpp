@@ -0,0 +1,654 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-replay.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Replays recorded client sessions through `protocol_fsm` and `stream`, and doubles as a libFuzzer entry point.
+ * @remark A capture is one file of raw bytes exactly as the server read them from one client connection (e.g. the client-to-server half of a `tcpdump`/Wireshark "Follow TCP Stream" export). Directories are walked recursively and each regular file is one capture.
+ * @remark For each capture, reports throughput, heap allocations per pass, and p50/p99/max latency per read chunk for three paths: `process_byte` alone, the `input_processor` fast path (`process_span` and `process_subnegotiation_span`), and `stream::read_some` over the in-memory `capture_stream`.
+ * @remark Also checks that the fast path forwards exactly the bytes, and returns exactly the signals and responses, that `process_byte` alone does, and that `stream::read_some` (whose `scan_plain_run` uses the SIMD `byte_scan` kernel) delivers exactly the bytes `process_byte` forwards; a mismatch makes the exit status nonzero.
+ * @remark Built with `NET_TELNET_REPLAY_FUZZER`, provides `LLVMFuzzerTestOneInput` instead of `main`: each input is checked for fast-path and stream equivalence, aborting on a mismatch.
+ * @remark "bench/corpus" holds small synthetic captures (IAC escapes, CR NUL, subnegotiations with IAC IAC, and sequences split across 4096-byte reads) that CTest replays at several chunk sizes.
+ * @remark Uses `urgent_data_policy::at_mark`, so no out-of-band receive is left pending on the unconnected socket behind `capture_stream`.
+ *
+ * @see "net.telnet-protocol_fsm.cppm" for `process_byte`, "net.telnet-stream.cppm" for `stream`, "net.telnet-bench.cpp" for the synthetic-corpus benchmarks
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::string, std::chrono, std::filesystem, std::ifstream, std::println
+
+import net.telnet; ///< @see "net.telnet.cppm"
+
+#ifndef NET_TELNET_REPLAY_FUZZER
+namespace {
+    //Counts every global `operator new` so each path can report allocations per pass.
+    std::atomic<std::uint64_t> allocation_count{0};
+} //namespace
+
+//NOLINTBEGIN(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory): Replacing the global allocation functions requires raw `malloc`/`free`.
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+//NOLINTEND(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+#endif
+
+namespace {
+    namespace telnet = net::telnet;
+    using telnet::byte_t;
+    using telnet::option;
+
+    /**
+     * @brief The default configuration with logging compiled out and `urgent_data_policy::at_mark`.
+     * @remark Shares `registered_options` and the handlers with `default_protocol_fsm_config`.
+     */
+    class replay_config : public telnet::default_protocol_fsm_config {
+    public:
+        static constexpr telnet::log_level minimum_log_level = telnet::log_level::off;
+
+        static constexpr telnet::urgent_data_policy urgent_data = telnet::urgent_data_policy::at_mark;
+    }; //class replay_config
+
+    using fsm_type         = telnet::protocol_fsm<replay_config>;
+    using response_type    = fsm_type::processing_return_variant;
+    using subneg_awaitable = telnet::awaitables::subnegotiation_awaitable;
+
+    /**
+     * @brief An in-memory `LayerableSocketStream` that serves a capture in fixed-size reads and discards what is written to it.
+     * @remark The lowest layer is an opened but unconnected `tcp::socket`, so socket options and `at_mark` have a real descriptor to act on.
+     * @remark Asynchronous operations complete through `asio::post`, so they only finish when the `io_context` runs; every completion token works through `asio::async_initiate`.
+     */
+    class capture_stream {
+    public:
+        using executor_type     = asio::io_context::executor_type;
+        using lowest_layer_type = asio::ip::tcp::socket;
+
+        ///@brief Opens the lowest layer on `context` and serves `capture` at most `chunk_size` bytes per read.
+        capture_stream(asio::io_context& context, std::span<const byte_t> capture, std::size_t chunk_size)
+            : socket_(context, asio::ip::tcp::v4()), capture_(capture), chunk_size_(std::max<std::size_t>(chunk_size, 1))
+        {}
+
+        executor_type get_executor() noexcept { return socket_.get_executor(); }
+
+        lowest_layer_type& lowest_layer() noexcept { return socket_; }
+
+        const lowest_layer_type& lowest_layer() const noexcept { return socket_; }
+
+        ///@brief Copies up to one chunk of the remaining capture into `buffers`, or reports `asio::error::eof` once it is exhausted.
+        template<typename MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec)
+        {
+            if (capture_.empty()) {
+                ec = asio::error::eof;
+                return 0;
+            }
+            ec.clear();
+            const std::size_t bytes =
+                asio::buffer_copy(buffers, asio::buffer(capture_.data(), std::min(chunk_size_, capture_.size())));
+            capture_ = capture_.subspan(bytes);
+            return bytes;
+        } //capture_stream::read_some(const MutableBufferSequence&, std::error_code&)
+
+        template<typename MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence& buffers)
+        {
+            std::error_code ec;
+            const std::size_t bytes = read_some(buffers, ec);
+            if (ec) {
+                throw std::system_error(ec);
+            }
+            return bytes;
+        } //capture_stream::read_some(const MutableBufferSequence&)
+
+        ///@brief Discards the bytes in `buffers`, reporting them all written.
+        template<typename ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence& buffers, std::error_code& ec)
+        {
+            ec.clear();
+            return asio::buffer_size(buffers);
+        } //capture_stream::write_some(const ConstBufferSequence&, std::error_code&)
+
+        template<typename ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence& buffers)
+        {
+            std::error_code ec;
+            return write_some(buffers, ec);
+        } //capture_stream::write_some(const ConstBufferSequence&)
+
+        template<typename MutableBufferSequence, typename CompletionToken>
+        auto async_read_some(const MutableBufferSequence& buffers, CompletionToken&& token)
+        {
+            return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+                [this](auto handler, const MutableBufferSequence& target) {
+                    std::error_code ec;
+                    const std::size_t bytes = read_some(target, ec);
+                    complete(std::move(handler), ec, bytes);
+                },
+                token,
+                buffers
+            );
+        } //capture_stream::async_read_some(const MutableBufferSequence&, CompletionToken&&)
+
+        template<typename ConstBufferSequence, typename CompletionToken>
+        auto async_write_some(const ConstBufferSequence& buffers, CompletionToken&& token)
+        {
+            return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+                [this](auto handler, const ConstBufferSequence& source) {
+                    std::error_code ec;
+                    const std::size_t bytes = write_some(source, ec);
+                    complete(std::move(handler), ec, bytes);
+                },
+                token,
+                buffers
+            );
+        } //capture_stream::async_write_some(const ConstBufferSequence&, CompletionToken&&)
+
+    private:
+        ///@brief Posts `handler` to its associated executor, so an asynchronous operation never completes inside its initiation.
+        template<typename Handler>
+        void complete(Handler handler, std::error_code ec, std::size_t bytes)
+        {
+            auto executor = asio::get_associated_executor(handler, socket_.get_executor());
+            asio::post(executor, asio::append(std::move(handler), ec, bytes));
+        } //capture_stream::complete(Handler, std::error_code, std::size_t)
+
+        lowest_layer_type socket_;
+        std::span<const byte_t> capture_;
+        std::size_t chunk_size_;
+    }; //class capture_stream
+
+    static_assert(telnet::concepts::LayerableSocketStream<capture_stream>);
+
+    using replay_stream = telnet::stream<capture_stream, replay_config>;
+
+    ///@brief A subnegotiation handler that accepts and ignores the payload.
+    subneg_awaitable ignore_subnegotiation(const option& /*opt*/, std::span<const byte_t> /*data*/) { co_return; }
+
+    /**
+     * @brief Registers GMCP and MSDP (accepted both ways, with subnegotiation) and silences the unknown-option and error callbacks, once.
+     * @remark MUD clients negotiate at least one of these early, so captures exercise `process_subnegotiation_span`.
+     */
+    void prepare_config()
+    {
+        static const bool prepared = [] {
+            replay_config::initialize();
+            for (const auto& [id, name] : {std::pair{option::id_num::gmcp, "GMCP"}, std::pair{option::id_num::msdp, "MSDP"}}) {
+                replay_config::registered_options.upsert(
+                    option{id, name, option::always_accept, option::always_accept, /*subneg_supported=*/true}
+                );
+            }
+            replay_config::set_unknown_option_handler([](option::id_num /*id*/) {});
+            replay_config::set_error_logger([](const std::error_code& /*ec*/, const std::string& /*msg*/) {});
+            return true;
+        }();
+        static_cast<void>(prepared);
+    } //prepare_config()
+
+    ///@brief Registers `ignore_subnegotiation` for GMCP and MSDP on `target` (an FSM or a stream).
+    template<typename Target>
+    void register_handlers(Target& target)
+    {
+        for (const option::id_num id : {option::id_num::gmcp, option::id_num::msdp}) {
+            target.register_option_handlers(id, std::nullopt, std::nullopt, &ignore_subnegotiation);
+        }
+    } //register_handlers(Target&)
+
+    ///@brief Creates an FSM for one replay pass.
+    fsm_type make_fsm()
+    {
+        prepare_config();
+        fsm_type fsm;
+        register_handlers(fsm);
+        return fsm;
+    } //make_fsm()
+
+    ///@brief Describes a signal or error together with the response returned with it, in a form that compares equal exactly when both do.
+    std::string describe(const std::error_code& ec, const std::optional<response_type>& response)
+    {
+        std::string text = ec ? std::format("{}:{}", ec.category().name(), ec.value()) : std::string{"ok"};
+        const auto describe_negotiation = [&text](const fsm_type::negotiation_response_type& negotiation) {
+            const auto& [direction, enable, id] = negotiation;
+            text += std::format(
+                " negotiation({},{},{})",
+                std::to_underlying(direction),
+                enable,
+                static_cast<std::uint32_t>(std::to_underlying(id))
+            );
+        };
+        if (!response) {
+            return text;
+        }
+        switch (response->index()) {
+            case 0:
+                describe_negotiation(std::get<0>(*response));
+                break;
+            case 1:
+                text += std::format(" write({})", std::get<1>(*response));
+                break;
+            case 2:
+                text += " enablement";
+                if (const auto& negotiation = std::get<1>(std::get<2>(*response))) {
+                    describe_negotiation(*negotiation);
+                }
+                break;
+            case 3:
+                text += " disablement";
+                if (const auto& negotiation = std::get<1>(std::get<3>(*response))) {
+                    describe_negotiation(*negotiation);
+                }
+                break;
+            default:
+                text += " subnegotiation";
+                break;
+        }
+        return text;
+    } //describe(const std::error_code&, const std::optional<response_type>&)
+
+    ///@brief Counts what a path produces, cheaply enough to sit inside a timed loop.
+    struct counting_sink {
+        std::size_t forwarded = 0;
+        std::size_t events    = 0;
+
+        void data(std::span<const byte_t> bytes) noexcept { forwarded += bytes.size(); }
+
+        void event(const std::error_code& /*ec*/, const std::optional<response_type>& /*response*/) noexcept { ++events; }
+    }; //struct counting_sink
+
+    ///@brief Records everything a path produces, for the equivalence check.
+    struct tracing_sink {
+        std::vector<byte_t> forwarded;
+        std::vector<std::string> events;
+
+        void data(std::span<const byte_t> bytes) { forwarded.insert(forwarded.end(), bytes.begin(), bytes.end()); }
+
+        void event(const std::error_code& ec, const std::optional<response_type>& response)
+        {
+            events.push_back(std::format("@{} {}", forwarded.size(), describe(ec, response)));
+        }
+    }; //struct tracing_sink
+
+    ///@brief Feeds `input` to `fsm` one byte at a time: the reference behaviour.
+    template<typename Sink>
+    void feed_byte_wise(fsm_type& fsm, std::span<const byte_t> input, Sink& sink)
+    {
+        for (const byte_t& byte : input) {
+            auto [ec, forward, response] = fsm.process_byte(byte);
+            if (forward) {
+                sink.data({&byte, 1});
+            }
+            if (ec || response) {
+                sink.event(ec, response);
+            }
+        }
+    } //feed_byte_wise(fsm_type&, std::span<const byte_t>, Sink&)
+
+    ///@brief Feeds `input` to `fsm` the way `input_processor` does: `process_span` runs, whole subnegotiations via `process_subnegotiation_span`, and `process_byte` for the rest.
+    template<typename Sink>
+    void feed_fast_path(fsm_type& fsm, std::span<const byte_t> input, Sink& sink)
+    {
+        while (!input.empty()) {
+            if (const std::size_t run = fsm.process_span(input); run > 0) {
+                sink.data(input.first(run));
+                input = input.subspan(run);
+                continue;
+            }
+            if (auto [consumed, ec, response] = fsm.process_subnegotiation_span(input); consumed > 0) {
+                if (ec || response) {
+                    sink.event(ec, response);
+                }
+                input = input.subspan(consumed);
+                continue;
+            }
+            feed_byte_wise(fsm, input.first(1), sink);
+            input = input.subspan(1);
+        }
+    } //feed_fast_path(fsm_type&, std::span<const byte_t>, Sink&)
+
+    ///@brief Traces `capture` through `feed` in `chunk_size` pieces on a fresh FSM.
+    template<typename Feed>
+    tracing_sink trace(std::span<const byte_t> capture, std::size_t chunk_size, Feed feed)
+    {
+        fsm_type fsm = make_fsm();
+        tracing_sink sink;
+        for (std::size_t offset = 0; offset < capture.size(); offset += chunk_size) {
+            feed(fsm, capture.subspan(offset, std::min(chunk_size, capture.size() - offset)), sink);
+        }
+        return sink;
+    } //trace(std::span<const byte_t>, std::size_t, Feed)
+
+    /**
+     * @brief Reads `capture` through a fresh `stream` until end of file or an error that is not a `processing_signal`.
+     * @remark `on_read` runs each `read_some` (so it can be timed) and `on_data` sees the bytes each one delivered.
+     */
+    template<typename OnRead, typename OnData>
+    std::error_code read_through_stream(std::span<const byte_t> capture, std::size_t chunk_size, OnRead on_read, OnData on_data)
+    {
+        prepare_config();
+        asio::io_context context;
+        replay_stream stream(capture_stream{context, capture, chunk_size});
+        register_handlers(stream);
+        std::vector<byte_t> buffer(chunk_size);
+
+        std::error_code ec;
+        while (true) {
+            const std::size_t bytes = on_read([&] { return stream.read_some(asio::buffer(buffer), ec); });
+            on_data(std::span<const byte_t>(buffer).first(bytes));
+            if (ec && (&ec.category() != &telnet::telnet_processing_signal_category::instance())) {
+                break;
+            }
+        }
+        return (ec == asio::error::eof) ? std::error_code{} : ec;
+    } //read_through_stream(std::span<const byte_t>, std::size_t, OnRead, OnData)
+
+    /**
+     * @brief Compares the fast path, and the data `stream::read_some` delivers, against `process_byte` alone over `capture`.
+     * @return An empty string if they agree, otherwise a description of the first difference.
+     * @remark Only the stream's data is compared, since it answers negotiations and signals itself rather than returning them.
+     */
+    std::string check_equivalence(std::span<const byte_t> capture, std::size_t chunk_size)
+    {
+        const tracing_sink reference = trace(capture, chunk_size, [](fsm_type& fsm, std::span<const byte_t> input, tracing_sink& sink) {
+            feed_byte_wise(fsm, input, sink);
+        });
+        const tracing_sink fast = trace(capture, chunk_size, [](fsm_type& fsm, std::span<const byte_t> input, tracing_sink& sink) {
+            feed_fast_path(fsm, input, sink);
+        });
+
+        if (const auto [ref_it, fast_it] = std::ranges::mismatch(reference.forwarded, fast.forwarded);
+            (ref_it != reference.forwarded.end()) || (fast_it != fast.forwarded.end())) {
+            return std::format(
+                "forwarded data differs at byte {} ({} bytes by process_byte, {} by the fast path)",
+                std::distance(reference.forwarded.begin(), ref_it),
+                reference.forwarded.size(),
+                fast.forwarded.size()
+            );
+        }
+        if (const auto [ref_it, fast_it] = std::ranges::mismatch(reference.events, fast.events);
+            (ref_it != reference.events.end()) || (fast_it != fast.events.end())) {
+            return std::format(
+                "event {} differs: process_byte \"{}\", fast path \"{}\"",
+                std::distance(reference.events.begin(), ref_it),
+                (ref_it != reference.events.end()) ? *ref_it : std::string{"(none)"},
+                (fast_it != fast.events.end()) ? *fast_it : std::string{"(none)"}
+            );
+        }
+
+        std::vector<byte_t> delivered;
+        const std::error_code stream_ec = read_through_stream(
+            capture,
+            chunk_size,
+            [](auto read) { return read(); },
+            [&delivered](std::span<const byte_t> bytes) { delivered.insert(delivered.end(), bytes.begin(), bytes.end()); }
+        );
+        if (const auto [ref_it, stream_it] = std::ranges::mismatch(reference.forwarded, delivered);
+            (ref_it != reference.forwarded.end()) || (stream_it != delivered.end())) {
+            return std::format(
+                "stream data differs at byte {} ({} bytes by process_byte, {} by stream::read_some{})",
+                std::distance(reference.forwarded.begin(), ref_it),
+                reference.forwarded.size(),
+                delivered.size(),
+                stream_ec ? std::format(", stopped: {}", stream_ec.message()) : std::string{}
+            );
+        }
+        return {};
+    } //check_equivalence(std::span<const byte_t>, std::size_t)
+} //namespace
+
+#ifdef NET_TELNET_REPLAY_FUZZER
+/**
+ * @brief libFuzzer entry point: checks the fast path and a `stream` read of the input against `process_byte`.
+ * @remark The first byte selects the read chunk size (1 to 256) so chunk boundaries fall inside commands and subnegotiations; the rest is the capture.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    const std::span<const byte_t> input(data, size);
+    const std::size_t chunk_size        = std::size_t{input.front()} + 1;
+    const std::span<const byte_t> capture = input.subspan(1);
+
+    if (!check_equivalence(capture, chunk_size).empty()) {
+        std::abort(); //The fast path or the stream diverged from `process_byte`.
+    }
+    return 0;
+}
+#else
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    ///@brief Bytes replayed per path and capture when `--passes` is not given.
+    constexpr std::size_t auto_pass_bytes = std::size_t{8} * 1024 * 1024;
+
+    ///@brief Timings and allocation counts for one path over every pass of one capture.
+    struct path_measurement {
+        std::string_view name;
+        std::size_t bytes_per_pass = 0;
+        std::size_t passes         = 0;
+        clock_type::duration elapsed{};
+        std::uint64_t allocations = 0;
+        std::vector<clock_type::duration> latencies;
+        std::size_t forwarded = 0;
+        std::error_code failure;
+
+        ///@brief Runs `step` once as one timed, allocation-counted chunk and returns its result.
+        template<typename Step>
+        auto measure(Step step)
+        {
+            const std::uint64_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+            const auto start                       = clock_type::now();
+            auto result                            = step();
+            const auto duration                    = clock_type::now() - start;
+            allocations += allocation_count.load(std::memory_order_relaxed) - allocations_before;
+            elapsed += duration;
+            latencies.push_back(duration);
+            return result;
+        } //path_measurement::measure(Step)
+    }; //struct path_measurement
+
+    ///@brief Times `count` FSM passes over `capture` through `feed`, one latency sample per chunk.
+    template<typename Feed>
+    path_measurement measure_fsm(std::string_view name, std::span<const byte_t> capture, std::size_t chunk_size, std::size_t passes, Feed feed)
+    {
+        path_measurement result{.name = name, .bytes_per_pass = capture.size(), .passes = passes};
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            fsm_type fsm = make_fsm();
+            counting_sink sink;
+            for (std::size_t offset = 0; offset < capture.size(); offset += chunk_size) {
+                const auto chunk = capture.subspan(offset, std::min(chunk_size, capture.size() - offset));
+                result.measure([&] {
+                    feed(fsm, chunk, sink);
+                    return 0;
+                });
+            }
+            result.forwarded = sink.forwarded;
+        }
+        return result;
+    } //measure_fsm(std::string_view, std::span<const byte_t>, std::size_t, std::size_t, Feed)
+
+    ///@brief Times `passes` reads of `capture` through `stream::read_some`, one latency sample per call.
+    path_measurement measure_stream(std::span<const byte_t> capture, std::size_t chunk_size, std::size_t passes)
+    {
+        path_measurement result{.name = "stream::read_some", .bytes_per_pass = capture.size(), .passes = passes};
+        for (std::size_t pass = 0; (pass < passes) && !result.failure; ++pass) {
+            std::size_t forwarded = 0;
+            result.failure        = read_through_stream(
+                capture,
+                chunk_size,
+                [&](auto read) {
+                    const std::size_t bytes = result.measure(read);
+                    forwarded += bytes;
+                    return bytes;
+                },
+                [](std::span<const byte_t> /*bytes*/) {}
+            );
+            result.forwarded = forwarded;
+        }
+        return result;
+    } //measure_stream(std::span<const byte_t>, std::size_t, std::size_t)
+
+    ///@brief Gets the nearest-rank `percent` percentile of `sorted`, in microseconds.
+    double percentile_us(const std::vector<clock_type::duration>& sorted, std::size_t percent)
+    {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const std::size_t index = ((sorted.size() - 1) * percent) / 100;
+        return std::chrono::duration<double, std::micro>(sorted[index]).count();
+    } //percentile_us(const std::vector<clock_type::duration>&, std::size_t)
+
+    ///@brief Prints one line of throughput, allocations, and latency percentiles for `measurement`.
+    void report(path_measurement& measurement)
+    {
+        std::ranges::sort(measurement.latencies);
+        const double seconds = std::chrono::duration<double>(measurement.elapsed).count();
+        const double mib     = static_cast<double>(measurement.bytes_per_pass * measurement.passes) / (1024.0 * 1024.0);
+        std::println(
+            "  {:<18} {:>9.1f} MiB/s  {:>9.1f} allocs/pass  p50 {:>8.2f} us  p99 {:>8.2f} us  max {:>8.2f} us  {} bytes forwarded{}",
+            measurement.name,
+            (seconds > 0.0) ? mib / seconds : 0.0,
+            static_cast<double>(measurement.allocations) / static_cast<double>(std::max<std::size_t>(measurement.passes, 1)),
+            percentile_us(measurement.latencies, 50),
+            percentile_us(measurement.latencies, 99),
+            percentile_us(measurement.latencies, 100),
+            measurement.forwarded,
+            measurement.failure ? std::format(" (stopped: {})", measurement.failure.message()) : std::string{}
+        );
+    } //report(path_measurement&)
+
+    ///@brief Reads a whole capture file.
+    std::vector<byte_t> load_capture(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), path.string());
+        }
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    } //load_capture(const std::filesystem::path&)
+
+    ///@brief Expands the command-line paths into capture files, walking directories recursively in sorted order.
+    std::vector<std::filesystem::path> collect_captures(const std::vector<std::filesystem::path>& paths)
+    {
+        std::vector<std::filesystem::path> captures;
+        for (const auto& path : paths) {
+            if (!std::filesystem::is_directory(path)) {
+                captures.push_back(path);
+                continue;
+            }
+            std::vector<std::filesystem::path> found;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file()) {
+                    found.push_back(entry.path());
+                }
+            }
+            std::ranges::sort(found);
+            captures.insert(captures.end(), found.begin(), found.end());
+        }
+        return captures;
+    } //collect_captures(const std::vector<std::filesystem::path>&)
+
+    ///@brief Replays one capture through every path and reports it; returns `false` if the fast path or the stream diverged.
+    bool replay(const std::filesystem::path& path, std::size_t chunk_size, std::size_t passes)
+    {
+        const std::vector<byte_t> capture = load_capture(path);
+        if (passes == 0) {
+            passes = std::clamp<std::size_t>(auto_pass_bytes / std::max<std::size_t>(capture.size(), 1), 1, 10'000);
+        }
+        std::println("{} ({} bytes, {} passes, {}-byte chunks)", path.string(), capture.size(), passes, chunk_size);
+
+        auto byte_wise = measure_fsm("process_byte", capture, chunk_size, passes, [](fsm_type& fsm, std::span<const byte_t> input, counting_sink& sink) {
+            feed_byte_wise(fsm, input, sink);
+        });
+        auto fast_path = measure_fsm("fast path", capture, chunk_size, passes, [](fsm_type& fsm, std::span<const byte_t> input, counting_sink& sink) {
+            feed_fast_path(fsm, input, sink);
+        });
+        auto stream = measure_stream(capture, chunk_size, passes);
+        report(byte_wise);
+        report(fast_path);
+        report(stream);
+
+        const std::string difference = check_equivalence(capture, chunk_size);
+        std::println("  equivalence: {}", difference.empty() ? std::string{"ok"} : "MISMATCH, " + difference);
+        return difference.empty();
+    } //replay(const std::filesystem::path&, std::size_t, std::size_t)
+
+    ///@brief Prints the command-line usage to `std::cerr`.
+    void usage(std::string_view program)
+    {
+        std::println(std::cerr, "usage: {} [--chunk BYTES] [--passes N] CAPTURE_FILE_OR_DIRECTORY...", program);
+        std::println(std::cerr, "  --chunk BYTES  read size for every path (default 4096)");
+        std::println(std::cerr, "  --passes N     replays per path (default: enough for 8 MiB per capture)");
+    } //usage(std::string_view)
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    const std::vector<std::string_view> args(argv, std::next(argv, argc));
+    std::size_t chunk_size = 4096;
+    std::size_t passes     = 0;
+    std::vector<std::filesystem::path> paths;
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const auto parse_value = [&](std::size_t& value) {
+            if ((i + 1 == args.size()) || (std::from_chars(args[i + 1].data(), args[i + 1].data() + args[i + 1].size(), value).ec != std::errc{})) {
+                return false;
+            }
+            ++i;
+            return true;
+        };
+        if (args[i] == "--chunk") {
+            if (!parse_value(chunk_size) || (chunk_size == 0)) {
+                usage(args[0]);
+                return 2;
+            }
+        } else if (args[i] == "--passes") {
+            if (!parse_value(passes)) {
+                usage(args[0]);
+                return 2;
+            }
+        } else {
+            paths.emplace_back(args[i]);
+        }
+    }
+    if (paths.empty()) {
+        usage(args[0]);
+        return 2;
+    }
+
+    bool equivalent = true;
+    try {
+        for (const auto& capture : collect_captures(paths)) {
+            equivalent = replay(capture, chunk_size, passes) && equivalent;
+        }
+    } catch (const std::exception& e) {
+        std::println(std::cerr, "error: {}", e.what());
+        return 2;
+    }
+    return equivalent ? 0 : 1;
+}
+#endif
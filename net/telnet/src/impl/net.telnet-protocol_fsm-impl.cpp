@@ -33,6 +33,7 @@ import :types;      ///< @see "net.telnet-types.cppm" for `telnet::command`, `ne
 import :errors;     ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
 import :options;    ///< @see "net.telnet-options.cppm" for `option` and `option::id_num`
 import :awaitables; ///< @see "net.telnet-awaitables.cppm" for `option_disablement_awaitable`
+import :byte_scan;  ///< @see "net.telnet-byte_scan.cppm" for `byte_scan::find_first_of`
 
 import :protocol_fsm; ///< @see "net.telnet-protocol_fsm.cppm" for the partition being implemented.
 
@@ -62,8 +63,8 @@ namespace net::telnet {
     std::tuple<std::error_code, std::optional<typename protocol_fsm<PC>::negotiation_response_type>>
         protocol_fsm<PC>::request_option(option::id_num opt, negotiation_direction direction)
     {
-        if (!protocol_config_type::registered_options.get(opt)) {
-            protocol_config_type::log_error(
+        if (!knows_option(opt)) {
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::option_not_available),
                 "Option {} not registered for {} negotiation",
                 std::to_underlying(opt),
@@ -74,7 +75,7 @@ namespace net::telnet {
         auto& status = option_status_[opt];
         //Six states: YES, WANTYES/EMPTY, WANTYES/OPPOSITE, WANTNO/EMPTY, WANTNO/OPPOSITE, NO
         if (status.enabled(direction)) { //YES
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant request for option {} in YES state, direction: {}",
                 std::to_underlying(opt),
@@ -82,7 +83,7 @@ namespace net::telnet {
             );
             return {std::error_code{}, std::nullopt};                               //Idempotent success
         } else if (status.pending_enable(direction) && !status.queued(direction)) { //WANTYES/EMPTY
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant request for option {} in WANTYES/EMPTY state, direction: {}",
                 std::to_underlying(opt),
@@ -94,7 +95,7 @@ namespace net::telnet {
             return {std::error_code{}, std::nullopt};
         } else if (status.pending_disable(direction) && !status.queued(direction)) { //WANTNO/EMPTY
             if (auto ec = status.enqueue(direction); ec) {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     ec,
                     "Failed to enqueue request for option {} in WANTNO/EMPTY state, direction: {}",
                     std::to_underlying(opt),
@@ -104,7 +105,7 @@ namespace net::telnet {
             }
             return {std::error_code{}, std::nullopt};
         } else if (status.pending_disable(direction) && status.queued(direction)) { //WANTNO/OPPOSITE
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant request for option {} in WANTNO/OPPOSITE state, direction: {}",
                 std::to_underlying(opt),
@@ -118,7 +119,7 @@ namespace net::telnet {
                 negotiation_response_type{direction, true, opt}
             };
         }
-        protocol_config_type::log_error(
+        log_traits<protocol_config_type>::template log<log_level::error>(
             make_error_code(error::protocol_violation),
             "Invalid state for option {} in direction: {}",
             std::to_underlying(opt),
@@ -143,8 +144,8 @@ namespace net::telnet {
         std::optional<awaitables::option_disablement_awaitable>
     > protocol_fsm<PC>::disable_option(option::id_num opt, negotiation_direction direction)
     {
-        if (!protocol_config_type::registered_options.get(opt)) {
-            protocol_config_type::log_error(
+        if (!knows_option(opt)) {
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::option_not_available),
                 "Option {} not registered for {} negotiation",
                 std::to_underlying(opt),
@@ -155,7 +156,7 @@ namespace net::telnet {
         auto& status = option_status_[opt];
         //Six states: NO, WANTNO/EMPTY, WANTNO/OPPOSITE, WANTYES/EMPTY, WANTYES/OPPOSITE, YES
         if (status.disabled(direction)) { //NO
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant disable for option {} in NO state, direction: {}",
                 std::to_underlying(opt),
@@ -163,7 +164,7 @@ namespace net::telnet {
             );
             return {std::error_code{}, std::nullopt, std::nullopt};                  //Idempotent success
         } else if (status.pending_disable(direction) && !status.queued(direction)) { //WANTNO/EMPTY
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant disable for option {} in WANTNO/EMPTY state, direction: {}",
                 std::to_underlying(opt),
@@ -175,7 +176,7 @@ namespace net::telnet {
             return {std::error_code{}, std::nullopt, std::nullopt};
         } else if (status.pending_enable(direction) && !status.queued(direction)) { //WANTYES/EMPTY
             if (auto ec = status.enqueue(direction); ec) {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     ec,
                     "Failed to enqueue disable for option {} in WANTYES/EMPTY state, direction: {}",
                     std::to_underlying(opt),
@@ -185,7 +186,7 @@ namespace net::telnet {
             }
             return {std::error_code{}, std::nullopt, std::nullopt};
         } else if (status.pending_enable(direction) && status.queued(direction)) { //WANTYES/OPPOSITE
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::debug>(
                 make_error_code(error::invalid_negotiation),
                 "Redundant disable for option {} in WANTYES/OPPOSITE state, direction: {}",
                 std::to_underlying(opt),
@@ -194,14 +195,18 @@ namespace net::telnet {
             return {std::error_code{}, std::nullopt, std::nullopt}; //Idempotent success
         } else if (status.enabled(direction)) {                     //YES
             status.pend_disable(direction);
+            refresh_mode(opt);
             auto awaitable = option_handler_registry_.handle_disablement(opt, direction);
+            if (!awaitable.valid()) {
+                return {std::error_code{}, negotiation_response_type{direction, false, opt}, std::nullopt};
+            }
             return {
                 std::error_code{},
                 negotiation_response_type{direction, false, opt},
                 std::move(awaitable)
             };
         }
-        protocol_config_type::log_error(
+        log_traits<protocol_config_type>::template log<log_level::error>(
             make_error_code(error::protocol_violation),
             "Invalid state for option {} in direction: {}",
             std::to_underlying(opt),
@@ -210,18 +215,264 @@ namespace net::telnet {
         return {make_error_code(error::protocol_violation), std::nullopt, std::nullopt};
     } //disable_option(option::id_num, negotiation_direction)
 
+    /**
+     * @internal
+     * Appends the fields in the order `restore_state` reads them; the option table goes through `option_status_db::pack` so its layout does not depend on bit-field allocation.
+     */
+    template<typename PC>
+    void protocol_fsm<PC>::save_state(std::vector<byte_t>& out) const
+    {
+        out.reserve(out.size() + state_image_fixed_size + subnegotiation_buffer_.size());
+        out.push_back(state_format_version);
+
+        std::array<byte_t, option_status_db::max_option_count> records{};
+        option_status_.pack(records);
+        out.insert(out.end(), records.begin(), records.end());
+
+        out.push_back(std::to_underlying(current_state_));
+        out.push_back(static_cast<byte_t>(current_command_.has_value()));
+        out.push_back(current_command_.has_value() ? std::to_underlying(*current_command_) : byte_t{0});
+        out.push_back(static_cast<byte_t>(current_option_ != nullptr));
+        out.push_back((current_option_ != nullptr) ? std::to_underlying(current_option_->get_id()) : byte_t{0});
+
+        snapshot_length::append(out, static_cast<std::uint32_t>(subnegotiation_buffer_.size()));
+        out.insert(out.end(), subnegotiation_buffer_.begin(), subnegotiation_buffer_.end());
+    } //save_state(std::vector<byte_t>&) const
+
+    /**
+     * @internal
+     * Decodes the option table into a scratch `option_status_db` and checks every field before committing any of them.
+     * Only an option this configuration knows may hold a non-`NO` record, since the old process could only have agreed to options it knew.
+     * Each state holds exactly the parser fields `handle_state_iac` and `handle_state_subnegotiation_option` would have left: a WILL/WONT/DO/DONT command in `option_negotiation`, SB in the subnegotiation states, plus the option in `subnegotiation` and `subnegotiation_iac`, and nothing otherwise.
+     * Copies the partial payload and only then upserts an unregistered subnegotiation option, so a rejected or failed restore leaves the registry untouched too.
+     * Logs `error::invalid_snapshot` with the offending field before returning it.
+     */
+    template<typename PC>
+    std::tuple<std::size_t, std::error_code> protocol_fsm<PC>::restore_state(std::span<const byte_t> image)
+    {
+        const auto reject = [](std::string_view field) -> std::tuple<std::size_t, std::error_code> {
+            log_traits<protocol_config_type>::template log<log_level::error>(
+                make_error_code(error::invalid_snapshot), "field: {}", field
+            );
+            return {0, make_error_code(error::invalid_snapshot)};
+        };
+
+        if (image.size() < state_image_fixed_size) {
+            return reject("length");
+        }
+        if (image[0] != state_format_version) {
+            return reject("version");
+        }
+
+        option_status_db status;
+        if (!status.unpack(image.subspan<1, option_status_db::max_option_count>())) {
+            return reject("option records");
+        }
+        for (std::size_t id = 0; id < option_status_db::max_option_count; ++id) {
+            const auto opt = static_cast<option::id_num>(id);
+            const auto& record = status[opt];
+            if (!(record.local_disabled() && record.remote_disabled()) && !knows_option(opt)) {
+                return reject("unknown option");
+            }
+        }
+
+        auto fields = image.subspan(1 + option_status_db::max_option_count);
+        if (fields[0] > std::to_underlying(protocol_state::subnegotiation_iac)) {
+            return reject("state");
+        }
+        const auto state = static_cast<protocol_state>(fields[0]);
+        if ((fields[1] > 1) || (fields[3] > 1)) {
+            return reject("presence");
+        }
+        std::optional<telnet::command> command;
+        if (fields[1] != 0) {
+            command = static_cast<telnet::command>(fields[2]);
+        }
+        std::optional<option::id_num> option_id;
+        if (fields[3] != 0) {
+            option_id = static_cast<option::id_num>(fields[4]);
+        }
+
+        const bool in_subnegotiation =
+            (state == protocol_state::subnegotiation) || (state == protocol_state::subnegotiation_iac);
+        switch (state) {
+            case protocol_state::option_negotiation:
+                if (!command
+                    || ((*command != telnet::command::will_opt) && (*command != telnet::command::wont_opt)
+                        && (*command != telnet::command::do_opt) && (*command != telnet::command::dont_opt)))
+                {
+                    return reject("command");
+                }
+                break;
+            case protocol_state::subnegotiation_option:
+                [[fallthrough]];
+            case protocol_state::subnegotiation:
+                [[fallthrough]];
+            case protocol_state::subnegotiation_iac:
+                if (command != telnet::command::sb) {
+                    return reject("command");
+                }
+                break;
+            default:
+                if (command) {
+                    return reject("command");
+                }
+                break;
+        }
+        if (option_id.has_value() != in_subnegotiation) {
+            return reject("option");
+        }
+
+        const std::uint32_t length = *snapshot_length::read(fields.subspan(5));
+        if ((image.size() - state_image_fixed_size) < length) {
+            return reject("subnegotiation length");
+        }
+
+        option_registry& registry    = option_source();
+        const option* current_option = option_id ? registry.get(*option_id) : nullptr;
+        if (option_id) {
+            const std::size_t max_size =
+                current_option ? max_subnegotiation_size(*current_option) : option::default_max_subnegotiation_size;
+            if ((max_size > 0) && (length > max_size)) {
+                return reject("subnegotiation length");
+            }
+        }
+
+        const auto payload = image.subspan(state_image_fixed_size, length);
+        std::vector<byte_t> buffer(payload.begin(), payload.end());
+        if (option_id && !current_option) {
+            current_option = &registry.upsert(*option_id); //Last, once nothing else can fail
+        }
+
+        subnegotiation_buffer_ = std::move(buffer);
+        option_status_         = status;
+        current_state_         = state;
+        current_command_       = command;
+        current_option_        = current_option;
+        refresh_mode(option::id_num::binary);
+        return {state_image_fixed_size + length, std::error_code{}};
+    } //restore_state(std::span<const byte_t>)
+
+    /**
+     * @internal
+     * Reads the payload length at the end of the fixed fields, where `save_state` put it.
+     */
+    template<typename PC>
+    std::optional<std::size_t> protocol_fsm<PC>::state_image_size(std::span<const byte_t> image) noexcept
+    {
+        if (image.size() < state_image_fixed_size) {
+            return std::nullopt;
+        }
+        const std::size_t length = *snapshot_length::read(image.subspan(state_image_fixed_size - snapshot_length::size));
+        if ((image.size() - state_image_fixed_size) < length) {
+            return std::nullopt;
+        }
+        return state_image_fixed_size + length;
+    } //state_image_size(std::span<const byte_t>) noexcept
+
+    /**
+     * @internal
+     * Builds the mirroring registry on first use for a `StaticOptionTableConfig`.
+     */
+    template<typename PC>
+    option_registry& protocol_fsm<PC>::option_source()
+    {
+        if constexpr (has_option_table) {
+            static option_registry registry{protocol_config_type::option_table};
+            return registry;
+        } else {
+            return protocol_config_type::registered_options;
+        }
+    } //option_source()
+
+    /**
+     * @internal
+     * Consults `option_table` when present, else `registered_options.has`.
+     */
+    template<typename PC>
+    bool protocol_fsm<PC>::knows_option(option::id_num opt) noexcept
+    {
+        if constexpr (has_option_table) {
+            return protocol_config_type::option_table.has(opt);
+        } else {
+            return protocol_config_type::registered_options.has(opt);
+        }
+    } //knows_option(option::id_num)
+
+    /**
+     * @internal
+     * Consults `option_table` when present, else calls `opt.supports`.
+     */
+    template<typename PC>
+    bool protocol_fsm<PC>::supports(const option& opt, negotiation_direction direction)
+    {
+        if constexpr (has_option_table) {
+            return protocol_config_type::option_table.supports(opt, direction);
+        } else {
+            return opt.supports(direction);
+        }
+    } //supports(const option&, negotiation_direction)
+
+    /**
+     * @internal
+     * Consults `option_table` when present, else `opt`.
+     */
+    template<typename PC>
+    bool protocol_fsm<PC>::supports_subnegotiation(const option& opt) noexcept
+    {
+        if constexpr (has_option_table) {
+            return protocol_config_type::option_table.supports_subnegotiation(opt);
+        } else {
+            return opt.supports_subnegotiation();
+        }
+    } //supports_subnegotiation(const option&)
+
+    /**
+     * @internal
+     * Consults `option_table` when present, else `opt`.
+     */
+    template<typename PC>
+    std::size_t protocol_fsm<PC>::max_subnegotiation_size(const option& opt) noexcept
+    {
+        if constexpr (has_option_table) {
+            return protocol_config_type::option_table.max_subnegotiation_size(opt);
+        } else {
+            return opt.max_subnegotiation_size();
+        }
+    } //max_subnegotiation_size(const option&)
+
+    /**
+     * @internal
+     * Copies BINARY's local and remote `YES` states into `mode_`; other options leave it unchanged.
+     */
+    template<typename PC>
+    void protocol_fsm<PC>::refresh_mode(option::id_num opt) noexcept
+    {
+        if (opt != option::id_num::binary) {
+            return;
+        }
+        const auto& status = option_status_[option::id_num::binary];
+        mode_ = static_cast<std::uint8_t>(
+            (status.local_enabled() ? binary_local_mode : 0) | (status.remote_enabled() ? binary_remote_mode : 0)
+        );
+    } //refresh_mode(option::id_num)
+
     /**
      * @internal
      * Transitions `protocol_fsm`'s state.
-     * @note Resets `current_command_`, `current_option_`, and `subnegotiation_buffer_` when transitioning to `protocol_state::normal`.
+     * @note Resets `current_command_` and `current_option_` when transitioning to `protocol_state::normal`.
+     * @remark Leaves `subnegotiation_buffer_` intact, since a handler may still be viewing it; `handle_state_subnegotiation_option` clears it instead.
+     * @remark Under `lean_memory`, frees `subnegotiation_buffer_`'s capacity so an idle session holds no subnegotiation storage; `complete_subnegotiation` has moved any payload a handler needs.
      */
     template<typename PC>
     void protocol_fsm<PC>::change_state(protocol_state next_state) noexcept
     {
         if (next_state == protocol_state::normal) {
             current_command_ = std::nullopt;
-            current_option_  = std::nullopt;
-            subnegotiation_buffer_.clear();
+            current_option_  = nullptr;
+            if constexpr (policy_traits<PC>::lean_memory) {
+                std::vector<byte_t>{}.swap(subnegotiation_buffer_);
+            }
         }
         current_state_ = next_state;
     } //change_state(protocol_state)
@@ -253,7 +504,7 @@ namespace net::telnet {
                 return handle_state_subnegotiation_iac(byte);
             default:
                 [[unlikely]] //Impossible unless a new enumerator has been added or memory has been corrupted.
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     make_error_code(error::protocol_violation),
                     "byte: 0x{:02x}, cmd: {}, opt: {}",
                     byte,
@@ -265,6 +516,74 @@ namespace net::telnet {
         }
     } //process_byte(byte_t)
 
+    /**
+     * @internal
+     * Returns 0 immediately outside `protocol_state::normal` so that multi-byte sequences are always handled byte-wise.
+     * Reads the cached remote `BINARY` bit once and dispatches to the matching `scan_plain_run`, which finds the first byte that `handle_state_normal` would not simply forward.
+     */
+    template<typename PC>
+    std::size_t protocol_fsm<PC>::process_span(std::span<const byte_t> data) const noexcept
+    {
+        if (current_state_ != protocol_state::normal) [[unlikely]] {
+            return 0;
+        }
+        return binary_enabled(negotiation_direction::remote) ? scan_plain_run<true>(data) : scan_plain_run<false>(data);
+    } //process_span(std::span<const byte_t>) const noexcept
+
+    /**
+     * @internal
+     * Uses `byte_scan::find_first_of` with the stop set fixed at compile time: `IAC` and `'\0'`, plus `'\r'` in text mode.
+     */
+    template<typename PC>
+    template<bool RemoteBinary>
+    std::size_t protocol_fsm<PC>::scan_plain_run(std::span<const byte_t> data) noexcept
+    {
+        constexpr auto iac_byte = std::to_underlying(telnet::command::iac);
+        constexpr auto cr_byte  = static_cast<byte_t>('\r');
+        constexpr auto nul_byte = static_cast<byte_t>('\0');
+
+        const byte_t* first = data.data();
+        const byte_t* last  = first + data.size();
+        if constexpr (RemoteBinary) {
+            return static_cast<std::size_t>(byte_scan::find_first_of<iac_byte, nul_byte>(first, last) - first);
+        } else {
+            return static_cast<std::size_t>(byte_scan::find_first_of<iac_byte, nul_byte, cr_byte>(first, last) - first);
+        }
+    } //scan_plain_run(std::span<const byte_t>)
+
+    /**
+     * @internal
+     * Returns 0 unless in `protocol_state::subnegotiation` with nothing buffered yet, so fragmented or partially buffered payloads stay byte-wise.
+     * Finds the first `IAC` in `data`; if the next byte is `SE` and the payload fits `max_subnegotiation_size()`, dispatches the payload in place via `complete_subnegotiation`.
+     * @remark An `IAC IAC` escape, a stray command, or an oversized payload falls back to `process_byte`, which unescapes into `subnegotiation_buffer_` and reports any overflow.
+     */
+    template<typename PC>
+    std::tuple<std::size_t, std::error_code, std::optional<typename protocol_fsm<PC>::processing_return_variant>>
+        protocol_fsm<PC>::process_subnegotiation_span(std::span<const byte_t> data)
+    {
+        if constexpr (policy_traits<PC>::lean_memory) {
+            return {0, std::error_code(), std::nullopt};
+        } else {
+            if ((current_state_ != protocol_state::subnegotiation) || !current_option_ || !subnegotiation_buffer_.empty()) {
+                return {0, std::error_code(), std::nullopt};
+            }
+
+            constexpr auto iac_byte = std::to_underlying(telnet::command::iac);
+            constexpr auto se_byte  = std::to_underlying(telnet::command::se);
+
+            const auto payload_size = static_cast<std::size_t>(std::ranges::distance(data.begin(), std::ranges::find(data, iac_byte)));
+            if ((payload_size + 1 >= data.size()) || (data[payload_size + 1] != se_byte)) {
+                return {0, std::error_code(), std::nullopt}; //Fragmented, or not IAC SE
+            }
+            if (const std::size_t max_size = max_subnegotiation_size(*current_option_); max_size > 0 && payload_size > max_size) {
+                return {0, std::error_code(), std::nullopt}; //Let `process_byte` report the overflow.
+            }
+
+            auto [ec, response] = complete_subnegotiation(data.first(payload_size));
+            return {payload_size + 2, ec, std::move(response)}; //Payload plus IAC SE
+        }
+    } //process_subnegotiation_span(std::span<const byte_t>)
+
     /**
      * @internal
      * Transitions to `protocol_state::has_iac` if `byte` is `IAC` (0xFF), discarding the byte (returns `false` for forward flag).
@@ -279,7 +598,7 @@ namespace net::telnet {
             change_state(protocol_state::has_iac);
             return {std::error_code(), false, std::nullopt}; //discard IAC byte
         } else if ((byte == static_cast<byte_t>('\r'))
-                   && (!option_status_[option::id_num::binary].enabled(negotiation_direction::remote))) {
+                   && !binary_enabled(negotiation_direction::remote)) {
             change_state(protocol_state::has_cr);
             return {std::error_code(), false, std::nullopt}; //discard CR byte
         } else if (byte == static_cast<byte_t>('\0')) {
@@ -314,7 +633,7 @@ namespace net::telnet {
             result_ec      = make_error_code(processing_signal::carriage_return);
             result_forward = false; //discard NUL byte
         } else if (byte == std::to_underlying(telnet::command::iac)) {
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::protocol_violation),
                 "Invalid CR IAC sequence. Retained bare CR and transitioned to `protocol_state::has_iac`."
             );
@@ -322,7 +641,7 @@ namespace net::telnet {
             result_forward = false; //discard IAC byte
             next_state     = protocol_state::has_iac;
         } else { //any other sequence is invalid
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::protocol_violation),
                 "Invalid CR 0x{:02x} sequence. Retained CR and data byte for data safety and transitioned back to `protocol_state::normal`.",
                 byte
@@ -378,7 +697,7 @@ namespace net::telnet {
                         break;
                     case se:
                         //SE outside subnegotiation is a protocol-level error. Log it, ignore it and move on.
-                        protocol_config_type::log_error(
+                        log_traits<protocol_config_type>::template log<log_level::error>(
                             make_error_code(error::invalid_subnegotiation),
                             "byte: 0x{:02x}, cmd: {}, opt: {}",
                             byte,
@@ -392,7 +711,7 @@ namespace net::telnet {
                     case ga:
                         if (option_status_[option::id_num::suppress_go_ahead].enabled(negotiation_direction::remote)) {
                             //Log GA if SGA is active, but ultimately ignore it.
-                            protocol_config_type::log_error(
+                            log_traits<protocol_config_type>::template log<log_level::debug>(
                                 make_error_code(error::ignored_go_ahead),
                                 "byte: 0x{:02x}, cmd: {}, opt: N/A",
                                 byte,
@@ -433,7 +752,7 @@ namespace net::telnet {
                         result_ec = make_error_code(processing_signal::telnet_break);
                         break;
                     default:
-                        protocol_config_type::log_error(
+                        log_traits<protocol_config_type>::template log<log_level::error>(
                             make_error_code(error::invalid_command),
                             "byte: 0x{:02x}, cmd: {}, opt: {}",
                             byte,
@@ -443,7 +762,7 @@ namespace net::telnet {
                         break;
                 } //switch(*current_command_)
             } else [[unlikely]] { //Impossible unless memory has been corrupted.
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     make_error_code(error::invalid_command), "byte: 0x{:02x}, cmd: N/A, opt: {}", byte, current_option_
                 );
             }
@@ -454,11 +773,31 @@ namespace net::telnet {
 
     /**
      * @internal
-     * Sets `current_option_` by querying `protocol_config_type::registered_options` with the option ID.
+     * Checks `awaitable.valid()` so handler-less negotiations produce a plain `negotiation_response_type` (or nothing) instead of a tuple the stream would `co_spawn`.
+     */
+    template<typename PC>
+    template<typename Tag>
+    std::optional<typename protocol_fsm<PC>::processing_return_variant> protocol_fsm<PC>::handler_response(
+        awaitables::tagged_awaitable<Tag, void> awaitable,
+        std::optional<negotiation_response_type> reply
+    )
+    {
+        if (awaitable.valid()) {
+            return std::tuple{std::move(awaitable), std::move(reply)};
+        }
+        if (reply) {
+            return *reply;
+        }
+        return std::nullopt;
+    } //handler_response(awaitables::tagged_awaitable<Tag, void>, std::optional<negotiation_response_type>)
+
+    /**
+     * @internal
+     * Sets `current_option_` by querying `option_source()` with the option ID.
      * For known options, evaluates enablement state using `option_status_` and updates `local_enabled_` or `remote_enabled_` based on `current_command_` (`WILL`/`WONT` for remote, `DO`/`DONT` for local).
-     * Generates a response (`WILL`/`WONT`/`DO`/`DONT`) if the request changes the enablement state and is supported.
+     * Generates a response (`WILL`/`WONT`/`DO`/`DONT`) if the request changes the enablement state and is supported, pairing it with the handler awaitable via `handler_response`.
      * For unknown options, invokes `protocol_config_type::get_unknown_option_handler` or logs `error::option_not_available`, and responds with `DONT`/`WONT` for enablement requests.
-     * Transitions to `protocol_state::normal` and discards the option byte (returns `false` for forward flag).
+     * Calls `refresh_mode` so a BINARY change updates `mode_`, then transitions to `protocol_state::normal` and discards the option byte (returns `false` for forward flag).
      * Uses `[[likely]]` for valid `current_command_` cases.
      */
     //NOLINTBEGIN(readability-function-cognitive-complexity)
@@ -473,7 +812,7 @@ namespace net::telnet {
                                                 ? negotiation_direction::remote
                                                 : negotiation_direction::local;
 
-            current_option_ = protocol_config_type::registered_options.get(static_cast<option::id_num>(byte));
+            current_option_ = option_source().get(static_cast<option::id_num>(byte));
 
             if (current_option_) {
                 auto& current_status = option_status_[*current_option_];
@@ -483,7 +822,7 @@ namespace net::telnet {
                 if ((request_to_enable && current_status.enabled(direction))
                     || (!request_to_enable && current_status.disabled(direction))) {
                     //Redundant WILL/DO in YES or WONT/DONT in NO: ignore
-                    protocol_config_type::log_error(
+                    log_traits<protocol_config_type>::template log<log_level::debug>(
                         make_error_code(error::invalid_negotiation),
                         "byte: 0x{:02x}, cmd: {}, opt: {}, dir: {}",
                         byte,
@@ -502,9 +841,9 @@ namespace net::telnet {
                         } else {
                             //WILL/DO in WANTYES with EMPTY queue bit: complete negotiation.
                             current_status.enable(direction);
-                            response = std::tuple{
+                            response = handler_response(
                                 option_handler_registry_.handle_enablement(*current_option_, direction), std::nullopt
-                            };
+                            );
                         }
                     } else if (current_status.pending_disable(direction)) {
                         //WANTNO
@@ -512,12 +851,12 @@ namespace net::telnet {
                             //WANTNO with OPPOSITE queue bit. Invalid Negotiation, but we're now in agreement, so accept gracefully.
                             current_status.dequeue(direction);
                             current_status.enable(direction);
-                            response = std::tuple{
+                            response = handler_response(
                                 option_handler_registry_.handle_enablement(*current_option_, direction), std::nullopt
-                            };
+                            );
                         } else {
                             //WANTNO with EMPTY queue bit. Invalid Negotiation.
-                            protocol_config_type::log_error(
+                            log_traits<protocol_config_type>::template log<log_level::error>(
                                 make_error_code(error::invalid_negotiation),
                                 "byte: 0x{:02x}, cmd: {}, opt: {}, dir: {}",
                                 byte,
@@ -527,13 +866,13 @@ namespace net::telnet {
                             );
                             current_status.disable(direction);
                         }
-                    } else if (current_option_->supports(direction)) {
+                    } else if (supports(*current_option_, direction)) {
                         //WILL/DO in NO: accept if supported.
                         current_status.enable(direction);
-                        response = std::tuple{
+                        response = handler_response(
                             option_handler_registry_.handle_enablement(*current_option_, direction),
                             negotiation_response_type{direction, true, *current_option_}
-                        };
+                        );
                     } else {
                         //Unsupported option
                         response = negotiation_response_type{direction, false, *current_option_};
@@ -563,10 +902,10 @@ namespace net::telnet {
                     } else { //YES
                         //WONT/DONT in YES: disable.
                         current_status.disable(direction);
-                        response = std::tuple{
+                        response = handler_response(
                             option_handler_registry_.handle_disablement(*current_option_, direction),
                             negotiation_response_type{direction, false, *current_option_}
-                        };
+                        );
                     }
                 }
             } else {
@@ -575,7 +914,7 @@ namespace net::telnet {
                 if (unknown_option_handler) {
                     unknown_option_handler(static_cast<option::id_num>(byte));
                 } else {
-                    protocol_config_type::log_error(
+                    log_traits<protocol_config_type>::template log<log_level::error>(
                         make_error_code(error::option_not_available),
                         "byte: 0x{:02x}, cmd: {}, opt: N/A, dir: {}",
                         byte,
@@ -590,10 +929,11 @@ namespace net::telnet {
                 }
             }
         } else [[unlikely]] { //Impossible unless memory has been corrupted.
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::protocol_violation), "byte: 0x{:02x}, cmd: N/A, opt: {}", byte, current_option_
             );
         }
+        refresh_mode(static_cast<option::id_num>(byte));
         change_state(protocol_state::normal);
         return {std::error_code(), false, std::move(response)}; //discard option byte
     } //handle_state_option_negotiation(byte_t)
@@ -602,31 +942,31 @@ namespace net::telnet {
 
     /**
      * @internal
-     * Sets `current_option_` by querying `protocol_config_type::registered_options` with the option ID.
+     * Sets `current_option_` by querying `option_source()` with the option ID.
      * For unknown options, memoizes a default `option` via `registry.upsert` and logs `error::invalid_subnegotiation`.
      * Logs `error::invalid_subnegotiation` for options that don’t support subnegotiation or aren’t enabled in `option_status_`.
-     * Reserves `subnegotiation_buffer_` based on `current_option_->max_subnegotiation_size()`.
+     * Clears `subnegotiation_buffer_` and reserves it based on `max_subnegotiation_size(*current_option_)`.
      * Transitions to `protocol_state::subnegotiation` and discards the option byte (returns `false` for forward flag).
      */
     template<typename PC>
     std::tuple<std::error_code, bool, std::optional<typename protocol_fsm<PC>::processing_return_variant>>
         protocol_fsm<PC>::handle_state_subnegotiation_option(byte_t byte)
     {
-        option_registry& registry = protocol_config_type::registered_options;
+        option_registry& registry = option_source();
         current_option_           = registry.get(static_cast<option::id_num>(byte));
 
         if (!current_option_) {
             //Memoize a defaulted option object (automatic rejection) to avoid lookup failures on repeated bad requests.
-            current_option_ = registry.upsert(static_cast<option::id_num>(byte));
-            protocol_config_type::log_error(
+            current_option_ = &registry.upsert(static_cast<option::id_num>(byte));
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::invalid_subnegotiation),
                 "byte: 0x{:02x}, cmd: {}, opt: {}",
                 byte,
                 telnet::command::sb,
                 *current_option_
             );
-        } else if (!current_option_->supports_subnegotiation() || !(option_status_[*current_option_].is_enabled())) {
-            protocol_config_type::log_error(
+        } else if (!supports_subnegotiation(*current_option_) || !(option_status_[*current_option_].is_enabled())) {
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::invalid_subnegotiation),
                 "byte: 0x{:02x}, cmd: {}, opt: {}",
                 byte,
@@ -634,7 +974,8 @@ namespace net::telnet {
                 *current_option_
             );
         }
-        subnegotiation_buffer_.reserve(current_option_->max_subnegotiation_size());
+        subnegotiation_buffer_.clear();
+        subnegotiation_buffer_.reserve(max_subnegotiation_size(*current_option_));
         change_state(protocol_state::subnegotiation);
         return {std::error_code(), false, std::nullopt}; //discard subnegotiation byte
     } //handle_state_subnegotiation_option(byte_t)
@@ -643,7 +984,7 @@ namespace net::telnet {
      * @internal
      * Logs `error::protocol_violation` and transitions to `protocol_state::normal` if `current_option_` is unset.
      * Transitions to `protocol_state::subnegotiation_iac` if `byte` is `IAC`.
-     * Checks `subnegotiation_buffer_` size against `current_option_->max_subnegotiation_size()` and logs `error::subnegotiation_overflow` if exceeded, transitioning to `protocol_state::normal`.
+     * Checks `subnegotiation_buffer_` size against `max_subnegotiation_size(*current_option_)` and logs `error::subnegotiation_overflow` if exceeded, transitioning to `protocol_state::normal`.
      * Appends non-`IAC` bytes to `subnegotiation_buffer_` and discards them (returns `false` for forward flag).
      */
     template<typename PC>
@@ -651,7 +992,7 @@ namespace net::telnet {
         protocol_fsm<PC>::handle_state_subnegotiation(byte_t byte)
     {
         if (!current_option_) {
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::protocol_violation), "byte: 0x{:02x}, cmd: {}, opt: N/A", byte, current_command_
             );
             change_state(protocol_state::normal);
@@ -660,9 +1001,9 @@ namespace net::telnet {
         if (byte == std::to_underlying(telnet::command::iac)) {
             change_state(protocol_state::subnegotiation_iac);
         } else {
-            size_t max_size = current_option_->max_subnegotiation_size();
+            size_t max_size = max_subnegotiation_size(*current_option_);
             if (max_size > 0 && subnegotiation_buffer_.size() >= max_size) {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     make_error_code(error::subnegotiation_overflow),
                     "byte: 0x{:02x}, cmd: {}, opt: {}",
                     byte,
@@ -680,8 +1021,7 @@ namespace net::telnet {
     /**
      * @internal
      * Logs `error::protocol_violation` and transitions to `protocol_state::normal` if `current_option_` is unset.
-     * For `SE`, completes subnegotiation by invoking `option_handler_registry_.handle_subnegotiation` if supported and enabled, then transitions to `protocol_state::normal`.
-     * @note For `STATUS` subnegotiation, invokes dedicated `handle_status_subnegotiation` helper to yield the `subnegotiation_awaitable` for internal processing.
+     * For `SE`, completes subnegotiation with `complete_subnegotiation` over `subnegotiation_buffer_`.
      * For non-`SE`/non-`IAC` bytes, logs `error::invalid_command`, assumes an unescaped IAC, and appends both `IAC` and the byte to `subnegotiation_buffer_`.
      * Checks `subnegotiation_buffer_` size against `max_subnegotiation_size()` and logs `error::subnegotiation_overflow` if exceeded.
      * Transitions to `protocol_state::subnegotiation` for non-`SE` bytes and discards all bytes (returns `false` for forward flag).
@@ -690,30 +1030,20 @@ namespace net::telnet {
     std::tuple<std::error_code, bool, std::optional<typename protocol_fsm<PC>::processing_return_variant>>
         protocol_fsm<PC>::handle_state_subnegotiation_iac(byte_t byte)
     {
-        std::optional<processing_return_variant> response = std::nullopt;
         if (!current_option_) {
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 make_error_code(error::protocol_violation), "byte: 0x{:02x}, cmd: {}, opt: N/A", byte, current_command_
             );
             change_state(protocol_state::normal);
             return {make_error_code(error::protocol_violation), false, std::nullopt};
         }
         if (byte == std::to_underlying(telnet::command::se)) {
-            //Subnegotiation sequence completed, so pass the buffer to the handler if supported.
-            //If subnegotiation is not supported or the option is not enabled, the error was logged at the beginning of subnegotiation, so just discard the buffer.
-            if (current_option_->supports_subnegotiation() && option_status_[*current_option_].is_enabled()) {
-                if (*current_option_ == option::id_num::status) {
-                    response = handle_status_subnegotiation(*current_option_, std::move(subnegotiation_buffer_));
-                } else {
-                    response =
-                        option_handler_registry_.handle_subnegotiation(*current_option_, std::move(subnegotiation_buffer_));
-                }
-            }
-            change_state(protocol_state::normal);
+            auto [ec, response] = complete_subnegotiation(subnegotiation_buffer_);
+            return {ec, false, std::move(response)}; //discard SE byte
         } else {
-            std::size_t max_size = current_option_->max_subnegotiation_size();
+            std::size_t max_size = max_subnegotiation_size(*current_option_);
             if (max_size > 0 && subnegotiation_buffer_.size() >= max_size) {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     make_error_code(error::subnegotiation_overflow),
                     "byte: 0x{:02x}, cmd: {}, opt: {}",
                     byte,
@@ -726,7 +1056,7 @@ namespace net::telnet {
             //We either have an escaped IAC or an invalid command, so append IAC to the buffer.
             subnegotiation_buffer_.push_back(std::to_underlying(telnet::command::iac));
             if (byte != std::to_underlying(telnet::command::iac)) {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     make_error_code(error::invalid_command),
                     "byte: 0x{:02x}, cmd: {}, opt: {}",
                     byte,
@@ -738,9 +1068,89 @@ namespace net::telnet {
             }
             change_state(protocol_state::subnegotiation);
         }
-        return {std::error_code(), false, std::move(response)}; //discard subnegotiation byte
+        return {std::error_code(), false, std::nullopt}; //discard subnegotiation byte
     } //handle_state_subnegotiation_iac(byte_t)
 
+    /**
+     * @internal
+     * Adds the payload size to `statistic::subnegotiation_bytes` of the attached `statistics_`, if any.
+     * Dispatches the payload if the option supports subnegotiation and is enabled, then transitions to `protocol_state::normal`.
+     * @note For `STATUS` subnegotiation, `dispatch_subnegotiation` invokes the dedicated `handle_status_subnegotiation` helper to yield the `subnegotiation_awaitable` for internal processing.
+     * @note For `MCCP2` enabled remotely or `MCCP3` enabled locally, returns `processing_signal::compression_start` instead of invoking a handler, since every byte after this `SE` is compressed.
+     * @note For `START_TLS` with the `FOLLOWS` payload, returns `processing_signal::tls_start` instead of invoking a handler, since every byte after this `SE` is a TLS record.
+     */
+    template<typename PC>
+    std::tuple<std::error_code, std::optional<typename protocol_fsm<PC>::processing_return_variant>>
+        protocol_fsm<PC>::complete_subnegotiation(std::span<const byte_t> payload)
+    {
+        std::optional<processing_return_variant> response = std::nullopt;
+        if (statistics_) {
+            statistics_->add(statistic::subnegotiation_bytes, payload.size());
+        }
+        //Subnegotiation sequence completed, so pass the payload to the handler if supported.
+        //If subnegotiation is not supported or the option is not enabled, the error was logged at the beginning of subnegotiation, so just discard the payload.
+        if (supports_subnegotiation(*current_option_) && option_status_[*current_option_].is_enabled()) {
+            if (((*current_option_ == option::id_num::mccp2)
+                 && option_status_[option::id_num::mccp2].enabled(negotiation_direction::remote))
+                || ((*current_option_ == option::id_num::mccp3)
+                    && option_status_[option::id_num::mccp3].enabled(negotiation_direction::local))) {
+                //The peer compresses everything after this SE; `stream` must switch its input to the inflater now.
+                change_state(protocol_state::normal);
+                return {make_error_code(processing_signal::compression_start), std::nullopt};
+            }
+            if ((*current_option_ == option::id_num::telnet_start_tls) && (payload.size() == 1)
+                && (payload.front() == start_tls_follows)) {
+                //The peer's next bytes are its TLS handshake; `stream` must switch its input to the TLS session now.
+                change_state(protocol_state::normal);
+                return {make_error_code(processing_signal::tls_start), std::nullopt};
+            }
+            if (auto handler = dispatch_subnegotiation(*current_option_, payload); handler.valid()) {
+                if constexpr (policy_traits<PC>::lean_memory) {
+                    //`process_subnegotiation_span` is disabled, so `payload` is `subnegotiation_buffer_`; move it into a frame that outlives the handler.
+                    response = handle_owned_subnegotiation(std::move(subnegotiation_buffer_), std::move(handler));
+                } else if constexpr (policy_traits<PC>::batch_subnegotiations) {
+                    //A batched handler runs after later subnegotiations have reused `subnegotiation_buffer_`, so a payload buffered there must move with it.
+                    if (payload.data() == subnegotiation_buffer_.data()) {
+                        response = handle_owned_subnegotiation(std::move(subnegotiation_buffer_), std::move(handler));
+                    } else {
+                        response = std::move(handler);
+                    }
+                } else {
+                    response = std::move(handler);
+                }
+            }
+        }
+        change_state(protocol_state::normal);
+        return {std::error_code(), std::move(response)};
+    } //complete_subnegotiation(std::span<const byte_t>)
+
+    /**
+     * @internal
+     * Routes `STATUS` to `handle_status_subnegotiation` and every other option to `option_handler_registry_`.
+     */
+    template<typename PC>
+    awaitables::subnegotiation_awaitable
+        protocol_fsm<PC>::dispatch_subnegotiation(const option& opt, std::span<const byte_t> payload)
+    {
+        if (opt == option::id_num::status) {
+            return handle_status_subnegotiation(opt, payload);
+        }
+        return option_handler_registry_.handle_subnegotiation(opt, payload);
+    } //dispatch_subnegotiation(const option&, std::span<const byte_t>)
+
+    /**
+     * @internal
+     * Awaits `handler` while the frame owns `payload`, so the view the handler received outlives it.
+     */
+    template<typename PC>
+    awaitables::subnegotiation_awaitable protocol_fsm<PC>::handle_owned_subnegotiation(
+        std::vector<byte_t> payload,
+        awaitables::subnegotiation_awaitable handler
+    )
+    {
+        co_return co_await std::move(handler);
+    } //handle_owned_subnegotiation(std::vector<byte_t>, awaitables::subnegotiation_awaitable)
+
     /**
      * @internal
      * Processes an `IAC` `SB` `STATUS` `SEND` or `IS` sequence, validating the input buffer for `SEND` (1) or `IS` (0) and logging `telnet::error::invalid_subnegotiation` if invalid.
@@ -753,21 +1163,25 @@ namespace net::telnet {
     //NOLINTBEGIN(readability-function-cognitive-complexity)
     template<typename PC>
     awaitables::subnegotiation_awaitable
-        protocol_fsm<PC>::handle_status_subnegotiation(const option opt, std::vector<byte_t> buffer)
+        protocol_fsm<PC>::handle_status_subnegotiation(const option opt, std::span<const byte_t> buffer)
     {
         constexpr auto subcommand_is   = static_cast<byte_t>(0);
         constexpr auto subcommand_send = static_cast<byte_t>(1);
 
         if (buffer.empty()) {
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 error::invalid_subnegotiation, "Invalid STATUS subnegotiation: no data between IAC SB STATUS and IAC SE"
             );
         } else if (buffer[0] == subcommand_is) {
             if (option_status_[option::id_num::status].remote_enabled()) {
                 //Delegate processing of subcommand IS to user-provided handler.
-                co_return co_await option_handler_registry_.handle_subnegotiation(opt, std::move(buffer));
+                auto handler = option_handler_registry_.handle_subnegotiation(opt, buffer);
+                if (!handler.valid()) {
+                    co_return std::make_tuple(opt, std::vector<byte_t>{});
+                }
+                co_return co_await std::move(handler);
             } else {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     error::option_not_available, "STATUS subnegotiation IS received, but STATUS option is not remotely enabled."
                 );
                 co_return std::make_tuple(opt, std::vector<byte_t>{});
@@ -798,21 +1212,21 @@ namespace net::telnet {
                 }
                 co_return std::make_tuple(opt, std::move(payload));
             } else {
-                protocol_config_type::log_error(
+                log_traits<protocol_config_type>::template log<log_level::error>(
                     error::option_not_available,
                     "STATUS subnegotiation SEND received, but STATUS option is not locally enabled."
                 );
                 co_return std::make_tuple(opt, std::vector<byte_t>{});
             }
         } else {
-            protocol_config_type::log_error(
+            log_traits<protocol_config_type>::template log<log_level::error>(
                 error::invalid_subnegotiation,
                 "Invalid STATUS subnegotiation: expected IS (0) or SEND (1); received {}",
                 buffer[0]
             );
             co_return std::make_tuple(opt, std::vector<byte_t>{});
         }
-    } //handle_status_subnegotiation(const option&, std::vector<byte_t>)
+    } //handle_status_subnegotiation(const option&, std::span<const byte_t>)
 
     //NOLINTEND(readability-function-cognitive-complexity)
 } //namespace net::telnet
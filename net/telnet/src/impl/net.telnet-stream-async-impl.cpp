@@ -20,7 +20,7 @@
  * limitations under the License. @endparblock
  *
  * @brief Implementation of asynchronous Telnet stream operations.
- * @remark Contains implementations for `async_read_some`, `async_write_some`, `async_write_raw`, `async_write_command`, `async_write_negotiation`, `async_write_subnegotiation`, `async_write_temp_buffer`, `async_report_error`, `async_request_option`, `async_disable_option`, and `async_send_synch`.
+ * @remark Contains implementations for `async_read_some`, `async_read_line`, `async_read_record`, `async_write_some`, `async_write_gather`, `async_write_raw`, `async_write_broadcast`, `async_write_command`, `async_write_negotiation`, `async_write_subnegotiation`, `async_write_temp_buffer`, `async_report_error`, `async_request_option`, `async_disable_option`, `async_send_synch`, `async_start_compression`, `async_stop_compression`, `async_start_tls`, and `async_stop_tls`.
  *
  * @see "net.telnet-stream.cppm" for interface, RFC 854 for Telnet protocol, RFC 855 for option negotiation, `:types` for `telnet::command`, `:options` for `option` and `option::id_num`, `:errors` for error codes, `:protocol_fsm` for `ProtocolFSM`
  */
@@ -31,7 +31,7 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module implementation unit
 module net.telnet;
 
-import std; //NOLINT For std::array, std::vector, std::ignore
+import std; //NOLINT For std::vector, std::get, std::distance, std::same_as
 
 import :types;        ///< @see "net.telnet-types.cppm" for `telnet::command`
 import :errors;       ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
@@ -39,6 +39,8 @@ import :concepts;     ///< @see "net.telnet-concepts.cppm" for `telnet::concepts
 import :options;      ///< @see "net.telnet-options.cppm" for `option` and `option::id_num`
 import :protocol_fsm; ///< @see "net.telnet-protocol_fsm.cppm" for `ProtocolFSM`
 import :awaitables;   ///< @see "net.telnet-awaitables.cppm" for awaitable types
+import :broadcast;    ///< @see "net.telnet-broadcast.cppm" for `broadcast_message`
+import :tls;          ///< @see "net.telnet-tls.cppm" for `tls_session`
 
 import :stream; ///< @see "net.telnet-stream.cppm" for the partition being implemented.
 
@@ -72,6 +74,7 @@ namespace net::telnet {
      * @remark Uses `asio::co_spawn` to manage coroutine lifetime, executing on the stream’s executor.
      * @remark If a response is present, writes IAC WONT/DONT via `async_write_negotiation` and accumulates bytes transferred.
      * @remark If an awaitable is present, co_awaits it to handle registered disablement callbacks.
+     * @remark Without a registered disablement handler the FSM returns no awaitable, so the response is written via `async_write_negotiation` with no coroutine.
      * @remark Catches non-system errors and converts to `telnet::error::internal_error` for consistency.
      * @remark Returns 0 bytes on error via `async_report_error` if neither response nor awaitable is provided.
      */
@@ -82,6 +85,8 @@ namespace net::telnet {
         auto [ec, response, awaitable] = fsm_.disable_option(opt, direction);
         if (ec || (!response && !awaitable)) {
             return async_report_error(ec, std::forward<CompletionToken>(token));
+        } else if (!awaitable) {
+            return async_write_negotiation(*response, std::forward<CompletionToken>(token));
         } else {
             return asio::co_spawn(
                 this->get_executor(),
@@ -127,7 +132,37 @@ namespace net::telnet {
 
     /**
      * @internal
-     * Escapes input data using `escape_telnet_output` and delegates to `async_write_temp_buffer`.
+     * Composes a `frame_reader<processing_signal::end_of_line>` over `lines` on the stream's executor.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ReadToken CompletionToken>
+    auto stream<NLS, PC>::async_read_line(frame_batch& lines, CompletionToken&& token)
+    {
+        return asio::async_compose<CompletionToken, typename stream<NLS, PC>::asio_completion_signature>(
+            frame_reader<processing_signal::end_of_line>(*this, lines),
+            std::forward<CompletionToken>(token),
+            this->get_executor()
+        );
+    } //stream::async_read_line(frame_batch&, CompletionToken&&)
+
+    /**
+     * @internal
+     * Composes a `frame_reader<processing_signal::end_of_record>` over `records` on the stream's executor.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ReadToken CompletionToken>
+    auto stream<NLS, PC>::async_read_record(frame_batch& records, CompletionToken&& token)
+    {
+        return asio::async_compose<CompletionToken, typename stream<NLS, PC>::asio_completion_signature>(
+            frame_reader<processing_signal::end_of_record>(*this, records),
+            std::forward<CompletionToken>(token),
+            this->get_executor()
+        );
+    } //stream::async_read_record(frame_batch&, CompletionToken&&)
+
+    /**
+     * @internal
+     * Escapes input data using `escape_telnet_output` and delegates to `async_write_temp_buffer` as droppable application data.
      * @remark Returns via `async_report_error` if `escape_telnet_output` fails.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
@@ -138,49 +173,109 @@ namespace net::telnet {
         if (ec) {
             return async_report_error(ec, std::forward<CompletionToken>(token));
         }
-        return async_write_temp_buffer(std::move(escaped_data), std::forward<CompletionToken>(token));
+        return async_write_temp_buffer</*Droppable=*/true>(std::move(escaped_data), std::forward<CompletionToken>(token));
     } //stream::async_write_some(const CBufSeq&, CompletionToken&&)
 
     /**
      * @internal
-     * Uses `asio::async_write` to write the raw buffer directly to `next_layer_`.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * Builds a pooled slice list with `escape_telnet_output` and delegates to `async_write_temp_buffer` as droppable application data.
+     * @remark Falls back to `async_write_some` when the slice list exceeds `max_gather_slices`, returning the list to the pool first.
+     * @remark Returns via `async_report_error` if building the slice list fails.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq, WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_write_gather(const CBufSeq& data, CompletionToken&& token)
+    {
+        std::vector<asio::const_buffer> slices;
+        try {
+            slices = context_.gather_slices.acquire(max_gather_slices);
+        } catch (const std::bad_alloc&) {
+            return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
+        }
+        if (auto ec = std::get<0>(escape_telnet_output(slices, data)); ec) {
+            context_.gather_slices.release(std::move(slices));
+            return async_report_error(ec, std::forward<CompletionToken>(token));
+        }
+        if (slices.size() > max_gather_slices) {
+            //Dense escapes: a contiguous copy beats a long gather list.
+            context_.gather_slices.release(std::move(slices));
+            return async_write_some(data, std::forward<CompletionToken>(token));
+        }
+        return async_write_temp_buffer</*Droppable=*/true>(std::move(slices), std::forward<CompletionToken>(token));
+    } //stream::async_write_gather(const CBufSeq&, CompletionToken&&)
+
+    /**
+     * @internal
+     * Copies the buffer descriptors of `data` (not its bytes) into a pooled slice list and delegates to `async_write_temp_buffer`.
+     * @remark Returns `std::errc::not_enough_memory` via `async_report_error` if building the slice list fails.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<ConstBufferSequence CBufSeq, WriteToken CompletionToken>
     auto stream<NLS, PC>::async_write_raw(const CBufSeq& data, CompletionToken&& token)
     {
-        return asio::async_write(
-            this->next_layer_, data, asio::bind_executor(this->get_executor(), std::forward<CompletionToken>(token))
-        );
+        std::vector<asio::const_buffer> slices;
+        try {
+            slices = context_.gather_slices.acquire(
+                static_cast<std::size_t>(std::distance(asio::buffer_sequence_begin(data), asio::buffer_sequence_end(data)))
+            );
+            for (auto buf_it = asio::buffer_sequence_begin(data), buf_end = asio::buffer_sequence_end(data); buf_it != buf_end;
+                 ++buf_it) {
+                slices.emplace_back(*buf_it);
+            }
+        } catch (const std::bad_alloc&) {
+            return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
+        }
+        return async_write_temp_buffer(std::move(slices), std::forward<CompletionToken>(token));
     } //stream::async_write_raw(const CBufSeq&, CompletionToken&&)
 
     /**
      * @internal
-     * Constructs a 2-byte `std::array` with `{IAC, cmd}` and writes it using `asio::async_write`.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * Gets the shared encoding with `broadcast_encoding` and uses `asio::async_initiate` to hand it to `output_processor_.enqueue_shared`.
+     * @remark Returns any escaping error via `async_report_error`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<WriteToken CompletionToken>
-    auto stream<NLS, PC>::async_write_command(telnet::command cmd, CompletionToken&& token)
+    auto stream<NLS, PC>::async_write_broadcast(const broadcast_message& message, CompletionToken&& token)
     {
-        static std::array<byte_t, 2> buf{std::to_underlying(telnet::command::iac), std::to_underlying(cmd)};
-
-        return asio::async_write(
-            this->next_layer_,
-            asio::buffer(buf),
-            asio::bind_executor(this->get_executor(), std::forward<CompletionToken>(token))
+        auto [ec, escaped] = broadcast_encoding(message);
+        if (ec) {
+            return async_report_error(ec, std::forward<CompletionToken>(token));
+        }
+        return asio::async_initiate<CompletionToken, typename stream<NLS, PC>::asio_completion_signature>(
+            [this](auto handler, std::shared_ptr<const std::vector<byte_t>> bytes) {
+                this->output_processor_.enqueue_shared(
+                    std::move(bytes), output_processor::make_handler(std::move(handler))
+                );
+            },
+            std::forward<CompletionToken>(token),
+            std::move(escaped)
         );
+    } //stream::async_write_broadcast(const broadcast_message&, CompletionToken&&)
+
+    /**
+     * @internal
+     * Fills a pooled buffer with `{IAC, cmd}` and delegates to `async_write_temp_buffer`.
+     * @remark Returns `std::errc::not_enough_memory` via `async_report_error` if the buffer cannot be acquired.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_write_command(telnet::command cmd, CompletionToken&& token)
+    {
+        std::vector<byte_t> buf;
+        try {
+            buf = context_.escape_buffers.acquire(2);
+            buf.push_back(std::to_underlying(telnet::command::iac));
+            buf.push_back(std::to_underlying(cmd));
+        } catch (const std::bad_alloc&) {
+            return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
+        }
+        return async_write_temp_buffer(std::move(buf), std::forward<CompletionToken>(token));
     } //stream::async_write_command(telnet::command, CompletionToken&&)
 
     /**
      * @internal
-     * Validates `opt` using `opt.supports_subnegotiation()` and `fsm_.is_enabled(opt)`.
-     * @remark Reserves space in `escaped_buffer` for subnegotiation data plus 5 bytes (IAC SB, opt, IAC SE).
-     * @remark Appends IAC SB, `opt`, escaped subnegotiation data via `escape_telnet_output`, and IAC SE.
-     * @remark Returns `telnet::error::invalid_subnegotiation` or `telnet::error::option_not_available` via `async_report_error` if validation fails.
-     * @remark Catches `std::bad_alloc` to return `std::errc::not_enough_memory` and other exceptions to return `telnet::error::internal_error` via `async_report_error`.
-     * @remark Delegates to `async_write_temp_buffer` for writing the constructed buffer.
+     * Frames and escapes the subnegotiation with `frame_subnegotiation` and delegates to `async_write_temp_buffer`.
+     * @remark Returns any validation or allocation error from `frame_subnegotiation` via `async_report_error`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<WriteToken CompletionToken>
@@ -190,168 +285,184 @@ namespace net::telnet {
         CompletionToken&& token
     )
     {
-        if (!opt.supports_subnegotiation()) {
-            return async_report_error(make_error_code(error::invalid_subnegotiation), std::forward<CompletionToken>(token));
+        auto [ec, framed_buffer] = frame_subnegotiation(opt, subnegotiation_buffer);
+        if (ec) {
+            return async_report_error(ec, std::forward<CompletionToken>(token));
+        }
+        return async_write_temp_buffer(std::move(framed_buffer), std::forward<CompletionToken>(token));
+    } //stream::async_write_subnegotiation(option, const std::vector<byte_t>&, CompletionToken&&)
+
+    /**
+     * @internal
+     * Initiates via `asio::async_initiate`, handing the type-erased handler to `output_processor_.enqueue_synch`.
+     * @remark Sends NUL NUL (the second urgent) with `message_out_of_band`, then NUL IAC DM in-band, so correct Synch behavior holds regardless of URG pointer semantics.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_send_synch(CompletionToken&& token)
+    {
+        return asio::async_initiate<CompletionToken, asio_completion_signature>(
+            [this](auto handler) { output_processor_.enqueue_synch(output_processor::make_handler(std::move(handler))); },
+            std::forward<CompletionToken>(token)
+        );
+    } //stream::async_send_synch(CompletionToken&&)
+
+    /**
+     * @internal
+     * Selects the option with `outbound_compression_option`, fills a pooled buffer with `compression_start_sequence`, and hands it to `output_processor_.enqueue_start_compression`.
+     * @remark Reports success with 0 bytes via `async_report_error` if output is already compressed, or `telnet::error::option_not_available` if no option applies.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_start_compression(CompletionToken&& token)
+    {
+        if (context_.deflater.active()) {
+            return async_report_error(std::error_code(), std::forward<CompletionToken>(token));
         }
-        if (!fsm_.is_enabled(opt)) {
+        const auto opt = outbound_compression_option();
+        if (!opt) {
             return async_report_error(make_error_code(error::option_not_available), std::forward<CompletionToken>(token));
         }
 
-        std::vector<byte_t> escaped_buffer;
+        std::vector<byte_t> buf;
         try {
-            //Reserve space for the original size plus 10% for escaping and 5 bytes for framing (IAC SB, opt, IAC SE)
-            constexpr double escaping_cushion_factor = 1.1;
-            using size_type                          = decltype(subnegotiation_buffer.size());
-            constexpr size_type framing_padding      = 5;
-            escaped_buffer.reserve(
-                static_cast<size_type>(static_cast<double>(subnegotiation_buffer.size()) * escaping_cushion_factor)
-                + framing_padding
-            );
-
-            //Append initial framing: IAC SB opt
-            escaped_buffer.push_back(std::to_underlying(telnet::command::iac));
-            escaped_buffer.push_back(std::to_underlying(telnet::command::sb));
-            escaped_buffer.push_back(std::to_underlying(opt.get_id()));
-
-            //Escape the subnegotiation data
-            std::error_code ec;
-            std::ignore = escape_telnet_output(escaped_buffer, subnegotiation_buffer);
-            if (ec) {
-                return async_report_error(ec, std::forward<CompletionToken>(token));
-            }
-
-            //Append final framing: IAC SE
-            escaped_buffer.push_back(std::to_underlying(telnet::command::iac));
-            escaped_buffer.push_back(std::to_underlying(telnet::command::se));
+            const auto start_sequence = compression_start_sequence(*opt);
+            buf = context_.escape_buffers.acquire(start_sequence.size());
+            buf.assign(start_sequence.begin(), start_sequence.end());
         } catch (const std::bad_alloc&) {
             return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
-        } catch (...) {
-            return async_report_error(make_error_code(error::internal_error), std::forward<CompletionToken>(token));
         }
-
-        return async_write_temp_buffer(std::move(escaped_buffer), std::forward<CompletionToken>(token));
-    } //stream::async_write_subnegotiation(option, const std::vector<byte_t>&, CompletionToken&&)
+        return asio::async_initiate<CompletionToken, asio_completion_signature>(
+            [this](auto handler, std::vector<byte_t> start_sequence) {
+                output_processor_.enqueue_start_compression(
+                    std::move(start_sequence), output_processor::make_handler(std::move(handler))
+                );
+            },
+            std::forward<CompletionToken>(token),
+            std::move(buf)
+        );
+    } //stream::async_start_compression(CompletionToken&&)
 
     /**
      * @internal
-     * Send 3 NULs, middle urgent, then IAC DM.
-     * Ensures correct Synch behavior regardless of URG pointer semantics.
+     * Initiates via `asio::async_initiate`, handing the type-erased handler to `output_processor_.enqueue_stop_compression`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<WriteToken CompletionToken>
-    auto stream<NLS, PC>::async_send_synch(CompletionToken&& token)
+    auto stream<NLS, PC>::async_stop_compression(CompletionToken&& token)
     {
         return asio::async_initiate<CompletionToken, asio_completion_signature>(
             [this](auto handler) {
-                std::size_t bytes_transferred = 0;
-                this->async_send_nul( //Send 1
-                    false,
-                    [this, bytes_transferred, handler = std::move(handler)](std::error_code ec,
-                                                                            std::size_t bytes) mutable {
-                        bytes_transferred += bytes;
-                        if (ec) {
-                            asio::dispatch(std::move(handler), ec, bytes_transferred);
-                            return;
-                        }
-                        this->async_send_nul( //Send 2
-                            true,             //Urgent/OOB
-                            [this, bytes_transferred, handler = std::move(handler)](std::error_code ec,
-                                                                                    std::size_t bytes) mutable {
-                                bytes_transferred += bytes;
-                                if (ec) {
-                                    asio::dispatch(std::move(handler), ec, bytes_transferred);
-                                    return;
-                                }
-                                this->async_send_nul( //Send 3
-                                    false,
-                                    [this, bytes_transferred, handler = std::move(handler)](std::error_code ec,
-                                                                                            std::size_t bytes) mutable {
-                                        bytes_transferred += bytes;
-                                        if (ec) {
-                                            asio::dispatch(std::move(handler), ec, bytes_transferred);
-                                            return;
-                                        }
-                                        this->async_write_command( //Final IAC DM
-                                            telnet::command::dm,
-                                            [bytes_transferred,
-                                             handler = std::move(handler)](std::error_code ec,
-                                                                           std::size_t bytes) mutable {
-                                                bytes_transferred += bytes;
-                                                asio::dispatch(std::move(handler), ec, bytes_transferred);
-                                            }); //End of final IAC DM
-                                    });         //End of send 3
-                            });                 //End of send 2
-                    });                         //End of send 1
+                output_processor_.enqueue_stop_compression(output_processor::make_handler(std::move(handler)));
             },
             std::forward<CompletionToken>(token)
-        ); //End of async_initiate
-    } //stream::async_send_synch(CompletionToken&&)
+        );
+    } //stream::async_stop_compression(CompletionToken&&)
 
     /**
      * @internal
-     * Holds a static NUL byte and `async_send`s it (with `message_out_of_band` set if urgent).
+     * Fills a pooled buffer with `start_tls_sequence`, marks our FOLLOWS sent, and hands the buffer to `output_processor_.enqueue_start_tls`.
+     * @remark Reports success with 0 bytes via `async_report_error` if our FOLLOWS was already sent, or the error from `check_tls_start`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<WriteToken CompletionToken>
-    auto stream<NLS, PC>::async_send_nul(bool urgent, CompletionToken&& token)
+    auto stream<NLS, PC>::async_start_tls(CompletionToken&& token)
     {
-        constexpr static auto nul = static_cast<byte_t>('\0');
+        if (context_.tls_follows_sent) {
+            return async_report_error(std::error_code(), std::forward<CompletionToken>(token));
+        }
+        if (auto ec = check_tls_start(); ec) {
+            return async_report_error(ec, std::forward<CompletionToken>(token));
+        }
 
-        if (urgent) {
-            return this->lowest_layer().async_send(
-                asio::buffer(&nul, 1), lowest_layer_type::message_out_of_band, std::forward<CompletionToken>(token)
-            );
-        } else {
-            return this->lowest_layer().async_send(asio::buffer(&nul, 1), std::forward<CompletionToken>(token));
+        std::vector<byte_t> buf;
+        try {
+            const auto follows_sequence = start_tls_sequence();
+            buf = context_.escape_buffers.acquire(follows_sequence.size());
+            buf.assign(follows_sequence.begin(), follows_sequence.end());
+        } catch (const std::bad_alloc&) {
+            return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
+        }
+        context_.tls_follows_sent = true;
+        return asio::async_initiate<CompletionToken, asio_completion_signature>(
+            [this](auto handler, std::vector<byte_t> follows_sequence) {
+                output_processor_.enqueue_start_tls(
+                    std::move(follows_sequence), output_processor::make_handler(std::move(handler))
+                );
+            },
+            std::forward<CompletionToken>(token),
+            std::move(buf)
+        );
+    } //stream::async_start_tls(CompletionToken&&)
+
+    /**
+     * @internal
+     * Hands the completion handler to `output_processor_.enqueue_stop_tls`, so the close_notify follows every queued write.
+     * @remark Reports success with 0 bytes via `async_report_error` if our FOLLOWS was never sent, as there is no session to close.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_stop_tls(CompletionToken&& token)
+    {
+        if (!context_.tls_follows_sent) {
+            return async_report_error(std::error_code(), std::forward<CompletionToken>(token));
         }
-    } //stream::async_send_nul(bool, CompletionToken&&)
+        return asio::async_initiate<CompletionToken, asio_completion_signature>(
+            [this](auto handler) {
+                output_processor_.enqueue_stop_tls(output_processor::make_handler(std::move(handler)));
+            },
+            std::forward<CompletionToken>(token)
+        );
+    } //stream::async_stop_tls(CompletionToken&&)
 
     /**
      * @internal
-     * @remark Constructs a 3-byte `std::array` with `{IAC, cmd, opt}` and writes it using `asio::async_write` if valid.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * @remark Fills a pooled buffer with `{IAC, cmd, opt}` and delegates to `async_write_temp_buffer`.
+     * @remark Returns `std::errc::not_enough_memory` via `async_report_error` if the buffer cannot be acquired.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<WriteToken CompletionToken>
     auto stream<NLS, PC>::async_write_negotiation(typename fsm_type::negotiation_response response, CompletionToken&& token)
     {
         auto [dir, enable, opt] = response;
-        static std::array<byte_t, 3>
-            buf{std::to_underlying(telnet::command::iac),
-                std::to_underlying(fsm_type::make_negotiation_command(dir, enable)),
-                std::to_underlying(opt)};
-        return asio::async_write(
-            this->next_layer_,
-            asio::buffer(buf),
-            asio::bind_executor(this->get_executor(), std::forward<CompletionToken>(token))
-        );
+        std::vector<byte_t> buf;
+        try {
+            buf = context_.escape_buffers.acquire(3);
+            buf.push_back(std::to_underlying(telnet::command::iac));
+            buf.push_back(std::to_underlying(fsm_type::make_negotiation_command(dir, enable)));
+            buf.push_back(std::to_underlying(opt));
+        } catch (const std::bad_alloc&) {
+            return async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<CompletionToken>(token));
+        }
+        return async_write_temp_buffer(std::move(buf), std::forward<CompletionToken>(token));
     } //stream::async_write_negotiation(fsm_type::negotiation_response, CompletionToken&&)
 
     /**
      * @internal
-     * Uses `asio::async_initiate` to write `temp_buffer` via `asio::async_write` to `next_layer_`.
-     * @remark Moves `temp_buffer` into a lambda to manage its lifetime.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
-     * @remark Forwards the handler to receive `ec` and `bytes_written`.
+     * Uses `asio::async_initiate` to hand `temp_buffer` and the completion handler to `output_processor_`.
+     * @remark Type-erases the handler with `output_processor::make_handler`, which preserves its associated executor and recycles the erased storage.
+     * @remark The write itself (and the return of `temp_buffer` to its pool) happens when `output_processor_` flushes the batch containing it.
+     * @remark Passes `Droppable` to `output_processor::enqueue`, which marks the write for `discard_output` and `slow_consumer_policy::drop_oldest`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<WriteToken CompletionToken>
-    auto stream<NLS, PC>::async_write_temp_buffer(std::vector<byte_t>&& temp_buffer, CompletionToken&& token)
+    template<bool Droppable, typename T, WriteToken CompletionToken>
+    auto stream<NLS, PC>::async_write_temp_buffer(std::vector<T>&& temp_buffer, CompletionToken&& token)
     {
+        static_assert(
+            std::same_as<T, byte_t> || std::same_as<T, asio::const_buffer>,
+            "async_write_temp_buffer writes pooled byte buffers or pooled slice lists"
+        );
+
         return asio::async_initiate<CompletionToken, typename stream<NLS, PC>::asio_completion_signature>(
-            [this, temp_buffer = std::move(temp_buffer)](auto handler) mutable {
-                asio::async_write(
-                    this->next_layer_,
-                    asio::buffer(temp_buffer),
-                    asio::bind_executor(
-                        this->get_executor(),
-                        [handler](const std::error_code& ec, std::size_t bytes_written) mutable { handler(ec, bytes_written); }
-                    )
+            [this](auto handler, std::vector<T> buffer) {
+                this->output_processor_.enqueue(
+                    std::move(buffer), output_processor::make_handler(std::move(handler)), Droppable
                 );
             },
-            std::forward<CompletionToken>(token)
+            std::forward<CompletionToken>(token),
+            std::move(temp_buffer)
         );
-    } //stream::async_write_temp_buffer(std::vector<byte_t>&&, CompletionToken&&)
+    } //stream::async_write_temp_buffer(std::vector<T>&&, CompletionToken&&)
 
     /**
      * @internal
@@ -19,8 +19,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License. @endparblock
  *
- * @brief Implementation of Telnet stream constructor, `input_processor`, and utility functions.
- * @remark Contains implementations for `stream` constructor, `input_processor`, `sync_await`, and `escape_telnet_output` overloads.
+ * @brief Implementation of Telnet stream constructor, `input_processor`, `output_processor`, and utility functions.
+ * @remark Contains implementations for `stream` constructor, `input_processor`, `frame_reader`, `output_processor`, `sync_await`, `write_blocking`, `check_queued_wait`, `write_next_layer`, `write_wire_blocking`, `seal_output`, `outbound_compression_option`, `check_tls_start`, `check_snapshot`, `start_input_decompression`, `inflate_input`, `start_tls_session`, `start_input_decryption`, `start_output_encryption`, `decrypt_input`, `unwrap_input`, `write_tls_records`, `handshake_blocking`, `frame_subnegotiation`, `broadcast_encoding`, `escape_output`, and `escape_telnet_output` overloads.
  *
  * @see "net.telnet-stream.cppm" for interface, RFC 854 for Telnet protocol, RFC 855 for option negotiation, `:types` for `telnet::command`, `:options` for `option::id_num`, `:errors` for error codes, `:protocol_fsm` for `ProtocolFSM`
  */
@@ -31,7 +31,7 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module implementation unit
 module net.telnet;
 
-import std; //NOLINT For std::promise, std::future, std::jthread, std::exception_ptr, std::make_tuple
+import std; //NOLINT For std::promise, std::future, std::exception_ptr, std::make_tuple, std::span, std::copy_n, std::min, std::exchange
 
 import :types;        ///< @see "net.telnet-types.cppm" for `byte_t` and `telnet::command`
 import :errors;       ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
@@ -39,6 +39,11 @@ import :concepts;     ///< @see "net.telnet-concepts.cppm" for `telnet::concepts
 import :options;      ///< @see "net.telnet-options.cppm" for `option` and `option::id_num`
 import :protocol_fsm; ///< @see "net.telnet-protocol_fsm.cppm" for `ProtocolFSM`
 import :awaitables;   ///< @see "net.telnet-awaitables.cppm" for awaitable types
+import :byte_scan;    ///< @see "net.telnet-byte_scan.cppm" for `byte_scan::find_first_of`
+import :compression;  ///< @see "net.telnet-compression.cppm" for `deflate_stream` and `inflate_stream`
+import :statistics;   ///< @see "net.telnet-statistics.cppm" for `statistic`
+import :broadcast;    ///< @see "net.telnet-broadcast.cppm" for `broadcast_message`
+import :tls;          ///< @see "net.telnet-tls.cppm" for `tls_session`
 
 import :stream; ///< @see "net.telnet-stream.cppm" for the partition being implemented.
 
@@ -47,22 +52,26 @@ import :stream; ///< @see "net.telnet-stream.cppm" for the partition being imple
 namespace net::telnet {
     /**
      * @internal
-     * Moves the provided `next_layer_stream` into `next_layer_`, default-constructs `fsm_`, and enables SO_OOBINLINE.
+     * Moves the provided `next_layer_stream` into `next_layer_`, default-constructs `fsm_`, binds `output_processor_`, points `fsm_` at `statistics_`, and enables SO_OOBINLINE.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    stream<NLS, PC>::stream(next_layer_type&& next_layer_stream) : next_layer_(std::move(next_layer_stream)), fsm_()
+    stream<NLS, PC>::stream(next_layer_type&& next_layer_stream)
+        : next_layer_(std::move(next_layer_stream)), fsm_(), output_processor_(*this)
     {
+        fsm_.set_statistics(&statistics_);
         std::error_code ec;
         next_layer_.lowest_layer().set_option(lowest_layer_type::out_of_band_inline(true), ec);
         if (ec) {
-            PC::log_error(ec, "Failed to enable out_of_band_inline on socket: {}", ec.message());
+            log_traits<PC>::template log<log_level::error>(
+                ec, "Failed to enable out_of_band_inline on socket: {}", ec.message()
+            );
         }
     } //stream::stream(next_layer_type&&)
 
     /**
      * @internal
-     * Uses a temporary `asio::io_context` and `std::jthread` to run the awaitable via `asio::co_spawn`.
-     * @remark Captures the result or exception using `std::promise` and `std::future`.
+     * Runs the awaitable via `asio::co_spawn` on a temporary `asio::io_context` driven by the calling thread.
+     * @remark Captures the result or exception using `std::promise` and `std::future`; the future is ready once `run` returns.
      * @remark Deduces `result_type` with `asio::awaitable_traits` to handle `void` and non-`void` return types.
      * @remark Uses a lambda to set the promise’s value or exception, handling multiple return values via `std::make_tuple`.
      */
@@ -89,563 +98,2602 @@ namespace net::telnet {
             } //lambda
         ); //co_spawn
 
-        std::jthread runner_thread([&temp_ctx] { temp_ctx.run(); });
+        temp_ctx.run();
         return future.get();
     } //stream::sync_await(Awaitable&&)
 
     /**
      * @internal
-     * Iterates over `data` using `asio::buffers_begin` and `asio::buffers_end`.
-     * @remark Appends each byte to `escaped_data`, duplicating 0xFF (IAC) bytes plus transforming LF to CR LF and CR to CR NUL when not transmitting in BINARY mode.
-     * @remark Catches `std::bad_alloc` to clear `escaped_data` and return `std::errc::not_enough_memory`.
-     * @remark Catches other exceptions to clear `escaped_data` and return `telnet::error::internal_error`.
+     * Calls `write_next_layer` when `output_processor_` is idle.
+     * @remark Otherwise queues `data` via `async_write_raw` and waits with `sync_await`, so the bytes cannot overtake (or interleave with) writes already queued or in flight; `check_queued_wait` refuses that wait on the stream's own executor thread.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<ConstBufferSequence CBufSeq>
-    std::tuple<std::error_code, std::vector<byte_t>&>
-        stream<NLS, PC>::escape_telnet_output(std::vector<byte_t>& escaped_data, const CBufSeq& data) const noexcept
+    std::size_t stream<NLS, PC>::write_blocking(const CBufSeq& data, std::error_code& ec) noexcept
     {
         try {
-            for (auto iter = asio::buffers_begin(data), end = asio::buffers_end(data); iter != end; ++iter) {
-                if ((*iter == static_cast<byte_t>('\n'))
-                    && !fsm_.enabled(option::id_num::binary, negotiation_direction::local)) {
-                    escaped_data.push_back('\r'); //prepend CR before LF (LF -> CR LF)
-                }
-                escaped_data.push_back(*iter);
-                if (*iter == std::to_underlying(telnet::command::iac)) {
-                    escaped_data.push_back(*iter); //double IAC (IAC -> IAC IAC)
-                } else if ((*iter == static_cast<byte_t>('\r'))
-                           && !fsm_.enabled(option::id_num::binary, negotiation_direction::local)) {
-                    escaped_data.push_back('\0'); //append NUL after CR (CR -> CR NUL)
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return 0;
                 }
+                return sync_await(async_write_raw(data, asio::use_awaitable));
             }
-            return {std::error_code(), escaped_data};
+            return write_next_layer(data, ec);
+        } catch (const std::system_error& se) {
+            ec = se.code();
+            return 0;
         } catch (const std::bad_alloc&) {
-            escaped_data.clear();
-            return {make_error_code(std::errc::not_enough_memory), escaped_data};
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
         } catch (...) {
-            escaped_data.clear();
-            return {make_error_code(error::internal_error), escaped_data};
+            ec = make_error_code(error::internal_error);
+            return 0;
         }
-    } //stream::escape_telnet_output(std::vector<byte_t>&, const CBufSeq&) const noexcept
+    } //stream::write_blocking(const CBufSeq&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Creates a new `std::vector<byte_t>` with 10% extra capacity based on `asio::buffer_size(data)`.
-     * @remark Delegates to the overload with a provided vector.
-     * @remark Catches `std::bad_alloc` to return `std::errc::not_enough_memory` with an empty vector.
-     * @remark Catches other exceptions to return `telnet::error::internal_error` with an empty vector.
+     * Calls `write_wire_blocking` directly unless `context_.deflater` is active.
+     * @remark Otherwise compresses each buffer of `data` into one pooled vector, sync-flushes, writes it, and returns the vector to `context_.escape_buffers`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<ConstBufferSequence CBufSeq>
-    std::tuple<std::error_code, std::vector<byte_t>> stream<NLS, PC>::escape_telnet_output(const CBufSeq& data) const noexcept
+    std::size_t stream<NLS, PC>::write_next_layer(const CBufSeq& data, std::error_code& ec)
     {
-        std::vector<byte_t> escaped_data;
-        try {
-            constexpr double escaping_cushion_factor = 1.1;
-            escaped_data.reserve(asio::buffer_size(data) * escaping_cushion_factor);
-            return this->escape_telnet_output(escaped_data, data);
-        } catch (const std::bad_alloc&) {
-            return {make_error_code(std::errc::not_enough_memory), std::vector<byte_t>()};
-        } catch (...) {
-            return {make_error_code(error::internal_error), std::vector<byte_t>()};
+        if (!context_.deflater.active()) {
+            return write_wire_blocking(data, ec);
+        }
+
+        std::vector<byte_t> compressed = context_.escape_buffers.acquire(asio::buffer_size(data));
+        ec.clear();
+        for (auto it = asio::buffer_sequence_begin(data); !ec && (it != asio::buffer_sequence_end(data)); ++it) {
+            const asio::const_buffer buffer(*it);
+            ec = context_.deflater.compress({static_cast<const byte_t*>(buffer.data()), buffer.size()}, compressed);
+        }
+        if (!ec) {
+            ec = context_.deflater.flush(compressed);
         }
-    } //stream::escape_telnet_output(const CBufSeq&) const noexcept
+        if (!ec) {
+            write_wire_blocking(asio::buffer(compressed), ec);
+        }
+        context_.escape_buffers.release(std::move(compressed));
+        return ec ? 0 : asio::buffer_size(data);
+    } //stream::write_next_layer(const CBufSeq&, std::error_code&)
 
     /**
      * @internal
-     * Launches an asynchronous wait (via 0-byte async_receive) for notification of urgent (i.e. "out-of-band") data.
-     * @remark Only launches the async_receive if another one is not already in progress and there is not already urgent data in the byte stream.
+     * Calls `asio::write` directly unless TLS output is active.
+     * @remark Counts the bytes actually written to `next_layer_` (records or not) as `statistic::bytes_sent`.
+     * @remark Otherwise completes a pending handshake, seals `data` into one pooled vector via `seal_output`, writes it, and returns the vector to `context_.escape_buffers`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    void stream<NLS, PC>::launch_wait_for_urgent_data()
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_wire_blocking(const CBufSeq& data, std::error_code& ec)
     {
-        if (!context_.waiting_for_urgent_data.exchange(true, std::memory_order_relaxed) && !context_.urgent_data_state) {
-            this->lowest_layer().async_receive(
-                asio::mutable_buffer(nullptr, 0),
-                asio::socket_base::message_out_of_band,
-                asio::bind_executor(
-                    this->get_executor(), [this](std::error_code ec, std::size_t) {
-                        this->context_.waiting_for_urgent_data.store(false, std::memory_order_relaxed);
-                        if (!ec) {
-                            this->context_.urgent_data_state.saw_urgent();
-                        } else {
-                            fsm_type::protocol_config_type::log_error(ec, "OOB wait failed: {}", ec.message());
-                            if (!this->context_.deferred_transport_error) {
-                                this->context_.deferred_transport_error = ec;
-                            } //If there is already a transport error deferred, ignore this one as it’s likely redundant.
-                        }
-                    } //[this](std::error_code, std::size_t)
-                )
-            );
+        if (!context_.tls_output_active) {
+            const std::size_t bytes = asio::write(next_layer_, data, ec);
+            statistics_.add(statistic::bytes_sent, bytes);
+            return bytes;
         }
-    } //stream::launch_urgent_wait()
+
+        if (!context_.tls.established()) {
+            if (ec = handshake_blocking(); ec) {
+                return 0;
+            }
+        }
+        std::vector<byte_t> sealed = context_.escape_buffers.acquire(asio::buffer_size(data));
+        ec = seal_output(data, sealed);
+        if (!ec) {
+            statistics_.add(statistic::bytes_sent, asio::write(next_layer_, asio::buffer(sealed), ec));
+        }
+        context_.escape_buffers.release(std::move(sealed));
+        return ec ? 0 : asio::buffer_size(data);
+    } //stream::write_wire_blocking(const CBufSeq&, std::error_code&)
 
     /**
      * @internal
-     * Use `compare_exchange_strong` to update `state_`.
-     * If `state_` was `no_urgent_data`, it becomes `has_urgent_data`.
-     * If `state_` was `unexpected_data_mark`, it resets to `no_urgent_data`.
-     * It can't already be `has_urgent_data` without a major bug.
+     * Copies runs of buffers smaller than `seal_staging_size` into a stack array and encrypts each run with one `tls_session::encrypt`; larger buffers are encrypted from their own storage.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    void stream<NLS, PC>::context_type::urgent_data_tracker::saw_urgent()
+    template<ConstBufferSequence CBufSeq>
+    std::error_code stream<NLS, PC>::seal_output(const CBufSeq& data, std::vector<byte_t>& sealed) noexcept
     {
-        urgent_data_state expected_state{};
-        urgent_data_state desired_state{};
-        bool success = false;
-
-        do {
-            //Load the current state
-            expected_state = state_.load(std::memory_order_relaxed);
+        std::array<byte_t, seal_staging_size> staging; //NOLINT(cppcoreguidelines-pro-type-member-init): Only the staged prefix is ever read.
+        std::size_t staged = 0;
+        const auto seal_staged = [this, &staging, &staged, &sealed]() -> std::error_code {
+            const std::size_t bytes = std::exchange(staged, 0);
+            return (bytes == 0) ? std::error_code{} : context_.tls.encrypt({staging.data(), bytes}, sealed);
+        };
 
-            if (expected_state == urgent_data_state::no_urgent_data) {
-                //The OOB notification arrived first.
-                desired_state = urgent_data_state::has_urgent_data;
-            } else if (expected_state == urgent_data_state::unexpected_data_mark) {
-                //The DM arrived first; this is the delayed notification. Reset.
-                protocol_config_type::log_error(
-                    processing_signal::data_mark,
-                    "DM already arrived before current TCP urgent notification. Assuming Synch is already complete."
-                );
-                desired_state = urgent_data_state::no_urgent_data;
-            } else {
-                //CANT HAPPEN: state is `has_urgent_data`. This means another saw_urgent fired without saw_data_mark in between, or a logic error.
-                //We cannot transition and must exit.
-                protocol_config_type::log_error(
-                    error::internal_error,
-                    "Invalid state in saw_urgent: has_urgent_data already set; implies launch_wait_for_urgent_data was " "called while urgent data was already in the byte stream."
-                );
-                return;
+        std::error_code ec;
+        for (auto it = asio::buffer_sequence_begin(data); !ec && (it != asio::buffer_sequence_end(data)); ++it) {
+            const asio::const_buffer buffer(*it);
+            const std::span<const byte_t> bytes{static_cast<const byte_t*>(buffer.data()), buffer.size()};
+            if (bytes.size() > (staging.size() - staged)) {
+                ec = seal_staged();
+                if (!ec && (bytes.size() >= staging.size())) {
+                    ec = context_.tls.encrypt(bytes, sealed);
+                    continue;
+                }
             }
-
-            //Atomically attempt the transition
-            success = state_.compare_exchange_strong(
-                expected_state,
-                desired_state,
-                std::memory_order_release, //Ensure subsequent reads see the change
-                std::memory_order_relaxed
-            );
-
-        } while (!success);
-    } //stream::context_type::urgent_data_tracker::saw_urgent()
+            if (!ec) {
+                std::ranges::copy(bytes, staging.begin() + staged);
+                staged += bytes.size();
+            }
+        }
+        return ec ? ec : seal_staged();
+    } //stream::seal_output(const CBufSeq&, std::vector<byte_t>&) noexcept
 
     /**
      * @internal
-     * Use `compare_exchange_strong` to update `state_`.
-     * If `state_` was `no_urgent_data`, it becomes `unexpected_data_mark`.
-     * If `state_` was `has_urgent_data`, it resets to `no_urgent_data`.
+     * Prefers `MCCP2`, which a server may have enabled alongside `MCCP3`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    void stream<NLS, PC>::context_type::urgent_data_tracker::saw_data_mark()
+    std::optional<option::id_num> stream<NLS, PC>::outbound_compression_option() const
     {
-        urgent_data_state expected_state{};
-        urgent_data_state desired_state{};
-        bool success = false;
-
-        do {
-            //Load the current state
-            expected_state = state_.load(std::memory_order_relaxed);
-
-            if (expected_state == urgent_data_state::has_urgent_data) {
-                //The DM arrived as expected. Reset.
-                desired_state = urgent_data_state::no_urgent_data;
-            } else if (expected_state == urgent_data_state::no_urgent_data) {
-                //The DM arrived before the OOB notification arrived.
-                desired_state = urgent_data_state::unexpected_data_mark;
-                protocol_config_type::log_error(processing_signal::data_mark, "DM arrived without/before TCP urgent.");
-            } else {
-                //State is `unexpected_data_mark`. This means another `saw_data_mark` fired without `saw_urgent` in between, or a logic error. The peer likely sent 2 data marks in quick succession, but this is safe.
-                //We cannot transition and must exit.
-                protocol_config_type::log_error(
-                    processing_signal::data_mark, "Subsequent DM received while expecting TCP urgent."
-                );
-                return;
-            }
-
-            //Atomically attempt the transition
-            success = state_.compare_exchange_strong(
-                expected_state,
-                desired_state,
-                std::memory_order_release, //Ensure subsequent reads see the change
-                std::memory_order_relaxed
-            );
+        if (fsm_.is_enabled(option::id_num::mccp2, negotiation_direction::local)) {
+            return option::id_num::mccp2;
+        }
+        if (fsm_.is_enabled(option::id_num::mccp3, negotiation_direction::remote)) {
+            return option::id_num::mccp3;
+        }
+        return std::nullopt;
+    } //stream::outbound_compression_option() const
 
-        } while (!success);
-    } //stream::context_type::urgent_data_tracker::saw_data_mark()
+    /**
+     * @internal
+     * Shared by `async_start_tls` and `start_tls`, so both refuse the same states.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::check_tls_start() const noexcept
+    {
+        if (!fsm_.is_enabled(option::id_num::telnet_start_tls)) {
+            return make_error_code(error::option_not_available);
+        }
+        if (!context_.tls_config.valid() || context_.deflater.active() || context_.inflater.active()) {
+            return make_error_code(error::tls_error);
+        }
+        return {};
+    } //stream::check_tls_start() const noexcept
 
     /**
      * @internal
-     * Initializes member variables `parent_stream_`, `fsm_`, `buffers_`, and sets `state_` to `initializing`.
+     * Shared by `snapshot` and `restore`, so both refuse the same states.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    stream<NLS, PC>::input_processor<MBS>::input_processor(
-        stream& parent_stream,
-        stream::fsm_type& fsm,
-        stream::context_type& context,
-        MBS buffers
-    )
-        : parent_stream_(parent_stream), fsm_(fsm), context_(context), buffers_(buffers), state_(state::initializing)
-    {}
+    std::error_code stream<NLS, PC>::check_snapshot() const noexcept
+    {
+        if (context_.deflater.active() || context_.inflater.active() || context_.tls.active() || context_.tls_follows_sent) {
+            return make_error_code(error::snapshot_unavailable);
+        }
+        if (!output_processor_.is_idle() || context_.urgent_data_state.has_urgent_data()) {
+            return make_error_code(error::snapshot_unavailable);
+        }
+        if (context_.deferred_processing_signal || context_.deferred_transport_error) {
+            return make_error_code(error::snapshot_unavailable);
+        }
+        return {};
+    } //stream::check_snapshot() const noexcept
 
     /**
      * @internal
-     * Manages state transitions using a switch statement (`initializing`, `reading`, `processing`, `done`).
-     * Dispatches to "handle_processor_state_*" helpers for each valid state.
-     * @remark Uses `[[unlikely]]` for `done` state and default case, and `[[fallthrough]]` for `reading` to `processing`.
-     * @remark Checks `done` state early to prevent reentrancy.
+     * Asks the executor itself when it can answer, else looks through an `any_io_executor` for the `io_context` executor it usually wraps.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::operator()(Self& self, std::error_code ec_in, std::size_t bytes_transferred)
+    std::error_code stream<NLS, PC>::check_queued_wait() noexcept
     {
-        if (state_ == state::done) [[unlikely]] {
-            return; //complete has already been called; unsafe to do anything else
+        const auto executor     = get_executor();
+        bool on_executor_thread = false;
+        if constexpr (requires { executor.running_in_this_thread(); }) {
+            on_executor_thread = executor.running_in_this_thread();
+        } else if constexpr (requires { executor.template target<asio::io_context::executor_type>(); }) {
+            const auto* io_executor = executor.template target<asio::io_context::executor_type>();
+            on_executor_thread      = (io_executor != nullptr) && io_executor->running_in_this_thread();
+        }
+        if (on_executor_thread) {
+            return make_error_code(std::errc::resource_deadlock_would_occur);
         }
+        return {};
+    } //stream::check_queued_wait() noexcept
 
-        switch (state_) {
-            case state::initializing:
-                return handle_processor_state_initializing(self);
-            case state::reading:
-                return handle_processor_state_reading(self, ec_in, bytes_transferred);
-            case state::processing:
-                return handle_processor_state_processing(self, ec_in);
-            case state::done:
-                [[fallthrough]];
-            default:
-                [[unlikely]] break; //Unreachable due to early check
-        } //switch (state_)
-    } //stream::input_processor::operator(Self&, std::error_code, std::size_t)
+    /**
+     * @internal
+     * Starts `context_.inflater`, appends the unscanned bytes of `context_.input_side_buffer` to `context_.compressed_input_buffer`, and inflates the first chunk.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::start_input_decompression() noexcept
+    {
+        if (auto ec = context_.inflater.start(); ec) {
+            return ec;
+        }
+        try {
+            const auto pending = context_.input_side_buffer.data();
+            context_.compressed_input_buffer.commit(
+                asio::buffer_copy(context_.compressed_input_buffer.prepare(pending.size()), pending)
+            );
+            context_.input_side_buffer.consume(pending.size());
+        } catch (const std::length_error&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
+        }
+        return inflate_input();
+    } //stream::start_input_decompression() noexcept
 
     /**
      * @internal
-     * In `initializing`, calls `next_layer_.async_read_some` with `buffers_` unless `context_.input_side_buffer` already has data. Transitions to `reading`.
-     * @remark Directly calls `handle_processor_state_reading` if there is data in the buffer already waiting to be processed.
+     * Runs one `inflate_stream::decompress` from `context_.compressed_input_buffer` into at most `inflate_chunk_size` prepared bytes of `context_.input_side_buffer`.
+     * @remark Runs even with no compressed bytes buffered, since zlib may still hold output from a previous call that filled its chunk.
+     * @remark On stream end, copies the remaining compressed-buffer bytes (now plain Telnet) after the inflated ones.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_initializing(Self& self)
+    std::error_code stream<NLS, PC>::inflate_input() noexcept
     {
-        state_ = state::reading;
-        if (context_.input_side_buffer.size() == 0) {
-            if (context_.deferred_transport_error) {
-                //Immediately propagate a deferred error without attempting the next read.
-                complete(self, std::exchange(context_.deferred_transport_error, {}), 0);
-                return;
+        if (!context_.inflater.active()) {
+            return {};
+        }
+        try {
+            const auto compressed = context_.compressed_input_buffer.data();
+            const auto inflated   = context_.input_side_buffer.prepare(inflate_chunk_size);
+            const auto [ec, consumed, produced, finished] = context_.inflater.decompress(
+                {static_cast<const byte_t*>(compressed.data()), compressed.size()},
+                {static_cast<byte_t*>(inflated.data()), inflated.size()}
+            );
+            context_.compressed_input_buffer.consume(consumed);
+            context_.input_side_buffer.commit(produced);
+            if (finished) {
+                //The peer ended its compressed stream; whatever follows the trailer is plain Telnet.
+                const auto plain = context_.compressed_input_buffer.data();
+                context_.input_side_buffer.commit(asio::buffer_copy(context_.input_side_buffer.prepare(plain.size()), plain));
+                context_.compressed_input_buffer.consume(plain.size());
             }
-
-            parent_stream_.launch_wait_for_urgent_data();
-
-            auto read_buffer = context_.input_side_buffer.prepare(input_processor::read_block_size);
-            parent_stream_.next_layer()
-                .async_read_some(read_buffer, asio::bind_executor(parent_stream_.get_executor(), std::move(self)));
-            return; //Wait for next_layer async_read_some to complete.
+            return ec;
+        } catch (const std::length_error&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
         }
-        //If the buffer already has data, there is no need to wait for a network read.
-        return handle_processor_state_reading(self);
-    } //stream::input_processor::handle_processor_state_initializing(Self&)
+    } //stream::inflate_input() noexcept
 
     /**
      * @internal
-     * In `reading`, sets up iterators (`user_buf_begin_`, `user_buf_end_`, `write_it_`) and transitions to `processing`.
-     * @remark Directly calls `handle_processor_state_processing` to immediately begin processing.
+     * Defers to `tls_session::start`, which does nothing if a session is already open.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_reading(
-        Self& self,
-        std::error_code ec_in,
-        std::size_t bytes_transferred
-    )
+    std::error_code stream<NLS, PC>::start_tls_session() noexcept
     {
-        context_.input_side_buffer.commit(bytes_transferred);
+        return context_.tls.start(context_.tls_config, context_.tls_side, context_.tls_peer_name);
+    } //stream::start_tls_session() noexcept
 
-        if (context_.input_side_buffer.size() == 0) {
-            //If there is no data to process, we can complete, propagating any read error.
-            complete(self, ec_in, 0);
-            return;
+    /**
+     * @internal
+     * Opens the session, appends the unscanned bytes of `context_.input_side_buffer` to `context_.tls_input_buffer`, and decrypts the first chunk.
+     * @remark Rejects a FOLLOWS inside compressed or already-decrypted input, which no conforming peer sends.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::start_input_decryption() noexcept
+    {
+        if (!context_.tls_config.valid() || context_.inflater.active() || context_.tls_input_active) {
+            return make_error_code(error::tls_error);
         }
-
-        if (ec_in) {
-            //If we had a deferred error, we skipped the read in state::initializing.
-            //If we have a read error, defer it.
-            context_.deferred_transport_error = ec_in;
+        if (auto ec = start_tls_session(); ec) {
+            return ec;
         }
-
-        //Set up private member iterators into the provided buffer.
-        user_buf_begin_ = asio::buffers_begin(buffers_);
-        user_buf_end_   = asio::buffers_end(buffers_);
-        write_it_       = user_buf_begin_;
-
-        state_ = state::processing;
-        return handle_processor_state_processing(self);
-    } //stream::input_processor::handle_processor_state_reading(Self&, std::error_code, std::size_t)
+        try {
+            const auto pending = context_.input_side_buffer.data();
+            context_.tls_input_buffer.commit(asio::buffer_copy(context_.tls_input_buffer.prepare(pending.size()), pending));
+            context_.input_side_buffer.consume(pending.size());
+        } catch (const std::length_error&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
+        }
+        context_.tls_input_active = true;
+        return decrypt_input();
+    } //stream::start_input_decryption() noexcept
 
     /**
      * @internal
-     * In `processing`, iterates over the buffer, calling `fsm_.process_byte`, handling forward flags (outside of urgent/Synch mode), and dispatching to `do_response` overloads that handle `ProcessingReturnVariant` responses via `std::visit`
-     * Consumes bytes from the `context_.input_side_buffer` manually before async operations to avoid re-processing.
-     * Completes with `std::distance(user_buf_begin_, write_it_)` bytes when `read_it == buf_end` or `write_it_ == user_buf_end_` or `process_byte` returns an error code. [std::distance should be linear time in the number of buffers in the sequence rather than the number of bytes]
-     * Delegates to `process_fsm_signal` to handle `processing_signal`s returned from `process_byte`.
-     * @remark Handles AO by clearing `context_.output_side_buffer` but propagates the signal to the caller for higher-level notification.
-     * @note Unhandled `processing_signal`s and other `error_code`s propagate to the caller for higher-level notification.
+     * Opens the session if input has not already, then runs the first `tls_session::handshake`, which queues a client's ClientHello for `output_processor_` or `write_tls_records`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_processing(Self& self, std::error_code ec_in)
+    std::error_code stream<NLS, PC>::start_output_encryption() noexcept
     {
-        if (ec_in) { //This has to be a write error.
-            process_write_error(ec_in);
+        if (auto ec = start_tls_session(); ec) {
+            return ec;
         }
+        context_.tls_output_active = true;
+        return context_.tls.handshake();
+    } //stream::start_output_encryption() noexcept
 
-        std::error_code result_ec = std::exchange(context_.deferred_processing_signal, {});
-
-        std::size_t bytes_consumed    = 0;
-        std::size_t bytes_to_transfer = 0;
-
-        if (!result_ec) {
-            const auto proc_buffer = context_.input_side_buffer.data();
-            auto buf_begin         = asio::buffers_begin(proc_buffer);
-            auto buf_end           = asio::buffers_end(proc_buffer);
-            auto read_it           = buf_begin;
-
-            for (; (read_it != buf_end) && (write_it_ != user_buf_end_); ++read_it) {
-                auto [proc_ec, forward, response] = fsm_.process_byte(static_cast<byte_t>(*read_it));
-
-                if (proc_ec == processing_signal::abort_output) {
-                    //AO clears the output side buffer.
-                    context_.output_side_buffer.consume(context_.output_side_buffer.size());
-
-                    //Defer the AO processing signal for application-level notification after the `async_send_synch` completes.
-                    context_.deferred_processing_signal = proc_ec;
-
-                    //Consume the bytes currently processed from the buffer INCLUDING this one
-                    //MUST call now because we `move(self)` while handling `response` and lose access to `context_.input_side_buffer`
-                    bytes_consumed = std::distance(buf_begin, read_it) + 1;
-                    context_.input_side_buffer.consume(bytes_consumed);
+    /**
+     * @internal
+     * Runs one `tls_session::decrypt` from `context_.tls_input_buffer` into at most `decrypt_chunk_size` prepared bytes of `plaintext_target()`.
+     * @remark Runs even with no ciphertext buffered, since OpenSSL may still hold plaintext from a previous call that filled its chunk.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::decrypt_input() noexcept
+    {
+        if (!context_.tls_input_active) {
+            return {};
+        }
+        try {
+            const bool was_established = context_.tls.established();
+            side_buffer_type& target   = plaintext_target();
+            const auto ciphertext      = context_.tls_input_buffer.data();
+            const auto plaintext       = target.prepare(decrypt_chunk_size);
+            const auto [ec, consumed, produced] = context_.tls.decrypt(
+                {static_cast<const byte_t*>(ciphertext.data()), ciphertext.size()},
+                {static_cast<byte_t*>(plaintext.data()), plaintext.size()}
+            );
+            context_.tls_input_buffer.consume(consumed);
+            target.commit(produced);
+            if (context_.tls.has_output() || (context_.tls.established() != was_established)) {
+                output_processor_.notify_tls_output(); //Handshake replies to send, or writes held for the handshake.
+            }
+            return ec;
+        } catch (const std::length_error&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
+        }
+    } //stream::decrypt_input() noexcept
+
+    /**
+     * @internal
+     * Decrypts before inflating, since MCCP compresses inside TLS.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::unwrap_input() noexcept
+    {
+        if (auto ec = decrypt_input(); ec) {
+            return ec;
+        }
+        return inflate_input();
+    } //stream::unwrap_input() noexcept
+
+    /**
+     * @internal
+     * Moves the queued records into a pooled vector and writes them with `asio::write`, counting them as `statistic::bytes_sent`.
+     * @remark Leaves the records to `output_processor_` via `notify_tls_output` while asynchronous writes are outstanding, so they cannot overtake a batch sealed before them.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::write_tls_records() noexcept
+    {
+        if (!context_.tls_output_active || !context_.tls.has_output()) {
+            return {};
+        }
+        if (!output_processor_.is_idle()) {
+            output_processor_.notify_tls_output();
+            return {};
+        }
+        try {
+            std::vector<byte_t> records = context_.escape_buffers.acquire(0);
+            std::error_code ec = context_.tls.take_output(records);
+            if (!ec) {
+                statistics_.add(statistic::bytes_sent, asio::write(next_layer_, asio::buffer(records), ec));
+            }
+            context_.escape_buffers.release(std::move(records));
+            return ec;
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            return make_error_code(error::internal_error);
+        }
+    } //stream::write_tls_records() noexcept
+
+    /**
+     * @internal
+     * Alternates `write_tls_records` with blocking reads into `context_.tls_input_buffer`, each followed by `unwrap_input`, until `tls_session::established`.
+     * @remark Plaintext that arrives with the peer's Finished lands in the side buffer as usual, for the next read to scan.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::error_code stream<NLS, PC>::handshake_blocking() noexcept
+    {
+        if (!context_.tls_input_active) {
+            return make_error_code(error::tls_error); //Until the peer's FOLLOWS, its records cannot be told from Telnet.
+        }
+        try {
+            while (!context_.tls.established()) {
+                if (auto ec = write_tls_records(); ec) {
+                    return ec;
+                }
+                std::error_code read_ec;
+                const std::size_t bytes_read = next_layer_.read_some(
+                    context_.tls_input_buffer.prepare(context_.read_tuner.next_read_size()), read_ec
+                );
+                context_.tls_input_buffer.commit(bytes_read);
+                statistics_.add(statistic::bytes_received, bytes_read);
+                if (auto ec = unwrap_input(); ec) {
+                    return ec;
+                }
+                if (read_ec) {
+                    return read_ec;
+                }
+            }
+            return write_tls_records(); //A client's Finished.
+        } catch (const std::length_error&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (const std::bad_alloc&) {
+            return make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            return make_error_code(error::internal_error);
+        }
+    } //stream::handshake_blocking() noexcept
+
+    /**
+     * @internal
+     * Validates `opt` using `opt.supports_subnegotiation()` and `fsm_.is_enabled(opt)`.
+     * @remark Acquires the buffer from `context_.escape_buffers` with space for subnegotiation data plus 5 bytes (IAC SB, opt, IAC SE).
+     * @remark Appends IAC SB, `opt`, escaped subnegotiation data via `escape_telnet_output`, and IAC SE.
+     * @remark Returns `telnet::error::invalid_subnegotiation` or `telnet::error::option_not_available` if validation fails.
+     * @remark Catches `std::bad_alloc` to return `std::errc::not_enough_memory` and other exceptions to return `telnet::error::internal_error`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::tuple<std::error_code, std::vector<byte_t>> stream<NLS, PC>::frame_subnegotiation(
+        const option& opt,
+        const std::vector<byte_t>& subnegotiation_buffer
+    ) noexcept
+    {
+        if (!opt.supports_subnegotiation()) {
+            return {make_error_code(error::invalid_subnegotiation), std::vector<byte_t>()};
+        }
+        if (!fsm_.is_enabled(opt)) {
+            return {make_error_code(error::option_not_available), std::vector<byte_t>()};
+        }
+
+        std::vector<byte_t> escaped_buffer;
+        try {
+            //Reserve space for the original size plus 10% for escaping and 5 bytes for framing (IAC SB, opt, IAC SE)
+            constexpr double escaping_cushion_factor = 1.1;
+            using size_type                          = decltype(subnegotiation_buffer.size());
+            constexpr size_type framing_padding      = 5;
+            escaped_buffer                           = context_.escape_buffers.acquire(
+                static_cast<size_type>(static_cast<double>(subnegotiation_buffer.size()) * escaping_cushion_factor)
+                + framing_padding
+            );
+
+            //Append initial framing: IAC SB opt
+            escaped_buffer.push_back(std::to_underlying(telnet::command::iac));
+            escaped_buffer.push_back(std::to_underlying(telnet::command::sb));
+            escaped_buffer.push_back(std::to_underlying(opt.get_id()));
+
+            //Escape the subnegotiation data
+            if (auto ec = std::get<0>(escape_telnet_output(escaped_buffer, subnegotiation_buffer)); ec) {
+                return {ec, std::vector<byte_t>()};
+            }
+
+            //Append final framing: IAC SE
+            escaped_buffer.push_back(std::to_underlying(telnet::command::iac));
+            escaped_buffer.push_back(std::to_underlying(telnet::command::se));
+        } catch (const std::bad_alloc&) {
+            return {make_error_code(std::errc::not_enough_memory), std::vector<byte_t>()};
+        } catch (...) {
+            return {make_error_code(error::internal_error), std::vector<byte_t>()};
+        }
+        return {std::error_code(), std::move(escaped_buffer)};
+    } //stream::frame_subnegotiation(const option&, const std::vector<byte_t>&) noexcept
+
+    /**
+     * @internal
+     * Uses `byte_scan::find_first_of` with the needle set fixed at compile time: `IAC` alone in BINARY mode, else `IAC`, `CR`, and `LF`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<bool LocalBinary>
+    const byte_t* stream<NLS, PC>::find_escapable(const byte_t* first, const byte_t* last) noexcept
+    {
+        constexpr auto iac_byte = std::to_underlying(telnet::command::iac);
+        constexpr auto cr_byte  = static_cast<byte_t>('\r');
+        constexpr auto lf_byte  = static_cast<byte_t>('\n');
+
+        if constexpr (LocalBinary) {
+            return byte_scan::find_first_of<iac_byte>(first, last);
+        } else {
+            return byte_scan::find_first_of<iac_byte, cr_byte, lf_byte>(first, last);
+        }
+    } //stream::find_escapable(const byte_t*, const byte_t*)
+
+    /**
+     * @internal
+     * Walks each contiguous buffer in `data`, bulk-appending each plain run found by `find_escapable` to `escaped_data`, then the escape sequence for the byte that ended it: IAC -> IAC IAC always, plus LF -> CR LF and CR -> CR NUL in text mode.
+     * @remark In BINARY mode `find_escapable` only stops at IAC, so the CR and LF branches are never taken.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<bool LocalBinary, ConstBufferSequence CBufSeq>
+    void stream<NLS, PC>::escape_into(std::vector<byte_t>& escaped_data, const CBufSeq& data)
+    {
+        constexpr auto iac_byte = std::to_underlying(telnet::command::iac);
+        constexpr auto cr_byte  = static_cast<byte_t>('\r');
+        constexpr auto lf_byte  = static_cast<byte_t>('\n');
+        constexpr auto nul_byte = static_cast<byte_t>('\0');
+
+        for (auto buf_it = asio::buffer_sequence_begin(data), buf_end = asio::buffer_sequence_end(data); buf_it != buf_end;
+             ++buf_it) {
+            const asio::const_buffer buffer(*buf_it);
+            const auto* first = static_cast<const byte_t*>(buffer.data());
+            const auto* last  = first + buffer.size();
 
-                    parent_stream_.async_send_synch(std::move(self));
-                    return;           //Wait for the asynchronous operation to complete.
-                } else if (proc_ec) { //proc_ec will be cleared for non-terminal signals handled internally.
-                    process_fsm_signal(proc_ec);
+            while (first != last) {
+                const byte_t* special = find_escapable<LocalBinary>(first, last);
+                escaped_data.insert(escaped_data.end(), first, special); //bulk-copy the plain run
+                if (special == last) {
+                    break;
                 }
+                if (LocalBinary || (*special == iac_byte)) {
+                    escaped_data.insert(escaped_data.end(), {iac_byte, iac_byte}); //double IAC (IAC -> IAC IAC)
+                } else if (*special == lf_byte) {
+                    escaped_data.insert(escaped_data.end(), {cr_byte, lf_byte}); //prepend CR before LF (LF -> CR LF)
+                } else {
+                    escaped_data.insert(escaped_data.end(), {cr_byte, nul_byte}); //append NUL after CR (CR -> CR NUL)
+                }
+                first = special + 1;
+            }
+        }
+    } //stream::escape_into(std::vector<byte_t>&, const CBufSeq&)
+
+    /**
+     * @internal
+     * Dispatches once to the `escape_into` loop specialized for `local_binary`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    void stream<NLS, PC>::escape_output(std::vector<byte_t>& escaped_data, const CBufSeq& data, bool local_binary)
+    {
+        if (local_binary) {
+            escape_into<true>(escaped_data, data);
+        } else {
+            escape_into<false>(escaped_data, data);
+        }
+    } //stream::escape_output(std::vector<byte_t>&, const CBufSeq&, bool)
+
+    /**
+     * @internal
+     * Walks each contiguous buffer in `data`, appending a slice for each plain run found by `find_escapable`, then a static 2-byte escape buffer for the byte that ended it; the escapable byte itself is never referenced.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<bool LocalBinary, ConstBufferSequence CBufSeq>
+    void stream<NLS, PC>::escape_into(std::vector<asio::const_buffer>& slices, const CBufSeq& data)
+    {
+        constexpr auto iac_byte = std::to_underlying(telnet::command::iac);
+        constexpr auto cr_byte  = static_cast<byte_t>('\r');
+        constexpr auto lf_byte  = static_cast<byte_t>('\n');
+        constexpr auto nul_byte = static_cast<byte_t>('\0');
+
+        static constexpr std::array<byte_t, 2> iac_iac{iac_byte, iac_byte};
+        static constexpr std::array<byte_t, 2> cr_lf{cr_byte, lf_byte};
+        static constexpr std::array<byte_t, 2> cr_nul{cr_byte, nul_byte};
 
-                //Write a `forward`ed byte into the user's buffer.
-                if (forward && !context_.urgent_data_state) {
-                    *write_it_++ = *read_it;
+        for (auto buf_it = asio::buffer_sequence_begin(data), buf_end = asio::buffer_sequence_end(data); buf_it != buf_end;
+             ++buf_it) {
+            const asio::const_buffer buffer(*buf_it);
+            const auto* first = static_cast<const byte_t*>(buffer.data());
+            const auto* last  = first + buffer.size();
+
+            while (first != last) {
+                const byte_t* special = find_escapable<LocalBinary>(first, last);
+                if (special != first) {
+                    slices.emplace_back(first, static_cast<std::size_t>(special - first)); //slice of the plain run
+                }
+                if (special == last) {
+                    break;
                 }
-                if (proc_ec) { //Terminal signal or error
-                    //Consume the bytes currently processed from the buffer INCLUDING this one
-                    bytes_consumed = std::distance(buf_begin, read_it) + 1;
-                    result_ec      = proc_ec; //Propagate the processing error_code
-                    break;                    //Complete the operation.
+                if (LocalBinary || (*special == iac_byte)) {
+                    slices.push_back(asio::buffer(iac_iac)); //IAC -> IAC IAC
+                } else if (*special == lf_byte) {
+                    slices.push_back(asio::buffer(cr_lf)); //LF -> CR LF
+                } else {
+                    slices.push_back(asio::buffer(cr_nul)); //CR -> CR NUL
                 }
-                if (response) {
-                    //Consume the bytes currently processed from the buffer INCLUDING this one
-                    //MUST call now because we `move(self)` while handling `response` and lose access to `context_.input_side_buffer`
-                    bytes_consumed = std::distance(buf_begin, read_it) + 1;
-                    context_.input_side_buffer.consume(bytes_consumed);
+                first = special + 1;
+            }
+        }
+    } //stream::escape_into(std::vector<asio::const_buffer>&, const CBufSeq&)
 
-                    std::visit(
-                        [this, self = std::move(self)](auto&& arg) mutable {
-                            this->do_response(std::forward<decltype(arg)>(arg), std::move(self));
-                        },
-                        *response
-                    );
-                    return; //Wait for async operation to complete
-                } //if (response)
-            } //for
-            if (!result_ec) {
-                //SUCCESS: We either reached the end of the read data or filled the user's buffer.
-                bytes_consumed = std::distance(buf_begin, read_it);
+    /**
+     * @internal
+     * Passes `broadcast_message::encoding` the `escape_into` instantiation for the FSM's cached local `BINARY` bit.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::tuple<std::error_code, std::shared_ptr<const std::vector<byte_t>>>
+        stream<NLS, PC>::broadcast_encoding(const broadcast_message& message) const noexcept
+    {
+        try {
+            const bool local_binary = fsm_.binary_enabled(negotiation_direction::local);
+            return {
+                std::error_code(),
+                message.encoding(local_binary, [local_binary](std::vector<byte_t>& out, std::span<const byte_t> payload) {
+                    const asio::const_buffer data(payload.data(), payload.size());
+                    if (local_binary) {
+                        escape_into<true>(out, data);
+                    } else {
+                        escape_into<false>(out, data);
+                    }
+                })
+            };
+        } catch (const std::bad_alloc&) {
+            return {make_error_code(std::errc::not_enough_memory), nullptr};
+        } catch (...) {
+            return {make_error_code(error::internal_error), nullptr};
+        }
+    } //stream::broadcast_encoding(const broadcast_message&) const noexcept
+
+    /**
+     * @internal
+     * Reads the FSM's cached local `BINARY` bit once and runs the matching `escape_into` loop.
+     * @remark Catches `std::bad_alloc` to clear `escaped_data` and return `std::errc::not_enough_memory`.
+     * @remark Catches other exceptions to clear `escaped_data` and return `telnet::error::internal_error`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::tuple<std::error_code, std::vector<byte_t>&>
+        stream<NLS, PC>::escape_telnet_output(std::vector<byte_t>& escaped_data, const CBufSeq& data) const noexcept
+    {
+        try {
+            if (fsm_.binary_enabled(negotiation_direction::local)) {
+                escape_into<true>(escaped_data, data);
+            } else {
+                escape_into<false>(escaped_data, data);
+            }
+            return {std::error_code(), escaped_data};
+        } catch (const std::bad_alloc&) {
+            escaped_data.clear();
+            return {make_error_code(std::errc::not_enough_memory), escaped_data};
+        } catch (...) {
+            escaped_data.clear();
+            return {make_error_code(error::internal_error), escaped_data};
+        }
+    } //stream::escape_telnet_output(std::vector<byte_t>&, const CBufSeq&) const noexcept
+
+    /**
+     * @internal
+     * Reads the FSM's cached local `BINARY` bit once and runs the matching `escape_into` loop.
+     * @remark Catches `std::bad_alloc` to clear `slices` and return `std::errc::not_enough_memory`.
+     * @remark Catches other exceptions to clear `slices` and return `telnet::error::internal_error`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::tuple<std::error_code, std::vector<asio::const_buffer>&>
+        stream<NLS, PC>::escape_telnet_output(std::vector<asio::const_buffer>& slices, const CBufSeq& data) const noexcept
+    {
+        try {
+            if (fsm_.binary_enabled(negotiation_direction::local)) {
+                escape_into<true>(slices, data);
+            } else {
+                escape_into<false>(slices, data);
+            }
+            return {std::error_code(), slices};
+        } catch (const std::bad_alloc&) {
+            slices.clear();
+            return {make_error_code(std::errc::not_enough_memory), slices};
+        } catch (...) {
+            slices.clear();
+            return {make_error_code(error::internal_error), slices};
+        }
+    } //stream::escape_telnet_output(std::vector<asio::const_buffer>&, const CBufSeq&) const noexcept
+
+    /**
+     * @internal
+     * Acquires a `std::vector<byte_t>` from `context_.escape_buffers` with 10% extra capacity based on `asio::buffer_size(data)`.
+     * @remark Delegates to the overload with a provided vector.
+     * @remark Catches `std::bad_alloc` to return `std::errc::not_enough_memory` with an empty vector.
+     * @remark Catches other exceptions to return `telnet::error::internal_error` with an empty vector.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::tuple<std::error_code, std::vector<byte_t>> stream<NLS, PC>::escape_telnet_output(const CBufSeq& data) noexcept
+    {
+        try {
+            constexpr double escaping_cushion_factor = 1.1;
+            std::vector<byte_t> escaped_data         = context_.escape_buffers.acquire(
+                static_cast<std::size_t>(static_cast<double>(asio::buffer_size(data)) * escaping_cushion_factor)
+            );
+            auto [ec, escaped] = this->escape_telnet_output(escaped_data, data);
+            return {ec, std::move(escaped)};
+        } catch (const std::bad_alloc&) {
+            return {make_error_code(std::errc::not_enough_memory), std::vector<byte_t>()};
+        } catch (...) {
+            return {make_error_code(error::internal_error), std::vector<byte_t>()};
+        }
+    } //stream::escape_telnet_output(const CBufSeq&) noexcept
+
+    /**
+     * @internal
+     * Launches an asynchronous wait (via 0-byte async_receive) for notification of urgent (i.e. "out-of-band") data.
+     * @remark Only launches the async_receive if another one is not already in progress and there is not already urgent data in the byte stream.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::launch_wait_for_urgent_data()
+    {
+        if constexpr (policy_traits<PC>::urgent_data == urgent_data_policy::at_mark) {
+            return; //`check_urgent_mark` asks the kernel after each read instead.
+        }
+        if (!context_.waiting_for_urgent_data.exchange(true, std::memory_order_relaxed) && !context_.urgent_data_state) {
+            this->lowest_layer().async_receive(
+                asio::mutable_buffer(nullptr, 0),
+                asio::socket_base::message_out_of_band,
+                asio::bind_executor(
+                    this->get_executor(), [this](std::error_code ec, std::size_t) {
+                        this->context_.waiting_for_urgent_data.store(false, std::memory_order_relaxed);
+                        if (!ec) {
+                            this->context_.urgent_data_state.saw_urgent();
+                        } else {
+                            log_traits<PC>::template log<log_level::error>(ec, "OOB wait failed: {}", ec.message());
+                            if (!this->context_.deferred_transport_error) {
+                                this->context_.deferred_transport_error = ec;
+                                this->statistics_.add(statistic::deferred_errors);
+                            } //If there is already a transport error deferred, ignore this one as it’s likely redundant.
+                        }
+                    } //[this](std::error_code, std::size_t)
+                )
+            );
+        }
+    } //stream::launch_urgent_wait()
+
+    /**
+     * @internal
+     * Keeps the first error deferred, since later ones are usually its consequences.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::defer_write_error(const std::error_code& ec) noexcept
+    {
+        if (context_.deferred_transport_error) {
+            //We have a new write error on top of a previously deferred error.
+            //Log it and attempt to continue processing the buffered byte stream.
+            log_traits<PC>::template log<log_level::error>(
+                ec,
+                "Error writing Telnet response with error {} previously deferred " "for reporting after processing the buffered byte stream.",
+                context_.deferred_transport_error
+            );
+        } else {
+            //Defer the write error.
+            context_.deferred_transport_error = ec;
+            statistics_.add(statistic::deferred_errors);
+        }
+    } //stream::defer_write_error(const std::error_code&) noexcept
+
+    /**
+     * @internal
+     * Asks `lowest_layer().at_mark` whether the urgent byte is next after every read that committed bytes, whatever the byte it ended on.
+     * @remark Under `urgent_data_policy::oob_wait`, does nothing while `launch_wait_for_urgent_data` has a receive armed, so only reads with no wait behind them (blocking reads, or after a failed wait) pay for the check.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::check_urgent_mark(std::size_t bytes_read) noexcept
+    {
+        if constexpr (policy_traits<PC>::urgent_data != urgent_data_policy::at_mark) {
+            if (context_.waiting_for_urgent_data.load(std::memory_order_relaxed)) {
+                return; //The armed OOB wait reports the urgent data instead.
+            }
+        }
+        if ((bytes_read == 0) || context_.inflater.active() || context_.tls_input_active || context_.urgent_data_state) {
+            return;
+        }
+        std::error_code ec;
+        if (lowest_layer().at_mark(ec)) {
+            context_.urgent_data_state.saw_urgent();
+        } else if (ec) {
+            log_traits<PC>::template log<log_level::error>(ec, "Urgent mark check failed: {}", ec.message());
+        }
+    } //stream::check_urgent_mark(std::size_t) noexcept
+
+    /**
+     * @internal
+     * Use `compare_exchange_strong` to update `state_`.
+     * If `state_` was `no_urgent_data`, it becomes `has_urgent_data`.
+     * If `state_` was `unexpected_data_mark`, it resets to `no_urgent_data`.
+     * It can't already be `has_urgent_data` without a major bug.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::context_type::urgent_data_tracker::saw_urgent()
+    {
+        urgent_data_state expected_state{};
+        urgent_data_state desired_state{};
+        bool success = false;
+
+        do {
+            //Load the current state
+            expected_state = state_.load(std::memory_order_relaxed);
+
+            if (expected_state == urgent_data_state::no_urgent_data) {
+                //The OOB notification arrived first.
+                desired_state = urgent_data_state::has_urgent_data;
+            } else if (expected_state == urgent_data_state::unexpected_data_mark) {
+                //The DM arrived first; this is the delayed notification. Reset.
+                log_traits<protocol_config_type>::template log<log_level::error>(
+                    processing_signal::data_mark,
+                    "DM already arrived before current TCP urgent notification. Assuming Synch is already complete."
+                );
+                desired_state = urgent_data_state::no_urgent_data;
+            } else {
+                //CANT HAPPEN: state is `has_urgent_data`. This means another saw_urgent fired without saw_data_mark in between, or a logic error.
+                //We cannot transition and must exit.
+                log_traits<protocol_config_type>::template log<log_level::error>(
+                    error::internal_error,
+                    "Invalid state in saw_urgent: has_urgent_data already set; implies launch_wait_for_urgent_data was " "called while urgent data was already in the byte stream."
+                );
+                return;
+            }
+
+            //Atomically attempt the transition
+            success = state_.compare_exchange_strong(
+                expected_state,
+                desired_state,
+                std::memory_order_release, //Ensure subsequent reads see the change
+                std::memory_order_relaxed
+            );
+
+        } while (!success);
+    } //stream::context_type::urgent_data_tracker::saw_urgent()
+
+    /**
+     * @internal
+     * Use `compare_exchange_strong` to update `state_`.
+     * If `state_` was `no_urgent_data`, it becomes `unexpected_data_mark`.
+     * If `state_` was `has_urgent_data`, it resets to `no_urgent_data`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::context_type::urgent_data_tracker::saw_data_mark()
+    {
+        urgent_data_state expected_state{};
+        urgent_data_state desired_state{};
+        bool success = false;
+
+        do {
+            //Load the current state
+            expected_state = state_.load(std::memory_order_relaxed);
+
+            if (expected_state == urgent_data_state::has_urgent_data) {
+                //The DM arrived as expected. Reset.
+                desired_state = urgent_data_state::no_urgent_data;
+            } else if (expected_state == urgent_data_state::no_urgent_data) {
+                //The DM arrived before the OOB notification arrived.
+                desired_state = urgent_data_state::unexpected_data_mark;
+                log_traits<protocol_config_type>::template log<log_level::error>(
+                    processing_signal::data_mark, "DM arrived without/before TCP urgent."
+                );
+            } else {
+                //State is `unexpected_data_mark`. This means another `saw_data_mark` fired without `saw_urgent` in between, or a logic error. The peer likely sent 2 data marks in quick succession, but this is safe.
+                //We cannot transition and must exit.
+                log_traits<protocol_config_type>::template log<log_level::error>(
+                    processing_signal::data_mark, "Subsequent DM received while expecting TCP urgent."
+                );
+                return;
+            }
+
+            //Atomically attempt the transition
+            success = state_.compare_exchange_strong(
+                expected_state,
+                desired_state,
+                std::memory_order_release, //Ensure subsequent reads see the change
+                std::memory_order_relaxed
+            );
+
+        } while (!success);
+    } //stream::context_type::urgent_data_tracker::saw_data_mark()
+
+    /**
+     * @internal
+     * Initializes member variables `parent_stream_`, `fsm_`, `buffers_`, and sets `state_` to `initializing`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    stream<NLS, PC>::input_processor<MBS>::input_processor(
+        stream& parent_stream,
+        stream::fsm_type& fsm,
+        stream::context_type& context,
+        MBS buffers
+    )
+        : parent_stream_(parent_stream), fsm_(fsm), context_(context), buffers_(buffers), state_(state::initializing)
+    {}
+
+    /**
+     * @internal
+     * Manages state transitions using a switch statement (`initializing`, `awaiting_input`, `reading`, `processing`, `done`).
+     * Dispatches to "handle_processor_state_*" helpers for each valid state.
+     * @remark Uses `[[unlikely]]` for `done` state and default case, and `[[fallthrough]]` for `reading` to `processing`.
+     * @remark Checks `done` state early to prevent reentrancy.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::operator()(Self& self, std::error_code ec_in, std::size_t bytes_transferred)
+    {
+        if (state_ == state::done) [[unlikely]] {
+            return; //complete has already been called; unsafe to do anything else
+        }
+
+        switch (state_) {
+            case state::initializing:
+                return handle_processor_state_initializing(self);
+            case state::awaiting_input:
+                return handle_processor_state_awaiting_input(self, ec_in);
+            case state::reading:
+                return handle_processor_state_reading(self, ec_in, bytes_transferred);
+            case state::processing:
+                return handle_processor_state_processing(self, ec_in);
+            case state::done:
+                [[fallthrough]];
+            default:
+                [[unlikely]] break; //Unreachable due to early check
+        } //switch (state_)
+    } //stream::input_processor::operator(Self&, std::error_code, std::size_t)
+
+    /**
+     * @internal
+     * In `initializing`, calls `next_layer_.async_read_some` for `context_.read_tuner.next_read_size()` bytes of `read_target()` unless `context_.input_side_buffer` already has data. Transitions to `reading`.
+     * @remark While input is encrypted or compressed, first unwraps any buffered bytes via `unwrap_input`, reading only if that yields nothing.
+     * @remark Under `lean_memory`, first waits in `awaiting_input` for `lowest_layer()` to become readable, so no read buffer is allocated while the session is idle.
+     * @remark Directly calls `handle_processor_state_reading` if there is data in the buffer already waiting to be processed.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_initializing(Self& self)
+    {
+        state_ = state::reading;
+        if (context_.input_side_buffer.size() == 0) {
+            if (context_.deferred_transport_error) {
+                //Immediately propagate a deferred error without attempting the next read.
+                complete(self, std::exchange(context_.deferred_transport_error, {}), 0);
+                return;
+            }
+            if (auto unwrap_ec = parent_stream_.unwrap_input(); unwrap_ec) {
+                complete(self, unwrap_ec, 0);
+                return;
+            }
+        }
+        if (context_.input_side_buffer.size() == 0) {
+            parent_stream_.launch_wait_for_urgent_data();
+
+            if constexpr (policy_traits<PC>::lean_memory) {
+                if (!std::exchange(input_ready_, false)) {
+                    state_ = state::awaiting_input;
+                    parent_stream_.lowest_layer().async_wait(
+                        asio::socket_base::wait_read, asio::bind_executor(parent_stream_.get_executor(), std::move(self))
+                    );
+                    return; //Wait for the socket to become readable before preparing a read buffer.
+                }
+            }
+
+            auto read_buffer = parent_stream_.read_target().prepare(context_.read_tuner.next_read_size());
+            read_issued_     = true;
+            parent_stream_.next_layer()
+                .async_read_some(read_buffer, asio::bind_executor(parent_stream_.get_executor(), std::move(self)));
+            return; //Wait for next_layer async_read_some to complete.
+        }
+        //If the buffer already has data, there is no need to wait for a network read.
+        return handle_processor_state_reading(self);
+    } //stream::input_processor::handle_processor_state_initializing(Self&)
+
+    /**
+     * @internal
+     * In `awaiting_input`, completes with a failed readiness wait's error, or re-enters `initializing` to issue the read it deferred.
+     * @remark Re-enters `initializing` rather than `reading` so the read is sized by `context_.read_tuner` and aimed at `read_target()` exactly as without the wait.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_awaiting_input(Self& self, std::error_code ec_in)
+    {
+        if (ec_in) {
+            complete(self, ec_in, 0);
+            return;
+        }
+        input_ready_ = true;
+        return handle_processor_state_initializing(self);
+    } //stream::input_processor::handle_processor_state_awaiting_input(Self&, std::error_code)
+
+    /**
+     * @internal
+     * In `reading`, feeds the size of a completed next-layer read to `context_.read_tuner`, sets up iterators (`user_buf_begin_`, `user_buf_end_`, `write_it_`), and transitions to `processing`.
+     * @remark Unwraps a completed read while input is encrypted or compressed, re-entering `initializing` if every byte read was absorbed by the TLS session or the inflater.
+     * @remark Directly calls `handle_processor_state_processing` to immediately begin processing.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_reading(
+        Self& self,
+        std::error_code ec_in,
+        std::size_t bytes_transferred
+    )
+    {
+        parent_stream_.read_target().commit(bytes_transferred);
+        if (std::exchange(read_issued_, false)) {
+            context_.read_tuner.record_read(bytes_transferred);
+            parent_stream_.statistics_.add(statistic::bytes_received, bytes_transferred);
+            parent_stream_.check_urgent_mark(bytes_transferred);
+            if (auto unwrap_ec = parent_stream_.unwrap_input(); unwrap_ec && !ec_in) {
+                ec_in = unwrap_ec;
+            }
+        }
+
+        if (context_.input_side_buffer.size() == 0) {
+            if (!ec_in && (bytes_transferred > 0)) {
+                //Every encrypted or compressed byte read is still inside the TLS session or the inflater, so read again.
+                return handle_processor_state_initializing(self);
+            }
+            //If there is no data to process, we can complete, propagating any read error.
+            complete(self, ec_in, 0);
+            return;
+        }
+
+        if (ec_in) {
+            //If we had a deferred error, we skipped the read in state::initializing.
+            //If we have a read error, defer it.
+            context_.deferred_transport_error = ec_in;
+            parent_stream_.statistics_.add(statistic::deferred_errors);
+        }
+
+        //Set up private member iterators into the provided buffer.
+        user_buf_begin_ = asio::buffers_begin(buffers_);
+        user_buf_end_   = asio::buffers_end(buffers_);
+        write_it_       = user_buf_begin_;
+
+        state_ = state::processing;
+        return handle_processor_state_processing(self);
+    } //stream::input_processor::handle_processor_state_reading(Self&, std::error_code, std::size_t)
+
+    /**
+     * @internal
+     * In `processing`, runs `scan_side_buffer` and acts on why it stopped: `discard_output` and `async_send_synch` for AO, `async_start_tls` for the peer's FOLLOWS, a `do_response` overload (via `std::visit`) for an FSM response, or completion.
+     * Completes with `std::distance(user_buf_begin_, write_it_)` bytes when the input is exhausted, `write_it_ == user_buf_end_`, or `process_byte` returns an error code. [std::distance should be linear time in the number of buffers in the sequence rather than the number of bytes]
+     * @remark Re-enters `initializing` for another underlying read if nothing was written into the user's buffer and there is no error.
+     * @remark Under `batch_subnegotiations`, first collects every subnegotiation handler the buffered input yields and dispatches them together, then acts on whatever ended the collection.
+     * @remark Queues the pass's negotiation replies with `send_replies` before acting on anything, without waiting for them to be written.
+     * @note Unhandled `processing_signal`s and other `error_code`s propagate to the caller for higher-level notification.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::handle_processor_state_processing(Self& self, std::error_code ec_in)
+    {
+        if (ec_in) { //This has to be a write error.
+            process_write_error(ec_in);
+        }
+
+        std::error_code result_ec = std::exchange(context_.deferred_processing_signal, {});
+
+        if (!result_ec) {
+            scan_result scan = resume_scan();
+            if constexpr (policy_traits<PC>::batch_subnegotiations) {
+                if (collect_subnegotiations(scan)) {
+                    send_replies();
+                    dispatch_subnegotiation_batch(std::move(self));
+                    return; //Wait for the batch to complete.
+                }
+            }
+            send_replies();
+            auto& [scan_ec, response, abort_output, tls_follows] = scan;
+            if (abort_output) {
+                parent_stream_.output_processor_.discard_output(); //The peer asked not to see the output queued so far.
+                parent_stream_.async_send_synch(std::move(self));
+                return; //Wait for the asynchronous operation to complete.
+            }
+            if (tls_follows) {
+                parent_stream_.async_start_tls(std::move(self));
+                return; //Wait for our FOLLOWS to be written.
+            }
+            if (response) {
+                std::visit(
+                    [this, self = std::move(self)](auto&& arg) mutable {
+                        this->do_response(std::forward<decltype(arg)>(arg), std::move(self));
+                    },
+                    *response
+                );
+                return; //Wait for async operation to complete
+            }
+            result_ec = scan_ec;
+        }
+
+        const std::size_t bytes_to_transfer = std::distance(user_buf_begin_, write_it_);
+
+        if (!result_ec && (bytes_to_transfer == 0)) {
+            //Re-initialize the processor for another underlying read if we haven't written into the user's buffer.
+            return handle_processor_state_initializing(self);
+        }
+
+        complete(self, result_ec, bytes_to_transfer);
+    } //stream::input_processor::handle_processor_state_processing(Self&, std::error_code)
+
+    /**
+     * @internal
+     * Walks the contiguous side buffer, bulk-copying plain data runs found by `fsm_.process_span` and falling back to `fsm_.process_byte` for the byte that ends each run.
+     * Offers each subnegotiation payload to `fsm_.process_subnegotiation_span` first, so an unfragmented one reaches its handler as a view of the side buffer.
+     * @remark That view stays valid because the side buffer is neither read into nor compacted until the response completes; `consume` only advances the get area.
+     * Handles forward flags (outside of urgent/Synch mode) and delegates to `process_fsm_signals` to handle `processing_signal`s returned from `process_byte`.
+     * Consumes the processed bytes from `context_.input_side_buffer` before returning, so the caller may safely start I/O.
+     * @remark Handles AO by deferring the signal for the caller to report after the Synch is sent; output already queued on `output_processor_` is still delivered.
+     * @remark Queues a plain `negotiation_response` in `replies_` and keeps scanning; only handler-bearing responses, or a reply `replies_` could not hold, end the pass.
+     * @remark Handles `processing_signal::compression_start` by calling `start_input_decompression` and rescanning, since the rest of `input` was compressed.
+     * @remark Handles `processing_signal::tls_start` via `start_tls_input`, since the rest of `input` is TLS records.
+     * @remark When the input is exhausted or the user's buffer is full, swaps in any deferred transport error as the result.
+     * @remark Counts the bytes given to `process_byte`, and the IACs among them, in locals and adds them to `statistics_` once on return.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    auto stream<NLS, PC>::input_processor<MBS>::scan_side_buffer() -> scan_result
+    {
+        const auto proc_buffer = context_.input_side_buffer.data();
+        const std::span<const byte_t> input{static_cast<const byte_t*>(proc_buffer.data()), proc_buffer.size()};
+        std::size_t read_pos = 0;
+
+        //Tally byte-wise work locally and publish it once, however the scan ends.
+        struct fsm_tally {
+            typename fsm_type::statistics_type& statistics;
+            std::uint64_t byte_wise = 0;
+            std::uint64_t iacs      = 0;
+
+            ~fsm_tally()
+            {
+                statistics.add(statistic::byte_wise_fsm_bytes, byte_wise);
+                statistics.add(statistic::iac_bytes, iacs);
+            }
+        } tally{parent_stream_.statistics_};
+
+        while ((read_pos < input.size()) && (write_it_ != user_buf_end_)) {
+            //Fast path: bulk-copy the run of plain data up to the next byte needing the byte-wise FSM.
+            const bool discarding       = static_cast<bool>(context_.urgent_data_state);
+            const std::size_t available = input.size() - read_pos;
+            const std::size_t room      = static_cast<std::size_t>(user_buf_end_ - write_it_);
+            const std::size_t run_limit = discarding ? available : std::min(available, room);
+
+            if (const std::size_t run = fsm_.process_span(input.subspan(read_pos, run_limit)); run > 0) [[likely]] {
+                if (!discarding) {
+                    write_it_ = std::copy_n(input.begin() + read_pos, run, write_it_);
+                } //Data is discarded in urgent/Synch mode.
+                read_pos += run;
+                continue;
+            }
+
+            byte_t byte   = 0;
+            bool forward  = false;
+            std::error_code proc_ec;
+            std::optional<typename fsm_type::processing_return_variant> response;
+            if (auto [consumed, subneg_ec, subneg_response] = fsm_.process_subnegotiation_span(input.subspan(read_pos));
+                consumed > 0) {
+                //Zero-copy path: the whole payload and IAC SE are here, so the handler views `input` directly.
+                read_pos += consumed;
+                ++tally.iacs;
+                proc_ec  = subneg_ec;
+                response = std::move(subneg_response);
+            } else {
+                byte = input[read_pos++];
+                ++tally.byte_wise;
+                tally.iacs += (byte == std::to_underlying(command::iac)) ? 1 : 0;
+                std::tie(proc_ec, forward, response) = fsm_.process_byte(byte);
+            }
+
+            if (proc_ec == processing_signal::abort_output) {
+                //Defer the AO processing signal for application-level notification after the Synch is sent.
+                context_.deferred_processing_signal = proc_ec;
+
+                //Consume the bytes currently processed from the buffer INCLUDING this one
+                context_.input_side_buffer.consume(read_pos);
+                return {.ec = {}, .response = std::nullopt, .abort_output = true};
+            } else if (proc_ec == processing_signal::compression_start) {
+                //Everything after this SE is compressed, so move the rest of the input behind the inflater and keep scanning.
+                context_.input_side_buffer.consume(read_pos);
+                if constexpr (policy_traits<PC>::batch_subnegotiations) {
+                    if (!batch_.handlers.empty()) {
+                        //Inflating may compact the side buffer the batched handlers view, so `resume_scan` starts it after they run.
+                        return {.ec = proc_ec, .response = std::nullopt, .abort_output = false};
+                    }
+                }
+                if (auto start_ec = parent_stream_.start_input_decompression(); start_ec) {
+                    return {.ec = start_ec, .response = std::nullopt, .abort_output = false};
+                }
+                return scan_side_buffer();
+            } else if (proc_ec == processing_signal::tls_start) {
+                //Everything after this SE is TLS records, so move the rest of the input behind the TLS session.
+                context_.input_side_buffer.consume(read_pos);
+                if constexpr (policy_traits<PC>::batch_subnegotiations) {
+                    if (!batch_.handlers.empty()) {
+                        //Decrypting may compact the side buffer the batched handlers view, so `resume_scan` starts it after they run.
+                        return {.ec = proc_ec, .response = std::nullopt, .abort_output = false};
+                    }
+                }
+                return start_tls_input();
+            } else if (proc_ec) { //proc_ec will be cleared for non-terminal signals handled internally.
+                process_fsm_signals(proc_ec);
+            }
+
+            //Write a `forward`ed byte into the user's buffer.
+            if (forward && !context_.urgent_data_state) {
+                *write_it_++ = byte;
+            }
+            if (proc_ec) { //Terminal signal or error
+                //Consume the bytes currently processed from the buffer INCLUDING this one
+                context_.input_side_buffer.consume(read_pos);
+                return {.ec = proc_ec, .response = std::nullopt, .abort_output = false};
+            }
+            if (response) {
+                if (const auto* negotiation = std::get_if<typename fsm_type::negotiation_response>(&*response);
+                    negotiation && queue_negotiation_reply(*negotiation)) {
+                    continue; //Pipelined: sent with the pass's other replies once it ends.
+                }
+                //Consume the bytes currently processed from the buffer INCLUDING this one
+                context_.input_side_buffer.consume(read_pos);
+                return {.ec = {}, .response = std::move(response), .abort_output = false};
+            }
+        } //while
+
+        //SUCCESS: We either reached the end of the read data or filled the user's buffer.
+        context_.input_side_buffer.consume(read_pos);
+
+        //Since there is no current error, report any deferred error.
+        return {.ec = std::exchange(context_.deferred_transport_error, {}), .response = std::nullopt, .abort_output = false};
+    } //stream::input_processor::scan_side_buffer()
+
+    /**
+     * @internal
+     * Without `batch_subnegotiations`, simply calls `scan_side_buffer`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    auto stream<NLS, PC>::input_processor<MBS>::resume_scan() -> scan_result
+    {
+        if constexpr (policy_traits<PC>::batch_subnegotiations) {
+            if (batch_.stop) {
+                scan_result stop = std::move(*batch_.stop);
+                batch_.stop.reset();
+                if (stop.abort_output) {
+                    context_.deferred_processing_signal = std::exchange(stop.ec, {});
+                    return stop;
+                }
+                if (stop.ec == processing_signal::tls_start) {
+                    return start_tls_input();
+                }
+                if (stop.ec != processing_signal::compression_start) {
+                    return stop;
+                }
+                if (auto start_ec = parent_stream_.start_input_decompression(); start_ec) {
+                    return {.ec = start_ec, .response = std::nullopt, .abort_output = false};
+                }
+            }
+        }
+        return scan_side_buffer();
+    } //stream::input_processor::resume_scan()
+
+    /**
+     * @internal
+     * Calls `start_input_decryption`, then asks the caller for our FOLLOWS unless `context_.tls_follows_sent`, else rescans the decrypted bytes.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    auto stream<NLS, PC>::input_processor<MBS>::start_tls_input() -> scan_result
+    {
+        if (auto start_ec = parent_stream_.start_input_decryption(); start_ec) {
+            return {.ec = start_ec, .response = std::nullopt, .abort_output = false};
+        }
+        if (!context_.tls_follows_sent) {
+            return {.ec = {}, .response = std::nullopt, .abort_output = false, .tls_follows = true};
+        }
+        return scan_side_buffer();
+    } //stream::input_processor::start_tls_input()
+
+    /**
+     * @internal
+     * Appends each `subnegotiation_awaitable` response to `batch_.handlers` and rescans until a scan ends some other way.
+     * @remark The views those handlers hold stay valid: nothing reads into or compacts the side buffer until the batch completes, and `protocol_fsm` moves payloads held in its own buffer into the handlers' frames.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    bool stream<NLS, PC>::input_processor<MBS>::collect_subnegotiations(scan_result& scan)
+    {
+        while (scan.response && std::holds_alternative<awaitables::subnegotiation_awaitable>(*scan.response)) {
+            batch_.handlers.push_back(std::get<awaitables::subnegotiation_awaitable>(std::move(*scan.response)));
+            scan = scan_side_buffer();
+        }
+        if (batch_.handlers.empty()) {
+            return false;
+        }
+        if (scan.abort_output) {
+            scan.ec = std::exchange(context_.deferred_processing_signal, {}); //Reported after the Synch, which follows the batch
+        }
+        parent_stream_.statistics_.add(statistic::subnegotiation_batches);
+        batch_.stop = std::move(scan);
+        return true;
+    } //stream::input_processor::collect_subnegotiations(scan_result&)
+
+    /**
+     * @internal
+     * Awaits each handler in turn and appends its framed reply to the first reply's pooled buffer, returning the others to `context_.escape_buffers`.
+     * @remark Catches a failing handler's exception as an error code, so the replies framed before it stay in `replies` for the caller to send.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    asio::awaitable<std::tuple<std::error_code, std::vector<byte_t>>>
+        stream<NLS, PC>::input_processor<MBS>::run_subnegotiation_batch(
+            std::vector<awaitables::subnegotiation_awaitable> handlers
+        )
+    {
+        std::vector<byte_t> replies;
+        std::error_code handler_ec;
+        try {
+            for (auto& handler_awaitable : handlers) {
+                auto [opt, subneg_buffer] = co_await handler_awaitable;
+                if (subneg_buffer.empty()) {
+                    continue;
+                }
+                auto [frame_ec, framed_buffer] = parent_stream_.frame_subnegotiation(opt, subneg_buffer);
+                if (frame_ec) {
+                    handler_ec = frame_ec;
+                    break;
+                }
+                if (replies.empty()) {
+                    replies = std::move(framed_buffer);
+                } else {
+                    replies.insert(replies.end(), framed_buffer.begin(), framed_buffer.end());
+                    context_.escape_buffers.release(std::move(framed_buffer));
+                }
+            }
+        } catch (const std::system_error& se) {
+            handler_ec = se.code();
+        } catch (const std::bad_alloc&) {
+            handler_ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            handler_ec = make_error_code(error::internal_error);
+        }
+        co_return std::tuple{handler_ec, std::move(replies)};
+    } //stream::input_processor::run_subnegotiation_batch(std::vector<awaitables::subnegotiation_awaitable>)
+
+    /**
+     * @internal
+     * Runs the same `initializing` -> `reading` -> `processing` cycle as `operator()`, but with `next_layer().read_some` and the `do_blocking_response` overloads in place of their asynchronous counterparts.
+     * @remark Discards queued application data and sends the Synch for AO with the blocking `send_synch`; write errors are deferred by `process_write_error` exactly as on the asynchronous path.
+     * @remark Reads into `read_target()` and unwraps with `unwrap_input` while input is encrypted or compressed, as `handle_processor_state_initializing` and `handle_processor_state_reading` do.
+     * @remark Answers the peer's FOLLOWS with the blocking `start_tls`, and sends the records decrypting produced with `write_tls_records` before each read.
+     * @remark Under `lean_memory`, blocks on `lowest_layer().wait` before each read, mirroring `awaiting_input`.
+     * @remark Never arms `launch_wait_for_urgent_data`, whose receive would only complete if the stream's executor were run elsewhere; `check_urgent_mark` finds the Synch instead, as under `urgent_data_policy::at_mark`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    std::size_t stream<NLS, PC>::input_processor<MBS>::run_blocking(std::error_code& ec)
+    {
+        blocking_ = true;
+        for (;;) {
+            if (context_.input_side_buffer.size() == 0) {
+                if (context_.deferred_transport_error) {
+                    //Immediately propagate a deferred error without attempting the next read.
+                    ec = std::exchange(context_.deferred_transport_error, {});
+                    return 0;
+                }
+                if (auto unwrap_ec = parent_stream_.unwrap_input(); unwrap_ec) {
+                    ec = unwrap_ec;
+                    return 0;
+                }
+            }
+            if (context_.input_side_buffer.size() == 0) {
+                std::error_code read_ec;
+                if (auto records_ec = parent_stream_.write_tls_records(); records_ec) {
+                    ec = records_ec;
+                    return 0; //The peer cannot answer records it never received.
+                }
+                if constexpr (policy_traits<PC>::lean_memory) {
+                    //Hold no read buffer while blocked on an idle socket.
+                    parent_stream_.lowest_layer().wait(asio::socket_base::wait_read, read_ec);
+                    if (read_ec) {
+                        ec = read_ec;
+                        return 0;
+                    }
+                }
+                auto& read_target            = parent_stream_.read_target();
+                const std::size_t bytes_read = parent_stream_.next_layer().read_some(
+                    read_target.prepare(context_.read_tuner.next_read_size()), read_ec
+                );
+                read_target.commit(bytes_read);
+                context_.read_tuner.record_read(bytes_read);
+                parent_stream_.statistics_.add(statistic::bytes_received, bytes_read);
+                parent_stream_.check_urgent_mark(bytes_read);
+                if (auto unwrap_ec = parent_stream_.unwrap_input(); unwrap_ec && !read_ec) {
+                    read_ec = unwrap_ec;
+                }
+
+                if (context_.input_side_buffer.size() == 0) {
+                    if (!read_ec && (bytes_read > 0)) {
+                        continue; //Every encrypted or compressed byte read is still inside the TLS session or the inflater, so read again.
+                    }
+                    //If there is no data to process, we can complete, propagating any read error.
+                    ec = read_ec;
+                    return 0;
+                }
+                if (read_ec) {
+                    context_.deferred_transport_error = read_ec;
+                    parent_stream_.statistics_.add(statistic::deferred_errors);
+                }
+            }
+
+            user_buf_begin_ = asio::buffers_begin(buffers_);
+            user_buf_end_   = asio::buffers_end(buffers_);
+            write_it_       = user_buf_begin_;
+
+            std::error_code result_ec;
+            while (!(result_ec = std::exchange(context_.deferred_processing_signal, {}))) {
+                scan_result scan = resume_scan();
+                std::error_code write_ec;
+                if constexpr (policy_traits<PC>::batch_subnegotiations) {
+                    if (collect_subnegotiations(scan)) {
+                        write_replies_blocking();
+                        do_blocking_subnegotiation_batch(write_ec);
+                        if (write_ec) {
+                            process_write_error(write_ec);
+                        }
+                        continue; //Act on `batch_.stop` next.
+                    }
+                }
+                write_replies_blocking();
+                auto& [scan_ec, response, abort_output, tls_follows] = scan;
+                if (abort_output) {
+                    parent_stream_.output_processor_.discard_output();
+                    parent_stream_.send_synch(write_ec);
+                } else if (tls_follows) {
+                    parent_stream_.start_tls(write_ec);
+                } else if (response) {
+                    std::visit(
+                        [this, &write_ec](auto&& arg) { this->do_blocking_response(std::forward<decltype(arg)>(arg), write_ec); },
+                        *response
+                    );
+                } else {
+                    result_ec = scan_ec;
+                    break;
+                }
+                if (write_ec) {
+                    process_write_error(write_ec);
+                }
+            }
+
+            const std::size_t bytes_to_transfer = std::distance(user_buf_begin_, write_it_);
+            if (result_ec || (bytes_to_transfer != 0)) {
+                state_ = state::done;
+                ec     = result_ec;
+                return bytes_to_transfer;
+            }
+            //Nothing was written into the user's buffer; read again.
+        }
+    } //stream::input_processor::run_blocking(std::error_code&)
+
+    /**
+     * @internal
+     * Sets `state_` to `done` and calls `self.complete` with `ec` and `bytes_transferred`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::complete(Self& self, const std::error_code& ec, std::size_t bytes_transferred)
+    {
+        state_ = state::done;
+        self.complete(ec, bytes_transferred);
+    } //stream::input_processor::complete(Self&, const std::error_code&, std::size_t)
+
+    /**
+     * @internal
+     * Defers write errors for later reporting and logs multi-error pile-ups.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::process_write_error(std::error_code ec)
+    {
+        parent_stream_.defer_write_error(ec);
+    } //stream::input_processor::process_write_error(std::error_code)
+
+    /**
+     * @internal
+     * Appends IAC, the negotiation command, and the option in one range insert, which leaves `replies_` unchanged if it throws.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    bool stream<NLS, PC>::input_processor<MBS>::queue_negotiation_reply(
+        const typename fsm_type::negotiation_response& response
+    ) noexcept
+    {
+        const auto [dir, enable, opt] = response;
+        const std::array<byte_t, 3> reply{
+            std::to_underlying(telnet::command::iac),
+            std::to_underlying(fsm_type::make_negotiation_command(dir, enable)),
+            std::to_underlying(opt)
+        };
+        try {
+            if (replies_.capacity() == 0) {
+                replies_ = context_.escape_buffers.acquire(reply.size());
+            }
+            replies_.insert(replies_.end(), reply.begin(), reply.end());
+        } catch (const std::bad_alloc&) {
+            return false;
+        } catch (const std::length_error&) {
+            return false;
+        }
+        parent_stream_.statistics_.add(statistic::negotiations_answered);
+        return true;
+    } //stream::input_processor::queue_negotiation_reply(const negotiation_response&) noexcept
+
+    /**
+     * @internal
+     * Queues `replies_` via `async_write_temp_buffer` with a handler bound to the stream's executor that only defers a failure.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::send_replies()
+    {
+        if (replies_.empty()) {
+            return;
+        }
+        parent_stream_.async_write_temp_buffer(
+            std::exchange(replies_, {}),
+            asio::bind_executor(
+                parent_stream_.get_executor(),
+                [&parent = parent_stream_](const std::error_code& ec, std::size_t) {
+                    if (ec) {
+                        parent.defer_write_error(ec);
+                    }
+                }
+            )
+        );
+    } //stream::input_processor::send_replies()
+
+    /**
+     * @internal
+     * Writes `replies_` with `write_blocking` and returns the buffer to `context_.escape_buffers`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::write_replies_blocking()
+    {
+        if (replies_.empty()) {
+            return;
+        }
+        std::error_code write_ec;
+        parent_stream_.write_blocking(asio::buffer(replies_), write_ec);
+        context_.escape_buffers.release(std::exchange(replies_, {}));
+        if (write_ec) {
+            process_write_error(write_ec);
+        }
+    } //stream::input_processor::write_replies_blocking()
+
+    /*
+     * @internal
+     * Handles `processing_signal`s returned from `process_byte`.
+     * @remark Handles EC and EL internally if there is buffered output to edit; otherwise, signals caller.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::process_fsm_signals(std::error_code& signal_ec)
+    {
+        //Handle `processing_signal`s that modify the buffer directly.
+        if (signal_ec == processing_signal::carriage_return) {
+            //A previously discarded '\r' byte must be inserted into the user's buffer.
+            *write_it_++ = '\r';
+            signal_ec.clear(); //Further processing is clear to continue.
+        } else if ((signal_ec == processing_signal::erase_character) && (write_it_ != user_buf_begin_)) {
+            //If the user buffer has data, EC backs up the write position by one character.
+            //Otherwise, it propagates to the caller.
+            --write_it_;
+            signal_ec.clear(); //Further processing is clear to continue.
+        } else if ((signal_ec == processing_signal::erase_line) && (write_it_ != user_buf_begin_)) {
+            //If the user buffer has data, EL resets the write position to the beginning of the buffer.
+            //Otherwise, it propagates to the caller.
+            write_it_ = user_buf_begin_;
+            signal_ec.clear(); //Further processing is clear to continue.
+        } else if (signal_ec == processing_signal::data_mark) {
+            parent_stream_.statistics_.add(statistic::data_marks_received);
+            if constexpr (policy_traits<PC>::urgent_data == urgent_data_policy::at_mark) {
+                //The mark is checked before the DM is read, so a DM outside Synch mode ends a Synch whose data already passed.
+                if (context_.urgent_data_state) {
+                    context_.urgent_data_state.saw_data_mark();
+                }
+            } else {
+                //With no OOB wait armed, as on a blocking read, `check_urgent_mark` has already run, exactly as under `at_mark`.
+                if (context_.waiting_for_urgent_data.load(std::memory_order_relaxed) || context_.urgent_data_state) {
+                    context_.urgent_data_state.saw_data_mark();
+                }
+                if (!blocking_) {
+                    parent_stream_.launch_wait_for_urgent_data();
+                }
+            }
+            signal_ec.clear(); //Further processing is clear to continue.
+        }
+    } //stream::input_processor::process_fsm_signals(std::error_code&)
+
+    /**
+     * @internal
+     * Initiates an asynchronous write of a `negotiation_response` using `async_write_negotiation`.
+     * @see "net.telnet-stream.cppm" for interface, `:protocol_fsm` for `negotiation_response`, `:errors` for error codes, RFC 855 for negotiation
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::do_response(
+        typename stream::fsm_type::negotiation_response response,
+        Self&& self
+    )
+    {
+        parent_stream_.statistics_.add(statistic::negotiations_answered);
+        parent_stream_.async_write_negotiation(response, std::forward<Self>(self));
+    } //stream::input_processor::do_response(negotiation_response, Self&&)
+
+    /**
+     * @internal
+     * Copies the response into a pooled buffer and queues it using `async_write_temp_buffer`.
+     * @remark The queue owns the copy until the write completes, so the response outlives any batching delay.
+     * @see "net.telnet-stream.cppm" for interface, `:errors` for error codes, RFC 854 for IAC escaping
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::do_response(std::string response, Self&& self)
+    {
+        std::vector<byte_t> buffer;
+        try {
+            buffer = context_.escape_buffers.acquire(response.size());
+            buffer.assign(response.begin(), response.end());
+        } catch (const std::bad_alloc&) {
+            parent_stream_.async_report_error(make_error_code(std::errc::not_enough_memory), std::forward<Self>(self));
+            return;
+        }
+        parent_stream_.async_write_temp_buffer(std::move(buffer), std::forward<Self>(self));
+    } //stream::input_processor::do_response(std::string, Self&&)
+
+    /**
+     * @internal
+     * Spawns a coroutine to process a `subnegotiation_awaitable`, writing the result via `async_write_subnegotiation` if non-empty.
+     * @remark Uses `asio::co_spawn` to execute the awaitable, handling potential exceptions by throwing `std::system_error` with `telnet::error::internal_error` for non-system errors.
+     * @remark Binds `asio::recycling_allocator` to the completion so the spawn's bookkeeping reuses the thread's cached blocks, as Asio already does for the coroutine frames themselves.
+     * @see "net.telnet-stream.cppm" for interface, `:awaitables` for `subnegotiation_awaitable`, `:errors` for error codes, RFC 855 for subnegotiation
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::do_response(awaitables::subnegotiation_awaitable awaitable, Self&& self)
+    {
+        asio::co_spawn(
+            parent_stream_.get_executor(),
+            //NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines): Lambda closure lifetime is ensured by Asio. `this` lifetime is bound to parent operation which will not continue until the coroutine returns.
+            [this, handler_awaitable = std::move(awaitable)]() mutable -> asio::awaitable<std::size_t> {
+                try {
+                    auto [opt, subneg_buffer] = co_await handler_awaitable;
+                    if (!subneg_buffer.empty()) {
+                        co_return co_await parent_stream_.async_write_subnegotiation(opt, subneg_buffer, asio::use_awaitable);
+                    }
+                    co_return std::size_t{0};
+                } catch (const std::system_error& se) {
+                    throw;
+                } catch (...) {
+                    throw std::system_error(error::internal_error);
+                }
+            },
+            asio::bind_allocator(asio::recycling_allocator<void>(), std::forward<Self>(self))
+        );
+    } //stream::input_processor::do_response(awaitables::subnegotiation_awaitable, Self&&)
+
+    /**
+     * @internal
+     * Spawns one coroutine over `run_subnegotiation_batch` and queues its replies, if any, as a single `async_write_temp_buffer`, then throws any handler error as `std::system_error`.
+     * @remark Takes the handlers out of `batch_` first, leaving `batch_.stop` for `resume_scan` once the composed operation resumes.
+     * @remark Binds `asio::recycling_allocator` to the completion, as the per-message overload does.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self>
+    void stream<NLS, PC>::input_processor<MBS>::dispatch_subnegotiation_batch(Self&& self)
+    {
+        asio::co_spawn(
+            parent_stream_.get_executor(),
+            //NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines): Lambda closure lifetime is ensured by Asio. `this` lifetime is bound to parent operation which will not continue until the coroutine returns.
+            [this, handlers = std::exchange(batch_.handlers, {})]() mutable -> asio::awaitable<std::size_t> {
+                auto [handler_ec, replies] = co_await run_subnegotiation_batch(std::move(handlers));
+                std::size_t bytes_written = 0;
+                if (!replies.empty()) {
+                    bytes_written = co_await parent_stream_.async_write_temp_buffer(std::move(replies), asio::use_awaitable);
+                }
+                if (handler_ec) {
+                    throw std::system_error(handler_ec); //Only after the replies of the handlers before it are queued
+                }
+                co_return bytes_written;
+            },
+            asio::bind_allocator(asio::recycling_allocator<void>(), std::forward<Self>(self))
+        );
+    } //stream::input_processor::dispatch_subnegotiation_batch(Self&&)
+
+    /**
+     * @internal
+     * Spawns a coroutine to process a `tagged_awaitable`, optionally writing a `negotiation_response` via `async_write_negotiation`.
+     * @remark Uses `asio::co_spawn` to execute the awaitable, followed by an optional negotiation write, handling exceptions by throwing `std::system_error` with `telnet::error::internal_error` for non-system errors.
+     * @remark Binds `asio::recycling_allocator` to the completion, as the subnegotiation overload does.
+     * @note The FSM only produces this response when a handler is registered (see `protocol_fsm::handler_response`); handler-less negotiations arrive as a plain `negotiation_response`.
+     * @see "net.telnet-stream.cppm" for interface, `:awaitables` for `tagged_awaitable`, `:protocol_fsm` for `negotiation_response`, `:errors` for error codes, RFC 855 for negotiation
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Self, typename Tag, typename T, typename Awaitable>
+    void stream<NLS, PC>::input_processor<MBS>::do_response(
+        std::tuple<
+            awaitables::tagged_awaitable<Tag, T, Awaitable>,
+            std::optional<typename stream::fsm_type::negotiation_response>
+        > response,
+        Self&& self
+    )
+    {
+        auto [awaitable, negotiation] = std::move(response);
+        if (negotiation) {
+            parent_stream_.statistics_.add(statistic::negotiations_answered);
+        }
+        asio::co_spawn(
+            parent_stream_.get_executor(),
+            //NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines): Lambda closure lifetime is ensured by Asio. `this` lifetime is bound to parent operation which will not continue until the coroutine returns.
+            [this,
+             awaitable   = std::move(awaitable),
+             negotiation = std::move(negotiation)]() mutable -> asio::awaitable<std::size_t> {
+                try {
+                    std::size_t bytes_transferred = 0;
+                    if (negotiation) {
+                        bytes_transferred += co_await parent_stream_.async_write_negotiation(*negotiation, asio::use_awaitable);
+                    }
+                    co_await awaitable;
+                    co_return bytes_transferred;
+                } catch (const std::system_error& se) {
+                    throw;
+                } catch (...) {
+                    throw std::system_error(error::internal_error);
+                }
+            },
+            asio::bind_allocator(asio::recycling_allocator<void>(), std::forward<Self>(self))
+        );
+    } //stream::input_processor::do_response(tagged_awaitable<Tag, T, Awaitable>, Self&&)
+
+    /**
+     * @internal
+     * Writes a `negotiation_response` using the blocking `write_negotiation`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::do_blocking_response(
+        typename stream::fsm_type::negotiation_response response,
+        std::error_code& ec
+    )
+    {
+        parent_stream_.statistics_.add(statistic::negotiations_answered);
+        parent_stream_.write_negotiation(response, ec);
+    } //stream::input_processor::do_blocking_response(negotiation_response, std::error_code&)
+
+    /**
+     * @internal
+     * Writes the response directly from the string with `write_blocking`; no copy is needed because the write completes before returning.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::do_blocking_response(const std::string& response, std::error_code& ec)
+    {
+        parent_stream_.write_blocking(asio::buffer(response), ec);
+    } //stream::input_processor::do_blocking_response(const std::string&, std::error_code&)
+
+    /**
+     * @internal
+     * Runs the handler coroutine with `sync_await`, then writes the result with the blocking `write_subnegotiation` if non-empty.
+     * @remark Handler coroutines need an executor, so this is the one read-side step that still uses `sync_await`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::do_blocking_response(
+        awaitables::subnegotiation_awaitable awaitable,
+        std::error_code& ec
+    )
+    {
+        try {
+            asio::awaitable<std::tuple<option, std::vector<byte_t>>> handler_awaitable = std::move(awaitable);
+            auto [opt, subneg_buffer] = sync_await(std::move(handler_awaitable));
+            if (!subneg_buffer.empty()) {
+                parent_stream_.write_subnegotiation(opt, subneg_buffer, ec);
+            }
+        } catch (const std::system_error& se) {
+            ec = se.code();
+        } catch (const std::bad_alloc&) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::input_processor::do_blocking_response(awaitables::subnegotiation_awaitable, std::error_code&)
+
+    /**
+     * @internal
+     * Runs `run_subnegotiation_batch` with one `sync_await`, then writes the replies with the blocking `write_blocking` and returns their buffer to `context_.escape_buffers`.
+     * @remark Reports a handler error only after those replies are written, unless the write itself failed.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    void stream<NLS, PC>::input_processor<MBS>::do_blocking_subnegotiation_batch(std::error_code& ec)
+    {
+        try {
+            auto [handler_ec, replies] = sync_await(run_subnegotiation_batch(std::exchange(batch_.handlers, {})));
+            if (!replies.empty()) {
+                parent_stream_.write_blocking(asio::buffer(replies), ec);
+                context_.escape_buffers.release(std::move(replies));
+            }
+            if (!ec) {
+                ec = handler_ec;
+            }
+        } catch (const std::system_error& se) {
+            ec = se.code();
+        } catch (const std::bad_alloc&) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::input_processor::do_blocking_subnegotiation_batch(std::error_code&)
+
+    /**
+     * @internal
+     * Writes the optional `negotiation_response` with the blocking `write_negotiation`, then runs the handler coroutine with `sync_await`.
+     * @remark Keeps the order of the asynchronous overload: the negotiation goes out before the handler runs.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBS>
+    template<typename Tag, typename T, typename Awaitable>
+    void stream<NLS, PC>::input_processor<MBS>::do_blocking_response(
+        std::tuple<
+            awaitables::tagged_awaitable<Tag, T, Awaitable>,
+            std::optional<typename stream::fsm_type::negotiation_response>
+        > response,
+        std::error_code& ec
+    )
+    {
+        auto [awaitable, negotiation] = std::move(response);
+        if (negotiation) {
+            parent_stream_.statistics_.add(statistic::negotiations_answered);
+            parent_stream_.write_negotiation(*negotiation, ec);
+        }
+        try {
+            Awaitable handler_awaitable = std::move(awaitable);
+            sync_await(std::move(handler_awaitable));
+        } catch (const std::system_error& se) {
+            ec = se.code();
+        } catch (const std::bad_alloc&) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::input_processor::do_blocking_response(tagged_awaitable<Tag, T, Awaitable>, std::error_code&)
+
+    /**
+     * @internal
+     * Starts the batch on first entry; afterward absorbs each `async_read_some` result and completes once `absorb` says so.
+     * @remark Each read is its own `input_processor` pass, so option negotiation and other commands are answered between frames exactly as for `async_read_some`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<processing_signal Delimiter>
+    template<typename Self>
+    void stream<NLS, PC>::frame_reader<Delimiter>::operator()(Self& self, std::error_code ec_in, std::size_t bytes_transferred)
+    {
+        if (!started_) {
+            started_ = true;
+            batch_.start_batch();
+        } else if (absorb(ec_in, bytes_transferred)) {
+            self.complete(ec_in, bytes_read_);
+            return;
+        }
+
+        std::error_code buffer_ec;
+        const asio::mutable_buffer buffer = read_buffer(buffer_ec);
+        if (buffer_ec) {
+            self.complete(buffer_ec, bytes_read_);
+            return;
+        }
+        parent_stream_.async_read_some(buffer, std::move(self));
+    } //stream::frame_reader::operator()(Self&, std::error_code, std::size_t)
+
+    /**
+     * @internal
+     * Loops `read_buffer`, the `noexcept` `read_some`, and `absorb` until `absorb` reports the read done.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<processing_signal Delimiter>
+    std::size_t stream<NLS, PC>::frame_reader<Delimiter>::run_blocking(std::error_code& ec)
+    {
+        batch_.start_batch();
+        while (true) {
+            const asio::mutable_buffer buffer = read_buffer(ec);
+            if (ec) {
+                return bytes_read_;
+            }
+            const std::size_t bytes_read = parent_stream_.read_some(buffer, ec);
+            if (absorb(ec, bytes_read)) {
+                return bytes_read_;
+            }
+        }
+    } //stream::frame_reader::run_blocking(std::error_code&)
+
+    /**
+     * @internal
+     * Records the current size in `read_offset_` and appends up to `frame_read_chunk` bytes, fewer if the partial frame nears `max_frame_size()`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<processing_signal Delimiter>
+    asio::mutable_buffer stream<NLS, PC>::frame_reader<Delimiter>::read_buffer(std::error_code& ec)
+    {
+        const std::size_t partial_size = batch_.data_.size() - batch_.partial_begin_;
+        if (partial_size >= batch_.max_frame_size_) {
+            ec = make_error_code(std::errc::message_size);
+            return {};
+        }
+        read_offset_ = batch_.data_.size();
+        batch_.data_.resize(read_offset_ + std::min(frame_read_chunk, batch_.max_frame_size_ - partial_size));
+        return asio::buffer(batch_.data_) + read_offset_;
+    } //stream::frame_reader::read_buffer(std::error_code&)
+
+    /**
+     * @internal
+     * Trims the storage to the bytes read, then ends, edits, or keeps the partial frame per the signal in `ec`.
+     * @remark An EC or EL with no partial frame to edit still completes the read, as it would for `async_read_some`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<processing_signal Delimiter>
+    bool stream<NLS, PC>::frame_reader<Delimiter>::absorb(std::error_code& ec, std::size_t bytes_transferred)
+    {
+        auto& data = batch_.data_;
+        data.resize(read_offset_ + bytes_transferred);
+        bytes_read_ += bytes_transferred;
+
+        if (ec == Delimiter) {
+            const bool has_lf = (Delimiter == processing_signal::end_of_line) && (data.size() > batch_.partial_begin_)
+                             && (data.back() == static_cast<byte_t>('\n'));
+            batch_.end_frame(has_lf ? 1 : 0);
+            ec.clear();
+        } else if (ec == processing_signal::end_of_line) {
+            ec.clear(); //Line ends are data inside a record.
+        } else if ((ec == processing_signal::erase_character) && (data.size() > batch_.partial_begin_)) {
+            data.pop_back();
+            ec.clear();
+        } else if ((ec == processing_signal::erase_line) && (data.size() > batch_.partial_begin_)) {
+            data.resize(batch_.partial_begin_);
+            ec.clear();
+        }
+        if (ec) {
+            return true;
+        }
+
+        //Batch every frame already received, but never wait on the network once one is complete.
+        return !batch_.empty() && !parent_stream_.has_buffered_input();
+    } //stream::frame_reader::absorb(std::error_code&, std::size_t)
+
+    /**
+     * @internal
+     * Hands a `pending_write` holding `buffer` and `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<typename T>
+    void stream<NLS, PC>::output_processor::enqueue(std::vector<T>&& buffer, handler_type handler, bool droppable)
+    {
+        pending_write write;
+        if constexpr (std::same_as<T, byte_t>) {
+            write.bytes = std::move(buffer);
+        } else {
+            write.slices = std::move(buffer);
+        }
+        write.handler   = std::move(handler);
+        write.droppable = droppable;
+        push(std::move(write));
+    } //stream::output_processor::enqueue(std::vector<T>&&, handler_type, bool)
+
+    /**
+     * @internal
+     * Hands a droppable `pending_write` holding the `bytes` reference and `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_shared(std::shared_ptr<const std::vector<byte_t>> bytes, handler_type handler)
+    {
+        push(pending_write{{}, {}, std::move(handler), write_kind::data, std::move(bytes), 0, /*droppable=*/true});
+    } //stream::output_processor::enqueue_shared(std::shared_ptr<const std::vector<byte_t>>, handler_type)
+
+    /**
+     * @internal
+     * Hands a Synch `pending_write` holding only `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_synch(handler_type handler)
+    {
+        parent_stream_.statistics_.add(statistic::synchs_sent);
+        push(pending_write{{}, {}, std::move(handler), write_kind::synch});
+    } //stream::output_processor::enqueue_synch(handler_type)
+
+    /**
+     * @internal
+     * Hands a start `pending_write` holding `start_sequence` and `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_start_compression(std::vector<byte_t>&& start_sequence, handler_type handler)
+    {
+        push(pending_write{std::move(start_sequence), {}, std::move(handler), write_kind::start_compression});
+    } //stream::output_processor::enqueue_start_compression(std::vector<byte_t>&&, handler_type)
+
+    /**
+     * @internal
+     * Hands a stop `pending_write` holding only `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_stop_compression(handler_type handler)
+    {
+        push(pending_write{{}, {}, std::move(handler), write_kind::stop_compression});
+    } //stream::output_processor::enqueue_stop_compression(handler_type)
+
+    /**
+     * @internal
+     * Hands a start-TLS `pending_write` holding `follows_sequence` and `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_start_tls(std::vector<byte_t>&& follows_sequence, handler_type handler)
+    {
+        push(pending_write{std::move(follows_sequence), {}, std::move(handler), write_kind::start_tls});
+    } //stream::output_processor::enqueue_start_tls(std::vector<byte_t>&&, handler_type)
+
+    /**
+     * @internal
+     * Hands a stop-TLS `pending_write` holding only `handler` to `push`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::enqueue_stop_tls(handler_type handler)
+    {
+        push(pending_write{{}, {}, std::move(handler), write_kind::stop_tls});
+    } //stream::output_processor::enqueue_stop_tls(handler_type)
+
+    /**
+     * @internal
+     * Clamps `low_water` to `high_water`, then lets `relieve_congestion` end any congestion the new marks or policy no longer support.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::set_limits(std::size_t high_water, std::size_t low_water, slow_consumer_policy policy)
+    {
+        high_water_ = high_water;
+        low_water_  = std::min(low_water, high_water);
+        policy_     = policy;
+        relieve_congestion();
+    } //stream::output_processor::set_limits(std::size_t, std::size_t, slow_consumer_policy)
+
+    /**
+     * @internal
+     * Drops every droppable queued write, then lets `relieve_congestion` end any congestion the drop cleared.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::discard_output()
+    {
+        drop_pending(0);
+        relieve_congestion();
+    } //stream::output_processor::discard_output()
+
+    /**
+     * @internal
+     * Fixes `write.depth`, adds it to `depth_`, and appends `write` to `pending_`; a crossing of the high-water mark then counts once and applies `policy_`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::push(pending_write&& write)
+    {
+        write.depth = write_size(write);
+        depth_ += write.depth;
+        pending_.push_back(std::move(write));
+
+        if ((policy_ != slow_consumer_policy::unbounded) && (depth_ > high_water_)) {
+            if (!std::exchange(congested_, true)) {
+                parent_stream_.statistics_.add(statistic::high_water_crossings);
+            }
+            if (policy_ == slow_consumer_policy::drop_oldest) {
+                drop_pending(low_water_);
+                relieve_congestion();
+            } else if (policy_ == slow_consumer_policy::disconnect) {
+                disconnect();
+                return;
+            } //`block` holds completions in `complete_batch` instead.
+        }
+        schedule_flush();
+    } //stream::output_processor::push(pending_write&&)
+
+    /**
+     * @internal
+     * Erases dropped writes from `pending_` in place, so the survivors keep their order.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::drop_pending(std::size_t target)
+    {
+        std::size_t dropped = 0;
+        for (auto it = pending_.begin(); (it != pending_.end()) && (depth_ > target);) {
+            if (!it->droppable) {
+                ++it;
+                continue;
+            }
+            depth_ -= it->depth;
+            dropped += it->depth;
+            release_buffer(*it);
+            post_completion(std::move(it->handler), make_error_code(error::output_dropped), 0);
+            it = pending_.erase(it);
+        }
+        parent_stream_.statistics_.add(statistic::output_bytes_dropped, dropped);
+    } //stream::output_processor::drop_pending(std::size_t)
+
+    /**
+     * @internal
+     * Takes `pending_` and `held_` before posting their handlers, so any write those handlers start finds an empty queue and fails on the closed socket.
+     * @remark The in-flight batch keeps its share of `depth_` until `complete_batch` sees it aborted by the close.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::disconnect()
+    {
+        const std::error_code ec = make_error_code(error::slow_consumer);
+        log_traits<PC>::template log<log_level::warning>(
+            ec,
+            "Queued output exceeded {} bytes; disconnecting the slow consumer",
+            high_water_
+        );
 
-                //Since there is no current error, swap in any deferred error to report it.
-                std::swap(context_.deferred_transport_error, result_ec);
-            } //if (!result_ec) late check
-        } //if (!result_ec) early check
+        auto failed = std::exchange(pending_, {});
+        auto held   = std::exchange(held_, {});
+        for (auto& write : failed) {
+            depth_ -= write.depth;
+            release_buffer(write);
+            post_completion(std::move(write.handler), ec, 0);
+        }
+        for (auto& completion : held) {
+            post_completion(std::move(completion.handler), ec, completion.bytes);
+        }
+        congested_ = (depth_ > low_water_);
 
-        bytes_to_transfer = std::distance(user_buf_begin_, write_it_);
-        context_.input_side_buffer.consume(bytes_consumed);
+        parent_stream_.defer_write_error(ec);
+        std::error_code ignored;
+        parent_stream_.lowest_layer().close(ignored);
+    } //stream::output_processor::disconnect()
 
-        if (!result_ec && (bytes_to_transfer == 0)) {
-            //Re-initialize the processor for another underlying read if we haven't written into the user's buffer.
-            return handle_processor_state_initializing(self);
+    /**
+     * @internal
+     * Posts rather than dispatches, since `push` may call it inside the initiating function of a write.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::relieve_congestion()
+    {
+        if (!congested_ || ((policy_ != slow_consumer_policy::unbounded) && (depth_ > low_water_))) {
+            return;
         }
-
-        complete(self, result_ec, bytes_to_transfer);
-    } //stream::input_processor::handle_processor_state_processing(Self&, std::error_code)
+        congested_ = false;
+        for (auto& completion : std::exchange(held_, {})) {
+            post_completion(std::move(completion.handler), completion.ec, completion.bytes);
+        }
+    } //stream::output_processor::relieve_congestion()
 
     /**
      * @internal
-     * Sets `state_` to `done` and calls `self.complete` with `ec` and `bytes_transferred`.
+     * Reads the handler's associated executor before moving it, defaulting to the stream's, so a plain lambda never runs on `asio::system_executor`'s pool concurrently with the stream.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::complete(Self& self, const std::error_code& ec, std::size_t bytes_transferred)
+    void stream<NLS, PC>::output_processor::post_completion(handler_type&& handler, const std::error_code& ec, std::size_t bytes)
     {
-        state_ = state::done;
-        self.complete(ec, bytes_transferred);
-    } //stream::input_processor::complete(Self&, const std::error_code&, std::size_t)
+        auto executor = asio::get_associated_executor(handler, parent_stream_.get_executor());
+        asio::post(executor, asio::append(std::move(handler), ec, bytes));
+    } //stream::output_processor::post_completion(handler_type&&, const std::error_code&, std::size_t)
 
     /**
      * @internal
-     * Defers write errors for later reporting and logs multi-error pile-ups.
+     * Returns owned bytes to `context_.escape_buffers`, a slice list to `context_.gather_slices`, and drops a shared reference.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    void stream<NLS, PC>::input_processor<MBS>::process_write_error(std::error_code ec)
+    void stream<NLS, PC>::output_processor::release_buffer(pending_write& write) noexcept
     {
-        if (context_.deferred_transport_error) {
-            //We have a new write error on top of a previously deferred error.
-            //Log it and attempt to continue processing the buffered byte stream.
-            fsm_type::protocol_config_type::log_error(
-                ec,
-                "Error writing Telnet response with error {} previously deferred " "for reporting after processing the buffered byte stream.",
-                context_.deferred_transport_error
-            );
+        if ((write.kind == write_kind::synch) || (write.kind == write_kind::stop_compression) || (write.kind == write_kind::stop_tls)) {
+            //These hold no buffer; pooling the empty vector would only displace a reusable buffer.
+        } else if (write.shared) {
+            write.shared.reset(); //Other streams may still be writing the same bytes.
+        } else if (write.slices.empty()) {
+            parent_stream_.context_.escape_buffers.release(std::move(write.bytes));
         } else {
-            //Defer the write error.
-            context_.deferred_transport_error = ec;
+            parent_stream_.context_.gather_slices.release(std::move(write.slices));
         }
-    } //stream::input_processor::process_write_error(std::error_code)
+    } //stream::output_processor::release_buffer(pending_write&) noexcept
 
-    /*
+    /**
      * @internal
-     * Handles `processing_signal`s returned from `process_byte`.
-     * @remark Handles EC and EL internally if there is buffered output to edit; otherwise, signals caller.
+     * Decrements `cork_depth_`, ignoring unbalanced calls, and calls `schedule_flush` once it reaches zero.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    void stream<NLS, PC>::input_processor<MBS>::process_fsm_signals(std::error_code& signal_ec)
+    void stream<NLS, PC>::output_processor::uncork()
     {
-        //Handle `processing_signal`s that modify the buffer directly.
-        if (signal_ec == processing_signal::carriage_return) {
-            //A previously discarded '\r' byte must be inserted into the user's buffer.
-            *write_it_++ = '\r';
-            signal_ec.clear(); //Further processing is clear to continue.
-        } else if ((signal_ec == processing_signal::erase_character) && (write_it_ != user_buf_begin_)) {
-            //If the user buffer has data, EC backs up the write position by one character.
-            //Otherwise, it propagates to the caller.
-            --write_it_;
-            signal_ec.clear(); //Further processing is clear to continue.
-        } else if ((signal_ec == processing_signal::erase_line) && (write_it_ != user_buf_begin_)) {
-            //If the user buffer has data, EL resets the write position to the beginning of the buffer.
-            //Otherwise, it propagates to the caller.
-            write_it_ = user_buf_begin_;
-            signal_ec.clear(); //Further processing is clear to continue.
-        } else if (signal_ec == processing_signal::data_mark) {
-            context_.urgent_data_state.saw_data_mark();
-            parent_stream_.launch_wait_for_urgent_data();
-            signal_ec.clear(); //Further processing is clear to continue.
+        if (cork_depth_ == 0) {
+            return;
         }
-    } //stream::input_processor::process_fsm_signal(std::error_code)
+        if (--cork_depth_ == 0) {
+            schedule_flush();
+        }
+    } //stream::output_processor::uncork()
 
     /**
      * @internal
-     * Initiates an asynchronous write of a `negotiation_response` using `async_write_negotiation`.
-     * @see "net.telnet-stream.cppm" for interface, `:protocol_fsm` for `negotiation_response`, `:errors` for error codes, RFC 855 for negotiation
+     * Posts `flush` to the parent stream's executor, so writes queued in the same executor turn join the batch.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::do_response(
-        typename stream::fsm_type::negotiation_response response,
-        Self&& self
-    )
+    void stream<NLS, PC>::output_processor::schedule_flush()
     {
-        parent_stream_.async_write_negotiation(response, std::forward<Self>(self));
-    } //stream::input_processor::do_response(negotiation_response, Self&&)
+        if (flush_scheduled_ || writing_ || is_corked() || !has_output()) {
+            return;
+        }
+        flush_scheduled_ = true;
+        asio::post(parent_stream_.get_executor(), [this]() {
+            flush_scheduled_ = false;
+            flush();
+        });
+    } //stream::output_processor::schedule_flush()
 
     /**
      * @internal
-     * Initiates an asynchronous write of raw data using `async_write_raw`.
-     * @remark Wraps the `std::string` in a `std::shared_ptr<std::string>` for lifetime management and forwards it to `async_write_raw`.
-     * @see "net.telnet-stream.cppm" for interface, `:errors` for error codes, RFC 854 for IAC escaping
+     * Moves writes from `pending_` to `in_flight_` while their slices fit in `max_gather_slices`, then writes `batch_slices_` with one `write_wire` (or `write_compressed_batch`).
+     * @remark `batch_slices_` is reused across batches; it stays untouched until `complete_batch` runs.
+     * @remark While encrypting, queued records go first and nothing else goes until the handshake completes; `decrypt_input` schedules the flush that releases them.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::do_response(std::string response, Self&& self)
+    void stream<NLS, PC>::output_processor::flush()
     {
-        static std::string resp = std::move(response);
-        parent_stream_.async_write_raw(asio::buffer(resp), std::forward<Self>(self));
-    } //stream::input_processor::do_response(std::string, Self&&)
+        if (writing_ || is_corked() || !has_output()) {
+            return;
+        }
+        if (is_encrypting()) {
+            if (parent_stream_.context_.tls.has_output()) {
+                write_tls_records();
+                return;
+            }
+            if (!parent_stream_.context_.tls.established()) {
+                return; //Held until the handshake completes.
+            }
+        }
+
+        const bool in_band    = sends_synch_in_band();
+        const auto runs_alone = [in_band](const pending_write& write) {
+            return (write.kind == write_kind::stop_compression) || (write.kind == write_kind::stop_tls)
+                || ((write.kind == write_kind::synch) && !in_band);
+        };
+
+        if (pending_.front().kind == write_kind::stop_compression) {
+            finish_compression();
+            return;
+        }
+        if (pending_.front().kind == write_kind::stop_tls) {
+            finish_tls();
+            return;
+        }
+        if ((pending_.front().kind == write_kind::synch) && !in_band) {
+            start_synch();
+            return;
+        }
+
+        batch_slices_.clear();
+        while (!pending_.empty()) {
+            auto& next = pending_.front();
+            if (runs_alone(next)) {
+                break;
+            }
+            const std::size_t needed  = next.slices.empty() ? 1 : next.slices.size();
+            const bool batch_is_empty = in_flight_.empty();
+            if (!batch_is_empty && (batch_slices_.size() + needed) > max_gather_slices) {
+                break;
+            }
+            if (next.kind == write_kind::synch) {
+                //Compressed or encrypted output carries the Synch in-band; an urgent byte would land inside the zlib stream or a record.
+                batch_slices_.push_back(asio::buffer(synch_suffix));
+            } else if (next.shared) {
+                batch_slices_.push_back(asio::buffer(*next.shared));
+            } else if (next.slices.empty()) {
+                batch_slices_.push_back(asio::buffer(next.bytes));
+            } else {
+                batch_slices_.insert(batch_slices_.end(), next.slices.begin(), next.slices.end());
+            }
+            const bool ends_batch = (next.kind == write_kind::start_compression) || (next.kind == write_kind::start_tls);
+            in_flight_.push_back(std::move(next));
+            pending_.pop_front();
+            if (ends_batch) {
+                break; //Writes after the start sequence must wait for the deflater or the TLS session.
+            }
+        }
+
+        writing_ = true;
+        if (is_compressing()) {
+            write_compressed_batch();
+            return;
+        }
+        write_wire(std::span<const asio::const_buffer>(batch_slices_), [this](const std::error_code& ec, std::size_t bytes_written) {
+            complete_batch(ec, bytes_written);
+        });
+    } //stream::output_processor::flush()
 
     /**
      * @internal
-     * Spawns a coroutine to process a `subnegotiation_awaitable`, writing the result via `async_write_subnegotiation` if non-empty.
-     * @remark Uses `asio::co_spawn` to execute the awaitable, handling potential exceptions by throwing `std::system_error` with `telnet::error::internal_error` for non-system errors.
-     * @see "net.telnet-stream.cppm" for interface, `:awaitables` for `subnegotiation_awaitable`, `:errors` for error codes, RFC 855 for subnegotiation
+     * Writes the session's queued records from `sealed_batch_` with one `asio::async_write`, completing an empty batch.
+     * @remark `complete_batch` with nothing in flight only clears `writing_` and schedules the next flush.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self>
-    void stream<NLS, PC>::input_processor<MBS>::do_response(awaitables::subnegotiation_awaitable awaitable, Self&& self)
+    void stream<NLS, PC>::output_processor::write_tls_records()
     {
-        asio::co_spawn(
-            parent_stream_.get_executor(),
-            //NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines): Lambda closure lifetime is ensured by Asio. `this` lifetime is bound to parent operation which will not continue until the coroutine returns.
-            [this, handler_awaitable = std::move(awaitable)]() mutable -> asio::awaitable<std::size_t> {
-                try {
-                    auto [opt, subneg_buffer] = co_await handler_awaitable;
-                    if (!subneg_buffer.empty()) {
-                        co_return co_await parent_stream_.async_write_subnegotiation(opt, subneg_buffer, asio::use_awaitable);
+        writing_ = true;
+        sealed_batch_.clear();
+        if (auto ec = parent_stream_.context_.tls.take_output(sealed_batch_); ec) {
+            log_traits<PC>::template log<log_level::error>(ec, "Failed to gather TLS records: {}", ec.message());
+            complete_batch(ec, 0);
+            return;
+        }
+        asio::async_write(
+            parent_stream_.next_layer_,
+            asio::buffer(sealed_batch_),
+            asio::bind_executor(
+                parent_stream_.get_executor(),
+                [this](const std::error_code& ec, std::size_t record_bytes) {
+                    parent_stream_.statistics_.add(statistic::bytes_sent, record_bytes);
+                    if (ec) {
+                        log_traits<PC>::template log<log_level::error>(ec, "Failed to write TLS records: {}", ec.message());
                     }
-                    co_return std::size_t{0};
-                } catch (const std::system_error& se) {
-                    throw;
-                } catch (...) {
-                    throw std::system_error(error::internal_error);
+                    complete_batch(ec, 0);
                 }
-            },
-            std::forward<Self>(self)
+            )
         );
-    } //stream::input_processor::do_response(awaitables::subnegotiation_awaitable, Self&&)
+    } //stream::output_processor::write_tls_records()
 
     /**
      * @internal
-     * Spawns a coroutine to process a `tagged_awaitable`, optionally writing a `negotiation_response` via `async_write_negotiation`.
-     * @remark Uses `asio::co_spawn` to execute the awaitable, followed by an optional negotiation write, handling exceptions by throwing `std::system_error` with `telnet::error::internal_error` for non-system errors.
-     * @see "net.telnet-stream.cppm" for interface, `:awaitables` for `tagged_awaitable`, `:protocol_fsm` for `negotiation_response`, `:errors` for error codes, RFC 855 for negotiation
+     * Calls `asio::async_write` on `buffers` directly unless encrypting; otherwise seals them into `sealed_batch_` first.
+     * @remark `on_written` captures at most `this` and a byte count, so the composed handler still fits Asio's recycled handler memory.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBS>
-    template<typename Self, typename Tag, typename T, typename Awaitable>
-    void stream<NLS, PC>::input_processor<MBS>::do_response(
-        std::tuple<
-            awaitables::tagged_awaitable<Tag, T, Awaitable>,
-            std::optional<typename stream::fsm_type::negotiation_response>
-        > response,
-        Self&& self
-    )
+    template<ConstBufferSequence Buffers, typename Handler>
+    void stream<NLS, PC>::output_processor::write_wire(const Buffers& buffers, Handler on_written)
     {
-        auto [awaitable, negotiation] = std::move(response);
-        asio::co_spawn(
-            parent_stream_.get_executor(),
-            //NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines): Lambda closure lifetime is ensured by Asio. `this` lifetime is bound to parent operation which will not continue until the coroutine returns.
-            [this,
-             awaitable   = std::move(awaitable),
-             negotiation = std::move(negotiation)]() mutable -> asio::awaitable<std::size_t> {
-                try {
-                    std::size_t bytes_transferred = 0;
-                    if (negotiation) {
-                        bytes_transferred += co_await parent_stream_.async_write_negotiation(*negotiation, asio::use_awaitable);
+        if (!is_encrypting()) {
+            asio::async_write(
+                parent_stream_.next_layer_,
+                buffers,
+                asio::bind_executor(
+                    parent_stream_.get_executor(),
+                    [this, on_written = std::move(on_written)](const std::error_code& ec, std::size_t bytes_written) mutable {
+                        parent_stream_.statistics_.add(statistic::bytes_sent, bytes_written);
+                        on_written(ec, bytes_written);
                     }
-                    co_await awaitable;
-                    co_return bytes_transferred;
-                } catch (const std::system_error& se) {
-                    throw;
-                } catch (...) {
-                    throw std::system_error(error::internal_error);
+                )
+            );
+            return;
+        }
+
+        sealed_batch_.clear();
+        if (auto ec = parent_stream_.seal_output(buffers, sealed_batch_); ec) {
+            on_written(ec, 0);
+            return;
+        }
+        asio::async_write(
+            parent_stream_.next_layer_,
+            asio::buffer(sealed_batch_),
+            asio::bind_executor(
+                parent_stream_.get_executor(),
+                [this, on_written = std::move(on_written), plain_bytes = asio::buffer_size(buffers)](
+                    const std::error_code& ec,
+                    std::size_t record_bytes
+                ) mutable {
+                    parent_stream_.statistics_.add(statistic::bytes_sent, record_bytes);
+                    on_written(ec, ec ? 0 : plain_bytes);
                 }
-            },
-            std::forward<Self>(self)
+            )
         );
-    } //stream::input_processor::do_response(tagged_awaitable<Tag, T, Awaitable>, Self&&)
+    } //stream::output_processor::write_wire(const Buffers&, Handler)
+
+    /**
+     * @internal
+     * Sends `synch_urgent_prefix` out-of-band via `send_synch_prefix`; `continue_synch` writes the rest.
+     * @remark The send goes to `lowest_layer()` because only the socket carries urgent data; it cannot overlap a batch because `writing_` is set.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::start_synch()
+    {
+        in_flight_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+
+        writing_ = true;
+        send_synch_prefix(0);
+    } //stream::output_processor::start_synch()
+
+    /**
+     * @internal
+     * Sends the unsent tail of `synch_urgent_prefix` with `message_out_of_band`, so the urgent pointer still marks the final NUL after a short send.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::send_synch_prefix(std::size_t sent)
+    {
+        parent_stream_.lowest_layer().async_send(
+            asio::buffer(synch_urgent_prefix) + sent,
+            lowest_layer_type::message_out_of_band,
+            asio::bind_executor(
+                parent_stream_.get_executor(),
+                [this, sent](const std::error_code& ec, std::size_t prefix_bytes) {
+                    parent_stream_.statistics_.add(statistic::bytes_sent, prefix_bytes);
+                    continue_synch(ec, sent + prefix_bytes);
+                }
+            )
+        );
+    } //stream::output_processor::send_synch_prefix(std::size_t)
+
+    /**
+     * @internal
+     * Resends the rest of the urgent prefix after a short send; once all of it is out, writes `synch_suffix` in-band and completes the Synch entry through `complete_batch` with the bytes of every step.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::continue_synch(const std::error_code& ec, std::size_t prefix_bytes)
+    {
+        if (ec) {
+            complete_batch(ec, prefix_bytes);
+            return;
+        }
+        if (prefix_bytes < synch_urgent_prefix.size()) {
+            send_synch_prefix(prefix_bytes);
+            return;
+        }
+        asio::async_write(
+            parent_stream_.next_layer_,
+            asio::buffer(synch_suffix),
+            asio::bind_executor(
+                parent_stream_.get_executor(),
+                [this, prefix_bytes](const std::error_code& ec, std::size_t suffix_bytes) {
+                    parent_stream_.statistics_.add(statistic::bytes_sent, suffix_bytes);
+                    complete_batch(ec, prefix_bytes + suffix_bytes);
+                }
+            )
+        );
+    } //stream::output_processor::continue_synch(const std::error_code&, std::size_t)
+
+    /**
+     * @internal
+     * Deflates each slice of `batch_slices_` into `compressed_batch_`, sync-flushes once, and writes the result in one `write_wire`.
+     * @remark Completes the batch at once with the compression error, if any; the handler captures only `this` and the batch's uncompressed size.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::write_compressed_batch()
+    {
+        auto& deflater = parent_stream_.context_.deflater;
+        compressed_batch_.clear();
+
+        std::error_code ec;
+        for (const auto& slice : batch_slices_) {
+            ec = deflater.compress({static_cast<const byte_t*>(slice.data()), slice.size()}, compressed_batch_);
+            if (ec) {
+                break;
+            }
+        }
+        if (!ec) {
+            ec = deflater.flush(compressed_batch_);
+        }
+        if (ec) {
+            complete_batch(ec, 0);
+            return;
+        }
+
+        std::size_t batch_bytes = 0;
+        for (const auto& write : in_flight_) {
+            batch_bytes += write_size(write);
+        }
+        write_wire(asio::const_buffer(asio::buffer(compressed_batch_)), [this, batch_bytes](const std::error_code& write_ec, std::size_t) {
+            complete_batch(write_ec, write_ec ? 0 : batch_bytes);
+        });
+    } //stream::output_processor::write_compressed_batch()
+
+    /**
+     * @internal
+     * Finishes `context_.deflater` into `compressed_batch_` and writes the trailer; the stop entry's handler always sees 0 bytes.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::finish_compression()
+    {
+        in_flight_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+
+        writing_ = true;
+        compressed_batch_.clear();
+        if (auto ec = parent_stream_.context_.deflater.finish(compressed_batch_); ec || compressed_batch_.empty()) {
+            complete_batch(ec, 0); //Failed, or output was not compressed.
+            return;
+        }
+        write_wire(asio::const_buffer(asio::buffer(compressed_batch_)), [this](const std::error_code& ec, std::size_t) {
+            complete_batch(ec, 0);
+        });
+    } //stream::output_processor::finish_compression()
+
+    /**
+     * @internal
+     * Queues close_notify with `tls_session::shutdown` and leaves the write to `write_tls_records`; the stop entry's handler always sees 0 bytes.
+     * @remark `flush` only gets here once earlier records are written and the handshake has completed, so the alert follows every earlier write.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::finish_tls()
+    {
+        in_flight_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+
+        if (auto ec = parent_stream_.context_.tls.shutdown(); ec || !parent_stream_.context_.tls.has_output()) {
+            if (ec) {
+                log_traits<PC>::template log<log_level::error>(ec, "Failed to shut down TLS: {}", ec.message());
+            }
+            writing_ = true;
+            complete_batch(ec, 0); //Failed, or the alert was already sent.
+            return;
+        }
+        write_tls_records();
+    } //stream::output_processor::finish_tls()
+
+    /**
+     * @internal
+     * Detaches `in_flight_`, returns each buffer to its pool, schedules the next flush, and then dispatches each handler with its own byte count.
+     * @remark Handlers run after `writing_` is cleared, so writes they initiate are queued for the next batch rather than lost.
+     * @remark Starts the deflater for a written start entry; the flush scheduled above is only posted, so it always sees the deflater running.
+     * @remark Starts output encryption for a written FOLLOWS entry and schedules another flush, since the records of a client's first handshake step did not exist when the first was checked.
+     * @remark Under `lean_memory`, calls `release_idle_memory` if the handlers left the queue idle.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::complete_batch(const std::error_code& ec, std::size_t bytes_written)
+    {
+        auto completed = std::exchange(in_flight_, {});
+        writing_       = false;
+        schedule_flush();
+
+        std::size_t remaining = bytes_written;
+        for (auto& write : completed) {
+            const std::size_t written = std::min(write_size(write), remaining);
+            remaining -= written;
+            std::error_code write_ec = ec;
+            if ((write.kind == write_kind::start_compression) && !ec) {
+                write_ec = parent_stream_.context_.deflater.start();
+            } else if ((write.kind == write_kind::start_tls) && !ec) {
+                write_ec = parent_stream_.start_output_encryption();
+                schedule_flush();
+            }
+            depth_ -= write.depth;
+            release_buffer(write);
+            if (congested_ && (policy_ == slow_consumer_policy::block) && (write.kind == write_kind::data)) {
+                held_.push_back(held_completion{std::move(write.handler), write_ec, written});
+                continue; //Released by `relieve_congestion` once the queue drains to the low-water mark.
+            }
+            asio::dispatch(asio::append(std::move(write.handler), write_ec, written));
+        }
+        relieve_congestion();
+
+        if constexpr (policy_traits<PC>::lean_memory) {
+            if (is_idle()) {
+                release_idle_memory();
+                return; //Let `completed` free its capacity too.
+            }
+        }
+
+        //`flush` only runs via `asio::post`, so `in_flight_` is still empty here; keep the capacity for the next batch.
+        completed.clear();
+        in_flight_ = std::move(completed);
+    } //stream::output_processor::complete_batch(const std::error_code&, std::size_t)
+
+    /**
+     * @internal
+     * Frees the batch vectors, the queue's storage, and both of `context_`'s output pools.
+     * @remark Only called once the queue is idle, when none of `batch_slices_`, `compressed_batch_`, or `sealed_batch_` backs a pending write.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::output_processor::release_idle_memory() noexcept
+    {
+        std::vector<asio::const_buffer>{}.swap(batch_slices_);
+        std::vector<byte_t>{}.swap(compressed_batch_);
+        std::vector<byte_t>{}.swap(sealed_batch_);
+        std::vector<held_completion>{}.swap(held_);
+        pending_.trim();
+        parent_stream_.context_.escape_buffers.trim();
+        parent_stream_.context_.gather_slices.trim();
+    } //stream::output_processor::release_idle_memory()
+
+    /**
+     * @internal
+     * Sums the slice list, or counts the owned or shared bytes or the static Synch sequence.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::output_processor::write_size(const pending_write& write) const noexcept
+    {
+        switch (write.kind) {
+            case write_kind::synch:
+                return sends_synch_in_band() ? synch_suffix.size() : (synch_urgent_prefix.size() + synch_suffix.size());
+            case write_kind::stop_compression:
+            case write_kind::stop_tls:
+                return 0;
+            default:
+                if (write.shared) {
+                    return write.shared->size();
+                }
+                return write.slices.empty() ? write.bytes.size() : asio::buffer_size(write.slices);
+        }
+    } //stream::output_processor::write_size(const pending_write&) const
 } //namespace net::telnet
@@ -20,9 +20,10 @@
  * limitations under the License. @endparblock
  *
  * @brief Implementation of synchronous Telnet stream operations.
- * @remark Contains `read_some`, `write_some`, `write_raw`, `write_command`, `write_negotiation`, `write_subnegotiation`, `send_synch`, `request_option`, and `disable_option`, wrapping asynchronous counterparts.
+ * @remark Contains `read_some`, `read_line`, `read_record`, `write_some`, `write_gather`, `write_raw`, `write_broadcast`, `write_command`, `write_negotiation`, `write_subnegotiation`, `send_synch`, `start_compression`, `stop_compression`, `start_tls`, `start_implicit_tls`, `stop_tls`, `snapshot`, `restore`, `request_option`, and `disable_option`.
+ * @remark The `noexcept` overloads drive `protocol_fsm` and `next_layer_`'s blocking `read_some`/`write` directly on the calling thread; the throwing overloads wrap them.
  *
- * @note Synchronous I/O operations incur overhead from `sync_await`, which creates a new `io_context` and thread per call, and scale poorly compared to asynchronous methods. However, this overhead is minimal compared to blocking network I/O latency.
+ * @note `sync_await` (a temporary `io_context` run on the calling thread) remains only for running registered handler coroutines and for queuing behind outstanding asynchronous writes; `check_queued_wait` refuses the latter on the stream's own executor thread.
  * @see "net.telnet-stream.cppm" for interface, RFC 854 for Telnet protocol, RFC 855 for option negotiation, `:types` for `telnet::command`, `:options` for `option`, `:errors` for error codes, `:protocol_fsm` for `ProtocolFSM`
  */
 
@@ -32,13 +33,17 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module implementation unit
 module net.telnet;
 
-import std; //NOLINT For std::size_t, std::system_error
+import std; //NOLINT For std::size_t, std::system_error, std::array, std::visit
 
 import :types;        ///< @see "net.telnet-types.cppm" for `telnet::command`
 import :errors;       ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
 import :concepts;     ///< @see "net.telnet-concepts.cppm" for `telnet::concepts::LayerableSocketStream`
 import :options;      ///< @see "net.telnet-options.cppm" for `option`
 import :protocol_fsm; ///< @see "net.telnet-protocol_fsm.cppm" for `ProtocolFSM`
+import :compression;  ///< @see "net.telnet-compression.cppm" for `deflate_stream`
+import :statistics;   ///< @see "net.telnet-statistics.cppm" for `statistic`
+import :broadcast;    ///< @see "net.telnet-broadcast.cppm" for `broadcast_message`
+import :tls;          ///< @see "net.telnet-tls.cppm" for `tls_session`
 
 import :stream; ///< @see "net.telnet-stream.cppm" for the partition being implemented.
 
@@ -46,163 +51,300 @@ import :stream; ///< @see "net.telnet-stream.cppm" for the partition being imple
 
 namespace net::telnet {
     //=========================================================================================================
-    //Synchronous throwing wrappers use `sync_await` to execute their asynchronous counterparts.
+    //Synchronous `noexcept` implementations block the calling thread on `next_layer_`; no `io_context` or thread is created.
     //=========================================================================================================
 
     /**
      * @internal
-     * Wraps awaitable `async_request_option` in `sync_await`, forwarding the option and direction.
-     * @see `async_request_option` in "net.telnet-stream-async-impl.cpp".
+     * Calls `fsm_.request_option` and, if it produces a response, writes it with the blocking `write_negotiation`.
+     * @see `async_request_option` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::request_option(option::id_num opt, negotiation_direction direction)
+    std::size_t stream<NLS, PC>::request_option(option::id_num opt, negotiation_direction direction, std::error_code& ec) noexcept
     {
-        auto [ec, bytes] = sync_await(async_request_option(opt, direction, asio::use_awaitable));
-        if (ec) {
-            throw std::system_error(ec);
+        try {
+            auto [request_ec, response] = fsm_.request_option(opt, direction);
+            ec = request_ec;
+            if (ec || !response) {
+                return 0;
+            }
+            return write_negotiation(*response, ec);
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
         }
-        return bytes;
-    } //stream::request_option(option::id_num, negotiation_direction)
+    } //stream::request_option(option::id_num, negotiation_direction, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_disable_option` in `sync_await`, forwarding the option and direction.
-     * @see `async_disable_option` in "net.telnet-stream-async-impl.cpp".
+     * Calls `fsm_.disable_option`, writes any response with the blocking `write_negotiation`, then runs any disablement handler with `sync_await`.
+     * @see `async_disable_option` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::disable_option(option::id_num opt, negotiation_direction direction)
+    std::size_t stream<NLS, PC>::disable_option(option::id_num opt, negotiation_direction direction, std::error_code& ec) noexcept
     {
-        auto [ec, bytes] = sync_await(async_disable_option(opt, direction, asio::use_awaitable));
-        if (ec) {
-            throw std::system_error(ec);
+        try {
+            auto [disable_ec, response, awaitable] = fsm_.disable_option(opt, direction);
+            ec = disable_ec;
+            if (ec) {
+                return 0;
+            }
+            std::size_t bytes_transferred = 0;
+            if (response) {
+                bytes_transferred = write_negotiation(*response, ec);
+                if (ec) {
+                    return bytes_transferred;
+                }
+            }
+            if (awaitable) {
+                asio::awaitable<void> handler_awaitable = std::move(*awaitable);
+                sync_await(std::move(handler_awaitable));
+            }
+            return bytes_transferred;
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
         }
-        return bytes;
-    } //stream::disable_option(option::id_num, negotiation_direction)
+    } //stream::disable_option(option::id_num, negotiation_direction, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_read_some` in `sync_await` with perfect forwarding of the buffer sequence.
-     * @see `async_read_some` in "net.telnet-stream-async-impl.cpp".
+     * Runs an `input_processor` over `buffers` with `run_blocking`, which reads from `next_layer_` with its blocking `read_some`.
+     * @see `input_processor::run_blocking` in "net.telnet-stream-impl.cpp", `async_read_some` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
     template<MutableBufferSequence MBufSeq>
-    std::size_t stream<NLS, PC>::read_some(MBufSeq&& buffers)
+    std::size_t stream<NLS, PC>::read_some(MBufSeq&& buffers, std::error_code& ec) noexcept
     {
-        return sync_await(async_read_some(std::forward<MBufSeq>(buffers), asio::use_awaitable));
-    } //stream::read_some(MBufSeq&&)
+        try {
+            ec.clear();
+            using buffers_type = std::remove_cvref_t<MBufSeq>;
+            return input_processor<buffers_type>(*this, fsm_, context_, buffers_type(std::forward<MBufSeq>(buffers)))
+                .run_blocking(ec);
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
+        }
+    } //stream::read_some(MBufSeq&&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_write_some` in `sync_await`, forwarding the buffer sequence.
-     * @see `async_write_some` in "net.telnet-stream-async-impl.cpp".
+     * Runs a `frame_reader<processing_signal::end_of_line>` over `lines` with `run_blocking`.
+     * @see `async_read_line` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<ConstBufferSequence CBufSeq>
-    std::size_t stream<NLS, PC>::write_some(const CBufSeq& data)
+    std::size_t stream<NLS, PC>::read_line(frame_batch& lines, std::error_code& ec) noexcept
     {
-        return sync_await(async_write_some(data, asio::use_awaitable));
-    } //stream::write_some(const CBufSeq&)
+        try {
+            ec.clear();
+            return frame_reader<processing_signal::end_of_line>(*this, lines).run_blocking(ec);
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
+        }
+    } //stream::read_line(frame_batch&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_write_raw` in `sync_await`, forwarding the buffer sequence.
-     * @see `async_write_raw` in "net.telnet-stream-async-impl.cpp".
+     * Runs a `frame_reader<processing_signal::end_of_record>` over `records` with `run_blocking`.
+     * @see `async_read_record` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<ConstBufferSequence CBufSeq>
-    std::size_t stream<NLS, PC>::write_raw(const CBufSeq& data)
+    std::size_t stream<NLS, PC>::read_record(frame_batch& records, std::error_code& ec) noexcept
     {
-        return sync_await(async_write_raw(data, asio::use_awaitable));
-    } //stream::write_raw(const CBufSeq&)
+        try {
+            ec.clear();
+            return frame_reader<processing_signal::end_of_record>(*this, records).run_blocking(ec);
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
+        }
+    } //stream::read_record(frame_batch&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_write_command` in `sync_await`, forwarding the command.
-     * @see `async_write_command` in "net.telnet-stream-async-impl.cpp".
+     * Gets the shared encoding with `broadcast_encoding` and writes it with `write_blocking`; the encoding stays with `message` for other streams.
+     * @see `async_write_broadcast` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::write_command(telnet::command cmd)
+    std::size_t stream<NLS, PC>::write_broadcast(const broadcast_message& message, std::error_code& ec) noexcept
     {
-        return sync_await(async_write_command(cmd, asio::use_awaitable));
-    } //stream::write_command(telnet::command)
+        auto [encoding_ec, escaped] = broadcast_encoding(message);
+        ec = encoding_ec;
+        if (ec) {
+            return 0;
+        }
+        return write_blocking(asio::buffer(*escaped), ec);
+    } //stream::write_broadcast(const broadcast_message&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Wraps awaitable `async_write_subnegotiation` in `sync_await`, forwarding the option and buffer.
-     * @see `async_write_subnegotiation` in "net.telnet-stream-async-impl.cpp".
+     * Wraps the `noexcept` overload, throwing `std::system_error` if it sets `ec`.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::write_subnegotiation(option opt, const std::vector<byte_t>& subnegotiation_buffer)
+    std::size_t stream<NLS, PC>::write_broadcast(const broadcast_message& message)
     {
-        return sync_await(async_write_subnegotiation(opt, subnegotiation_buffer, asio::use_awaitable));
-    } //stream::write_subnegotiation(option, const std::vector<byte_t>&)
+        std::error_code ec;
+        const std::size_t bytes = write_broadcast(message, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_broadcast(const broadcast_message&)
 
     /**
      * @internal
-     * Wraps awaitable `async_send_synch` in `sync_await`, forwarding the command and option.
-     * @see `async_send_synch` in "net.telnet-stream-async-impl.cpp".
+     * Escapes `data` into a pooled buffer with `escape_telnet_output`, writes it with `write_blocking`, and returns the buffer to `context_.escape_buffers`.
+     * @see `async_write_some` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::send_synch()
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_some(const CBufSeq& data, std::error_code& ec) noexcept
     {
-        return sync_await(async_send_synch(asio::use_awaitable));
-    } //stream::send_synch()
+        try {
+            auto [escape_ec, escaped_data] = escape_telnet_output(data);
+            ec = escape_ec;
+            if (ec) {
+                return 0;
+            }
+            const std::size_t bytes = write_blocking(asio::buffer(escaped_data), ec);
+            context_.escape_buffers.release(std::move(escaped_data));
+            return bytes;
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
+        }
+    } //stream::write_some(const CBufSeq&, std::error_code&) noexcept
 
-    //=========================================================================================================
-    //Synchronous `noexcept` wrappers call their throwing counterparts and convert exceptions to error codes.
-    //=========================================================================================================
+    /**
+     * @internal
+     * Builds a pooled slice list with `escape_telnet_output`, writes it with `write_blocking`, and returns the list to `context_.gather_slices`.
+     * @remark Needs no `max_gather_slices` fallback; `asio::write` splits a long list across as many vectored writes as it takes.
+     * @see `async_write_gather` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_gather(const CBufSeq& data, std::error_code& ec) noexcept
+    {
+        try {
+            std::vector<asio::const_buffer> slices = context_.gather_slices.acquire(max_gather_slices);
+            ec                                     = std::get<0>(escape_telnet_output(slices, data));
+            std::size_t bytes                      = 0;
+            if (!ec) {
+                bytes = write_blocking(slices, ec);
+            }
+            context_.gather_slices.release(std::move(slices));
+            return bytes;
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return 0;
+        }
+    } //stream::write_gather(const CBufSeq&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `request_option`, catching exceptions to set `ec` to `std::system_error`’s code or `telnet::error::internal_error`.
-     * @see `request_option` for throwing version, `async_request_option` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Writes `data` unmodified with `write_blocking`.
+     * @see `async_write_raw` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t
-        stream<NLS, PC>::request_option(option::id_num opt, negotiation_direction direction, std::error_code& ec) noexcept
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_raw(const CBufSeq& data, std::error_code& ec) noexcept
     {
         try {
-            return request_option(opt, direction);
+            return write_blocking(data, ec);
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
         } catch (...) {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::request_option(option::id_num, negotiation_direction, std::error_code&) noexcept
+    } //stream::write_raw(const CBufSeq&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `disable_option`, catching exceptions to set `ec` to `std::system_error`’s code or `telnet::error::internal_error`.
-     * @see `disable_option` for throwing version, `async_disable_option` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Writes `{IAC, cmd}` from a stack buffer with `write_blocking`.
+     * @see `async_write_command` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t
-        stream<NLS, PC>::disable_option(option::id_num opt, negotiation_direction direction, std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::write_command(telnet::command cmd, std::error_code& ec) noexcept
     {
         try {
-            return disable_option(opt, direction);
+            const std::array<byte_t, 2> buf = {std::to_underlying(telnet::command::iac), std::to_underlying(cmd)};
+            return write_blocking(asio::buffer(buf), ec);
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return 0;
         } catch (...) {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::disable_option(option::id_num, negotiation_direction, std::error_code&) noexcept
+    } //stream::write_command(telnet::command, std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `read_some`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `read_some` for throwing version, `async_read_some` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Writes `{IAC, cmd, opt}` from a stack buffer with `write_blocking`.
+     * @see `async_write_negotiation` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<MutableBufferSequence MBufSeq>
-    std::size_t stream<NLS, PC>::read_some(MBufSeq&& buffers, std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::write_negotiation(typename fsm_type::negotiation_response response, std::error_code& ec) noexcept
     {
         try {
-            return read_some(std::forward<MBufSeq>(buffers));
+            auto [dir, enable, opt]         = response;
+            const std::array<byte_t, 3> buf = {
+                std::to_underlying(telnet::command::iac),
+                std::to_underlying(fsm_type::make_negotiation_command(dir, enable)),
+                std::to_underlying(opt)
+            };
+            return write_blocking(asio::buffer(buf), ec);
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -213,19 +355,29 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::read_some(MBufSeq&&, std::error_code&) noexcept
+    } //stream::write_negotiation(fsm_type::negotiation_response, std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `write_some`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `write_some` for throwing version, `async_write_some` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Frames the subnegotiation with `frame_subnegotiation`, writes it with `write_blocking`, and returns the buffer to `context_.escape_buffers`.
+     * @see `async_write_subnegotiation` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<ConstBufferSequence CBufSeq>
-    std::size_t stream<NLS, PC>::write_some(const CBufSeq& data, std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::write_subnegotiation(
+        option opt,
+        const std::vector<byte_t>& subnegotiation_buffer,
+        std::error_code& ec
+    ) noexcept
     {
         try {
-            return write_some(data);
+            auto [frame_ec, framed_buffer] = frame_subnegotiation(opt, subnegotiation_buffer);
+            ec = frame_ec;
+            if (ec) {
+                return 0;
+            }
+            const std::size_t bytes = write_blocking(asio::buffer(framed_buffer), ec);
+            context_.escape_buffers.release(std::move(framed_buffer));
+            return bytes;
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -236,19 +388,43 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::write_some(const CBufSeq&, std::error_code&) noexcept
+    } //stream::write_subnegotiation(option, const std::vector<byte_t>&, std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `write_raw`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `write_raw` for throwing version, `async_write_raw` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Sends `synch_urgent_prefix` with `message_out_of_band` on `lowest_layer()`, repeating after a short send, then writes `synch_suffix` to `next_layer_`, mirroring `output_processor::start_synch`.
+     * @remark Queues through `async_send_synch` with `sync_await` instead if asynchronous writes are outstanding, so the urgent byte cannot overtake them.
+     * @remark While output is compressed or encrypted, writes only `synch_suffix` through `write_next_layer`, as `output_processor::flush` does.
+     * @see `async_send_synch` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    template<ConstBufferSequence CBufSeq>
-    std::size_t stream<NLS, PC>::write_raw(const CBufSeq& data, std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::send_synch(std::error_code& ec) noexcept
     {
         try {
-            return write_raw(data);
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return 0;
+                }
+                return sync_await(async_send_synch(asio::use_awaitable));
+            }
+            statistics_.add(statistic::synchs_sent);
+            if (context_.deflater.active() || context_.tls_output_active) {
+                return write_next_layer(asio::buffer(synch_suffix), ec);
+            }
+            std::size_t bytes = 0;
+            while (bytes < synch_urgent_prefix.size()) {
+                //Each resend is urgent too, so a short send cannot leave the urgent pointer on the first NUL.
+                const std::size_t sent =
+                    lowest_layer().send(asio::buffer(synch_urgent_prefix) + bytes, lowest_layer_type::message_out_of_band, ec);
+                statistics_.add(statistic::bytes_sent, sent);
+                bytes += sent;
+                if (ec) {
+                    return bytes;
+                }
+            }
+            const std::size_t suffix_bytes = asio::write(next_layer_, asio::buffer(synch_suffix), ec);
+            statistics_.add(statistic::bytes_sent, suffix_bytes);
+            return bytes + suffix_bytes;
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -259,18 +435,39 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::write_raw(const CBufSeq&, std::error_code&) noexcept
+    } //stream::send_synch(std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `write_command`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `write_command` for throwing version, `async_write_command` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Writes `compression_start_sequence` uncompressed with `write_wire_blocking`, then starts `context_.deflater`.
+     * @remark Queues through `async_start_compression` with `sync_await` instead if asynchronous writes are outstanding.
+     * @see `async_start_compression` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::write_command(telnet::command cmd, std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::start_compression(std::error_code& ec) noexcept
     {
         try {
-            return write_command(cmd);
+            ec.clear();
+            if (context_.deflater.active()) {
+                return 0;
+            }
+            const auto opt = outbound_compression_option();
+            if (!opt) {
+                ec = make_error_code(error::option_not_available);
+                return 0;
+            }
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return 0;
+                }
+                return sync_await(async_start_compression(asio::use_awaitable));
+            }
+            const auto start_sequence = compression_start_sequence(*opt);
+            const std::size_t bytes   = write_wire_blocking(asio::buffer(start_sequence), ec);
+            if (!ec) {
+                ec = context_.deflater.start();
+            }
+            return bytes;
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -281,22 +478,35 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::write_command(telnet::command, std::error_code&) noexcept
+    } //stream::start_compression(std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `write_subnegotiation`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `write_subnegotiation` for throwing version, `async_write_subnegotiation` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Finishes `context_.deflater` into a pooled buffer and writes the trailer with `write_wire_blocking`.
+     * @remark Queues through `async_stop_compression` with `sync_await` instead if asynchronous writes are outstanding.
+     * @see `async_stop_compression` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::write_subnegotiation(
-        option opt,
-        const std::vector<byte_t>& subnegotiation_buffer,
-        std::error_code& ec
-    ) noexcept
+    std::size_t stream<NLS, PC>::stop_compression(std::error_code& ec) noexcept
     {
         try {
-            return write_subnegotiation(opt, subnegotiation_buffer);
+            ec.clear();
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return 0;
+                }
+                return sync_await(async_stop_compression(asio::use_awaitable));
+            }
+            if (!context_.deflater.active()) {
+                return 0;
+            }
+            std::vector<byte_t> trailer = context_.escape_buffers.acquire(deflate_stream::output_chunk_size);
+            ec                          = context_.deflater.finish(trailer);
+            if (!ec) {
+                write_wire_blocking(asio::buffer(trailer), ec);
+            }
+            context_.escape_buffers.release(std::move(trailer));
+            return 0;
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -307,18 +517,39 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::write_subnegotiation(option, const std::vector<byte_t>&, std::error_code&) noexcept
+    } //stream::stop_compression(std::error_code&) noexcept
 
     /**
      * @internal
-     * Calls the throwing `send_synch`, catching exceptions to set `ec` to `std::system_error`’s code, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
-     * @see `send_synch` for throwing version, `async_send_synch` in "net.telnet-stream-async-impl.cpp" for async implementation, "net.telnet-stream.cppm" for interface
+     * Writes `start_tls_sequence` in the clear with `asio::write`, then starts output encryption.
+     * @remark Queues through `async_start_tls` with `sync_await` instead if asynchronous writes are outstanding.
+     * @see `async_start_tls` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
      */
     template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
-    std::size_t stream<NLS, PC>::send_synch(std::error_code& ec) noexcept
+    std::size_t stream<NLS, PC>::start_tls(std::error_code& ec) noexcept
     {
         try {
-            return send_synch();
+            ec.clear();
+            if (context_.tls_follows_sent) {
+                return 0;
+            }
+            if (ec = check_tls_start(); ec) {
+                return 0;
+            }
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return 0;
+                }
+                return sync_await(async_start_tls(asio::use_awaitable));
+            }
+            const auto follows_sequence = start_tls_sequence();
+            context_.tls_follows_sent   = true;
+            const std::size_t bytes     = asio::write(next_layer_, asio::buffer(follows_sequence), ec);
+            statistics_.add(statistic::bytes_sent, bytes);
+            if (!ec) {
+                ec = start_output_encryption();
+            }
+            return bytes;
         } catch (const std::system_error& e) {
             ec = e.code();
             return 0;
@@ -329,5 +560,456 @@ namespace net::telnet {
             ec = make_error_code(error::internal_error);
             return 0;
         }
-    } //stream::send_synch(std::error_code&) noexcept
+    } //stream::start_tls(std::error_code&) noexcept
+
+    /**
+     * @internal
+     * Starts decryption and encryption together and marks our FOLLOWS sent, so a stray START_TLS exchange is refused; then lets `output_processor_` send a client's ClientHello.
+     * @remark Blocking callers need not wait for that flush: their first read or write sends the queued records itself.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::start_implicit_tls(std::error_code& ec) noexcept
+    {
+        try {
+            ec.clear();
+            if (context_.deflater.active()) {
+                ec = make_error_code(error::tls_error);
+                return;
+            }
+            if (ec = start_input_decryption(); ec) {
+                return;
+            }
+            if (ec = start_output_encryption(); ec) {
+                return;
+            }
+            context_.tls_follows_sent = true;
+            output_processor_.notify_tls_output();
+        } catch (const std::system_error& e) {
+            ec = e.code();
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::start_implicit_tls(std::error_code&) noexcept
+
+    /**
+     * @internal
+     * Completes a pending handshake, has `tls_session::shutdown` queue close_notify, and sends it with `write_tls_records`.
+     * @remark Queues through `async_stop_tls` with `sync_await` instead if asynchronous writes are outstanding.
+     * @see `async_stop_tls` in "net.telnet-stream-async-impl.cpp" for the asynchronous counterpart.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::stop_tls(std::error_code& ec) noexcept
+    {
+        try {
+            ec.clear();
+            if (!context_.tls_follows_sent) {
+                return;
+            }
+            if (!output_processor_.is_idle()) {
+                if (ec = check_queued_wait(); ec) {
+                    return;
+                }
+                sync_await(async_stop_tls(asio::use_awaitable));
+                return;
+            }
+            if (context_.tls_output_active && !context_.tls.established()) {
+                if (ec = handshake_blocking(); ec) {
+                    return;
+                }
+            }
+            if (ec = context_.tls.shutdown(); ec) {
+                return;
+            }
+            ec = write_tls_records();
+        } catch (const std::system_error& e) {
+            ec = e.code();
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::stop_tls(std::error_code&) noexcept
+
+    /**
+     * @internal
+     * Appends `snapshot_header`, `fsm_.save_state`'s image, and the length-prefixed unscanned input; between reads the side buffer holds only bytes no scan has reached.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::vector<byte_t> stream<NLS, PC>::snapshot(std::error_code& ec) const noexcept
+    {
+        try {
+            ec.clear();
+            if (ec = check_snapshot(); ec) {
+                return {};
+            }
+            const auto pending = context_.input_side_buffer.data();
+            std::vector<byte_t> image(snapshot_header.begin(), snapshot_header.end());
+            fsm_.save_state(image);
+            snapshot_length::append(image, static_cast<std::uint32_t>(pending.size()));
+            const auto* first = static_cast<const byte_t*>(pending.data());
+            image.insert(image.end(), first, first + pending.size());
+            return image;
+        } catch (const std::system_error& e) {
+            ec = e.code();
+            return {};
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+            return {};
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+            return {};
+        }
+    } //stream::snapshot(std::error_code&) const noexcept
+
+    /**
+     * @internal
+     * Checks the input trailer and stages the input behind the current side-buffer contents before restoring into a copy of `fsm_`, committing both only once the whole image has parsed.
+     * @remark `restore_state` upserts an unregistered subnegotiation option only after its own checks pass, so running it last keeps a rejected image from touching the shared registry.
+     * @remark The copy shares `fsm_`'s handler table, so handlers registered before `restore` survive it.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::restore(std::span<const byte_t> image, std::error_code& ec) noexcept
+    {
+        try {
+            ec.clear();
+            if (ec = check_snapshot(); ec) {
+                return;
+            }
+            if ((image.size() < snapshot_header.size()) || !std::ranges::equal(image.first(snapshot_header.size()), snapshot_header)) {
+                ec = make_error_code(error::invalid_snapshot);
+                log_traits<PC>::template log<log_level::error>(ec, "field: header");
+                return;
+            }
+            image = image.subspan(snapshot_header.size());
+
+            const std::optional<std::size_t> state_size = fsm_type::state_image_size(image);
+            if (!state_size) {
+                ec = make_error_code(error::invalid_snapshot);
+                log_traits<PC>::template log<log_level::error>(ec, "field: length");
+                return;
+            }
+            auto input = image.subspan(*state_size);
+            const std::optional<std::uint32_t> length = snapshot_length::read(input);
+            if (!length || ((input.size() - snapshot_length::size) != *length)) {
+                ec = make_error_code(error::invalid_snapshot);
+                log_traits<PC>::template log<log_level::error>(ec, "field: input length");
+                return;
+            }
+            input = input.subspan(snapshot_length::size);
+
+            //Copied now but committed only on success; a later `prepare` discards it otherwise.
+            if (!input.empty()) {
+                asio::buffer_copy(context_.input_side_buffer.prepare(input.size()), asio::buffer(input.data(), input.size()));
+            }
+
+            fsm_type restored = fsm_;
+            if (auto [consumed, fsm_ec] = restored.restore_state(image.first(*state_size)); fsm_ec) {
+                ec = fsm_ec;
+                return;
+            }
+
+            const std::size_t stale = context_.input_side_buffer.size();
+            context_.input_side_buffer.commit(input.size());
+            context_.input_side_buffer.consume(stale);
+            fsm_ = std::move(restored);
+        } catch (const std::system_error& e) {
+            ec = e.code();
+        } catch (const std::bad_alloc& e) {
+            ec = make_error_code(std::errc::not_enough_memory);
+        } catch (...) {
+            ec = make_error_code(error::internal_error);
+        }
+    } //stream::restore(std::span<const byte_t>, std::error_code&) noexcept
+
+    //=========================================================================================================
+    //Synchronous throwing wrappers call their `noexcept` counterparts and throw `std::system_error` on error.
+    //=========================================================================================================
+
+    /**
+     * @internal
+     * Calls the `noexcept` `request_option` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::request_option(option::id_num opt, negotiation_direction direction)
+    {
+        std::error_code ec;
+        const std::size_t bytes = request_option(opt, direction, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::request_option(option::id_num, negotiation_direction)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `disable_option` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::disable_option(option::id_num opt, negotiation_direction direction)
+    {
+        std::error_code ec;
+        const std::size_t bytes = disable_option(opt, direction, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::disable_option(option::id_num, negotiation_direction)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `read_some` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<MutableBufferSequence MBufSeq>
+    std::size_t stream<NLS, PC>::read_some(MBufSeq&& buffers)
+    {
+        std::error_code ec;
+        const std::size_t bytes = read_some(std::forward<MBufSeq>(buffers), ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::read_some(MBufSeq&&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `read_line` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::read_line(frame_batch& lines)
+    {
+        std::error_code ec;
+        const std::size_t bytes = read_line(lines, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::read_line(frame_batch&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `read_record` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::read_record(frame_batch& records)
+    {
+        std::error_code ec;
+        const std::size_t bytes = read_record(records, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::read_record(frame_batch&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_some` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_some(const CBufSeq& data)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_some(data, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_some(const CBufSeq&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_gather` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_gather(const CBufSeq& data)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_gather(data, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_gather(const CBufSeq&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_raw` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    template<ConstBufferSequence CBufSeq>
+    std::size_t stream<NLS, PC>::write_raw(const CBufSeq& data)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_raw(data, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_raw(const CBufSeq&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_command` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::write_command(telnet::command cmd)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_command(cmd, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_command(telnet::command)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_negotiation` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::write_negotiation(typename fsm_type::negotiation_response response)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_negotiation(response, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_negotiation(fsm_type::negotiation_response)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `write_subnegotiation` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::write_subnegotiation(option opt, const std::vector<byte_t>& subnegotiation_buffer)
+    {
+        std::error_code ec;
+        const std::size_t bytes = write_subnegotiation(opt, subnegotiation_buffer, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::write_subnegotiation(option, const std::vector<byte_t>&)
+
+    /**
+     * @internal
+     * Calls the `noexcept` `send_synch` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::send_synch()
+    {
+        std::error_code ec;
+        const std::size_t bytes = send_synch(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::send_synch()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `start_compression` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::start_compression()
+    {
+        std::error_code ec;
+        const std::size_t bytes = start_compression(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::start_compression()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `stop_compression` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::stop_compression()
+    {
+        std::error_code ec;
+        const std::size_t bytes = stop_compression(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::stop_compression()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `start_tls` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::size_t stream<NLS, PC>::start_tls()
+    {
+        std::error_code ec;
+        const std::size_t bytes = start_tls(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return bytes;
+    } //stream::start_tls()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `start_implicit_tls` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::start_implicit_tls()
+    {
+        std::error_code ec;
+        start_implicit_tls(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+    } //stream::start_implicit_tls()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `stop_tls` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::stop_tls()
+    {
+        std::error_code ec;
+        stop_tls(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+    } //stream::stop_tls()
+
+    /**
+     * @internal
+     * Calls the `noexcept` `snapshot` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    std::vector<byte_t> stream<NLS, PC>::snapshot() const
+    {
+        std::error_code ec;
+        auto image = snapshot(ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+        return image;
+    } //stream::snapshot() const
+
+    /**
+     * @internal
+     * Calls the `noexcept` `restore` and throws `std::system_error` if it sets `ec`.
+     */
+    template<LayerableSocketStream NLS, ProtocolFSMConfig PC>
+    void stream<NLS, PC>::restore(std::span<const byte_t> image)
+    {
+        std::error_code ec;
+        restore(image, ec);
+        if (ec) {
+            throw std::system_error(ec);
+        }
+    } //stream::restore(std::span<const byte_t>)
 } //namespace net::telnet
@@ -73,6 +73,9 @@ export namespace net::telnet::awaitables {
 
         //NOLINTEND(google-explicit-constructor)
 
+        ///@brief Checks whether a coroutine is attached; a default-constructed (empty) awaitable has nothing to `co_await`.
+        [[nodiscard]] bool valid() const noexcept { return awaitable_.valid(); }
+
         ///@brief Supports co_await for lvalue.
         auto operator co_await() & noexcept { return awaitable_.operator co_await(); }
 
@@ -88,6 +91,12 @@ export namespace net::telnet::awaitables {
      * @param awaitable The awaitable to wrap.
      * @note Implicit conversion from the underlying type allows direct returns from Boost.Asio asynchronous operations.
      */
+    /**
+     * @fn bool tagged_awaitable::valid() const noexcept
+     * @return `true` if the awaitable owns a coroutine frame, `false` if it is empty.
+     * @remark The FSM returns no handler response at all for an empty awaitable, so unregistered handlers cost no coroutine frame or `co_spawn`.
+     * @warning Awaiting an empty awaitable is undefined behavior.
+     */
 
     /// @brief Semantic tag `struct`s to specialize `tagged_awaitable`. @see `tagged_awaitable`
     namespace tags {
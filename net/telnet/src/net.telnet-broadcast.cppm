@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-broadcast.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief One-to-many output: a shared, immutable message escaped once per output mode and fanned out across many `stream`s.
+ * @remark A `broadcast_message` copies its payload once; each stream that writes it queues a reference to the escaped bytes for its own mode instead of escaping and allocating its own copy.
+ * @remark MCCP compression state is per-connection, so compressing streams deflate the shared escaped bytes in their own batches; only the escaping is shared.
+ *
+ * @see `:stream` for `stream::async_write_broadcast`, RFC 854 for IAC escaping, RFC 856 for BINARY
+ */
+
+module; //Including Asio in the Global Module Fragment until importable header units are reliable.
+#include <asio.hpp>
+
+//Module partition interface unit
+export module net.telnet:broadcast;
+
+import std; //NOLINT For std::vector, std::array, std::once_flag, std::call_once, std::shared_ptr, std::span, std::ranges
+
+import :types;    ///< @see "net.telnet-types.cppm" for `byte_t`
+import :concepts; ///< @see "net.telnet-concepts.cppm" for `ConstBufferSequence`
+
+export namespace net::telnet {
+    /**
+     * @brief An immutable payload shared by every `stream` it is broadcast to.
+     * @remark Cheap to copy: copies share one reference-counted state holding the payload and its escaped encodings.
+     * @remark Each encoding (text or BINARY) is built on first use by the first stream that needs it, then reused by every other.
+     * @remark Thread-safe: streams on different executors may request encodings concurrently.
+     * @see `stream::async_write_broadcast`, `telnet::broadcast`
+     */
+    class broadcast_message {
+    public:
+        ///@brief Copies `payload` into new shared storage.
+        template<concepts::ConstBufferSequence CBufSeq>
+        explicit broadcast_message(const CBufSeq& payload) : state_(std::make_shared<shared_state>())
+        {
+            state_->payload.resize(asio::buffer_size(payload));
+            asio::buffer_copy(asio::buffer(state_->payload), payload);
+        } //broadcast_message(const CBufSeq&)
+
+        ///@brief Gets the unescaped payload.
+        [[nodiscard]] std::span<const byte_t> payload() const noexcept { return state_->payload; }
+
+        ///@brief Gets the size of the unescaped payload.
+        [[nodiscard]] std::size_t size() const noexcept { return state_->payload.size(); }
+
+        ///@brief Gets the payload escaped for one local BINARY mode, building it with `escape` on first use.
+        template<typename Escape>
+        [[nodiscard]] std::shared_ptr<const std::vector<byte_t>> encoding(bool local_binary, Escape&& escape) const
+        {
+            const std::size_t mode = local_binary ? 1 : 0;
+            //NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index): `mode` is 0 or 1.
+            std::call_once(state_->once[mode], [&] {
+                //Escape into a local so a throwing `escape` leaves no partial bytes for the retry to append to.
+                std::vector<byte_t> escaped;
+                escaped.reserve(state_->payload.size() + (state_->payload.size() / 10));
+                std::forward<Escape>(escape)(escaped, std::span<const byte_t>(state_->payload));
+                state_->escaped[mode] = std::move(escaped);
+            });
+            return {state_, &state_->escaped[mode]};
+            //NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+        } //encoding(bool, Escape&&)
+
+    private:
+        ///@brief The storage shared by every copy of a `broadcast_message` and every write queued from it.
+        struct shared_state {
+            std::vector<byte_t> payload;
+            std::array<std::once_flag, 2> once;
+            std::array<std::vector<byte_t>, 2> escaped; //Indexed by local BINARY mode; written once under `once`
+        }; //struct shared_state
+
+        std::shared_ptr<shared_state> state_;
+    }; //class broadcast_message
+
+    /**
+     * @fn broadcast_message::broadcast_message(const CBufSeq& payload)
+     * @tparam CBufSeq The type of constant buffer sequence holding the payload.
+     * @param payload The unescaped data to broadcast.
+     * @throws std::bad_alloc If the shared storage cannot be allocated.
+     * @remark This is the only copy of the payload; the bytes `payload` refers to may be reused as soon as the constructor returns.
+     */
+    /**
+     * @fn std::shared_ptr<const std::vector<byte_t>> broadcast_message::encoding(bool local_binary, Escape&& escape) const
+     * @tparam Escape Callable as `escape(std::vector<byte_t>& out, std::span<const byte_t> payload)`, appending the escaped payload to `out`.
+     * @param local_binary Whether the writing stream transmits in BINARY mode.
+     * @param escape The escaping routine of the writing stream, called at most once per mode for all copies of the message.
+     * @return A pointer to the escaped bytes that shares ownership of the whole message, so queued writes keep it alive.
+     * @throws Whatever `escape` throws; the encoding is then retried from scratch by the next caller, since bytes are only published once `escape` returns.
+     * @remark Uses `std::call_once`, so concurrent first requests for one mode escape it once and the rest wait.
+     */
+
+    /**
+     * @brief Writes `message` to every stream in `streams`, each on its own executor, calling `handler` as each write completes.
+     * @tparam Streams An input range of streams, or of pointers (raw or smart) to streams.
+     * @tparam CompletionHandler Copyable and callable as `handler(std::error_code, std::size_t)`.
+     * @param message The message to write; each write holds a reference, so the caller's copy may be discarded at once.
+     * @param streams The target streams.
+     * @param handler Copied for each stream and invoked on that stream's executor with its write's result.
+     * @return The number of writes started.
+     * @remark Dispatches `async_write_broadcast` to each stream's executor, so the writes run concurrently and never touch a stream from a foreign thread; use strand executors for streams driven by multi-threaded contexts.
+     * @remark Elements held by `std::shared_ptr` are kept alive by the dispatched operation; streams in a range of references or raw pointers MUST outlive their writes.
+     */
+    template<std::ranges::input_range Streams, typename CompletionHandler>
+    std::size_t broadcast(const broadcast_message& message, Streams&& streams, CompletionHandler handler)
+    {
+        std::size_t started = 0;
+        for (auto&& element : streams) {
+            if constexpr (requires { element->get_executor(); }) {
+                auto executor = element->get_executor();
+                asio::dispatch(executor, [target = element, message, handler]() mutable {
+                    target->async_write_broadcast(message, std::move(handler));
+                });
+            } else {
+                auto executor = element.get_executor();
+                asio::dispatch(executor, [target = std::addressof(element), message, handler]() mutable {
+                    target->async_write_broadcast(message, std::move(handler));
+                });
+            }
+            ++started;
+        }
+        return started;
+    } //broadcast(const broadcast_message&, Streams&&, CompletionHandler)
+
+    /**
+     * @brief Writes `message` to every stream in `streams`, each on its own executor, ignoring the results.
+     * @overload
+     * @remark Use the overload taking a handler to observe each stream's write result.
+     */
+    template<std::ranges::input_range Streams>
+    std::size_t broadcast(const broadcast_message& message, Streams&& streams)
+    {
+        return broadcast(message, std::forward<Streams>(streams), [](const std::error_code& /*ec*/, std::size_t /*bytes*/) {});
+    } //broadcast(const broadcast_message&, Streams&&)
+} //namespace net::telnet
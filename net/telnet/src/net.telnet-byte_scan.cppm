@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025-2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-byte_scan.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2025-2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Internal partition defining vectorized byte-scanning kernels used by other partitions.
+ * @remark Provides `find_first_of<Needles...>` to locate the first occurrence of any of a small, compile-time set of byte values in a contiguous range.
+ * @remark Selects AVX2 (32 bytes per step), SSE2 (16 bytes per step), or NEON (16 bytes per step) at compile time from the target's predefined macros, with a scalar fallback for other targets and for tail bytes.
+ *
+ * @remark Not intended for direct use by external code; serves as an implementation detail for other partitions.
+ * @see `:stream` for output escaping, `:types` for `byte_t`
+ */
+
+module; //Including the SIMD intrinsic headers in the Global Module Fragment since they are not importable.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+//Module partition interface unit
+export module net.telnet:byte_scan;
+
+import std; //NOLINT For std::countr_zero, std::ranges::find_if
+
+import :types; ///< @see "net.telnet-types.cppm" for `byte_t`
+
+export namespace net::telnet {
+    /**
+     * @brief Compile-time selected byte-scanning kernel.
+     * @remark Stateless; all members are static.
+     * @see `:stream` for `escape_telnet_output`
+     */
+    class byte_scan {
+    public:
+        /**
+         * @brief Identifies the instruction set selected for the vectorized kernel.
+         */
+        enum class instruction_set : std::uint8_t {
+            scalar, ///< Portable byte-at-a-time loop
+            sse2,   ///< x86 SSE2, 16 bytes per step
+            avx2,   ///< x86 AVX2, 32 bytes per step
+            neon    ///< AArch64 NEON, 16 bytes per step
+        };
+
+        ///@brief The instruction set selected at compile time.
+        static constexpr instruction_set selected_instruction_set =
+#if defined(__AVX2__)
+            instruction_set::avx2;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+            instruction_set::sse2;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            instruction_set::neon;
+#else
+            instruction_set::scalar;
+#endif
+
+        ///@brief Finds the first byte in [`first`, `last`) equal to any of `Needles`.
+        template<byte_t... Needles>
+        [[nodiscard]] static const byte_t* find_first_of(const byte_t* first, const byte_t* last) noexcept
+        {
+            static_assert(sizeof...(Needles) > 0, "find_first_of requires at least one needle byte");
+#if defined(__AVX2__)
+            first = find_first_of_avx2<Needles...>(first, last);
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+            first = find_first_of_sse2<Needles...>(first, last);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+            first = find_first_of_neon<Needles...>(first, last);
+#endif
+            return find_first_of_scalar<Needles...>(first, last);
+        } //find_first_of(const byte_t*, const byte_t*)
+
+    private:
+        ///@brief Scalar kernel; also finishes the tail left by the vectorized kernels.
+        template<byte_t... Needles>
+        [[nodiscard]] static const byte_t* find_first_of_scalar(const byte_t* first, const byte_t* last) noexcept
+        {
+            return std::ranges::find_if(first, last, [](byte_t byte) { return ((byte == Needles) || ...); });
+        } //find_first_of_scalar(const byte_t*, const byte_t*)
+
+#if defined(__AVX2__)
+        ///@brief AVX2 kernel; returns the match or the start of the unscanned tail.
+        template<byte_t... Needles>
+        [[nodiscard]] static const byte_t* find_first_of_avx2(const byte_t* first, const byte_t* last) noexcept
+        {
+            constexpr std::ptrdiff_t step = sizeof(__m256i);
+            while ((last - first) >= step) {
+                //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): Unaligned vector load required by the intrinsic API.
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i hits        = _mm256_setzero_si256();
+                ((hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(static_cast<char>(Needles))))), ...);
+                if (const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits)); mask != 0) {
+                    return first + std::countr_zero(mask);
+                }
+                first += step;
+            }
+            return first;
+        } //find_first_of_avx2(const byte_t*, const byte_t*)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        ///@brief SSE2 kernel; returns the match or the start of the unscanned tail.
+        template<byte_t... Needles>
+        [[nodiscard]] static const byte_t* find_first_of_sse2(const byte_t* first, const byte_t* last) noexcept
+        {
+            constexpr std::ptrdiff_t step = sizeof(__m128i);
+            while ((last - first) >= step) {
+                //NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): Unaligned vector load required by the intrinsic API.
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i hits        = _mm_setzero_si128();
+                ((hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(Needles))))), ...);
+                if (const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits)); mask != 0) {
+                    return first + std::countr_zero(mask);
+                }
+                first += step;
+            }
+            return first;
+        } //find_first_of_sse2(const byte_t*, const byte_t*)
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        ///@brief NEON kernel; returns the match or the start of the unscanned tail.
+        template<byte_t... Needles>
+        [[nodiscard]] static const byte_t* find_first_of_neon(const byte_t* first, const byte_t* last) noexcept
+        {
+            constexpr std::ptrdiff_t step = sizeof(uint8x16_t);
+            while ((last - first) >= step) {
+                const uint8x16_t chunk = vld1q_u8(first);
+                uint8x16_t hits        = vdupq_n_u8(0);
+                ((hits = vorrq_u8(hits, vceqq_u8(chunk, vdupq_n_u8(Needles)))), ...);
+                if (vmaxvq_u8(hits) != 0) {
+                    //Narrow each 8-bit lane to 4 bits so the lane index is the trailing-zero count divided by 4.
+                    const std::uint64_t mask =
+                        vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+                    return first + (std::countr_zero(mask) / 4);
+                }
+                first += step;
+            }
+            return first;
+        } //find_first_of_neon(const byte_t*, const byte_t*)
+#endif
+    }; //class byte_scan
+
+    /**
+     * @fn const byte_t* byte_scan::find_first_of(const byte_t* first, const byte_t* last) noexcept
+     *
+     * @tparam Needles The byte values to search for.
+     * @param first Pointer to the first byte of the range.
+     * @param last Pointer one past the last byte of the range.
+     * @return Pointer to the first byte equal to any of `Needles`, or `last` if there is none.
+     *
+     * @remark Runs the vectorized kernel for `selected_instruction_set` over whole blocks, then the scalar kernel over the remaining tail.
+     * @remark Never reads outside [`first`, `last`); no alignment is required.
+     */
+    /**
+     * @fn const byte_t* byte_scan::find_first_of_scalar(const byte_t* first, const byte_t* last) noexcept
+     *
+     * @tparam Needles The byte values to search for.
+     * @param first Pointer to the first byte of the range.
+     * @param last Pointer one past the last byte of the range.
+     * @return Pointer to the first byte equal to any of `Needles`, or `last` if there is none.
+     */
+    /**
+     * @fn const byte_t* byte_scan::find_first_of_avx2(const byte_t* first, const byte_t* last) noexcept
+     *
+     * @tparam Needles The byte values to search for.
+     * @param first Pointer to the first byte of the range.
+     * @param last Pointer one past the last byte of the range.
+     * @return Pointer to the first matching byte, or to the first byte of the sub-32-byte tail left for the scalar kernel.
+     *
+     * @remark OR-folds one `_mm256_cmpeq_epi8` per needle and locates the first hit with `_mm256_movemask_epi8`.
+     */
+    /**
+     * @fn const byte_t* byte_scan::find_first_of_sse2(const byte_t* first, const byte_t* last) noexcept
+     *
+     * @tparam Needles The byte values to search for.
+     * @param first Pointer to the first byte of the range.
+     * @param last Pointer one past the last byte of the range.
+     * @return Pointer to the first matching byte, or to the first byte of the sub-16-byte tail left for the scalar kernel.
+     *
+     * @remark OR-folds one `_mm_cmpeq_epi8` per needle and locates the first hit with `_mm_movemask_epi8`.
+     */
+    /**
+     * @fn const byte_t* byte_scan::find_first_of_neon(const byte_t* first, const byte_t* last) noexcept
+     *
+     * @tparam Needles The byte values to search for.
+     * @param first Pointer to the first byte of the range.
+     * @param last Pointer one past the last byte of the range.
+     * @return Pointer to the first matching byte, or to the first byte of the sub-16-byte tail left for the scalar kernel.
+     *
+     * @remark OR-folds one `vceqq_u8` per needle, tests for any hit with `vmaxvq_u8`, and locates it with the `vshrn_n_u16` nibble-mask idiom.
+     */
+} //namespace net::telnet
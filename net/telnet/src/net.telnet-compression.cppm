@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025-2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-compression.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2025-2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Internal partition wrapping the zlib streams used for MCCP2/MCCP3 (MUD Client Compression Protocol) compression.
+ * @remark Defines `deflate_stream` for compressing outbound bytes and `inflate_stream` for decompressing inbound bytes, each one persistent zlib stream per session.
+ * @remark Built against zlib when `NET_TELNET_WITH_MCCP` is defined; otherwise both classes fail to `start` with `telnet::error::compression_error` and are never active.
+ *
+ * @remark Not intended for direct use by external code; serves as an implementation detail for other partitions.
+ * @see `:stream` for the MCCP layer, `:errors` for `telnet::error::compression_error`, `:types` for `byte_t`
+ */
+
+module; //Including zlib in the Global Module Fragment since it is not importable.
+#if defined(NET_TELNET_WITH_MCCP)
+    #include <zlib.h>
+#endif
+
+//Module partition interface unit
+export module net.telnet:compression;
+
+import std; //NOLINT For std::error_code, std::span, std::vector, std::size_t, std::min
+
+import :types;  ///< @see "net.telnet-types.cppm" for `byte_t`
+import :errors; ///< @see "net.telnet-errors.cppm" for `telnet::error` codes
+
+export namespace net::telnet {
+    /**
+     * @brief One persistent zlib deflate stream, compressing a session's outbound bytes.
+     * @remark The zlib state is allocated by `start` and freed by `finish` or `end`, so a session that never compresses costs one `z_stream` header.
+     * @remark Neither copyable nor movable, since zlib's internal state points back at the `z_stream`.
+     * @see `:stream` for `output_processor`, the MCCP2 specification for framing
+     */
+    class deflate_stream {
+    public:
+        ///@brief log2 of the LZ77 window; 4 KiB instead of zlib's default 32 KiB.
+        static constexpr int window_bits = 12;
+
+        ///@brief zlib `memLevel`; 16 KiB of hash and pending-output state instead of zlib's default 128 KiB.
+        static constexpr int memory_level = 5;
+
+        ///@brief zlib compression level.
+        static constexpr int compression_level = 6;
+
+        ///@brief Bytes appended to the output vector per `deflate` call.
+        static constexpr std::size_t output_chunk_size = 4096;
+
+        deflate_stream() noexcept = default;
+        deflate_stream(const deflate_stream&)            = delete;
+        deflate_stream& operator=(const deflate_stream&) = delete;
+        deflate_stream(deflate_stream&&)                 = delete;
+        deflate_stream& operator=(deflate_stream&&)      = delete;
+        ~deflate_stream() { end(); }
+
+        ///@brief Reports whether a compressed stream is open.
+        [[nodiscard]] bool active() const noexcept { return active_; }
+
+        ///@brief Opens a new compressed stream.
+        std::error_code start() noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (active_) {
+                return {};
+            }
+            stream_ = z_stream{};
+            switch (deflateInit2(&stream_, compression_level, Z_DEFLATED, window_bits, memory_level, Z_DEFAULT_STRATEGY)) {
+                case Z_OK:
+                    active_ = true;
+                    return {};
+                case Z_MEM_ERROR:
+                    return make_error_code(std::errc::not_enough_memory);
+                default:
+                    return make_error_code(error::compression_error);
+            }
+#else
+            return make_error_code(error::compression_error);
+#endif
+        } //start()
+
+        ///@brief Compresses `input`, appending whatever zlib emits to `output`.
+        std::error_code compress(std::span<const byte_t> input, std::vector<byte_t>& output) noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            return run(input, output, Z_NO_FLUSH);
+#else
+            (void)input;
+            (void)output;
+            return make_error_code(error::compression_error);
+#endif
+        } //compress(std::span<const byte_t>, std::vector<byte_t>&)
+
+        ///@brief Emits everything compressed so far to `output` on a byte boundary the peer can decode without more input.
+        std::error_code flush(std::vector<byte_t>& output) noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            return run({}, output, Z_SYNC_FLUSH);
+#else
+            (void)output;
+            return make_error_code(error::compression_error);
+#endif
+        } //flush(std::vector<byte_t>&)
+
+        ///@brief Terminates the compressed stream, appending its trailer to `output`, and frees the zlib state.
+        std::error_code finish(std::vector<byte_t>& output) noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (!active_) {
+                return {};
+            }
+            const std::error_code ec = run({}, output, Z_FINISH);
+            end();
+            return ec;
+#else
+            (void)output;
+            return {};
+#endif
+        } //finish(std::vector<byte_t>&)
+
+        ///@brief Frees the zlib state without terminating the compressed stream.
+        void end() noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (active_) {
+                deflateEnd(&stream_);
+                active_ = false;
+            }
+#endif
+        } //end()
+
+    private:
+#if defined(NET_TELNET_WITH_MCCP)
+        ///@brief Drives `deflate` with `flush_mode` until it has consumed `input` and has no more output to give.
+        std::error_code run(std::span<const byte_t> input, std::vector<byte_t>& output, int flush_mode) noexcept
+        {
+            if (!active_) {
+                return make_error_code(error::compression_error);
+            }
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): zlib's `next_in` is non-const but never written through.
+            stream_.next_in  = const_cast<Bytef*>(input.data());
+            stream_.avail_in = static_cast<uInt>(input.size());
+            try {
+                int rc = Z_OK;
+                do {
+                    const std::size_t offset = output.size();
+                    output.resize(offset + output_chunk_size);
+                    stream_.next_out  = output.data() + offset;
+                    stream_.avail_out = static_cast<uInt>(output_chunk_size);
+                    rc                = deflate(&stream_, flush_mode);
+                    output.resize(output.size() - stream_.avail_out);
+                    if (rc == Z_STREAM_ERROR) {
+                        return make_error_code(error::compression_error);
+                    }
+                } while ((rc != Z_STREAM_END) && (stream_.avail_out == 0));
+            } catch (const std::bad_alloc&) {
+                return make_error_code(std::errc::not_enough_memory);
+            }
+            return {};
+        } //run(std::span<const byte_t>, std::vector<byte_t>&, int)
+
+        z_stream stream_{};
+#endif
+        bool active_ = false;
+    }; //class deflate_stream
+
+    /**
+     * @brief One persistent zlib inflate stream, decompressing a session's inbound bytes.
+     * @remark Accepts any window size the peer chose; the zlib state is allocated by `start` and freed when the compressed stream ends.
+     * @see `:stream` for `input_processor`
+     */
+    class inflate_stream {
+    public:
+        /**
+         * @brief The outcome of one `decompress` call.
+         */
+        struct result {
+            std::error_code ec;       ///< Set if the compressed stream is corrupt or memory ran out
+            std::size_t consumed = 0; ///< Compressed bytes read from the input
+            std::size_t produced = 0; ///< Decompressed bytes written to the output
+            bool finished        = false; ///< The peer ended the compressed stream; bytes after `consumed` are plain Telnet
+        }; //struct result
+
+        inflate_stream() noexcept = default;
+        inflate_stream(const inflate_stream&)            = delete;
+        inflate_stream& operator=(const inflate_stream&) = delete;
+        inflate_stream(inflate_stream&&)                 = delete;
+        inflate_stream& operator=(inflate_stream&&)      = delete;
+        ~inflate_stream() { end(); }
+
+        ///@brief Reports whether a compressed stream is open.
+        [[nodiscard]] bool active() const noexcept { return active_; }
+
+        ///@brief Opens a new compressed stream.
+        std::error_code start() noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (active_) {
+                return {};
+            }
+            stream_ = z_stream{};
+            switch (inflateInit(&stream_)) {
+                case Z_OK:
+                    active_ = true;
+                    return {};
+                case Z_MEM_ERROR:
+                    return make_error_code(std::errc::not_enough_memory);
+                default:
+                    return make_error_code(error::compression_error);
+            }
+#else
+            return make_error_code(error::compression_error);
+#endif
+        } //start()
+
+        ///@brief Decompresses from `input` into `output` until either is exhausted or the compressed stream ends.
+        result decompress(std::span<const byte_t> input, std::span<byte_t> output) noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (!active_) {
+                return {.ec = make_error_code(error::compression_error)};
+            }
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): zlib's `next_in` is non-const but never written through.
+            stream_.next_in   = const_cast<Bytef*>(input.data());
+            stream_.avail_in  = static_cast<uInt>(input.size());
+            stream_.next_out  = output.data();
+            stream_.avail_out = static_cast<uInt>(output.size());
+
+            const int rc = inflate(&stream_, Z_SYNC_FLUSH);
+            result outcome{
+                .ec       = {},
+                .consumed = input.size() - stream_.avail_in,
+                .produced = output.size() - stream_.avail_out,
+                .finished = false
+            };
+            switch (rc) {
+                case Z_OK:
+                case Z_BUF_ERROR: //No progress possible; more input is needed.
+                    break;
+                case Z_STREAM_END:
+                    outcome.finished = true;
+                    end();
+                    break;
+                case Z_MEM_ERROR:
+                    outcome.ec = make_error_code(std::errc::not_enough_memory);
+                    break;
+                default: //Z_DATA_ERROR, Z_NEED_DICT, Z_STREAM_ERROR
+                    outcome.ec = make_error_code(error::compression_error);
+                    end();
+                    break;
+            }
+            return outcome;
+#else
+            (void)input;
+            (void)output;
+            return {.ec = make_error_code(error::compression_error)};
+#endif
+        } //decompress(std::span<const byte_t>, std::span<byte_t>)
+
+        ///@brief Frees the zlib state.
+        void end() noexcept
+        {
+#if defined(NET_TELNET_WITH_MCCP)
+            if (active_) {
+                inflateEnd(&stream_);
+                active_ = false;
+            }
+#endif
+        } //end()
+
+    private:
+#if defined(NET_TELNET_WITH_MCCP)
+        z_stream stream_{};
+#endif
+        bool active_ = false;
+    }; //class inflate_stream
+
+    /**
+     * @fn std::error_code deflate_stream::start() noexcept
+     *
+     * @return `std::errc::not_enough_memory` if zlib cannot allocate its state, `telnet::error::compression_error` if MCCP support is not compiled in, otherwise success.
+     *
+     * @remark Uses `window_bits` and `memory_level` to bound the per-session state to roughly 32 KiB rather than zlib's default of roughly 256 KiB; MCCP decoders accept any window size.
+     * @remark Does nothing if a stream is already open.
+     */
+    /**
+     * @fn std::error_code deflate_stream::compress(std::span<const byte_t> input, std::vector<byte_t>& output) noexcept
+     *
+     * @param input The escaped Telnet bytes to compress.
+     * @param[in,out] output The vector to append compressed bytes to.
+     * @return `telnet::error::compression_error` if no stream is open, `std::errc::not_enough_memory` if `output` cannot grow, otherwise success.
+     *
+     * @remark zlib may hold some or all of the compressed bytes back until `flush`.
+     */
+    /**
+     * @fn std::error_code deflate_stream::flush(std::vector<byte_t>& output) noexcept
+     *
+     * @param[in,out] output The vector to append compressed bytes to.
+     * @return As for `compress`.
+     *
+     * @remark Uses `Z_SYNC_FLUSH`, so the peer can decode everything written so far; called once per write batch rather than per write.
+     */
+    /**
+     * @fn std::error_code deflate_stream::finish(std::vector<byte_t>& output) noexcept
+     *
+     * @param[in,out] output The vector to append the stream trailer to.
+     * @return As for `compress`; success if no stream is open.
+     *
+     * @remark Once the peer receives the trailer, bytes that follow are plain Telnet again.
+     */
+    /**
+     * @fn void deflate_stream::end() noexcept
+     *
+     * @remark Safe to call when no stream is open; also called by the destructor.
+     */
+    /**
+     * @fn std::error_code deflate_stream::run(std::span<const byte_t> input, std::vector<byte_t>& output, int flush_mode) noexcept
+     *
+     * @param input The bytes to compress, possibly empty.
+     * @param[in,out] output The vector to append compressed bytes to, grown `output_chunk_size` bytes at a time.
+     * @param flush_mode `Z_NO_FLUSH`, `Z_SYNC_FLUSH`, or `Z_FINISH`.
+     * @return As for `compress`.
+     *
+     * @remark Loops while `deflate` fills the whole chunk, which is zlib's signal that it may have more output.
+     */
+    /**
+     * @fn std::error_code inflate_stream::start() noexcept
+     *
+     * @return `std::errc::not_enough_memory` if zlib cannot allocate its state, `telnet::error::compression_error` if MCCP support is not compiled in, otherwise success.
+     *
+     * @remark Does nothing if a stream is already open.
+     */
+    /**
+     * @fn inflate_stream::result inflate_stream::decompress(std::span<const byte_t> input, std::span<byte_t> output) noexcept
+     *
+     * @param input The compressed bytes received from the peer.
+     * @param output The space to decompress into.
+     * @return The bytes consumed and produced, whether the stream ended, and any error.
+     *
+     * @remark Ends the stream (freeing the zlib state) when the peer's trailer arrives or the stream is corrupt; a corrupt stream reports `telnet::error::compression_error`.
+     * @remark Callers loop while `produced == output.size()`, since zlib may hold further output.
+     */
+    /**
+     * @fn void inflate_stream::end() noexcept
+     *
+     * @remark Safe to call when no stream is open; also called by the destructor.
+     */
+} //namespace net::telnet
@@ -104,6 +104,8 @@ export namespace net::telnet::concepts {
      * @brief Constraint on configuration types for `ProtocolFSM`.
      * @tparam T Configuration type
      * @remark Ensures `T` provides required types and operations for `ProtocolFSM` initialization and behavior.
+     * @remark `minimum_log_level` and `log<Level>` are optional; `log_traits` supplies defaults built on `log_error`.
+     * @remark `lean_memory`, `collect_statistics`, `batch_subnegotiations`, and `urgent_data` are optional; `policy_traits` supplies `default_protocol_fsm_config`'s values.
      * @see `:protocol_fsm` for `ProtocolFSM`, `:protocol_config` for `DefaultProtocolFSMConfig`, RFC 854, RFC 855, RFC 1143
      */
     template<typename T>
@@ -130,7 +132,7 @@ export namespace net::telnet::concepts {
                 T::get_unknown_option_handler()
             } -> std::convertible_to<const typename protocol_fsm<T>::unknown_option_handler_type&>;
             { T::log_error(ec, msg) } -> std::same_as<void>;
-            { T::registered_options.get(opt) } -> std::convertible_to<std::optional<option>>;
+            { T::registered_options.get(opt) } -> std::convertible_to<const option*>;
             { T::registered_options.has(opt) } -> std::same_as<bool>;
             { T::registered_options.upsert(opt) } -> std::convertible_to<const option&>;
             { T::registered_options.upsert(full_opt, ec_out) } -> std::same_as<void>;
@@ -138,4 +140,21 @@ export namespace net::telnet::concepts {
             { T::get_ayt_response() } -> std::same_as<std::string_view>;
             { T::set_ayt_response(msg) } -> std::same_as<void>;
         }; //concept ProtocolFSMConfig
+
+    /**
+     * @concept StaticOptionTableConfig
+     * @brief A `ProtocolFSMConfig` that fixes its supported options at compile time.
+     * @tparam T Configuration type
+     * @remark Satisfied when `T::option_table` is a `static_option_table` usable in constant expressions, e.g. one built by `make_option_table`.
+     * @remark Optional: `ProtocolFSM` falls back to `T::registered_options` for configurations without one.
+     * @see `:options` for `static_option_table`, `:protocol_fsm` for how the table is used
+     */
+    template<typename T>
+    concept StaticOptionTableConfig = requires {
+        { T::option_table.has(option::id_num::binary) } -> std::same_as<bool>;
+        { T::option_table.supports(option::id_num::binary, negotiation_direction::remote) } -> std::same_as<bool>;
+        { T::option_table.supports_subnegotiation(option::id_num::binary) } -> std::same_as<bool>;
+        { T::option_table.max_subnegotiation_size(option::id_num::binary) } -> std::convertible_to<std::size_t>;
+        typename std::bool_constant<T::option_table.has(option::id_num::binary)>; //Must be a constant expression
+    }; //concept StaticOptionTableConfig
 } //namespace net::telnet::concepts
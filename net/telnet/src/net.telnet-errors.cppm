@@ -48,7 +48,13 @@ export namespace net::telnet {
         ignored_go_ahead,        ///< Go-Ahead command ignored due to `SUPPRESS_GO_AHEAD` (@see `:protocol_fsm`)
         user_handler_forbidden,  ///< Attempt to register handler for reserved option (@see `:protocol_fsm`)
         user_handler_not_found,  ///< No handler registered for requested option (@see `:protocol_fsm`)
-        negotiation_queue_error  ///< The negotiation queue bit was set in a forbidden `NegotiationState` (@see `:internal`)
+        negotiation_queue_error, ///< The negotiation queue bit was set in a forbidden `NegotiationState` (@see `:internal`)
+        compression_error,       ///< MCCP compression is unavailable or its zlib stream is corrupt (@see `:compression`, `:stream`)
+        tls_error,               ///< TLS is unavailable or unconfigured, or cannot start in the stream's current state (@see `:tls`, `:stream`)
+        output_dropped,          ///< Queued output was discarded by Abort Output or `slow_consumer_policy::drop_oldest` (@see `:stream`)
+        slow_consumer,           ///< Queued output rose above the high-water mark under `slow_consumer_policy::disconnect` (@see `:stream`)
+        snapshot_unavailable,    ///< Session state cannot be snapshotted while MCCP, TLS, or pending output is active (@see `:stream`)
+        invalid_snapshot         ///< A session snapshot is truncated, corrupt, or from an incompatible format or configuration (@see `:protocol_fsm`, `:stream`)
     }; //enum class error
 
     /**
@@ -66,7 +72,9 @@ export namespace net::telnet {
         abort_output,      ///< Encountered Abort Output (`IAC AO`) in byte stream (@see RFC 854, `:protocol_fsm`)
         interrupt_process, ///< Encountered Interrupt Process (`IAC IP`) in byte stream (@see RFC 854, `:protocol_fsm`)
         telnet_break,      ///< Encountered Break (`IAC BRK`) in byte stream (@see RFC 854, `:protocol_fsm`)
-        data_mark          ///< Encountered Data Mark (`IAC DM`) in byte stream (@see RFC 854, `:protocol_fsm`)
+        data_mark,         ///< Encountered Data Mark (`IAC DM`) in byte stream (@see RFC 854, `:protocol_fsm`)
+        compression_start, ///< Encountered `IAC SB MCCP2 IAC SE` or `IAC SB MCCP3 IAC SE`; the peer's bytes that follow are compressed (@see `:protocol_fsm`, `:stream`)
+        tls_start          ///< Encountered `IAC SB START_TLS FOLLOWS IAC SE`; the peer's bytes that follow are TLS records (@see `:protocol_fsm`, `:stream`)
     }; //enum class processing_signal
 
     /**
@@ -125,6 +133,18 @@ export namespace net::telnet {
                     return "No handler registered for requested option";
                 case error::negotiation_queue_error:
                     return "Telnet negotiation queue bit can only be set when the NegotiationState is WANTYES or WANTNO.";
+                case error::compression_error:
+                    return "MCCP compression unavailable or compressed stream corrupt";
+                case error::tls_error:
+                    return "TLS unavailable, unconfigured, or not startable in the current stream state";
+                case error::output_dropped:
+                    return "Queued Telnet output discarded before it was sent";
+                case error::slow_consumer:
+                    return "Telnet peer too slow to drain queued output; disconnected";
+                case error::snapshot_unavailable:
+                    return "Telnet session state not snapshottable while compressed, encrypted, or writing";
+                case error::invalid_snapshot:
+                    return "Truncated, corrupt, or incompatible Telnet session snapshot";
                 default:
                     [[unlikely]] return "Unknown Telnet error"; // Impossible unless programmer error results in an error code without a defined message
             }
@@ -158,6 +178,18 @@ export namespace net::telnet {
                     return std::errc::operation_not_supported;
                 case error::internal_error:
                     return std::errc::state_not_recoverable;
+                case error::tls_error:
+                    return std::errc::protocol_not_supported;
+                case error::compression_error:
+                    return std::errc::illegal_byte_sequence;
+                case error::output_dropped:
+                    return std::errc::operation_canceled;
+                case error::slow_consumer:
+                    return std::errc::no_buffer_space;
+                case error::snapshot_unavailable:
+                    return std::errc::operation_not_permitted;
+                case error::invalid_snapshot:
+                    return std::errc::invalid_argument;
                 case error::user_handler_forbidden:
                     [[fallthrough]];
                 case error::negotiation_queue_error:
@@ -222,6 +254,10 @@ export namespace net::telnet {
                     return "Telnet encountered \"Break\" command in the byte stream";
                 case processing_signal::data_mark:
                     return "Telnet encountered \"Data Mark\" command in the byte stream";
+                case processing_signal::compression_start:
+                    return "Telnet peer started MCCP compression of the byte stream";
+                case processing_signal::tls_start:
+                    return "Telnet peer started TLS on the byte stream";
                 default:
                     [[unlikely]] return "Unknown Telnet processing signal"; // Impossible unless programmer error results in a signal code without a defined message
             }
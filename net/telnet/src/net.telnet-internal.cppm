@@ -32,7 +32,7 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module partition interface unit
 export module net.telnet:internal;
 
-import std; //NOLINT For std::function, std::optional, std::map, std::set, std::vector, std::shared_mutex, std::shared_lock, std::lock_guard, std::once_flag, std::cout, std::cerr, std::hex, std::setw, std::setfill, std::dec
+import std; //NOLINT For std::function, std::optional, std::set, std::vector, std::array, std::numeric_limits, std::unique_ptr, std::mutex, std::shared_mutex, std::shared_lock, std::lock_guard, std::once_flag, std::atomic, std::clamp, std::jthread, std::condition_variable_any, std::vformat_to, std::shared_ptr, std::cout, std::cerr, std::hex, std::setw, std::setfill, std::dec
 import std.compat; //NOLINT For std::uint8_t (needed for bit-field type specifier)
 
 import :types;      ///< @see "net.telnet-types.cppm" for `byte_t` and `telnet::command`
@@ -52,6 +52,8 @@ export namespace net::telnet {
      * @tparam SubnegotiationHandler Handler type for processing subnegotiation data.
      * @remark Used by `:protocol_fsm` to manage handlers for Telnet options.
      * @remark Instantiated per-`ProtocolFSM` and used in a single thread/strand.
+     * @remark Copies share one immutable handler table until either side registers or unregisters, so many sessions configured alike hold one table between them rather than one each.
+     * @remark Copying, assigning, registering, and unregistering take the registry's mutex, so a prototype may be copied by other threads while its owner modifies it; lookups stay lock-free on the owner's thread.
      * @see `:protocol_fsm` for handler usage, `:options` for `option::id_num`, `:errors` for error codes
      */
     template<
@@ -64,16 +66,84 @@ export namespace net::telnet {
     private:
         /**
          * @brief Record for handlers registered to a single Telnet option.
-         * @details Stores an optional enablement handler, an optional disablement handler, and an optional subnegotiation handler for processing option-specific data.
+         * @details Stores an enablement handler, a disablement handler, and a subnegotiation handler for processing option-specific data; an empty handler means none is registered.
+         * @remark Stores the handlers directly rather than in `std::optional`, since the handler types already have an empty state.
          * @see `:options` for `option::id_num`, `:protocol_fsm` for usage
          */
         struct option_handler_record {
-            std::optional<OptionEnablementHandler> enablement_handler;
-            std::optional<OptionDisablementHandler> disablement_handler;
-            std::optional<SubnegotiationHandler> subnegotiation_handler;
+            option::id_num id{};
+            OptionEnablementHandler enablement_handler;
+            OptionDisablementHandler disablement_handler;
+            SubnegotiationHandler subnegotiation_handler;
         }; //struct option_handler_record
 
+        ///@brief Slot index type; `no_slot` marks an option without registered handlers.
+        using slot_index_type = std::uint16_t;
+
     public:
+        ///@brief The number of possible `option::id_num` values.
+        static constexpr std::size_t max_option_count{
+            std::numeric_limits<std::underlying_type_t<option::id_num>>::max() + std::size_t{1}
+        };
+
+    private:
+        static_assert(
+            max_option_count < std::numeric_limits<slot_index_type>::max(),
+            "`slot_index_type` MUST be able to index every `option::id_num` plus the `no_slot` sentinel."
+        );
+
+        ///@brief Sentinel `slot_index` entry for options without registered handlers.
+        static constexpr slot_index_type no_slot = std::numeric_limits<slot_index_type>::max();
+
+        /**
+         * @brief The handler storage that copies of a registry share.
+         * @details Holds a flat id-indexed table of slots into `records`, mirroring `option_status_db`'s dense layout without reserving a full handler record per option.
+         */
+        struct handler_table {
+            handler_table() noexcept { slot_index.fill(no_slot); }
+
+            std::array<slot_index_type, max_option_count> slot_index;
+            std::vector<option_handler_record> records;
+        }; //struct handler_table
+
+    public:
+        ///@brief Constructs an empty registry without allocating a handler table.
+        option_handler_registry() noexcept = default;
+
+        ///@brief Shares `other`'s handler table, reading it under `other`'s lock.
+        option_handler_registry(const option_handler_registry& other) : table_(other.shared_table()) {}
+
+        ///@brief Takes `other`'s handler table, leaving `other` empty.
+        option_handler_registry(option_handler_registry&& other) noexcept : table_(std::move(other.table_)) {}
+
+        ///@brief Shares `other`'s handler table in place of this registry's own.
+        option_handler_registry& operator=(const option_handler_registry& other)
+        {
+            if (this != &other) {
+                std::shared_ptr<handler_table> table = other.shared_table();
+                const std::lock_guard<std::mutex> lock(mutex_);
+                table_.swap(table);
+            }
+            return *this;
+        } //operator=(const option_handler_registry&)
+
+        ///@brief Takes `other`'s handler table in place of this registry's own, leaving `other` empty.
+        option_handler_registry& operator=(option_handler_registry&& other) noexcept
+        {
+            if (this != &other) {
+                std::shared_ptr<handler_table> table = std::move(other.table_);
+                const std::lock_guard<std::mutex> lock(mutex_);
+                table_.swap(table);
+            }
+            return *this;
+        } //operator=(option_handler_registry&&)
+
+        ///@brief Checks whether this registry shares its handler table with `other`.
+        [[nodiscard]] bool shares_table_with(const option_handler_registry& other) const noexcept
+        {
+            return table_ && (table_ == other.table_);
+        }
+
         /**
          * @brief Registers handlers for a Telnet option.
          * @param opt The `option::id_num` to register handlers for.
@@ -90,61 +160,118 @@ export namespace net::telnet {
             std::optional<SubnegotiationHandler> subnegotiation_handler = std::nullopt
         )
         {
-            handlers_[opt] = option_handler_record{
-                std::move(enablement_handler), std::move(disablement_handler), std::move(subnegotiation_handler)
+            option_handler_record record{
+                opt,
+                std::move(enablement_handler).value_or(OptionEnablementHandler{}),
+                std::move(disablement_handler).value_or(OptionDisablementHandler{}),
+                std::move(subnegotiation_handler).value_or(SubnegotiationHandler{})
             };
+            const std::lock_guard<std::mutex> lock(mutex_);
+            handler_table& table = writable_table();
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            auto& slot = table.slot_index[std::to_underlying(opt)];
+            if (slot != no_slot) {
+                table.records[slot] = std::move(record);
+                return;
+            }
+            table.records.push_back(std::move(record));
+            slot = static_cast<slot_index_type>(table.records.size() - 1);
         } //register_handlers(option::id_num, std::optional<OptionEnablementHandler>, std::optional<OptionDisablementHandler>, std::optional<SubnegotiationHandler>)
 
         /**
          * @brief Unregisters all handlers for a Telnet option.
          * @param opt The `option::id_num` to unregister handlers for.
-         * @remark Removes the handler record from the registry.
+         * @remark Removes the handler record from the registry, moving the last record into its slot to keep `records_` dense.
          * @see `:options` for `option::id_num`
          */
-        void unregister_handlers(option::id_num opt) { handlers_.erase(opt); } //unregister_handlers(option::id_num)
+        void unregister_handlers(option::id_num opt)
+        {
+            if (!find(opt)) {
+                return;
+            }
+            const std::lock_guard<std::mutex> lock(mutex_);
+            handler_table& table = writable_table();
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            auto& slot = table.slot_index[std::to_underlying(opt)];
+            if (slot != (table.records.size() - 1)) {
+                table.records[slot] = std::move(table.records.back());
+                //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+                table.slot_index[std::to_underlying(table.records[slot].id)] = slot;
+            }
+            table.records.pop_back();
+            slot = no_slot;
+        } //unregister_handlers(option::id_num)
 
         ///@brief Handles enablement for a Telnet option.
-        awaitables::option_enablement_awaitable handle_enablement(const option opt, negotiation_direction direction)
+        awaitables::option_enablement_awaitable handle_enablement(const option& opt, negotiation_direction direction)
         {
-            auto iter = handlers_.find(opt);
-            if ((iter != handlers_.end()) && iter->second.enablement_handler) {
-                auto& handler = *(iter->second.enablement_handler);
-                return handler(opt, direction);
+            if (const auto* record = find(opt); record && record->enablement_handler) {
+                return record->enablement_handler(opt, direction);
             }
             return {};
         } //handle_enablement(const option&, negotiation_direction)
 
         ///@brief Handles disablement for a Telnet option.
-        awaitables::option_disablement_awaitable handle_disablement(const option opt, negotiation_direction direction)
+        awaitables::option_disablement_awaitable handle_disablement(const option& opt, negotiation_direction direction)
         {
-            auto iter = handlers_.find(opt);
-            if ((iter != handlers_.end()) && iter->second.disablement_handler) {
-                auto& handler = *(iter->second.disablement_handler);
-                return handler(opt, direction);
+            if (const auto* record = find(opt); record && record->disablement_handler) {
+                return record->disablement_handler(opt, direction);
             }
             return {};
         } //handle_disablement(const option&, negotiation_direction)
 
         ///@brief Handles subnegotiation for a Telnet option.
-        awaitables::subnegotiation_awaitable handle_subnegotiation(const option opt, std::vector<byte_t> data)
+        awaitables::subnegotiation_awaitable handle_subnegotiation(const option& opt, std::span<const byte_t> data)
         {
-            auto iter = handlers_.find(opt);
-            if ((iter != handlers_.end()) && iter->second.subnegotiation_handler) {
-                auto& handler = *(iter->second.subnegotiation_handler);
-                return handler(opt, std::move(data));
-            } else {
-                return undefined_subnegotiation_handler<ProtocolConfig>(opt, std::move(data));
+            if (const auto* record = find(opt); record && record->subnegotiation_handler) {
+                return record->subnegotiation_handler(opt, data);
             }
-        } //handle_subnegotiation(option::id_num, std::vector<byte_t>)
+            return undefined_subnegotiation_handler(opt, data);
+        } //handle_subnegotiation(option::id_num, std::span<const byte_t>)
     private:
+        ///@brief Looks up the handler record for a Telnet option.
+        [[nodiscard]] const option_handler_record* find(option::id_num opt) const noexcept
+        {
+            if (!table_) {
+                return nullptr;
+            }
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            const slot_index_type slot = table_->slot_index[std::to_underlying(opt)];
+            return (slot == no_slot) ? nullptr : &table_->records[slot];
+        } //find(option::id_num)
+
+        ///@brief Copies `table_` under `mutex_`, for a registry about to share it.
+        [[nodiscard]] std::shared_ptr<handler_table> shared_table() const
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            return table_;
+        }
+
+        ///@brief Gets a handler table this registry may modify, allocating or unsharing it first as needed. Requires `mutex_`.
+        handler_table& writable_table()
+        {
+            if (!table_) {
+                table_ = std::make_shared<handler_table>();
+            } else if (table_.use_count() > 1) {
+                table_ = std::make_shared<handler_table>(*table_);
+            }
+            return *table_;
+        } //writable_table()
+
         ///@brief Default handler for undefined subnegotiation.
-        awaitables::subnegotiation_awaitable undefined_subnegotiation_handler(option opt, std::vector<byte_t> /*unused*/)
+        awaitables::subnegotiation_awaitable undefined_subnegotiation_handler(option opt, std::span<const byte_t> /*unused*/)
         {
-            ProtocolConfig::log_error(make_error_code(error::user_handler_not_found), "cmd: {}, option: {}", command::se, opt);
-            co_return;
-        } //undefined_subnegotiation_handler(option::id_num opt, std::vector<byte_t>)
+            log_traits<ProtocolConfig>::template log<log_level::error>(
+                make_error_code(error::user_handler_not_found), "cmd: {}, option: {}", command::se, opt
+            );
+            return {};
+        } //undefined_subnegotiation_handler(option::id_num opt, std::span<const byte_t>)
 
-        std::map<option::id_num, option_handler_record> handlers_;
+        //Null until the first registration; treated as immutable whenever `use_count() > 1`.
+        std::shared_ptr<handler_table> table_;
+
+        //Held while `table_` is copied or replaced, and across the copy-on-write decision and the modification after it.
+        mutable std::mutex mutex_;
     }; //class option_handler_registry
 
     /**
@@ -154,11 +281,19 @@ export namespace net::telnet {
      * @param disablement_handler Optional handler for option disablement.
      * @param subnegotiation_handler Optional handler for subnegotiation (defaults to `std::nullopt`).
      * @remark Overwrites existing handlers for the specified option.
+     * @remark Unshares the handler table first if it is shared with another registry.
      */
     /**
      * @fn void option_handler_registry::unregister_handlers(option::id_num opt)
      * @param opt The `option::id_num` to unregister handlers for.
-     * @remark Removes the handler record from the registry.
+     * @remark Removes the handler record from the registry in constant time by moving the last record into the vacated slot.
+     * @remark Leaves a shared table untouched when `opt` has no handlers.
+     */
+    /**
+     * @fn bool option_handler_registry::shares_table_with(const option_handler_registry& other) const noexcept
+     * @param other The registry to compare with.
+     * @return `true` if both registries reference the same allocated handler table.
+     * @remark Two empty registries share nothing, since neither has allocated a table.
      */
     /**
      * @fn option_enablement_awaitable option_handler_registry::handle_enablement(const option& opt, negotiation_direction direction)
@@ -175,19 +310,31 @@ export namespace net::telnet {
      * @remark Invokes the registered disablement handler if present; otherwise, returns an empty awaitable.
      */
     /**
-     * @fn subnegotiation_awaitable option_handler_registry::handle_subnegotiation(const option& opt, std::vector<byte_t> data)
+     * @fn subnegotiation_awaitable option_handler_registry::handle_subnegotiation(const option& opt, std::span<const byte_t> data)
      * @param opt The `option::id_num` of the Telnet option.
-     * @param data The subnegotiation data to process.
+     * @param data The subnegotiation payload, valid until the returned awaitable completes.
      * @return `subnegotiation_awaitable` representing the asynchronous handling result.
      * @remark Invokes the registered subnegotiation handler if present; otherwise, calls `undefined_subnegotiation_handler`.
      */
     /**
-     * @fn static subnegotiation_awaitable option_handler_registry::undefined_subnegotiation_handler<PC>(const option& opt, std::vector<byte_t>)
-     * @tparam PC The `ProtocolConfig` type for logging.
+     * @fn const option_handler_record* option_handler_registry::find(option::id_num opt) const noexcept
+     * @param opt The `option::id_num` of the Telnet option.
+     * @return Pointer to the handler record for `opt`, or `nullptr` if none is registered.
+     * @remark Resolves with one indexed load from the table's `slot_index`, so every enablement, disablement, and subnegotiation dispatch costs the same regardless of how many options have handlers.
+     */
+    /**
+     * @fn handler_table& option_handler_registry::writable_table()
+     * @return Reference to a handler table referenced by this registry alone.
+     * @throw std::bad_alloc If allocating or copying the table fails; the registry is unchanged.
+     * @remark Copy-on-write: a table shared with another registry is cloned before the first modification, so registering on one session never alters another.
+     * @remark The caller holds `mutex_` from this decision until its modification ends. A count of 1 then cannot grow meanwhile, since this registry holds the only reference and every copy of it takes `mutex_`; a count that falls meanwhile only costs a needless clone.
+     */
+    /**
+     * @fn subnegotiation_awaitable option_handler_registry::undefined_subnegotiation_handler(option opt, std::span<const byte_t>)
      * @param opt The `option::id_num` of the Telnet option.
      * @param data The subnegotiation data (unused).
-     * @return `subnegotiation_awaitable` representing an empty asynchronous result.
-     * @remark Logs an `error::user_handler_not_found` error via `PC::log_error`.
+     * @return An empty `subnegotiation_awaitable`.
+     * @remark Logs an `error::user_handler_not_found` error via `ProtocolConfig::log_error` immediately rather than from a coroutine, so unhandled subnegotiations allocate no frame.
      * @note Used as a fallback when no subnegotiation handler is registered.
      */
 
@@ -446,7 +593,36 @@ export namespace net::telnet {
             return (!local_queue_ || local_pending()) && (!remote_queue_ || remote_pending());
         } //is_valid() noexcept
 
+        //Serialization
+        ///@brief Packs the record into a byte with a fixed, implementation-independent bit layout.
+        [[nodiscard]] std::uint8_t pack() const noexcept
+        {
+            return static_cast<std::uint8_t>(
+                local_state_ | (remote_state_ << 2) | (local_queue_ << 4) | (remote_queue_ << 5)
+            );
+        } //pack() const noexcept
+
+        ///@brief Unpacks a byte produced by `pack()`, rejecting unused bits and inconsistent queue flags.
+        [[nodiscard]] static std::optional<option_status_record> unpack(std::uint8_t packed) noexcept
+        {
+            if ((packed & unused_bits_mask) != 0) {
+                return std::nullopt;
+            }
+            option_status_record record;
+            record.local_state_  = packed & 0x03U;
+            record.remote_state_ = (packed >> 2) & 0x03U;
+            record.local_queue_  = (packed >> 4) & 0x01U;
+            record.remote_queue_ = (packed >> 5) & 0x01U;
+            if (!record.is_valid()) {
+                return std::nullopt;
+            }
+            return record;
+        } //unpack(std::uint8_t) noexcept
+
     private:
+        //The 2 bits of the packed byte that no field occupies.
+        static constexpr std::uint8_t unused_bits_mask = 0xC0U;
+
         //Pack these 4 fields into 1 byte (6 bits used, 2 unused).
         std::uint8_t local_state_  : 2 = std::to_underlying(negotiation_state::no); //us
         std::uint8_t remote_state_ : 2 = std::to_underlying(negotiation_state::no); //him
@@ -686,6 +862,18 @@ export namespace net::telnet {
      * @return True if queue flags are consistent with pending states, false otherwise.
      * @remark Ensures `local_queue_` and `remote_queue_` are false unless respective states are WANTNO or WANTYES. [Optional]
      */
+    /**
+     * @fn std::uint8_t option_status_record::pack() const noexcept
+     * @brief Packs the record into a single byte for a session snapshot.
+     * @return `local_state_` in bits 0-1, `remote_state_` in bits 2-3, `local_queue_` in bit 4, and `remote_queue_` in bit 5.
+     * @remark The layout is spelled out rather than copied from the bit-fields, whose allocation order is implementation-defined, so a snapshot can cross a compiler upgrade.
+     */
+    /**
+     * @fn std::optional<option_status_record> option_status_record::unpack(std::uint8_t packed) noexcept
+     * @param packed A byte produced by `pack()`.
+     * @return The decoded record, or `std::nullopt` if bits 6-7 are set or the result fails `is_valid()`.
+     * @see `protocol_fsm::restore_state` for usage
+     */
 
     /**
      * @brief Collection of `option_status_record` objects for tracking Telnet option statuses.
@@ -721,6 +909,27 @@ export namespace net::telnet {
             std::numeric_limits<std::underlying_type_t<option::id_num>>::max() + std::size_t{1}
         };
 
+        ///@brief Packs every record, in `option::id_num` order, into `out`.
+        void pack(std::span<std::uint8_t, max_option_count> out) const noexcept
+        {
+            std::ranges::transform(status_records_, out.begin(), &option_status_record::pack);
+        } //pack(std::span<std::uint8_t, max_option_count>) const noexcept
+
+        ///@brief Replaces every record from bytes produced by `pack()`, leaving the database untouched on failure.
+        [[nodiscard]] bool unpack(std::span<const std::uint8_t, max_option_count> in) noexcept
+        {
+            std::array<option_status_record, max_option_count> records;
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                auto record = option_status_record::unpack(in[i]);
+                if (!record) {
+                    return false;
+                }
+                records[i] = *record;
+            }
+            status_records_ = records;
+            return true;
+        } //unpack(std::span<const std::uint8_t, max_option_count>) noexcept
+
     private:
         //Byte array of Status Record bit-fields.
         std::array<option_status_record, max_option_count> status_records_;
@@ -742,4 +951,662 @@ export namespace net::telnet {
      *
      * @remark Provides read-only access to the status record.
      */
+    /**
+     * @fn void option_status_db::pack(std::span<std::uint8_t, max_option_count> out) const noexcept
+     *
+     * @param out Destination for one `option_status_record::pack()` byte per option.
+     *
+     * @remark Produces the fixed-size option table of a session snapshot.
+     */
+    /**
+     * @fn bool option_status_db::unpack(std::span<const std::uint8_t, max_option_count> in) noexcept
+     *
+     * @param in One packed byte per option, as produced by `pack()`.
+     * @return True if every byte decoded; false (with no record changed) otherwise.
+     *
+     * @remark Decodes into a scratch table first so a corrupt snapshot cannot leave the database half-restored.
+     */
+
+    /**
+     * @brief The 32-bit little-endian length field of a session snapshot.
+     * @remark Shared by `protocol_fsm::save_state` and `restore_state` for the partial subnegotiation, and by `stream::snapshot` and `restore` for unscanned input.
+     * @see `:protocol_fsm` and `:stream` for usage
+     */
+    struct snapshot_length {
+        ///@brief Bytes the field occupies.
+        static constexpr std::size_t size = 4;
+
+        ///@brief Appends `length` to `out`, least significant byte first.
+        static void append(std::vector<byte_t>& out, std::uint32_t length)
+        {
+            for (std::size_t shift = 0; shift < (size * 8); shift += 8) {
+                out.push_back(static_cast<byte_t>(length >> shift));
+            }
+        } //append(std::vector<byte_t>&, std::uint32_t)
+
+        ///@brief Decodes the field at the front of `in`.
+        [[nodiscard]] static std::optional<std::uint32_t> read(std::span<const byte_t> in) noexcept
+        {
+            if (in.size() < size) {
+                return std::nullopt;
+            }
+            std::uint32_t length = 0;
+            for (std::size_t index = 0; index < size; ++index) {
+                length |= static_cast<std::uint32_t>(in[index]) << (index * 8);
+            }
+            return length;
+        } //read(std::span<const byte_t>) noexcept
+    }; //struct snapshot_length
+
+    /**
+     * @fn void snapshot_length::append(std::vector<byte_t>& out, std::uint32_t length)
+     *
+     * @param out The image being built.
+     * @param length The byte count that follows the field.
+     *
+     * @remark Spelled out byte by byte so a snapshot does not depend on the host's byte order.
+     * @throws std::bad_alloc if `out` cannot grow.
+     */
+    /**
+     * @fn std::optional<std::uint32_t> snapshot_length::read(std::span<const byte_t> in) noexcept
+     *
+     * @param in Bytes beginning with a field written by `append`.
+     * @return The decoded length, or `std::nullopt` if `in` is shorter than `size`.
+     */
+
+    /**
+     * @brief Small per-stream free list of reusable `std::vector<T>` buffers for output staging.
+     * @tparam T The element type of the pooled vectors.
+     * @tparam MaxPooledCapacity The largest vector capacity (in elements) retained for reuse.
+     * @remark Lets the steady-state write path reuse capacity from completed writes instead of allocating per write.
+     * @remark Vectors larger than `max_pooled_capacity` are released to the heap rather than hoarded, bounding idle memory.
+     * @remark Instantiated per-`stream` and used in a single thread/strand.
+     * @see `:stream` for `escape_telnet_output` and `async_write_temp_buffer`
+     */
+    template<typename T, std::size_t MaxPooledCapacity>
+    class vector_pool {
+    public:
+        ///@brief Takes a cleared vector from the pool (or a new one) with at least `capacity_hint` capacity.
+        [[nodiscard]] std::vector<T> acquire(std::size_t capacity_hint)
+        {
+            std::vector<T> buffer;
+            if (pooled_count_ > 0) {
+                buffer = std::move(buffers_[--pooled_count_]);
+                buffer.clear();
+            }
+            buffer.reserve(capacity_hint);
+            return buffer;
+        } //acquire(std::size_t)
+
+        ///@brief Returns a vector to the pool for reuse, or frees it if the pool is full or the vector is oversized.
+        void release(std::vector<T>&& buffer) noexcept
+        {
+            if ((pooled_count_ < max_pooled_buffers) && (buffer.capacity() <= max_pooled_capacity)) {
+                buffers_[pooled_count_++] = std::move(buffer);
+            } else {
+                std::vector<T>{}.swap(buffer);
+            }
+        } //release(std::vector<T>&&)
+
+        ///@brief Frees every pooled vector, returning the pool to its just-constructed footprint.
+        void trim() noexcept
+        {
+            for (auto& buffer : buffers_) {
+                std::vector<T>{}.swap(buffer);
+            }
+            pooled_count_ = 0;
+        } //trim()
+
+        ///@brief The maximum number of idle vectors retained.
+        static constexpr std::size_t max_pooled_buffers = 4;
+
+        ///@brief The largest vector capacity (in elements) retained for reuse.
+        static constexpr std::size_t max_pooled_capacity = MaxPooledCapacity;
+
+    private:
+        std::array<std::vector<T>, max_pooled_buffers> buffers_;
+        std::size_t pooled_count_ = 0;
+    }; //class vector_pool
+
+    /**
+     * @fn std::vector<T> vector_pool::acquire(std::size_t capacity_hint)
+     *
+     * @param capacity_hint The capacity to reserve in the returned vector.
+     * @return An empty vector with capacity of at least `capacity_hint`.
+     *
+     * @remark Allocates only when the pool is empty or the pooled vector is too small for `capacity_hint`.
+     * @throws std::bad_alloc If growing the vector fails.
+     */
+    /**
+     * @fn void vector_pool::release(std::vector<T>&& buffer) noexcept
+     *
+     * @param buffer The vector to return to the pool.
+     *
+     * @remark Retains up to `max_pooled_buffers` vectors no larger than `max_pooled_capacity`; frees all others.
+     */
+    /**
+     * @fn void vector_pool::trim() noexcept
+     *
+     * @remark Used by lean-memory streams once their output queue drains, trading a later reallocation for not holding up to `max_pooled_buffers` idle buffers per session.
+     */
+
+    /**
+     * @typedef escape_buffer_pool
+     * @brief Pool of escaped-output byte buffers, retaining buffers up to 64 KiB.
+     */
+    using escape_buffer_pool = vector_pool<byte_t, std::size_t{64} * 1024>;
+
+    /**
+     * @typedef gather_slice_pool
+     * @brief Pool of scatter/gather slice lists for zero-copy escaped output, retaining lists up to 1024 slices.
+     */
+    using gather_slice_pool = vector_pool<asio::const_buffer, std::size_t{1024}>;
+
+    /**
+     * @brief FIFO queue over one `std::vector<T>` whose capacity is reused, so a steady stream of `push_back`/`pop_front` allocates nothing.
+     * @tparam T The element type; must be nothrow move-constructible and move-assignable.
+     * @remark Unlike `std::deque`, which allocates a new block whenever the tail crosses one, elements only ever move within the retained storage.
+     * @remark `pop_front` advances a head index over moved-from slots; they are reclaimed when the queue empties or when `push_back` would otherwise grow the storage.
+     * @remark Instantiated per-`stream` and used in a single thread/strand.
+     * @see `:stream` for `output_processor::pending_`
+     */
+    template<typename T>
+    class reusable_queue {
+    public:
+        static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>);
+
+        using iterator = typename std::vector<T>::iterator;
+
+        ///@brief Checks if the queue holds no elements.
+        [[nodiscard]] bool empty() const noexcept { return head_ == slots_.size(); }
+
+        ///@brief Gets the number of queued elements.
+        [[nodiscard]] std::size_t size() const noexcept { return slots_.size() - head_; }
+
+        ///@brief Gets the oldest element. @pre `!empty()`
+        [[nodiscard]] T& front() noexcept { return slots_[head_]; }
+
+        ///@brief Gets an iterator to the oldest element.
+        [[nodiscard]] iterator begin() noexcept { return slots_.begin() + static_cast<std::ptrdiff_t>(head_); }
+
+        ///@brief Gets the past-the-end iterator.
+        [[nodiscard]] iterator end() noexcept { return slots_.end(); }
+
+        ///@brief Appends `value`, first compacting the moved-from prefix if the storage is full.
+        void push_back(T&& value)
+        {
+            if ((head_ > 0) && (slots_.size() == slots_.capacity())) {
+                slots_.erase(slots_.begin(), begin());
+                head_ = 0;
+            }
+            slots_.push_back(std::move(value));
+        } //push_back(T&&)
+
+        ///@brief Drops the oldest element, which the caller has normally moved from. @pre `!empty()`
+        void pop_front() noexcept
+        {
+            if (++head_ == slots_.size()) {
+                slots_.clear();
+                head_ = 0;
+            }
+        } //pop_front()
+
+        ///@brief Removes the element at `it`, returning an iterator to the one after it.
+        iterator erase(iterator it) noexcept
+        {
+            it = slots_.erase(it);
+            if (empty()) {
+                slots_.clear();
+                head_ = 0;
+                return slots_.end();
+            }
+            return it;
+        } //erase(iterator)
+
+        ///@brief Frees the storage, returning the queue to its just-constructed footprint. @pre `empty()`
+        void trim() noexcept
+        {
+            std::vector<T>{}.swap(slots_);
+            head_ = 0;
+        } //trim()
+
+    private:
+        std::vector<T> slots_;
+        std::size_t head_ = 0; //Index of the oldest element; slots before it are moved-from
+    }; //class reusable_queue
+
+    /**
+     * @fn void reusable_queue::push_back(T&& value)
+     *
+     * @param value The element to append.
+     *
+     * @remark Allocates only when the live elements alone fill the storage.
+     * @throws std::bad_alloc If the storage must grow and cannot.
+     */
+    /**
+     * @fn typename reusable_queue::iterator reusable_queue::erase(iterator it) noexcept
+     *
+     * @param it An iterator to a live element.
+     * @return An iterator to the element after the erased one, or `end()`.
+     *
+     * @remark Shifts the later elements down by one; used only for the rare removal of a write from the middle of the queue.
+     */
+
+    /**
+     * @brief An `asio::streambuf` that is allocated on first `prepare` and, optionally, freed whenever it is emptied.
+     * @tparam ReleaseWhenEmpty Whether `commit` and `consume` free the storage once no readable bytes remain.
+     * @remark Holds only a null pointer until used, rather than the 128 bytes a default `asio::streambuf` allocates at construction.
+     * @remark With `ReleaseWhenEmpty`, a session between reads holds no side-buffer storage at all; without it, the storage is kept for reuse exactly as a plain `asio::streambuf` would be.
+     * @remark Models the subset of `asio::streambuf` that `:stream` uses; `data()` of an unallocated buffer is an empty sequence.
+     * @remark Instantiated per-`stream` and used in a single thread/strand.
+     * @see `:stream` for `side_buffer_type`, `:protocol_config` for `lean_memory`
+     */
+    template<bool ReleaseWhenEmpty>
+    class lazy_streambuf {
+    public:
+        ///@typedef const_buffers_type @brief The readable byte sequence type of `asio::streambuf`.
+        using const_buffers_type = asio::streambuf::const_buffers_type;
+        ///@typedef mutable_buffers_type @brief The writable byte sequence type of `asio::streambuf`.
+        using mutable_buffers_type = asio::streambuf::mutable_buffers_type;
+
+        ///@brief Gets the number of readable bytes.
+        [[nodiscard]] std::size_t size() const noexcept { return buffer_ ? buffer_->size() : 0; }
+
+        ///@brief Checks whether storage is currently allocated.
+        [[nodiscard]] bool allocated() const noexcept { return static_cast<bool>(buffer_); }
+
+        ///@brief Gets the readable bytes.
+        [[nodiscard]] const_buffers_type data() const noexcept
+        {
+            return buffer_ ? buffer_->data() : const_buffers_type(nullptr, 0);
+        }
+
+        ///@brief Gets `n` writable bytes, allocating the storage first if needed.
+        mutable_buffers_type prepare(std::size_t n)
+        {
+            if (!buffer_) {
+                buffer_ = std::make_unique<asio::streambuf>();
+            }
+            return buffer_->prepare(n);
+        } //prepare(std::size_t)
+
+        ///@brief Moves `n` prepared bytes into the readable sequence.
+        void commit(std::size_t n) noexcept
+        {
+            if (buffer_) {
+                buffer_->commit(n);
+                release_if_empty();
+            }
+        } //commit(std::size_t)
+
+        ///@brief Removes `n` bytes from the front of the readable sequence.
+        void consume(std::size_t n) noexcept
+        {
+            if (buffer_) {
+                buffer_->consume(n);
+                release_if_empty();
+            }
+        } //consume(std::size_t)
+
+    private:
+        ///@brief Frees the storage if `ReleaseWhenEmpty` and no readable bytes remain.
+        void release_if_empty() noexcept
+        {
+            if constexpr (ReleaseWhenEmpty) {
+                if (buffer_->size() == 0) {
+                    buffer_.reset();
+                }
+            }
+        } //release_if_empty()
+
+        std::unique_ptr<asio::streambuf> buffer_;
+    }; //class lazy_streambuf
+
+    /**
+     * @fn const_buffers_type lazy_streambuf::data() const noexcept
+     *
+     * @return The readable bytes, or an empty sequence if no storage is allocated.
+     */
+    /**
+     * @fn mutable_buffers_type lazy_streambuf::prepare(std::size_t n)
+     *
+     * @param n The number of writable bytes required.
+     * @return The writable byte sequence, valid until the next `prepare`, `commit`, or `consume`.
+     *
+     * @throw std::bad_alloc If allocating the storage fails.
+     * @throw std::length_error If `n` exceeds the maximum size of `asio::streambuf`.
+     */
+    /**
+     * @fn void lazy_streambuf::commit(std::size_t n) noexcept
+     *
+     * @param n The number of prepared bytes to make readable; clamped by `asio::streambuf`.
+     *
+     * @remark Committing zero bytes to an otherwise empty buffer frees it when `ReleaseWhenEmpty`, so a read that returned nothing leaves nothing allocated.
+     */
+    /**
+     * @fn void lazy_streambuf::consume(std::size_t n) noexcept
+     *
+     * @param n The number of readable bytes to discard; clamped by `asio::streambuf`.
+     */
+
+    /**
+     * @brief Chooses the size of each `input_processor` read from the sizes of recent reads.
+     * @remark Grows (doubling, up to `maximum`) as soon as a read fills the block, and shrinks (halving, down to `minimum`) after `shrink_after_reads` consecutive reads fill less than a quarter of it, in the style of TCP receive-buffer autotuning.
+     * @remark Setting `minimum == maximum` pins a fixed read size.
+     * @remark Instantiated per-`stream` and used in a single thread/strand.
+     * @see `:stream` for `input_processor` and `stream::set_read_block_size`
+     */
+    class read_size_tuner {
+    public:
+        ///@brief Default smallest read size.
+        static constexpr std::size_t default_minimum = 256;
+        ///@brief Default initial read size.
+        static constexpr std::size_t default_initial = 1024;
+        ///@brief Default largest read size.
+        static constexpr std::size_t default_maximum = std::size_t{64} * 1024;
+        ///@brief Consecutive small reads before shrinking.
+        static constexpr std::uint8_t shrink_after_reads = 4;
+
+        ///@brief Constructs an adaptive tuner with the default bounds.
+        read_size_tuner() noexcept = default;
+
+        ///@brief Sets the read size bounds, clamping the current size into them.
+        void set_limits(std::size_t minimum, std::size_t maximum) noexcept
+        {
+            minimum_     = std::max<std::size_t>(minimum, 1);
+            maximum_     = std::max(maximum, minimum_);
+            current_     = std::clamp(current_, minimum_, maximum_);
+            small_reads_ = 0;
+        } //set_limits(std::size_t, std::size_t)
+
+        ///@brief Gets the size to request for the next read.
+        [[nodiscard]] std::size_t next_read_size() const noexcept { return current_; }
+
+        ///@brief Adapts the read size to the bytes returned by a completed read of `next_read_size()` bytes.
+        void record_read(std::size_t bytes_read) noexcept
+        {
+            if (bytes_read >= current_) {
+                current_     = std::min(current_ * 2, maximum_);
+                small_reads_ = 0;
+            } else if (bytes_read < (current_ / 4)) {
+                if (++small_reads_ >= shrink_after_reads) {
+                    current_     = std::max(current_ / 2, minimum_);
+                    small_reads_ = 0;
+                }
+            } else {
+                small_reads_ = 0;
+            }
+        } //record_read(std::size_t)
+
+    private:
+        std::size_t minimum_     = default_minimum;
+        std::size_t maximum_     = default_maximum;
+        std::size_t current_     = default_initial;
+        std::uint8_t small_reads_ = 0;
+    }; //class read_size_tuner
+
+    /**
+     * @fn void read_size_tuner::set_limits(std::size_t minimum, std::size_t maximum) noexcept
+     * @param minimum The smallest read size (at least 1).
+     * @param maximum The largest read size (raised to `minimum` if smaller).
+     * @remark Resets the small-read count.
+     */
+    /**
+     * @fn void read_size_tuner::record_read(std::size_t bytes_read) noexcept
+     * @param bytes_read The bytes returned by the read.
+     * @remark A full read suggests more data is already queued in the kernel, so growing immediately cuts `async_read_some` round trips for bulk traffic; shrinking waits for a run of small reads so a single short read does not thrash the size.
+     */
+
+    /**
+     * @brief Fixed-capacity single-producer/single-consumer ring of formatted log records.
+     * @remark Owned by one producer thread (via `async_log_sink::local_ring`) and drained by one consumer at a time (serialized by `async_log_sink`).
+     * @remark Formats directly into inline record storage with `std::format_to_n`, so producing a record neither locks nor allocates.
+     * @remark Drops records when full rather than blocking the producer, counting the drops for later reporting.
+     * @see `async_log_sink`, `:protocol_config` for `default_protocol_fsm_config::log`
+     */
+    class log_ring {
+    public:
+        ///@brief Maximum number of records buffered before new records are dropped.
+        static constexpr std::size_t capacity = 128;
+
+        ///@brief Maximum formatted message length; longer messages are truncated.
+        static constexpr std::size_t message_capacity = 240;
+
+        ///@brief Replaces the end of a truncated message, so a reader can tell it was cut short.
+        static constexpr std::string_view truncation_marker = "...";
+
+        ///@brief A single formatted log record.
+        struct record {
+            log_level level;
+            std::error_code ec;
+            std::size_t size;
+            std::array<char, message_capacity> text;
+        }; //struct record
+
+        ///@brief Formats and appends a record; drops it if the ring is full. Producer thread only.
+        template<typename... Args>
+        void try_push(
+            log_level level,
+            const std::error_code& ec,
+            std::format_string<std::remove_cvref_t<Args>...> fmt,
+            Args&&... args
+        ) noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if ((head - tail_.load(std::memory_order_acquire)) == capacity) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            record& slot = records_[head % capacity];
+            try {
+                const auto end = std::vformat_to(
+                    truncating_writer{slot.text.data(), slot.text.data() + message_capacity},
+                    fmt.get(),
+                    std::make_format_args(args...)
+                );
+                slot.size = static_cast<std::size_t>(end.next - slot.text.data());
+                if (end.truncated) {
+                    std::ranges::copy(truncation_marker, slot.text.end() - truncation_marker.size());
+                }
+            } catch (...) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            slot.level = level;
+            slot.ec    = ec;
+            head_.store(head + 1, std::memory_order_release);
+        } //try_push(log_level, const std::error_code&, std::format_string<Args...>, Args&&...)
+
+        ///@brief Invokes `consumer` on each buffered record in order and releases them. Consumer side only.
+        template<typename Consumer>
+        std::size_t drain(Consumer&& consumer)
+        {
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            std::size_t tail       = tail_.load(std::memory_order_relaxed);
+            const std::size_t count = head - tail;
+            for (; tail != head; ++tail) {
+                const record& slot = records_[tail % capacity];
+                consumer(slot.level, slot.ec, std::string_view(slot.text.data(), slot.size));
+                tail_.store(tail + 1, std::memory_order_release);
+            }
+            return count;
+        } //drain(Consumer&&)
+
+        ///@brief Returns and resets the number of records dropped since the last call.
+        std::size_t take_dropped() noexcept { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        ///@brief Output iterator that writes into a fixed span, discarding and flagging overflow.
+        struct truncating_writer {
+            using difference_type = std::ptrdiff_t;
+            char* next;
+            char* end;
+            bool truncated = false;
+            truncating_writer& operator*() noexcept { return *this; }
+            truncating_writer& operator++() noexcept { return *this; }
+            truncating_writer& operator++(int) noexcept { return *this; } //By reference, so `*it++ = chr` advances `it` itself
+            truncating_writer& operator=(char chr) noexcept
+            {
+                if (next != end) {
+                    *next++ = chr;
+                } else {
+                    truncated = true;
+                }
+                return *this;
+            }
+        }; //struct truncating_writer
+
+        static constexpr std::size_t cache_line_size = 64;
+
+        std::array<record, capacity> records_{};
+        alignas(cache_line_size) std::atomic<std::size_t> head_{0}; //Written by the producer only
+        alignas(cache_line_size) std::atomic<std::size_t> tail_{0}; //Written by the consumer only
+        std::atomic<std::size_t> dropped_{0};
+    }; //class log_ring
+
+    /**
+     * @fn void log_ring::try_push(log_level level, const std::error_code& ec, std::format_string<std::remove_cvref_t<Args>...> fmt, Args&&... args) noexcept
+     * @tparam Args Variadic argument type pack.
+     * @param level The severity of the record.
+     * @param ec The error code to record.
+     * @param fmt The format string for the message.
+     * @param args Arguments to format the message.
+     * @remark Formats in place through `truncating_writer`; a message longer than `message_capacity` keeps its first `message_capacity` characters, the last of which are overwritten by `truncation_marker`.
+     * @remark Publishes the record with a `std::memory_order_release` store of `head_` after it is fully written.
+     * @remark Counts (rather than throws) formatting failures and full-ring drops.
+     */
+    /**
+     * @fn std::size_t log_ring::drain(Consumer&& consumer)
+     * @tparam Consumer Callable as `void(log_level, const std::error_code&, std::string_view)`.
+     * @param consumer The callable receiving each record.
+     * @return The number of records drained.
+     * @remark Releases each slot back to the producer as soon as `consumer` returns.
+     */
+
+    /**
+     * @brief Process-wide asynchronous log sink fed by per-thread `log_ring`s and drained by a background thread.
+     * @remark Producers touch only their own thread's ring, so logging on a hot path never contends on a shared lock or cache line.
+     * @remark The background `std::jthread` drains every ring periodically and hands each record to the consumer; `flush` drains synchronously.
+     * @remark Rings of exited threads are drained one last time and then released.
+     * @see `log_ring`, `:protocol_config` for `default_protocol_fsm_config::log`
+     */
+    class async_log_sink {
+    public:
+        /**
+         * @typedef consumer_type
+         * @brief Function type receiving each drained record.
+         */
+        using consumer_type = std::function<void(log_level /*level*/, const std::error_code& /*ec*/, std::string_view /*msg*/)>;
+
+        ///@brief Interval between background drains.
+        static constexpr std::chrono::milliseconds drain_interval{10};
+
+        ///@brief Constructs the sink and starts the background drain thread.
+        explicit async_log_sink(consumer_type consumer)
+            : consumer_(std::move(consumer)), drainer_([this](std::stop_token stop) { run(stop); })
+        {}
+
+        async_log_sink(const async_log_sink&)            = delete;
+        async_log_sink& operator=(const async_log_sink&) = delete;
+
+        ///@brief Stops the background thread, then drains any remaining records.
+        ~async_log_sink()
+        {
+            drainer_.request_stop();
+            if (drainer_.joinable()) {
+                drainer_.join();
+            }
+            flush();
+        } //~async_log_sink()
+
+        ///@brief Gets the calling thread's ring, registering it on first use.
+        log_ring& local_ring()
+        {
+            thread_local std::vector<std::pair<const async_log_sink*, std::shared_ptr<log_ring>>> thread_rings;
+            for (auto& [sink, ring] : thread_rings) {
+                if (sink == this) {
+                    return *ring;
+                }
+            }
+            auto ring = std::make_shared<log_ring>();
+            {
+                const std::lock_guard<std::mutex> lock(rings_mutex_);
+                rings_.push_back(ring);
+            }
+            return *thread_rings.emplace_back(this, std::move(ring)).second;
+        } //local_ring()
+
+        ///@brief Synchronously drains every ring to the consumer.
+        void flush()
+        {
+            const std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+            std::vector<std::shared_ptr<log_ring>> rings;
+            {
+                const std::lock_guard<std::mutex> lock(rings_mutex_);
+                rings = rings_;
+            }
+            std::vector<const log_ring*> expired;
+            for (auto& ring : rings) {
+                //Only `rings_` and this local copy own the ring once its producer thread has exited; sample before draining.
+                const bool producer_exited = (ring.use_count() == 2);
+                ring->drain(consumer_);
+                if (const std::size_t dropped = ring->take_dropped(); dropped > 0) {
+                    const auto note = std::format("{} log record(s) dropped", dropped);
+                    consumer_(log_level::warning, make_error_code(std::errc::no_buffer_space), note);
+                }
+                if (producer_exited) {
+                    expired.push_back(ring.get());
+                }
+            }
+            if (!expired.empty()) {
+                const std::lock_guard<std::mutex> lock(rings_mutex_);
+                std::erase_if(rings_, [&expired](const std::shared_ptr<log_ring>& ring) {
+                    return std::ranges::find(expired, ring.get()) != expired.end();
+                });
+            }
+        } //flush()
+
+    private:
+        ///@brief Background drain loop.
+        void run(const std::stop_token& stop)
+        {
+            std::mutex wait_mutex;
+            std::unique_lock<std::mutex> wait_lock(wait_mutex);
+            while (!stop.stop_requested()) {
+                wake_.wait_for(wait_lock, stop, drain_interval, [] { return false; });
+                flush();
+            }
+        } //run(const std::stop_token&)
+
+        consumer_type consumer_;
+        std::mutex rings_mutex_; //Guards `rings_` registration only; never taken by producers after their first record
+        std::mutex drain_mutex_; //Serializes consumers, as each `log_ring` permits a single consumer at a time
+        std::vector<std::shared_ptr<log_ring>> rings_;
+        std::condition_variable_any wake_;
+        std::jthread drainer_; //Declared last so it starts after, and stops before, the members it uses
+    }; //class async_log_sink
+
+    /**
+     * @fn async_log_sink::async_log_sink(consumer_type consumer)
+     * @param consumer The callable receiving each drained record on the background thread (or the `flush` caller).
+     */
+    /**
+     * @fn async_log_sink::~async_log_sink()
+     * @remark Joins the background thread before the final `flush`, so no record buffered before destruction is lost.
+     */
+    /**
+     * @fn log_ring& async_log_sink::local_ring()
+     * @return Reference to the calling thread's `log_ring` for this sink.
+     * @remark Takes `rings_mutex_` only the first time a thread logs; afterwards it is a `thread_local` lookup.
+     */
+    /**
+     * @fn void async_log_sink::flush()
+     * @remark Drains every ring in order, reports any dropped records as a `log_level::warning` with `std::errc::no_buffer_space`, and releases rings of exited threads.
+     * @remark A ring whose only owners are `rings_` and this call's local copy belongs to an exited thread; its use count can no longer grow, so it is released after its final drain.
+     */
+    /**
+     * @fn void async_log_sink::run(const std::stop_token& stop)
+     * @param stop The stop token of `drainer_`.
+     * @remark Wakes every `drain_interval` (or immediately on stop) and calls `flush`; producers never notify, keeping the hot path free of syscalls.
+     */
 } //namespace net::telnet
@@ -32,7 +32,7 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module partition interface unit
 export module net.telnet:options;
 
-import std; //NOLINT For std::string, std::vector, std::function, std::optional, std::size_t
+import std; //NOLINT For std::string, std::string_view, std::vector, std::function, std::optional, std::size_t, std::set, std::array, std::span, std::atomic, std::deque, std::mutex
 
 export import :types;  ///< @see "net.telnet-types.cppm" for `byte_t`
 export import :errors; ///< @see "net.telnet-errors.cppm" for `error` enum
@@ -138,8 +138,11 @@ export namespace net::telnet {
         ///@brief Predicate that always rejects the `option`.
         [[nodiscard]] static bool always_reject(id_num /*unused*/) noexcept { return false; }
 
+        ///@brief The maximum subnegotiation buffer size used when none is given.
+        static constexpr size_t default_max_subnegotiation_size = 1024;
+
     private:
-        static constexpr size_t max_subnegotiation_buffer_size = 1024;
+        static constexpr size_t max_subnegotiation_buffer_size = default_max_subnegotiation_size;
 
         id_num id_;
         std::string name_;
@@ -336,60 +339,211 @@ export namespace net::telnet {
         // clang-format on
     }; //enum class option::id_num
 
+    /**
+     * @brief Compile-time description of one supported `option`, for a `static_option_table`.
+     * @remark A literal type, so a whole option set can be declared `constexpr` in a `ProtocolFSMConfig`.
+     * @see `static_option_table`, `make_option_table`
+     */
+    struct option_spec {
+        option::id_num id;                                                     ///< The Telnet option ID
+        std::string_view name;                                                 ///< The option name, used for logging
+        bool local_supported        = false;                                   ///< Whether the option may be enabled locally (WILL)
+        bool remote_supported       = false;                                   ///< Whether the option may be enabled remotely (DO)
+        bool subneg_supported       = false;                                   ///< Whether the option accepts subnegotiation
+        std::size_t max_subneg_size = option::default_max_subnegotiation_size; ///< Maximum subnegotiation size (0 for unlimited)
+    }; //struct option_spec
+
+    /**
+     * @brief A `constexpr` table of the options a configuration supports, indexed by `option::id_num`.
+     * @tparam N The number of `option_spec` entries.
+     * @remark Flattened at compile time into a 256-entry flag array and size array, so every query is one indexed load and a mask; with a constant ID it folds away entirely.
+     * @remark Unlike `option_registry`, whose predicates are `std::function`s, the table cannot change at run time; options it omits are always refused.
+     * @remark Later duplicates of an ID replace earlier ones, as in `option_registry`.
+     * @see `make_option_table`, `:protocol_fsm` for how a configuration's `option_table` replaces `registered_options` for negotiation decisions
+     */
+    template<std::size_t N>
+    class static_option_table {
+    public:
+        ///@brief The number of possible `option::id_num` values.
+        static constexpr std::size_t max_option_count{
+            std::numeric_limits<std::underlying_type_t<option::id_num>>::max() + std::size_t{1}
+        };
+
+        ///@brief Builds the lookup tables from `specs`.
+        consteval explicit static_option_table(const std::array<option_spec, N>& specs) : specs_(specs)
+        {
+            max_sizes_.fill(option::default_max_subnegotiation_size);
+            for (const auto& spec : specs_) {
+                const auto index = std::to_underlying(spec.id);
+                flags_[index]    = known_flag | (spec.local_supported ? local_flag : 0) | (spec.remote_supported ? remote_flag : 0)
+                             | (spec.subneg_supported ? subnegotiation_flag : 0);
+                max_sizes_[index] = spec.max_subneg_size;
+            }
+        } //static_option_table(const std::array<option_spec, N>&)
+
+        ///@brief Checks if the table lists `opt_id`.
+        [[nodiscard]] constexpr bool has(option::id_num opt_id) const noexcept { return (flag_bits(opt_id) & known_flag) != 0; }
+
+        ///@brief Checks if `opt_id` may be enabled in `direction`.
+        [[nodiscard]] constexpr bool supports(option::id_num opt_id, negotiation_direction direction) const noexcept
+        {
+            return (flag_bits(opt_id) & ((direction == negotiation_direction::remote) ? remote_flag : local_flag)) != 0;
+        }
+
+        ///@brief Checks if `opt_id` may be enabled locally.
+        [[nodiscard]] constexpr bool supports_local(option::id_num opt_id) const noexcept
+        {
+            return supports(opt_id, negotiation_direction::local);
+        }
+
+        ///@brief Checks if `opt_id` may be enabled remotely.
+        [[nodiscard]] constexpr bool supports_remote(option::id_num opt_id) const noexcept
+        {
+            return supports(opt_id, negotiation_direction::remote);
+        }
+
+        ///@brief Checks if `opt_id` accepts subnegotiation.
+        [[nodiscard]] constexpr bool supports_subnegotiation(option::id_num opt_id) const noexcept
+        {
+            return (flag_bits(opt_id) & subnegotiation_flag) != 0;
+        }
+
+        ///@brief Gets the maximum subnegotiation size for `opt_id` (0 for unlimited).
+        [[nodiscard]] constexpr std::size_t max_subnegotiation_size(option::id_num opt_id) const noexcept
+        {
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            return max_sizes_[std::to_underlying(opt_id)];
+        }
+
+        ///@brief Gets the entries the table was built from.
+        [[nodiscard]] constexpr std::span<const option_spec> specs() const noexcept { return specs_; }
+
+    private:
+        static constexpr std::uint8_t known_flag          = 0x01;
+        static constexpr std::uint8_t local_flag          = 0x02;
+        static constexpr std::uint8_t remote_flag         = 0x04;
+        static constexpr std::uint8_t subnegotiation_flag = 0x08;
+
+        [[nodiscard]] constexpr std::uint8_t flag_bits(option::id_num opt_id) const noexcept
+        {
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            return flags_[std::to_underlying(opt_id)];
+        }
+
+        std::array<option_spec, N> specs_{};
+        std::array<std::uint8_t, max_option_count> flags_{};    //`*_flag` bits per `option::id_num`
+        std::array<std::size_t, max_option_count> max_sizes_{}; //Default size for IDs not in the table
+    }; //class static_option_table
+
+    ///@brief Builds a `static_option_table` from a list of `option_spec`s.
+    template<typename... Specs>
+        requires(std::same_as<Specs, option_spec> && ...)
+    consteval auto make_option_table(Specs... specs)
+    {
+        return static_option_table<sizeof...(Specs)>(std::array<option_spec, sizeof...(Specs)>{specs...});
+    } //make_option_table(Specs...)
+
+    /**
+     * @fn consteval static_option_table::static_option_table(const std::array<option_spec, N>& specs)
+     *
+     * @param specs The supported options.
+     *
+     * @remark IDs not in `specs` are refused in both directions, do not accept subnegotiation, and keep `option::default_max_subnegotiation_size`.
+     */
+    /**
+     * @fn constexpr bool static_option_table::supports(option::id_num opt_id, negotiation_direction direction) const noexcept
+     *
+     * @param opt_id The `option::id_num` to check.
+     * @param direction The direction to check.
+     * @return True if `opt_id` is listed and supported in `direction`.
+     *
+     * @remark Branch-free apart from selecting the direction's mask.
+     */
+    /**
+     * @fn auto make_option_table(Specs... specs)
+     *
+     * @tparam Specs Each `option_spec`.
+     * @param specs The supported options.
+     * @return A `static_option_table<sizeof...(Specs)>`.
+     *
+     * @example
+     *   struct mud_config : telnet::default_protocol_fsm_config {
+     *       static constexpr auto option_table = telnet::make_option_table(
+     *           telnet::option_spec{telnet::option::id_num::suppress_go_ahead, "Suppress Go-Ahead", true, true},
+     *           telnet::option_spec{telnet::option::id_num::gmcp, "GMCP", true, false, true, 4096}
+     *       );
+     *   };
+     */
+
     /**
      * @brief Thread-safe registry for managing `option` instances in the protocol state machine.
      * @remark Used by `ProtocolFSM` to store and query supported Telnet options.
-     * @remark The `std::initializer_list` constructor enforces sorted input by `option::id_num` at compile time using `static_assert`, ensuring O(n) `std::set` construction. Unsorted inputs cause compilation failure. All accessor methods are atomic via `std::shared_mutex`, supporting concurrent reads and exclusive writes.
-     * @warning Methods are guaranteed atomic by `std::shared_mutex`, but chaining operations is NOT thread-safe; however `get` followed by `upsert` provides snapshot consistency.
+     * @remark Publishes each `option` through a flat table of `std::atomic<const option*>` indexed by `option::id_num`; readers perform one acquire load and take no lock and make no copy.
+     * @remark Published `option` objects are immutable and never freed before the registry, so a pointer returned by `get` stays valid for the registry's lifetime even if the entry is later replaced by `upsert`.
+     * @warning Each `upsert` retains its `option` until the registry is destroyed; intended for configuration-time and memoization updates, not per-connection churn.
+     * @warning Individual methods are atomic, but chaining operations is NOT; a `get` concurrent with an `upsert` of the same ID observes either the old or the new `option`.
      * @see RFC 855 for Telnet option negotiation, `:protocol_fsm` for `option` usage in the protocol state machine, `:stream` for negotiation operations, `:types` for `telnet::command`, `option` for option details.
      */
     class option_registry {
     public:
-        ///@brief Constructs a registry from a sorted initializer list of `option` instances.
+        ///@brief The number of possible `option::id_num` values.
+        static constexpr std::size_t max_option_count{
+            std::numeric_limits<std::underlying_type_t<option::id_num>>::max() + std::size_t{1}
+        };
+
+        ///@brief Constructs a registry from an initializer list of `option` instances.
         option_registry(std::initializer_list<option> init)
         {
-            ///@todo Figure out if this can be done as a constant expression.
-            //static_assert(
-            // std::is_sorted(init.begin(), init.end(), std::less<>{}),
-            // "Initializer list must be sorted by option::id_num"
-            //);
-            registry_ = std::set<option, std::less<>>(init.begin(), init.end());
+            for (const auto& opt : init) {
+                upsert(opt);
+            }
         } //option_registry(std::initializer_list<option>)
 
+        ///@brief Constructs a registry holding an `option` for each entry of a `static_option_table`.
+        template<std::size_t N>
+        explicit option_registry(const static_option_table<N>& table)
+        {
+            for (const auto& spec : table.specs()) {
+                upsert(option::make_option(
+                    spec.id,
+                    std::string(spec.name),
+                    spec.local_supported,
+                    spec.remote_supported,
+                    spec.subneg_supported,
+                    spec.max_subneg_size
+                ));
+            }
+        } //option_registry(const static_option_table<N>&)
+
         ///@brief Constructs a registry from a pre-constructed `std::set` of `option` instances.
-        explicit option_registry(std::set<option, std::less<>>&& init) : registry_(std::move(init)) {}
+        explicit option_registry(std::set<option, std::less<>>&& init)
+        {
+            for (const auto& opt : init) {
+                upsert(opt);
+            }
+        } //option_registry(std::set<option, std::less<>>&&)
+
+        option_registry(const option_registry&)            = delete;
+        option_registry& operator=(const option_registry&) = delete;
 
         ///@brief Retrieves an `option` by its ID.
-        std::optional<option> get(option::id_num opt_id) const noexcept
+        [[nodiscard]] const option* get(option::id_num opt_id) const noexcept
         {
-            const std::shared_lock<std::shared_mutex> lock(mutex_);
-            auto iter = registry_.find(opt_id);
-            if (iter != registry_.end()) {
-                return *iter;
-            } else {
-                return std::nullopt;
-            }
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            return table_[std::to_underlying(opt_id)].load(std::memory_order_acquire);
         } //get(option::id_num)
 
         ///@brief Checks if an `option` is present in the registry.
-        [[nodiscard]] bool has(option::id_num opt_id) const noexcept
-        {
-            const std::shared_lock<std::shared_mutex> lock(mutex_);
-            return (registry_.find(opt_id) != registry_.end());
-        } //has(option::id_num)
+        [[nodiscard]] bool has(option::id_num opt_id) const noexcept { return get(opt_id) != nullptr; } //has(option::id_num)
 
         ///@brief Inserts or updates an `option` in the registry.
         const option& upsert(const option& opt)
         {
-            const std::lock_guard<std::shared_mutex> lock(mutex_);
-            auto [add_result, success] = registry_.insert(opt);
-            if (success) {
-                return *add_result;
-            } else {
-                //Use iterator from erase as hint to insert new option at same position, optimizing insertion to O(1)
-                auto replace_result = registry_.insert(registry_.erase(add_result), opt);
-                return *replace_result;
-            }
+            const std::lock_guard<std::mutex> lock(writer_mutex_);
+            const option& published = retained_.emplace_back(opt);
+            //NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): Safe by construction as the array bounds are defined to hold all values of the underlying type.
+            table_[std::to_underlying(published.get_id())].store(&published, std::memory_order_release);
+            return published;
         } //upsert(const option&)
 
         ///@brief Inserts or updates an `option` with error handling.
@@ -414,34 +568,40 @@ export namespace net::telnet {
         } //upsert(option::id_num, Args...)
 
     private:
-        std::set<option, std::less<>> registry_;
-        mutable std::shared_mutex mutex_;
+        std::array<std::atomic<const option*>, max_option_count> table_{}; //Published snapshot per `option::id_num`
+        std::deque<option> retained_;                                     //Stable storage for every published `option`
+        std::mutex writer_mutex_;                                          //Serializes writers only; readers never lock
     }; //class option_registry
 
     /**
      * @fn option_registry::option_registry(std::initializer_list<option> init)
      *
-     * @param init Initializer list of `option` instances, must be sorted by `option::id_num`.
+     * @param init Initializer list of `option` instances.
+     *
+     * @remark Publishes each `option` via `upsert`; later duplicates of an ID replace earlier ones.
+     */
+    /**
+     * @fn option_registry::option_registry(const static_option_table<N>& table)
+     *
+     * @param table The compile-time option table to mirror.
      *
-     * @pre `init` Initializer list MUST be sorted by `option::id_num` in ascending order (enforced at compile time by `static_assert`).
-     * @remark Ensures O(n) construction of the internal `std::set` by requiring sorted input.
-     * @remark Unsorted inputs cause compilation failure, guaranteeing performance for compile-time configurations.
+     * @remark Gives each entry an `option` with `always_accept`/`always_reject` predicates matching the table, for handler dispatch and logging.
      */
     /**
      * @fn option_registry::option_registry(std::set<option, std::less<>>&& init)
      *
-     * @param init A `std::set` of `option` instances, moved into the registry.
+     * @param init A `std::set` of `option` instances.
      *
      * @remark Allows advanced use cases where options are pre-sorted or dynamically generated before registry creation.
      */
     /**
-     * @fn std::optional<option> option_registry::get(option::id_num opt_id) const noexcept
+     * @fn const option* option_registry::get(option::id_num opt_id) const noexcept
      *
      * @param opt_id The `option::id_num` to query.
-     * @return `std::optional` containing the `option` if found, or `std::nullopt` if not.
+     * @return Pointer to the published `option` if found, or `nullptr` if not.
      *
-     * @remark Thread-safe via `std::shared_mutex` (shared lock).
-     * @remark Performs O(log n) lookup.
+     * @remark Lock-free and copy-free: one `std::memory_order_acquire` load from the ID-indexed table.
+     * @remark The pointee is immutable and remains valid for the lifetime of the registry.
      */
     /**
      * @fn bool option_registry::has(option::id_num opt_id) const noexcept
@@ -449,17 +609,16 @@ export namespace net::telnet {
      * @param opt_id The `option::id_num` to check.
      * @return True if the `option` exists, false otherwise.
      *
-     * @remark Thread-safe via `std::shared_mutex` (shared lock).
-     * @remark Performs O(log n) lookup.
+     * @remark Lock-free; equivalent to `get(opt_id) != nullptr`.
      */
     /**
      * @fn const option& option_registry::upsert(const option& opt)
      *
      * @param opt The `option` to insert or update.
-     * @return Reference to the inserted or updated `option` in the registry.
+     * @return Reference to the published `option` in the registry.
      *
-     * @remark Thread-safe via `std::shared_mutex` (exclusive lock).
-     * @remark Performs O(log n) insertion or replacement, using `erase` result iterator as a hint to optimize `insert` performance during replacement.
+     * @remark Copies `opt` into retained storage under `writer_mutex_`, then publishes it with a `std::memory_order_release` store so concurrent readers see a fully constructed `option`.
+     * @remark A replaced `option` is not freed, so readers holding a pointer to it are unaffected.
      */
     /**
      * @overload void option_registry::upsert(const option& opt, std::error_code& ec) noexcept
@@ -546,4 +705,23 @@ export namespace std {
             }
         } //format(const ::net::telnet::option&, FormatContext&)
     }; //class formatter<::net::telnet::option>
+
+    /**
+     * @brief Formatter specialization for `const ::net::telnet::option*`, as `protocol_fsm` holds its current option.
+     * @remark Formats a non-null pointer exactly as the `option` it points to, accepting the same specifiers, and a null pointer as "N/A".
+     * @remark Lets a log call pass the pointer itself, so nothing is formatted unless the record is actually logged.
+     * @see `:protocol_fsm` for logging usage.
+     */
+    template<>
+    struct formatter<const ::net::telnet::option*, char> : formatter<::net::telnet::option, char> {
+        ///@brief Formats the pointed-to `option`, or "N/A" for a null pointer.
+        template<typename FormatContext>
+        auto format(const ::net::telnet::option* opt, FormatContext& ctx) const
+        {
+            if (opt == nullptr) {
+                return std::format_to(ctx.out(), "N/A");
+            }
+            return formatter<::net::telnet::option, char>::format(*opt, ctx);
+        } //format(const ::net::telnet::option*, FormatContext&)
+    }; //struct formatter<const ::net::telnet::option*>
 } //namespace std
@@ -21,6 +21,9 @@
  *
  * @brief Default configuration implementation for `ProtocolFSM`.
  * @remark Provides thread-safe, static configuration with option registry and handlers.
+ * @remark Logs errors synchronously to the `error_logger` and lesser levels through a lock-free asynchronous sink, filtered at compile time by `log_traits` against `minimum_log_level` and at run time by `set_log_level`.
+ * @remark Derive from `default_protocol_fsm_config` and hide `minimum_log_level`, `lean_memory`, `collect_statistics`, `batch_subnegotiations`, or `urgent_data` to change a compile-time policy while keeping the shared static state.
+ * @remark A derived configuration may also add a `constexpr` `option_table` (see `make_option_table`), which then decides option support in place of `registered_options`.
  * @example
  *   telnet::ProtocolFSM<> fsm;
  *   telnet::default_protocol_fsm_config::set_error_logger([](const std::error_code& ec, std::string msg) {
@@ -33,13 +36,15 @@
 //Module partition interface unit
 export module net.telnet:protocol_config;
 
-import std; //NOLINT For std::shared_mutex, std::lock_guard, std::shared_lock, std::function, std::error_code, std::string, std::once_flag
+import std; //NOLINT For std::shared_mutex, std::lock_guard, std::shared_lock, std::function, std::error_code, std::string, std::once_flag, std::atomic
 
 export import :types;    ///< @see "net.telnet-types.cppm" for `byte_t` and `telnet::command`
 export import :errors;   ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
 export import :concepts; ///< @see "net.telnet-concepts.cppm" for `telnet::concepts::ProtocolFSMConfig`
 export import :options;  ///< @see "net.telnet-options.cppm" for `option` and `option::id_num`
 
+import :internal; ///< @see "net.telnet-internal.cppm" for `async_log_sink`
+
 export namespace net::telnet {
     /**
      * @brief Default configuration class for `ProtocolFSM`, encapsulating options and handlers.
@@ -63,6 +68,21 @@ export namespace net::telnet {
          */
         using error_logger_type = std::function<void(const std::error_code& /*ec*/, const std::string& /*msg*/)>;
 
+        ///@brief The least severe `log_level` compiled in; `log_traits` discards calls below it at compile time.
+        static constexpr log_level minimum_log_level = log_level::info;
+
+        ///@brief Whether sessions release idle buffers and wait for readability before allocating read space; see `stream` for the budget.
+        static constexpr bool lean_memory = false;
+
+        ///@brief Whether each `stream` keeps `stream_statistics`; `false` compiles the counters out entirely.
+        static constexpr bool collect_statistics = true;
+
+        ///@brief Whether a read collects every subnegotiation found in its buffered input and runs their handlers as one batch, rather than suspending at each.
+        static constexpr bool batch_subnegotiations = false;
+
+        ///@brief How each `stream` notices TCP urgent data; `urgent_data_policy::at_mark` needs no pending receive per session.
+        static constexpr urgent_data_policy urgent_data = urgent_data_policy::oob_wait;
+
         ///@brief Initializes the configuration once.
         static void initialize() { std::call_once(initialization_flag, &init); }
 
@@ -87,16 +107,39 @@ export namespace net::telnet {
             return unknown_option_handler;
         }
 
+        ///@brief Sets the least severe `log_level` delivered at run time; levels below `minimum_log_level` stay compiled out.
+        static void set_log_level(log_level level) noexcept { runtime_log_level.store(level, std::memory_order_relaxed); }
+
+        ///@brief Gets the least severe `log_level` delivered at run time.
+        static log_level get_log_level() noexcept { return runtime_log_level.load(std::memory_order_relaxed); }
+
+        ///@brief Logs a message at `Level`, unless `set_log_level` filters it out; compile-time filtering is left to `log_traits`.
+        template<log_level Level, typename... Args>
+        static void log(const std::error_code& ec, std::format_string<std::remove_cvref_t<Args>...> fmt, Args&&... args)
+        {
+            if (Level < runtime_log_level.load(std::memory_order_relaxed)) {
+                return; //Checked before formatting, so a filtered record costs one relaxed load
+            }
+            if constexpr (Level >= log_level::error) {
+                const std::shared_lock<std::shared_mutex> lock(mutex);
+                if (error_logger) {
+                    error_logger(ec, std::format(fmt, std::forward<Args>(args)...));
+                }
+            } else {
+                log_sink().local_ring().try_push(Level, ec, fmt, std::forward<Args>(args)...);
+            }
+        } //log(const std::error_code&, std::format_string<Args...>, Args&&...)
+
         ///@brief Logs an error with the registered error logger using a formatted string.
         template<typename... Args>
         static void log_error(const std::error_code& ec, std::format_string<std::remove_cvref_t<Args>...> fmt, Args&&... args)
         {
-            const std::shared_lock<std::shared_mutex> lock(mutex);
-            if (error_logger) {
-                error_logger(ec, std::format(fmt, std::forward<Args>(args)...));
-            }
+            log<log_level::error>(ec, fmt, std::forward<Args>(args)...);
         }
 
+        ///@brief Synchronously delivers every buffered (below `log_level::error`) record to the error logger.
+        static void flush_log() { log_sink().flush(); }
+
         ///@brief Gets the AYT response string.
         static std::string_view get_ayt_response()
         {
@@ -131,6 +174,18 @@ export namespace net::telnet {
         static inline option_registry registered_options = initialize_option_registry();
 
     private:
+        ///@brief Gets the process-wide asynchronous log sink, starting it on first use.
+        static async_log_sink& log_sink()
+        {
+            static async_log_sink sink([](log_level /*level*/, const std::error_code& ec, std::string_view msg) {
+                const std::shared_lock<std::shared_mutex> lock(mutex);
+                if (error_logger) {
+                    error_logger(ec, std::string(msg));
+                }
+            });
+            return sink;
+        } //log_sink()
+
         ///@brief Performs initialization for `initialize`.
         static void init()
         {
@@ -148,6 +203,7 @@ export namespace net::telnet {
         static inline error_logger_type error_logger;
         static inline std::string ayt_response = "Telnet system is active."; ///Default AYT response
         static inline std::shared_mutex mutex;                               ///Mutex to protect shared static members
+        static inline std::atomic<log_level> runtime_log_level{log_level::trace}; ///Run-time threshold; lock-free for `log`
         static inline std::once_flag initialization_flag; ///Ensures initialize() is idempotent; only invokes init() once
     }; //class default_protocol_fsm_config
 
@@ -178,6 +234,30 @@ export namespace net::telnet {
      *
      * @remark Thread-safe via `std::shared_lock<std::shared_mutex>`.
      */
+    /**
+     * @fn template<log_level Level, typename ...Args> void default_protocol_fsm_config::log(const std::error_code& ec, std::format_string<auto> fmt, Args&&... args)
+     *
+     * @tparam Level The severity of the message.
+     * @tparam Args Variadic argument type pack.
+     * @param ec The error code to log.
+     * @param fmt The format string for the message.
+     * @param args Arguments to format the message.
+     *
+     * @remark Returns before formatting when `Level` is below `get_log_level()`.
+     * @remark Does not compare `Level` with `minimum_log_level`: `log_traits` does, using the calling configuration's own value, so a derived configuration that hides `minimum_log_level` with a lower level receives those levels here.
+     * @remark `log_level::error` records are formatted and passed to the registered `error_logger` on the calling thread, under `std::shared_lock<std::shared_mutex>`, as `log_error` always has.
+     * @remark Lesser levels are formatted into the calling thread's `log_ring` without locking or allocating; the background thread of `log_sink` later invokes the registered `error_logger`.
+     * @remark Buffered records are dropped (and the drop count reported) if a thread outpaces the drain; the producer never blocks.
+     * @remark Buffered messages longer than `log_ring::message_capacity` are cut short and end in `log_ring::truncation_marker`.
+     * @note Because errors bypass the buffer, an error can reach the `error_logger` before a warning logged just before it; call `flush_log` first where that order matters.
+     */
+    /**
+     * @fn void default_protocol_fsm_config::set_log_level(log_level level) noexcept
+     *
+     * @param level The least severe level to deliver; `log_level::off` silences everything.
+     *
+     * @remark Thread-safe; a relaxed atomic, so other threads observe the change promptly but not at a defined point.
+     */
     /**
      * @fn template<typename ...Args> void default_protocol_fsm_config::log_error(const std::error_code& ec, std::format_string<auto> fmt, Args&&... args)
      *
@@ -186,8 +266,14 @@ export namespace net::telnet {
      * @param fmt The format string for the error message.
      * @param args Arguments to format the error message.
      *
-     * @remark Formats the message using std::format and invokes the registered `error_logger`.
-     * @remark Thread-safe via `std::shared_lock<std::shared_mutex>`.
+     * @remark Equivalent to `log<log_level::error>`: the registered `error_logger` runs on the calling thread before `log_error` returns.
+     * @remark Like `log`, filtered only at run time; the library's own errors go through `log_traits`, which applies `minimum_log_level` first.
+     */
+    /**
+     * @fn void default_protocol_fsm_config::flush_log()
+     *
+     * @remark Drains every thread's ring to the `error_logger` before returning; useful before shutdown or in tests of logging output.
+     * @note The `error_logger` runs on the flushing thread here, and on the sink's background thread otherwise, for every level below `log_level::error`.
      */
     /**
      * @fn std::string_view default_protocol_fsm_config::get_ayt_response()
@@ -211,6 +297,13 @@ export namespace net::telnet {
      * @remark Initializes options for `BINARY`, `SUPPRESS_GO_AHEAD`, and `STATUS` to support default implementations.
      * @note `STATUS` is supported locally but not remotely by default as the core implementation can send a status report but will not request one and cannot understand receipt of one.
      */
+    /**
+     * @fn async_log_sink& default_protocol_fsm_config::log_sink()
+     *
+     * @return Reference to the function-local static `async_log_sink`.
+     *
+     * @remark The sink's consumer takes `std::shared_lock<std::shared_mutex>` on the drain thread only, so `set_error_logger` never races with delivery.
+     */
     /**
      * @fn void default_protocol_fsm_config::init()
      *
@@ -41,6 +41,7 @@ export import :errors;     ///< @see "net.telnet-errors.cppm" for `telnet::error
 export import :concepts;   ///< @see "net.telnet-concepts.cppm" for `telnet::concepts::ProtocolFSMConfig`
 export import :options;    ///< @see "net.telnet-options.cppm" for `option` and `option::id_num`
 export import :awaitables; ///< @see "net.telnet-awaitables.cppm" for `TaggedAwaitable`, semantic tags, and type aliases
+export import :statistics; ///< @see "net.telnet-statistics.cppm" for `stream_statistics`
 
 import :internal;        ///< @see "net.telnet-internal.cppm" for implementation classes
 import :protocol_config; ///< @see "net.telnet-protocol_config.cppm" for `default_protocol_fsm_config`
@@ -50,6 +51,7 @@ import :protocol_config; ///< @see "net.telnet-protocol_config.cppm" for `defaul
 namespace net::telnet {
     //Non-exported using declarations to simplify template constraints below.
     using concepts::ProtocolFSMConfig;
+    using concepts::StaticOptionTableConfig;
 } //namespace net::telnet
 
 export namespace net::telnet {
@@ -58,6 +60,7 @@ export namespace net::telnet {
      * @tparam ConfigT Configuration class defining options and handlers (defaults to `default_protocol_fsm_config`).
      * @remark Initialized to `protocol_state::normal` per RFC 854.
      * @remark Thread-safe for `protocol_config_type` access via `mutex_`.
+     * @remark If `ConfigT` is a `StaticOptionTableConfig`, accept/reject decisions, subnegotiation limits, and the BINARY check come from `ConfigT::option_table` at compile time instead of `registered_options`.
      * @see RFC 854 for Telnet protocol, RFC 855 for option negotiation, `:options` for `option` and `option::id_num`, `:types` for `telnet::command`, `:errors` for error codes, `:stream` for FSM usage, `:internal` for implementation classes
      */
     template<typename ConfigT = default_protocol_fsm_config>
@@ -95,11 +98,12 @@ export namespace net::telnet {
          * @typedef subnegotiation_handler_type
          * @brief Function type for processing subnegotiation data.
          * @param id The `option::id_num` identifying the option.
-         * @param data The `std::vector<byte_t>` containing subnegotiation data.
+         * @param data A view of the unescaped subnegotiation payload, valid until the returned awaitable completes.
          * @return `subnegotiation_awaitable` for asynchronous subnegotiation handling.
+         * @note The view may point into the stream's input buffer; copy it to keep the payload past the awaitable.
          */
         using subnegotiation_handler_type =
-            std::function<awaitables::subnegotiation_awaitable(const option& /*id*/, std::vector<byte_t> /*data*/)>;
+            std::function<awaitables::subnegotiation_awaitable(const option& /*id*/, std::span<const byte_t> /*data*/)>;
 
         /**
          * @typedef unknown_option_handler_type
@@ -123,6 +127,17 @@ export namespace net::telnet {
          */
         using negotiation_response_type = std::tuple<negotiation_direction, bool, option::id_num>;
 
+        /**
+         * @typedef option_handlers_type
+         * @brief Copy-on-write set of option handlers; copies share one handler table until modified.
+         */
+        using option_handlers_type = option_handler_registry<
+            protocol_config_type,
+            option_enablement_handler_type,
+            option_disablement_handler_type,
+            subnegotiation_handler_type
+        >;
+
         /**
          * @typedef processing_return_variant
          * @brief Variant type for return values from byte processing.
@@ -136,6 +151,9 @@ export namespace net::telnet {
             awaitables::subnegotiation_awaitable
         >;
 
+        ///@brief The START_TLS subnegotiation payload after which the sender's bytes are TLS records.
+        static constexpr byte_t start_tls_follows = 0x01;
+
         ///@brief Constructs the FSM, initializing `protocol_config_type` once.
         protocol_fsm() { ConfigT::initialize(); }
 
@@ -154,14 +172,49 @@ export namespace net::telnet {
         ///@brief Unregisters handlers for an option.
         void unregister_option_handlers(option::id_num opt) { option_handler_registry_.unregister_handlers(opt); }
 
+        /**
+         * @typedef statistics_type
+         * @brief The statistics block type selected by `policy_traits<ConfigT>::collect_statistics`.
+         */
+        using statistics_type = stream_statistics<policy_traits<ConfigT>::collect_statistics>;
+
+        ///@brief Sets the statistics block that FSM-level counters are added to, or `nullptr` for none.
+        void set_statistics(statistics_type* statistics) noexcept { statistics_ = statistics; }
+
+        ///@brief Gets the option handlers, e.g. to share them with other FSMs via `set_option_handlers`.
+        [[nodiscard]] const option_handlers_type& option_handlers() const noexcept { return option_handler_registry_; }
+
+        ///@brief Replaces the option handlers, sharing `handlers`' table rather than copying it.
+        void set_option_handlers(option_handlers_type handlers) noexcept
+        {
+            option_handler_registry_ = std::move(handlers);
+        }
+
         ///@brief Processes a single byte of Telnet input.
         std::tuple<std::error_code, bool, std::optional<processing_return_variant>> process_byte(byte_t byte);
 
+        ///@brief Scans the leading run of plain data bytes in `data` that `process_byte` would forward unchanged.
+        [[nodiscard]] std::size_t process_span(std::span<const byte_t> data) const noexcept;
+
+        ///@brief Completes a subnegotiation whose whole payload and `IAC SE` lie in `data`, handing the handler a view of `data` instead of buffering it.
+        std::tuple<std::size_t, std::error_code, std::optional<processing_return_variant>>
+            process_subnegotiation_span(std::span<const byte_t> data);
+
         ///@brief Checks if an option is enabled locally or remotely.
-        bool is_enabled(option::id_num opt) { return option_status_[opt].is_enabled(); }
+        bool is_enabled(option::id_num opt) const { return option_status_[opt].is_enabled(); }
 
         ///@brief Checks if an option is enabled in a specified direction.
-        bool is_enabled(option::id_num opt, negotiation_direction dir) { return option_status_[opt].enabled(dir); }
+        bool is_enabled(option::id_num opt, negotiation_direction dir) const { return option_status_[opt].enabled(dir); }
+
+        ///@brief Checks if BINARY is in effect in `direction`, from the mode bitmask cached when option state changes.
+        [[nodiscard]] bool binary_enabled(negotiation_direction direction) const noexcept
+        {
+            if constexpr (!binary_negotiable) {
+                return false;
+            } else {
+                return (mode_ & ((direction == negotiation_direction::remote) ? binary_remote_mode : binary_local_mode)) != 0;
+            }
+        }
 
         ///@brief Makes a negotiation response command
         static telnet::command make_negotiation_command(negotiation_direction direction, bool enable) noexcept;
@@ -177,6 +230,18 @@ export namespace net::telnet {
             std::optional<awaitables::option_disablement_awaitable>
         > disable_option(option::id_num opt, negotiation_direction direction);
 
+        ///@brief The leading byte of every `save_state` image; bumped whenever the layout changes.
+        static constexpr byte_t state_format_version = 0x01;
+
+        ///@brief Appends a compact binary image of the option states and the parser's partial command to `out`.
+        void save_state(std::vector<byte_t>& out) const;
+
+        ///@brief Replaces the option states and partial command from an image at the front of `image`, without emitting any negotiation.
+        [[nodiscard]] std::tuple<std::size_t, std::error_code> restore_state(std::span<const byte_t> image);
+
+        ///@brief Gets the length of the `save_state` image at the front of `image` from its length field alone.
+        [[nodiscard]] static std::optional<std::size_t> state_image_size(std::span<const byte_t> image) noexcept;
+
     private:
         enum class protocol_state : std::uint8_t {
             normal,                ///< Default state for data processing
@@ -188,6 +253,47 @@ export namespace net::telnet {
             subnegotiation_iac     ///< Processing IAC during subnegotiation
         };
 
+        ///@brief Whether `ConfigT` declares a compile-time `option_table`.
+        static constexpr bool has_option_table = StaticOptionTableConfig<ConfigT>;
+
+        ///@brief Whether BINARY can ever be enabled; `false` when `option_table` omits it.
+        static constexpr bool binary_negotiable = [] {
+            if constexpr (has_option_table) {
+                return ConfigT::option_table.has(option::id_num::binary);
+            } else {
+                return true;
+            }
+        }();
+
+        ///@brief Gets the registry supplying `option` objects: one mirroring `option_table`, or `registered_options`.
+        static option_registry& option_source();
+
+        ///@brief Checks if `opt` is supported at all, via `option_table` or `registered_options`.
+        [[nodiscard]] static bool knows_option(option::id_num opt) noexcept;
+
+        ///@brief Checks if `opt` may be enabled in `direction`, via `option_table` or `opt`'s predicate.
+        [[nodiscard]] static bool supports(const option& opt, negotiation_direction direction);
+
+        ///@brief Checks if `opt` accepts subnegotiation, via `option_table` or `opt`.
+        [[nodiscard]] static bool supports_subnegotiation(const option& opt) noexcept;
+
+        ///@brief Gets `opt`'s maximum subnegotiation size, via `option_table` or `opt`.
+        [[nodiscard]] static std::size_t max_subnegotiation_size(const option& opt) noexcept;
+
+        ///@brief Bytes of a `save_state` image before the partial subnegotiation payload: version, option records, state, command, option, and length.
+        static constexpr std::size_t state_image_fixed_size = 1 + option_status_db::max_option_count + 1 + 2 + 2 + snapshot_length::size;
+
+        ///@brief Bits of `mode_`.
+        static constexpr std::uint8_t binary_local_mode  = 0x01;
+        static constexpr std::uint8_t binary_remote_mode = 0x02;
+
+        ///@brief Recomputes `mode_` if `opt` is one of the options it caches.
+        void refresh_mode(option::id_num opt) noexcept;
+
+        ///@brief Scans the leading plain data run of `data` for one BINARY mode.
+        template<bool RemoteBinary>
+        [[nodiscard]] static std::size_t scan_plain_run(std::span<const byte_t> data) noexcept;
+
         ///@brief Changes the FSM state.
         void change_state(protocol_state next_state) noexcept;
 
@@ -215,23 +321,37 @@ export namespace net::telnet {
         std::tuple<std::error_code, bool, std::optional<processing_return_variant>>
             handle_state_subnegotiation_iac(byte_t byte);
 
+        ///@brief Pairs a handler awaitable with an optional negotiation reply, dropping the awaitable if no handler is registered.
+        template<typename Tag>
+        static std::optional<processing_return_variant> handler_response(
+            awaitables::tagged_awaitable<Tag, void> awaitable,
+            std::optional<negotiation_response_type> reply
+        );
+
+        ///@brief Dispatches a complete subnegotiation payload at `IAC SE` and returns to `protocol_state::normal`.
+        std::tuple<std::error_code, std::optional<processing_return_variant>>
+            complete_subnegotiation(std::span<const byte_t> payload);
+
+        ///@brief Dispatches a subnegotiation payload to the STATUS helper or the registered handler.
+        awaitables::subnegotiation_awaitable dispatch_subnegotiation(const option& opt, std::span<const byte_t> payload);
+
+        ///@brief Keeps `payload` alive in the coroutine frame while `handler` runs (`lean_memory` or `batch_subnegotiations` only).
+        static auto handle_owned_subnegotiation(std::vector<byte_t> payload, awaitables::subnegotiation_awaitable handler)
+            -> awaitables::subnegotiation_awaitable;
+
         ///@brief Handles STATUS subnegotiation (RFC 859), returning an awaitable with the IS [list] payload or user-handled result.
-        auto handle_status_subnegotiation(option opt, std::vector<byte_t> buffer) -> awaitables::subnegotiation_awaitable;
+        auto handle_status_subnegotiation(option opt, std::span<const byte_t> buffer) -> awaitables::subnegotiation_awaitable;
 
         //Data Members
-        option_handler_registry<
-            protocol_config_type,
-            option_enablement_handler_type,
-            option_disablement_handler_type,
-            subnegotiation_handler_type
-        >
-            option_handler_registry_;
+        option_handlers_type option_handler_registry_;
         option_status_db option_status_;
 
         protocol_state current_state_ = protocol_state::normal;
         std::optional<telnet::command> current_command_;
-        std::optional<option> current_option_;
-        std::vector<byte_t> subnegotiation_buffer_;
+        const option* current_option_ = nullptr; //Points into `option_source()`, which never frees a published option
+        std::uint8_t mode_ = 0; //`binary_*_mode` bits, kept in step with `option_status_` by `refresh_mode`
+        std::vector<byte_t> subnegotiation_buffer_; //Reused across subnegotiations; handlers may view it until their awaitable completes
+        statistics_type* statistics_ = nullptr; //The owning `stream`'s block; FSM-level counters only
     }; //class protocol_fsm
 
     /**
@@ -256,6 +376,27 @@ export namespace net::telnet {
      *
      * @remark Forwards to `OptionHandlerRegistry::unregister_handlers`.
      */
+    /**
+     * @fn void protocol_fsm::set_statistics(statistics_type* statistics) noexcept
+     *
+     * @param statistics The block to count into; must outlive the FSM or be reset first.
+     *
+     * @remark The FSM counts only `statistic::subnegotiation_bytes`; `stream` counts the rest around its calls into the FSM.
+     */
+    /**
+     * @fn const option_handlers_type& protocol_fsm::option_handlers() const noexcept
+     *
+     * @return Const reference to this FSM's `option_handlers_type`.
+     *
+     * @remark Copying the result is cheap: the copy shares the handler table.
+     */
+    /**
+     * @fn void protocol_fsm::set_option_handlers(option_handlers_type handlers) noexcept
+     *
+     * @param handlers The handlers to adopt, typically a copy of a prototype's `option_handlers()`.
+     *
+     * @remark A later `register_option_handlers` or `unregister_option_handlers` on this FSM unshares the table first, leaving every other holder unaffected.
+     */
     /**
      * @fn std::tuple<std::error_code, bool, std::optional<processing_return_variant>> protocol_fsm::process_byte(byte_t byte)
      *
@@ -267,7 +408,31 @@ export namespace net::telnet {
      * @see RFC 854 for Telnet protocol, RFC 855 for option negotiation, :errors for error codes
      */
     /**
-     * @fn bool protocol_fsm::is_enabled(const option& opt)
+     * @fn std::size_t protocol_fsm::process_span(std::span<const byte_t> data) const noexcept
+     *
+     * @param data The contiguous input bytes to scan.
+     * @return The number of leading bytes in `data` that are plain data (0 if the first byte requires `process_byte` or the FSM is not in `protocol_state::normal`).
+     *
+     * @remark Bulk fast path for `protocol_state::normal`: stops at the first `IAC`, `'\0'`, or (unless remote `BINARY` is enabled) `'\r'`.
+     * @remark Selects the text-mode or binary-mode instantiation of `scan_plain_run` once per call, so the scan loop itself never tests the mode.
+     * @remark Does not change FSM state; the returned run is exactly the bytes `process_byte` would have forwarded with no error and no response.
+     * @note Callers MUST feed the byte that terminated the run (if any) to `process_byte`.
+     * @see `:stream` for bulk copying in `input_processor`
+     */
+    /**
+     * @fn std::tuple<std::size_t, std::error_code, std::optional<processing_return_variant>> protocol_fsm::process_subnegotiation_span(std::span<const byte_t> data)
+     *
+     * @param data The contiguous input bytes following `IAC SB <option>`.
+     * @return Tuple of the bytes consumed (0 if nothing was done), the error code or `processing_signal`, and the optional response, as `process_byte` would have returned at `SE`.
+     *
+     * @remark Acts only at the start of a subnegotiation payload, and only if `data` holds the whole payload followed by `IAC SE`, with no escaped `IAC` and within `max_subnegotiation_size()`; otherwise consumes nothing.
+     * @remark The response's handler views `data` directly, so the caller MUST keep those bytes unmodified until the returned awaitable completes.
+     * @remark Always consumes nothing under `lean_memory`, whose input buffer may be released as soon as it is consumed.
+     * @note Callers MUST fall back to `process_byte` when 0 is returned.
+     * @see `:stream` for zero-copy subnegotiation dispatch in `input_processor`
+     */
+    /**
+     * @fn bool protocol_fsm::is_enabled(option::id_num opt) const
      *
      * @param opt The `option::id_num` to check.
      * @return True if `opt` is enabled either locally or remotely, false otherwise.
@@ -275,7 +440,7 @@ export namespace net::telnet {
      * @remark Queries `option_status_db` for the option’s status.
      */
     /**
-     * @overload bool protocol_fsm::is_enabled(option::id_num opt, negotiation_direction dir)
+     * @overload bool protocol_fsm::is_enabled(option::id_num opt, negotiation_direction dir) const
      *
      * @param opt The `option::id_num` to check.
      * @param dir The `negotiation_direction` to check.
@@ -312,10 +477,43 @@ export namespace net::telnet {
      *
      * @remark Validates option registration and state per RFC 1143 Q Method, handling six states: NO, WANTNO/EMPTY, WANTNO/OPPOSITE, WANTYES/EMPTY, WANTYES/OPPOSITE, YES.
      * @remark Enqueues opposite request in WANTYES/EMPTY; treats redundant disablements (NO, WANTNO/EMPTY, WANTYES/OPPOSITE) as idempotent successes, logging warnings.
-     * @remark Returns `option_disablement_awaitable` in YES state via `OptionHandlerRegistry::handle_disablement` (no-op if unregistered).
+     * @remark Returns `option_disablement_awaitable` in YES state via `OptionHandlerRegistry::handle_disablement`, or `std::nullopt` in its place if no disablement handler is registered.
      * @throws None; errors returned via error_code (e.g., `error::option_not_available`, `error::negotiation_queue_error`, `error::protocol_violation`).
      * @see RFC 1143 for Q Method, `:options` for `option::id_num`, `:errors` for error codes, `:types` for `negotiation_direction`, `:awaitables` for `option_disablement_awaitable`, `:stream` for usage in async_disable_option
      */
+    /**
+     * @fn void protocol_fsm::save_state(std::vector<byte_t>& out) const
+     *
+     * @param out The buffer the image is appended to.
+     *
+     * @remark Writes `state_format_version`, one `option_status_record::pack` byte per option, `current_state_`, `current_command_` and `current_option_` (each as a presence byte plus value), and the partial `subnegotiation_buffer_` behind a 32-bit little-endian length.
+     * @remark A client between negotiations therefore costs 266 bytes; only a half-received subnegotiation adds more.
+     * @remark Handlers, `mode_`, and the statistics block are not saved; handlers belong to the restoring process and `mode_` is derived from BINARY's record.
+     * @throws std::bad_alloc if `out` cannot grow.
+     * @see `restore_state`, `stream::snapshot` for usage
+     */
+    /**
+     * @fn std::tuple<std::size_t, std::error_code> protocol_fsm::restore_state(std::span<const byte_t> image)
+     *
+     * @param image Bytes beginning with an image produced by `save_state`; anything after it is left for the caller.
+     * @return Tuple of the image's length and `std::error_code{}`, or 0 and `error::invalid_snapshot`.
+     *
+     * @remark Validates the whole image before changing anything, so a rejected image leaves the FSM as it was.
+     * @remark Rejects an unknown version, an out-of-range state, a presence byte other than 0 or 1, a command the state never holds (anything but WILL, WONT, DO, or DONT in `option_negotiation`, anything but SB in the subnegotiation states, any command elsewhere), an option outside `subnegotiation` and `subnegotiation_iac` or a missing one inside them, a non-`NO` record for an option this configuration does not know, and a partial payload above the option's `max_subnegotiation_size`.
+     * @remark Re-resolves `current_option_` through `option_source()`, upserting a default option as `handle_state_subnegotiation_option` does, but only after every check has passed; then recomputes `mode_` via `refresh_mode`.
+     * @note Sends nothing: the peer already agreed to every recorded state, so a handed-off session resumes mid-negotiation exactly where the old process left it.
+     * @throws std::bad_alloc if `subnegotiation_buffer_` cannot hold the partial payload.
+     * @see `save_state`, `stream::restore` for usage
+     */
+    /**
+     * @fn std::optional<std::size_t> protocol_fsm::state_image_size(std::span<const byte_t> image) noexcept
+     *
+     * @param image Bytes beginning with an image produced by `save_state`.
+     * @return `state_image_fixed_size` plus the partial payload length, or `std::nullopt` if `image` is shorter than that.
+     *
+     * @remark Checks nothing but the length, so `stream::restore` can validate what follows the image before `restore_state` may upsert an option.
+     * @see `restore_state`, `stream::restore` for usage
+     */
     /**
      * @fn void protocol_fsm::change_state(protocol_state next_state) noexcept
      *
@@ -392,9 +590,34 @@ export namespace net::telnet {
      * @todo Phase 6: Review `subnegotiation_overflow` handling for custom error handlers
      */
     /**
-     * @fn protocol_fsm::handle_status_subnegotiation(const option& opt, std::vector<byte_t> buffer)
+     * @fn std::optional<processing_return_variant> protocol_fsm::handler_response(awaitables::tagged_awaitable<Tag, void> awaitable, std::optional<negotiation_response_type> reply)
+     * @tparam Tag `tags::option_enablement_tag` or `tags::option_disablement_tag`.
+     * @param awaitable The awaitable returned by `option_handler_registry`, empty if no handler is registered.
+     * @param reply The negotiation reply to send, if any.
+     * @return The awaitable and `reply` as a tuple if `awaitable` is valid; otherwise `reply` alone, or `std::nullopt` if there is none.
+     * @remark This is the synchronous fast path: without a registered handler the stream writes a plain reply (or nothing) and never `co_spawn`s, so negotiation storms on handler-less options make no coroutine allocations.
+     */
+    /**
+     * @fn std::tuple<std::error_code, std::optional<processing_return_variant>> protocol_fsm::complete_subnegotiation(std::span<const byte_t> payload)
+     * @param payload The unescaped payload, either `subnegotiation_buffer_` or a view of the caller's input.
+     * @return The error code (`processing_signal::compression_start` for MCCP, `processing_signal::tls_start` for START_TLS `FOLLOWS`) and the optional `subnegotiation_awaitable`.
+     * @remark Shared by `handle_state_subnegotiation_iac` and `process_subnegotiation_span`, so both paths dispatch identically.
+     * @remark Under `lean_memory`, moves `subnegotiation_buffer_` into `handle_owned_subnegotiation` so the FSM keeps no capacity while a handler runs.
+     * @remark Under `batch_subnegotiations`, does the same when `payload` is `subnegotiation_buffer_`, since the next subnegotiation reuses that buffer before a batched handler runs; views of the caller's input are passed through unchanged.
+     * @remark Returns no response if `dispatch_subnegotiation` yields an empty awaitable (no registered handler).
+     */
+    /**
+     * @fn protocol_fsm::handle_owned_subnegotiation(std::vector<byte_t> payload, awaitables::subnegotiation_awaitable handler)
+     * @param payload The payload, owned by the coroutine frame.
+     * @param handler The awaitable returned by `dispatch_subnegotiation` over `payload`.
+     * @return `subnegotiation_awaitable` yielding the result of `handler`.
+     * @remark Moving a `std::vector` keeps its storage, so the view `handler` holds stays valid in the frame.
+     * @remark Costs one coroutine frame per handled message, the `lean_memory` trade of an allocation for no idle buffer.
+     */
+    /**
+     * @fn protocol_fsm::handle_status_subnegotiation(const option& opt, std::span<const byte_t> buffer)
      * @param opt The `status` option being negotiated (expected to be `option::id_num::status`)
-     * @param buffer The subnegotiation input data (expected to contain `SEND` (1) or `IS` (0))
+     * @param buffer The subnegotiation input data (expected to contain `SEND` (1) or `IS` (0)), valid until the awaitable completes
      * @return `subnegotiation_awaitable` yielding `std::tuple<const option&, std::vector<byte_t>>` containing the `status` option and the `IS` [list] payload for `SEND`, or user-defined result for `IS`
      * @remark For `SEND` (1), validates that `STATUS` is locally enabled; constructs a payload starting with `IS` (0), followed by pairs of [`WILL` (251), opt] for locally enabled options and [`DO` (252), opt] for remotely enabled options, with `IAC` (255) and `SE` (240) option codes escaped by doubling.
      * @remark For `IS` (0), validates that `STATUS` is remotely enabled and delegates to the user-provided subnegotiation handler via `OptionHandlerRegistry`.
@@ -403,4 +626,24 @@ export namespace net::telnet {
      * @remark The returned `subnegotiation_awaitable` is processed by `InputProcessor` to pass the payload to `stream::async_write_subnegotiation`, which adds `IAC` `SB` `status` ... `IAC` `SE` framing.
      * @see RFC 859, `:internal` for `option_status_db`, `:options` for `option`, `:awaitables` for `subnegotiation_awaitable`, `:stream` for `async_write_subnegotiation`
      */
+    /**
+     * @fn bool protocol_fsm::binary_enabled(negotiation_direction direction) const noexcept
+     * @param direction The direction to check.
+     * @return True if BINARY is enabled (`YES`) in `direction`.
+     * @remark One load and mask; `mode_` is refreshed by every path that changes BINARY's `option_status_`, not per byte.
+     * @remark Constant `false` when `binary_negotiable` is `false`.
+     */
+    /**
+     * @fn option_registry& protocol_fsm::option_source()
+     * @return `ConfigT::registered_options`, or, for a `StaticOptionTableConfig`, a function-local registry built once from `ConfigT::option_table`.
+     * @remark The per-configuration registry keeps table configurations from publishing into a `registered_options` they may share with other configurations.
+     * @remark Unknown options are still memoized here by `handle_state_subnegotiation_option`.
+     */
+    /**
+     * @fn bool protocol_fsm::supports(const option& opt, negotiation_direction direction)
+     * @param opt The option being negotiated.
+     * @param direction The direction of the request.
+     * @return True if the request may be accepted.
+     * @remark With an `option_table`, an indexed load and mask in place of `opt`'s `std::function` predicate.
+     */
 } //namespace net::telnet
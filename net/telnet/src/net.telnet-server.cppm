@@ -0,0 +1,399 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-server.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief A sharded TCP acceptor that runs one `io_context` per core and pins each accepted `stream` to one of them.
+ * @remark Each shard is an `io_context` with a concurrency hint of 1 run by exactly one thread, so a session's FSM, handler registry, side buffers, and output queue are only ever touched by that thread and need no strand.
+ * @remark Accepted sockets are distributed round-robin, to the shard with the fewest live sessions, or by the kernel via `SO_REUSEPORT` with one acceptor per shard.
+ *
+ * @see `:stream` for `stream`, `:protocol_config` for `default_protocol_fsm_config`
+ */
+
+module; //Including Asio in the Global Module Fragment until importable header units are reliable.
+#include <asio.hpp>
+
+//Module partition interface unit
+export module net.telnet:server;
+
+import std; //NOLINT For std::vector, std::unique_ptr, std::shared_ptr, std::function, std::atomic, std::jthread, std::optional
+
+import :types;           ///< @see "net.telnet-types.cppm" for `log_level` and `log_traits`
+import :errors;          ///< @see "net.telnet-errors.cppm" for `telnet::error`
+import :concepts;        ///< @see "net.telnet-concepts.cppm" for `ProtocolFSMConfig`
+import :protocol_config; ///< @see "net.telnet-protocol_config.cppm" for `default_protocol_fsm_config`
+import :stream;          ///< @see "net.telnet-stream.cppm" for `stream`
+
+export namespace net::telnet {
+    /**
+     * @brief How a `server` assigns accepted connections to its shards.
+     * @remark A live `stream` cannot move between shards (its socket is bound to its `io_context`), so balancing happens at accept time.
+     * @remark A shared acceptor picks the shard for a connection when it is re-armed, so the connection is accepted straight into its shard; `least_loaded` therefore compares the counts as of the previous handoff.
+     */
+    enum class accept_distribution : std::uint8_t {
+        round_robin,  ///< One acceptor hands each connection to the next shard in turn
+        least_loaded, ///< One acceptor hands each connection to the shard with the fewest live sessions
+        reuse_port    ///< One `SO_REUSEPORT` acceptor per shard; the kernel spreads connections (round-robin where unavailable)
+    }; //enum class accept_distribution
+
+    ///@brief Construction options for `server`.
+    struct server_options {
+        std::size_t shard_count          = 0; ///< The number of shards (threads); 0 uses `std::thread::hardware_concurrency()`
+        accept_distribution distribution = accept_distribution::round_robin;
+        int backlog                      = asio::socket_base::max_listen_connections;
+    }; //struct server_options
+
+    /**
+     * @brief Accepts TCP connections on many cores, wrapping each in a `stream` pinned to one shard.
+     * @tparam ProtocolConfigT The protocol configuration of the accepted streams.
+     * @remark `on_session` runs on the accepting shard's thread with a new `stream`; operations initiated there stay on that thread.
+     * @remark Neither copyable nor movable; shards hold their own addresses in pending handlers.
+     * @warning Sessions MUST be released before the `server` is destroyed, since their sockets belong to its `io_context`s.
+     */
+    template<concepts::ProtocolFSMConfig ProtocolConfigT = default_protocol_fsm_config>
+    class server {
+    public:
+        using socket_type = asio::ip::tcp::socket;
+        using stream_type = stream<socket_type, ProtocolConfigT>;
+
+        /**
+         * @typedef session_handler
+         * @brief Called on its shard's thread with each newly accepted stream.
+         */
+        using session_handler = std::function<void(std::shared_ptr<stream_type>)>;
+
+        ///@brief Creates the shards; nothing is opened or run until `start`.
+        server(asio::ip::tcp::endpoint endpoint, session_handler on_session, server_options options = {})
+            : endpoint_(std::move(endpoint)), on_session_(std::move(on_session)), options_(options)
+        {
+            if (options_.shard_count == 0) {
+                options_.shard_count = std::max(1U, std::thread::hardware_concurrency());
+            }
+            if constexpr (!reuse_port_supported) {
+                if (options_.distribution == accept_distribution::reuse_port) {
+                    options_.distribution = accept_distribution::round_robin;
+                }
+            }
+            shards_.reserve(options_.shard_count);
+            for (std::size_t i = 0; i < options_.shard_count; ++i) {
+                shards_.push_back(std::make_unique<shard>());
+            }
+        } //server(asio::ip::tcp::endpoint, session_handler, server_options)
+
+        server(const server&)            = delete;
+        server& operator=(const server&) = delete;
+
+        ///@brief Stops every shard and joins its thread.
+        ~server()
+        {
+            stop();
+            join();
+        } //~server()
+
+        ///@brief Opens the acceptor(s), starts accepting, and launches one thread per shard.
+        void start()
+        {
+            std::error_code ec;
+            start(ec);
+            if (ec) {
+                throw std::system_error(ec);
+            }
+        } //start()
+
+        ///@brief Opens the acceptor(s), starts accepting, and launches one thread per shard.
+        void start(std::error_code& ec) noexcept
+        {
+            try {
+                const bool per_shard = (options_.distribution == accept_distribution::reuse_port);
+                for (std::size_t i = 0; i < (per_shard ? shards_.size() : 1); ++i) {
+                    ec = open_acceptor(*shards_[i], per_shard);
+                    if (ec) {
+                        stop();
+                        return;
+                    }
+                }
+                for (auto& each : shards_) {
+                    each->work.emplace(asio::make_work_guard(each->context));
+                    if (each->acceptor) {
+                        accept_next(*each);
+                    }
+                    each->thread = std::jthread([context = &each->context] { context->run(); });
+                }
+            } catch (const std::system_error& e) {
+                stop();
+                ec = e.code();
+            } catch (const std::bad_alloc&) {
+                stop();
+                ec = make_error_code(std::errc::not_enough_memory);
+            } catch (...) {
+                stop();
+                ec = make_error_code(error::internal_error);
+            }
+        } //start(std::error_code&)
+
+        ///@brief Stops accepting and stops every shard's `io_context`; live sessions are abandoned mid-operation.
+        void stop() noexcept
+        {
+            for (auto& each : shards_) {
+                each->work.reset();
+                each->context.stop();
+            }
+        } //stop()
+
+        ///@brief Waits for every shard thread to return.
+        void join()
+        {
+            for (auto& each : shards_) {
+                if (each->thread.joinable()) {
+                    each->thread.join();
+                }
+            }
+        } //join()
+
+        ///@brief Gets the number of shards.
+        [[nodiscard]] std::size_t shard_count() const noexcept { return shards_.size(); }
+
+        ///@brief Gets the `io_context` of one shard, e.g. to pin related work such as outbound connections to it.
+        [[nodiscard]] asio::io_context& shard_context(std::size_t index) noexcept { return shards_[index]->context; }
+
+        ///@brief Gets the number of live sessions of one shard.
+        [[nodiscard]] std::size_t session_count(std::size_t index) const noexcept
+        {
+            return shards_[index]->sessions.load(std::memory_order_relaxed);
+        }
+
+        ///@brief Gets the endpoint the server listens on, with the port chosen by the system if `endpoint.port()` was 0.
+        [[nodiscard]] asio::ip::tcp::endpoint local_endpoint() const { return endpoint_; }
+
+    private:
+#if defined(SO_REUSEPORT)
+        ///@brief `SO_REUSEPORT` as an Asio `SettableSocketOption`, which Asio itself only provides in `asio::detail`.
+        class reuse_port_option {
+        public:
+            explicit reuse_port_option(bool enabled) noexcept : value_(enabled ? 1 : 0) {}
+
+            template<typename Protocol>
+            [[nodiscard]] int level(const Protocol& /*protocol*/) const noexcept
+            {
+                return SOL_SOCKET;
+            }
+
+            template<typename Protocol>
+            [[nodiscard]] int name(const Protocol& /*protocol*/) const noexcept
+            {
+                return SO_REUSEPORT;
+            }
+
+            template<typename Protocol>
+            [[nodiscard]] const int* data(const Protocol& /*protocol*/) const noexcept
+            {
+                return &value_;
+            }
+
+            template<typename Protocol>
+            [[nodiscard]] std::size_t size(const Protocol& /*protocol*/) const noexcept
+            {
+                return sizeof(value_);
+            }
+
+        private:
+            int value_;
+        }; //class reuse_port_option
+
+        static constexpr bool reuse_port_supported = true;
+#else
+        static constexpr bool reuse_port_supported = false;
+#endif
+
+        ///@brief One core's `io_context`, its thread, and (for `SO_REUSEPORT` or shard 0) its acceptor.
+        struct shard {
+            //Declared first so it outlives the handlers `context` destroys, whose sessions decrement it.
+            std::atomic<std::size_t> sessions{0};
+            asio::io_context context{1};
+            std::optional<asio::ip::tcp::acceptor> acceptor;
+            std::optional<asio::executor_work_guard<asio::io_context::executor_type>> work;
+            std::jthread thread; //Declared last so it is joined before anything else is destroyed
+        }; //struct shard
+
+        ///@brief Opens, binds, and listens on an acceptor running on `owner`.
+        std::error_code open_acceptor(shard& owner, bool reuse_port);
+
+        ///@brief Accepts the next connection on `listener`'s acceptor into the shard chosen by `next_shard`.
+        void accept_next(shard& listener);
+
+        ///@brief Picks the shard for the next connection accepted by a shared acceptor.
+        shard& next_shard() noexcept;
+
+        ///@brief Wraps `socket` in a `stream` on `target`'s thread and hands it to `on_session_`.
+        void launch(shard& target, socket_type socket);
+
+        asio::ip::tcp::endpoint endpoint_;
+        session_handler on_session_;
+        server_options options_;
+        std::vector<std::unique_ptr<shard>> shards_;
+        std::size_t next_shard_ = 0; //Only touched by the thread of shard 0
+    }; //class server
+
+    /**
+     * @internal
+     * Sets `SO_REUSEADDR` (and `SO_REUSEPORT` when sharing the port), binds, and listens; records the bound endpoint so later acceptors share a system-chosen port.
+     */
+    template<concepts::ProtocolFSMConfig PC>
+    std::error_code server<PC>::open_acceptor(shard& owner, bool reuse_port)
+    {
+        std::error_code ec;
+        auto& acceptor = owner.acceptor.emplace(owner.context);
+        if (acceptor.open(endpoint_.protocol(), ec); ec) {
+            return ec;
+        }
+        if (acceptor.set_option(asio::socket_base::reuse_address(true), ec); ec) {
+            return ec;
+        }
+        if constexpr (reuse_port_supported) {
+            if (reuse_port) {
+                if (acceptor.set_option(reuse_port_option(true), ec); ec) {
+                    return ec;
+                }
+            }
+        }
+        if (acceptor.bind(endpoint_, ec); ec) {
+            return ec;
+        }
+        if (acceptor.listen(options_.backlog, ec); ec) {
+            return ec;
+        }
+        endpoint_ = acceptor.local_endpoint(ec);
+        return ec;
+    } //server::open_acceptor(shard&, bool)
+
+    /**
+     * @internal
+     * Accepts directly into the target shard's `io_context`, so the socket is born on the thread that will own it.
+     * @remark Stops re-arming on `operation_aborted` (the acceptor was closed); logs and continues after any other error.
+     */
+    template<concepts::ProtocolFSMConfig PC>
+    void server<PC>::accept_next(shard& listener)
+    {
+        shard& target = (options_.distribution == accept_distribution::reuse_port) ? listener : next_shard();
+        listener.acceptor->async_accept(
+            target.context,
+            [this, &listener, &target](const std::error_code& ec, socket_type socket) {
+                if (ec == asio::error::operation_aborted) {
+                    return;
+                }
+                if (ec) {
+                    log_traits<PC>::template log<log_level::error>(ec, "Failed to accept connection: {}", ec.message());
+                } else {
+                    launch(target, std::move(socket));
+                }
+                accept_next(listener);
+            }
+        );
+    } //server::accept_next(shard&)
+
+    /**
+     * @internal
+     * Advances the round-robin cursor, or scans the live-session counts for `least_loaded`.
+     */
+    template<concepts::ProtocolFSMConfig PC>
+    auto server<PC>::next_shard() noexcept -> shard&
+    {
+        if (options_.distribution == accept_distribution::least_loaded) {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < shards_.size(); ++i) {
+                if (shards_[i]->sessions.load(std::memory_order_relaxed)
+                    < shards_[best]->sessions.load(std::memory_order_relaxed)) {
+                    best = i;
+                }
+            }
+            return *shards_[best];
+        }
+        shard& chosen = *shards_[next_shard_];
+        next_shard_   = (next_shard_ + 1) % shards_.size();
+        return chosen;
+    } //server::next_shard()
+
+    /**
+     * @internal
+     * Counts the session immediately, so `least_loaded` sees it before the post runs, and uncounts it from the `shared_ptr` deleter.
+     * @remark Logs and drops the connection if constructing the `stream` fails.
+     * @remark Also logs and drops it if `on_session_` throws: the exception must not escape into the shard's `io_context::run`, which would end the shard's thread and every session on it. Closing the socket cancels whatever the handler started before throwing.
+     */
+    template<concepts::ProtocolFSMConfig PC>
+    void server<PC>::launch(shard& target, socket_type socket)
+    {
+        target.sessions.fetch_add(1, std::memory_order_relaxed);
+        asio::post(target.context, [this, &target, socket = std::move(socket)]() mutable {
+            auto* sessions = &target.sessions;
+            std::shared_ptr<stream_type> session;
+            try {
+                session = std::shared_ptr<stream_type>(new stream_type(std::move(socket)), [sessions](stream_type* ptr) {
+                    delete ptr; //NOLINT(cppcoreguidelines-owning-memory): Paired with the `new` above.
+                    sessions->fetch_sub(1, std::memory_order_relaxed);
+                });
+            } catch (const std::bad_alloc&) {
+                sessions->fetch_sub(1, std::memory_order_relaxed);
+                log_traits<PC>::template log<log_level::error>(
+                    make_error_code(std::errc::not_enough_memory), "Failed to create a session stream"
+                );
+                return;
+            }
+            try {
+                on_session_(session);
+                return;
+            } catch (const std::system_error& e) {
+                log_traits<PC>::template log<log_level::error>(e.code(), "Session handler failed: {}", e.what());
+            } catch (const std::bad_alloc&) {
+                log_traits<PC>::template log<log_level::error>(
+                    make_error_code(std::errc::not_enough_memory), "Session handler failed"
+                );
+            } catch (...) {
+                log_traits<PC>::template log<log_level::error>(
+                    make_error_code(error::internal_error), "Session handler failed"
+                );
+            }
+            std::error_code ignored;
+            session->lowest_layer().close(ignored); //Drop the session whatever the handler kept of it.
+        });
+    } //server::launch(shard&, socket_type)
+
+    /**
+     * @fn server::server(asio::ip::tcp::endpoint endpoint, session_handler on_session, server_options options)
+     * @param endpoint The address and port to listen on; port 0 lets the system choose (see `local_endpoint`).
+     * @param on_session Called with each accepted stream on the thread of the shard it is pinned to. If it throws, the error goes to `PC::log_error` and the stream's socket is closed; the shard keeps running.
+     * @param options The shard count, distribution strategy, and listen backlog.
+     * @remark `accept_distribution::reuse_port` falls back to `round_robin` on platforms without `SO_REUSEPORT`.
+     */
+    /**
+     * @fn void server::start(std::error_code& ec) noexcept
+     * @param[out] ec Set to the first error opening an acceptor, `std::errc::not_enough_memory`, or `telnet::error::internal_error`.
+     * @remark Each shard's thread runs its `io_context` under a work guard, so idle shards keep waiting for handed-off connections.
+     * @remark On error, stops any shard already started; call `join` (or destroy the server) to reclaim its threads.
+     */
+    /**
+     * @fn void server::stop() noexcept
+     * @remark Safe to call from any thread, including from a session handler; `join` must then be called from a thread that is not a shard thread.
+     */
+    /**
+     * @fn std::size_t server::session_count(std::size_t index) const noexcept
+     * @param index The shard, less than `shard_count()`.
+     * @return The number of streams of that shard still referenced by its handlers or the application.
+     * @remark A relaxed read; exact only when the shard is idle.
+     */
+} //namespace net::telnet
@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-statistics.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Per-`stream` statistics counters and an optional process-wide aggregator.
+ * @remark Counters are relaxed atomics written from the stream's strand and readable from any thread.
+ * @remark `stream_statistics<false>` is empty and every operation on it compiles to nothing, so `collect_statistics = false` in the configuration removes the instrumentation entirely.
+ *
+ * @see `:stream` for `stream::statistics` and `stream::aggregate_statistics`, `:protocol_config` for `collect_statistics`
+ */
+
+//Module partition interface unit
+export module net.telnet:statistics;
+
+import std; //NOLINT For std::atomic, std::array, std::uint64_t, std::mutex, std::lock_guard, std::shared_ptr, std::to_underlying
+
+export namespace net::telnet {
+    /**
+     * @brief Counters kept for each `stream`.
+     * @remark `count` is not a counter; it is the number of counters.
+     */
+    enum class statistic : std::uint8_t {
+        bytes_received,         ///< Bytes read from the next layer (compressed bytes while MCCP input is active)
+        bytes_sent,             ///< Bytes written to the next layer, after escaping and compression
+        iac_bytes,              ///< IAC bytes in the input, including escaped data bytes and those inside subnegotiations
+        byte_wise_fsm_bytes,    ///< Input bytes run through `protocol_fsm::process_byte` rather than the bulk-copy fast path
+        negotiations_answered,  ///< Option negotiation replies the FSM asked the stream to send
+        subnegotiation_bytes,   ///< Payload bytes of subnegotiations the FSM buffered up to IAC SE
+        subnegotiation_batches, ///< Batches of subnegotiation handlers dispatched together under `batch_subnegotiations`
+        synchs_sent,            ///< Synch sequences queued or sent
+        data_marks_received,    ///< IAC DM commands received
+        deferred_errors,        ///< Transport or write errors deferred to a later read
+        output_bytes_dropped,   ///< Queued output bytes discarded by Abort Output or `slow_consumer_policy::drop_oldest`
+        high_water_crossings,   ///< Times the outbound queue rose above its high-water mark
+        count
+    }; //enum class statistic
+
+    /**
+     * @brief A point-in-time copy of a set of `statistic` counters.
+     * @remark Plain values, so snapshots can be summed, compared, and exported freely.
+     */
+    struct statistics_snapshot {
+        ///@brief The number of counters in a snapshot.
+        static constexpr std::size_t size = std::to_underlying(statistic::count);
+
+        std::array<std::uint64_t, size> values{};
+
+        ///@brief Gets the value of one counter.
+        [[nodiscard]] constexpr std::uint64_t operator[](statistic stat) const noexcept
+        {
+            return values[std::to_underlying(stat)];
+        }
+
+        ///@brief Adds every counter of `other` to this snapshot.
+        constexpr statistics_snapshot& operator+=(const statistics_snapshot& other) noexcept
+        {
+            for (std::size_t i = 0; i < size; ++i) {
+                values[i] += other.values[i];
+            }
+            return *this;
+        } //operator+=(const statistics_snapshot&)
+    }; //struct statistics_snapshot
+
+    template<bool Enabled>
+    class stream_statistics;
+
+    /**
+     * @brief Sums the statistics of every attached `stream`, live or destroyed.
+     * @remark Attachment and detachment lock a mutex; the streams' hot paths never touch the aggregator.
+     * @remark `process()` provides a process-wide instance for exporters such as a Prometheus endpoint; separate instances can group sessions by listener or tenant.
+     * @remark Thread-safe.
+     */
+    class statistics_aggregator {
+    public:
+        ///@brief Constructs an aggregator with nothing attached.
+        statistics_aggregator() : registry_(std::make_shared<registry>()) {}
+        statistics_aggregator(const statistics_aggregator&)            = delete;
+        statistics_aggregator& operator=(const statistics_aggregator&) = delete;
+
+        ///@brief Detaches every block still attached.
+        ~statistics_aggregator();
+
+        ///@brief Gets the process-wide aggregator.
+        static statistics_aggregator& process()
+        {
+            static statistics_aggregator aggregator;
+            return aggregator;
+        }
+
+        ///@brief Sums the retired totals and the current counts of every attached block.
+        [[nodiscard]] statistics_snapshot snapshot() const;
+
+        ///@brief Gets the number of blocks currently attached.
+        [[nodiscard]] std::size_t attached_count() const
+        {
+            const std::lock_guard<std::mutex> lock(registry_->mutex);
+            return registry_->attached_count;
+        }
+
+        ///@brief Calls `visitor` with the id and a snapshot of each attached block, e.g. to find the sessions costing the most FSM time.
+        template<typename Visitor>
+        void for_each(Visitor&& visitor) const;
+
+    private:
+        friend class stream_statistics<true>;
+
+        /**
+         * @brief The list and totals, shared with every attached block.
+         * @remark Each block holds a `std::shared_ptr` to it, so a block can always lock `mutex` to leave, even while the aggregator is being destroyed.
+         */
+        struct registry {
+            std::mutex mutex;
+            stream_statistics<true>* head = nullptr;
+            std::size_t attached_count    = 0;
+            statistics_snapshot retired;
+            bool closed = false; //Set by `~statistics_aggregator`, after which the list is empty and nothing is retired
+
+            ///@brief Links `block` at the head of the list.
+            void link(stream_statistics<true>& block);
+
+            ///@brief Unlinks `block`, adding its counts to `retired`.
+            void unlink(stream_statistics<true>& block) noexcept;
+        }; //struct registry
+
+        std::shared_ptr<registry> registry_;
+    }; //class statistics_aggregator
+
+    /**
+     * @brief The statistics block of one `stream`.
+     * @tparam Enabled Whether the counters exist; see the `stream_statistics<false>` specialization.
+     * @remark Neither copyable nor movable, since an attached `statistics_aggregator` holds its address.
+     * @remark Instantiated per-`stream`; written from its strand and read from anywhere.
+     * @see `:stream` for `stream::statistics`
+     */
+    template<bool Enabled>
+    class stream_statistics {
+    public:
+        ///@brief Constructs a block with every counter at zero, a fresh id, and no aggregator.
+        stream_statistics() noexcept = default;
+        stream_statistics(const stream_statistics&)            = delete;
+        stream_statistics& operator=(const stream_statistics&) = delete;
+
+        ///@brief Folds the final counts into the attached aggregator, if any.
+        ~stream_statistics() { detach(); }
+
+        ///@brief Gets the process-unique id that `statistics_aggregator::for_each` reports for this block.
+        [[nodiscard]] std::uint64_t id() const noexcept { return id_; }
+
+        ///@brief Adds `n` to one counter.
+        void add(statistic stat, std::uint64_t n = 1) noexcept
+        {
+            counters_[std::to_underlying(stat)].fetch_add(n, std::memory_order_relaxed);
+        }
+
+        ///@brief Copies every counter.
+        [[nodiscard]] statistics_snapshot snapshot() const noexcept
+        {
+            statistics_snapshot result;
+            for (std::size_t i = 0; i < statistics_snapshot::size; ++i) {
+                result.values[i] = counters_[i].load(std::memory_order_relaxed);
+            }
+            return result;
+        } //snapshot()
+
+        ///@brief Includes this block in `aggregator`'s totals, leaving any previous aggregator first.
+        void attach(statistics_aggregator& aggregator);
+
+        ///@brief Leaves the attached aggregator, folding the current counts into its retired totals.
+        void detach() noexcept;
+
+    private:
+        friend class statistics_aggregator;
+
+        ///@brief Hands out ids from 1, so 0 can mean "no statistics".
+        static std::uint64_t next_id() noexcept
+        {
+            static std::atomic<std::uint64_t> last{0};
+            return last.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        std::array<std::atomic<std::uint64_t>, statistics_snapshot::size> counters_{};
+        std::uint64_t id_ = next_id();
+
+        //Written only by the owning thread, in `attach` and `detach`.
+        std::shared_ptr<statistics_aggregator::registry> registry_;
+
+        //Intrusive list links, guarded by `registry_->mutex`.
+        stream_statistics* previous_ = nullptr;
+        stream_statistics* next_     = nullptr;
+    }; //class stream_statistics
+
+    /**
+     * @brief The statistics "block" of a `stream` configured with `collect_statistics = false`.
+     * @remark Empty, with every operation a no-op, so instrumented call sites compile away.
+     */
+    template<>
+    class stream_statistics<false> {
+    public:
+        ///@brief Returns 0, the id of no block.
+        [[nodiscard]] std::uint64_t id() const noexcept { return 0; }
+
+        ///@brief Does nothing.
+        void add(statistic /*stat*/, std::uint64_t /*n*/ = 1) noexcept {}
+
+        ///@brief Returns all zeros.
+        [[nodiscard]] statistics_snapshot snapshot() const noexcept { return {}; }
+
+        ///@brief Does nothing.
+        void attach(statistics_aggregator& /*aggregator*/) noexcept {}
+
+        ///@brief Does nothing.
+        void detach() noexcept {}
+    }; //class stream_statistics<false>
+
+    inline statistics_aggregator::~statistics_aggregator()
+    {
+        const std::lock_guard<std::mutex> lock(registry_->mutex);
+        for (auto* block = registry_->head; block != nullptr;) {
+            auto* next       = block->next_;
+            block->previous_ = nullptr;
+            block->next_     = nullptr;
+            block            = next;
+        }
+        registry_->head           = nullptr;
+        registry_->attached_count = 0;
+        registry_->closed         = true;
+    } //~statistics_aggregator()
+
+    inline statistics_snapshot statistics_aggregator::snapshot() const
+    {
+        const std::lock_guard<std::mutex> lock(registry_->mutex);
+        statistics_snapshot result = registry_->retired;
+        for (const auto* block = registry_->head; block != nullptr; block = block->next_) {
+            result += block->snapshot();
+        }
+        return result;
+    } //statistics_aggregator::snapshot()
+
+    template<typename Visitor>
+    void statistics_aggregator::for_each(Visitor&& visitor) const
+    {
+        const std::lock_guard<std::mutex> lock(registry_->mutex);
+        for (const auto* block = registry_->head; block != nullptr; block = block->next_) {
+            visitor(block->id(), block->snapshot());
+        }
+    } //statistics_aggregator::for_each(Visitor&&)
+
+    inline void statistics_aggregator::registry::link(stream_statistics<true>& block)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        block.previous_ = nullptr;
+        block.next_     = head;
+        if (head != nullptr) {
+            head->previous_ = &block;
+        }
+        head = &block;
+        ++attached_count;
+    } //statistics_aggregator::registry::link(stream_statistics<true>&)
+
+    inline void statistics_aggregator::registry::unlink(stream_statistics<true>& block) noexcept
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (closed) {
+            return; //Already unlinked by `~statistics_aggregator`.
+        }
+        retired += block.snapshot();
+        if (block.previous_ != nullptr) {
+            block.previous_->next_ = block.next_;
+        } else {
+            head = block.next_;
+        }
+        if (block.next_ != nullptr) {
+            block.next_->previous_ = block.previous_;
+        }
+        block.previous_ = nullptr;
+        block.next_     = nullptr;
+        --attached_count;
+    } //statistics_aggregator::registry::unlink(stream_statistics<true>&)
+
+    template<bool Enabled>
+    void stream_statistics<Enabled>::attach(statistics_aggregator& aggregator)
+    {
+        if (registry_ == aggregator.registry_) {
+            return;
+        }
+        detach();
+        aggregator.registry_->link(*this);
+        registry_ = aggregator.registry_;
+    } //stream_statistics::attach(statistics_aggregator&)
+
+    template<bool Enabled>
+    void stream_statistics<Enabled>::detach() noexcept
+    {
+        if (registry_) {
+            registry_->unlink(*this);
+            registry_.reset();
+        }
+    } //stream_statistics::detach()
+
+    /**
+     * @fn void stream_statistics::add(statistic stat, std::uint64_t n) noexcept
+     *
+     * @param stat The counter to increment.
+     * @param n The amount to add (defaults to 1).
+     *
+     * @remark One relaxed `fetch_add`; hot paths tally locally and call `add` once per batch.
+     */
+    /**
+     * @fn statistics_snapshot stream_statistics::snapshot() const noexcept
+     *
+     * @return The current value of every counter.
+     *
+     * @remark Each counter is read independently, so a snapshot taken while the stream is active may mix slightly different instants.
+     */
+    /**
+     * @fn void stream_statistics::attach(statistics_aggregator& aggregator)
+     *
+     * @param aggregator The aggregator to join.
+     *
+     * @remark Re-attaching to the current aggregator does nothing.
+     * @note Must not race with `detach` or destruction of the same block; the stream calls both from its own thread.
+     */
+    /**
+     * @fn void stream_statistics::detach() noexcept
+     *
+     * @remark The aggregator's totals keep every count this block ever contributed, so aggregated counters never go backwards.
+     * @remark Takes the aggregator's mutex before looking at the list, and holds its shared state alive while doing so, so it is safe against a concurrent `~statistics_aggregator`.
+     */
+    /**
+     * @fn statistics_snapshot statistics_aggregator::snapshot() const
+     *
+     * @return Totals of every block ever attached.
+     *
+     * @remark Walks the attached blocks under the mutex; cost is linear in `attached_count()`.
+     */
+    /**
+     * @fn void statistics_aggregator::for_each(Visitor&& visitor) const
+     *
+     * @tparam Visitor Callable as `visitor(std::uint64_t id, statistics_snapshot)`.
+     * @param visitor The callable to invoke.
+     *
+     * @remark `id` is the block's `stream_statistics::id()`, which `stream::statistics_id()` also returns, so an exporter can label each snapshot with the session's endpoint or name.
+     *
+     * @remark Holds the mutex for the whole walk; `visitor` MUST NOT attach or detach streams.
+     */
+} //namespace net::telnet
@@ -22,11 +22,12 @@
  * @brief Interface for Telnet stream operations.
  * @remark Defines `telnet::stream` class to provide a Telnet-aware stream wrapper around a lower-layer stream-oriented socket.
  * @remark Defines `stream::input_processor` for composed Telnet-aware async_read_some.
+ * @remark Defines `frame_batch` and `stream::frame_reader` for line- and record-framed reads.
+ * @remark Layers TLS (implicit or START_TLS) between the MCCP layer and the next layer, via `tls_session`.
  * @see Partition implementation units "net.telnet-stream-impl.cpp", "net.telnet-stream-async-impl.cpp", and "net.telnet-stream-sync-impl.cpp" for function definitions.
  *
  * @see RFC 854 for Telnet protocol, RFC 855 for option negotiation, `:protocol_fsm` for `protocol_fsm`, `:types` for `telnet::command`, `:options` for `option` and `option::id_num`, `:errors` for error codes, `:internal` for implementation classes
  * @todo Phase 6: Hand-tune next-layer stream constraints to exactly match Boost.Asio stream sockets.
- * @todo Phase 6: Add concept for TLS-aware next-layer stream to implement conditional TLS support.
  * @todo Future Development: Monitor `asio::async_result_t` compatibility with evolving Boost.Asio and `std::execution` for potential transition to awaitable or standard async frameworks.
  * @todo Future Development: Consider using `asio::get_associated_executor(token)` for handler execution in `telnet::stream` to support custom executors.
  */
@@ -37,7 +38,7 @@ module; //Including Asio in the Global Module Fragment until importable header u
 //Module partition interface unit
 export module net.telnet:stream;
 
-import std; //NOLINT For std::error_code, std::size_t, std::vector, std::same_as
+import std; //NOLINT For std::error_code, std::size_t, std::vector, std::array, std::same_as
 
 export import :types;           ///< @see "net.telnet-types.cppm" for `byte_t` and `telnet::command`
 export import :errors;          ///< @see "net.telnet-errors.cppm" for `telnet::error` and `telnet::processing_signal` codes
@@ -46,6 +47,13 @@ export import :options;         ///< @see "net.telnet-options.cppm" for `option`
 export import :protocol_config; ///< @see "net.telnet-protocol_config.cppm" for `default_protocol_fsm_config`
 export import :protocol_fsm;    ///< @see "net.telnet-protocol_fsm.cppm" for `protocol_fsm`
 export import :awaitables;      ///< @see "net.telnet-awaitables.cppm" for `tagged_awaitable`
+export import :statistics;      ///< @see "net.telnet-statistics.cppm" for `stream_statistics` and `statistics_aggregator`
+export import :broadcast;       ///< @see "net.telnet-broadcast.cppm" for `broadcast_message`
+export import :tls;             ///< @see "net.telnet-tls.cppm" for `tls_context` and `tls_session`
+
+import :byte_scan;   ///< @see "net.telnet-byte_scan.cppm" for `byte_scan::find_first_of`
+import :compression; ///< @see "net.telnet-compression.cppm" for `deflate_stream` and `inflate_stream`
+import :internal;    ///< @see "net.telnet-internal.cppm" for `escape_buffer_pool`, `gather_slice_pool`, `reusable_queue`, and `read_size_tuner`
 
 //namespace asio = boost::asio;
 
@@ -60,9 +68,98 @@ namespace net::telnet {
 } //namespace net::telnet
 
 export namespace net::telnet {
+    template<LayerableSocketStream NextLayerT, ProtocolFSMConfig ProtocolConfigT>
+    class stream;
+
+    /**
+     * @brief The frames (lines or records) delivered by one `stream::async_read_line` or `stream::async_read_record` completion.
+     * @remark Frames are views into one contiguous buffer owned by the batch; they stay valid until the batch is passed to the next framed read or cleared.
+     * @remark A frame still being received when the read completes is kept inside the batch and continued by the next framed read, so reuse one batch per stream.
+     * @see `stream::async_read_line`, `stream::async_read_record`
+     */
+    class frame_batch {
+    public:
+        ///@brief The default bound on a single frame, in bytes.
+        static constexpr std::size_t default_max_frame_size = 65536;
+
+        ///@brief Constructs an empty batch that accepts frames of up to `max_frame_size` bytes.
+        explicit frame_batch(std::size_t max_frame_size = default_max_frame_size) noexcept
+            : max_frame_size_(max_frame_size)
+        {}
+
+        ///@brief Gets the number of complete frames.
+        [[nodiscard]] std::size_t size() const noexcept { return frames_.size(); }
+
+        ///@brief Reports whether the batch holds no complete frame.
+        [[nodiscard]] bool empty() const noexcept { return frames_.empty(); }
+
+        ///@brief Gets the complete frame at `index`, without its delimiter.
+        [[nodiscard]] std::span<const byte_t> operator[](std::size_t index) const noexcept
+        {
+            return std::span<const byte_t>(data_).subspan(frames_[index].offset, frames_[index].size);
+        }
+
+        ///@brief Gets the bytes received so far of the frame not yet complete.
+        [[nodiscard]] std::span<const byte_t> partial() const noexcept
+        {
+            return std::span<const byte_t>(data_).subspan(partial_begin_);
+        }
+
+        ///@brief Gets the bound on a single frame, in bytes.
+        [[nodiscard]] std::size_t max_frame_size() const noexcept { return max_frame_size_; }
+
+        ///@brief Discards every frame, including the partial one.
+        void clear() noexcept
+        {
+            data_.clear();
+            frames_.clear();
+            partial_begin_ = 0;
+        }
+
+    private:
+        template<LayerableSocketStream NextLayerT, ProtocolFSMConfig ProtocolConfigT>
+        friend class stream;
+
+        ///@brief Where one complete frame lies in `data_`.
+        struct frame_bounds {
+            std::size_t offset;
+            std::size_t size;
+        }; //struct frame_bounds
+
+        ///@brief Drops the frames delivered by the previous read, moving the partial frame to the front of `data_`.
+        void start_batch()
+        {
+            data_.erase(data_.begin(), data_.begin() + static_cast<std::ptrdiff_t>(partial_begin_));
+            frames_.clear();
+            partial_begin_ = 0;
+        }
+
+        ///@brief Ends the partial frame, excluding its last `delimiter_size` bytes.
+        void end_frame(std::size_t delimiter_size)
+        {
+            frames_.push_back({.offset = partial_begin_, .size = data_.size() - partial_begin_ - delimiter_size});
+            partial_begin_ = data_.size();
+        }
+
+        std::vector<byte_t> data_; //Complete frames followed by the partial frame
+        std::vector<frame_bounds> frames_;
+        std::size_t partial_begin_ = 0;
+        std::size_t max_frame_size_;
+    }; //class frame_batch
+
     /**
      * @brief Stream class wrapping a next-layer stream/socket with Telnet protocol handling.
      * @remark Implements a stream interface (read/write) over a layered stream/socket.
+     * @par Per-connection memory budget @parblock
+     * With a `ProtocolConfigT` whose `lean_memory` is `true` and handlers shared through `set_option_handlers`, an idle session (one pending read, no queued output, no subnegotiation in progress, MCCP off) owns:
+     * - `sizeof(stream)` inline: the 256-byte `option_status_db`, two `z_stream` headers, the empty output pools, and the next layer itself, all fixed at compile time;
+     * - the composed read operation and its readiness wait, allocated through the completion handler's allocator;
+     * - no side-buffer, output-queue, output-pool, batch, or subnegotiation storage, and no private copy of the option handler table.
+     *
+     * Beyond that, only what Asio's reactor and the kernel keep per socket. The heap share is not quoted here because it depends on the standard library and Asio build; `bm_idle_sessions` in "bench/net.telnet-bench.cpp" measures it, along with `sizeof(stream)`, with and without `lean_memory`.
+     * While data flows, a session also holds one read buffer of `read_block_size()` bytes and its queued output; with MCCP active, zlib adds about 34 KiB to deflate and up to 39 KiB to inflate, as the peer may use a 32 KiB window.
+     * Without `lean_memory`, buffers are kept after use rather than freed, and the read buffer is held for the whole wait.
+     * @endparblock
      * @see `:protocol_fsm` for `protocol_fsm`, `:types` for `telnet::command`, `:options` for `option` and `option::id_num`, `:errors` for error codes
      */
     template<LayerableSocketStream NextLayerT, ProtocolFSMConfig ProtocolConfigT = default_protocol_fsm_config>
@@ -77,9 +174,9 @@ export namespace net::telnet {
 
         /**
          * @typedef side_buffer_type
-         * @brief Type for input and output side buffers.
+         * @brief Type for input side buffers; allocated on first use and, under `lean_memory`, freed whenever drained.
          */
-        using side_buffer_type = asio::streambuf;
+        using side_buffer_type = lazy_streambuf<policy_traits<ProtocolConfigT>::lean_memory>;
 
     public:
         /**
@@ -138,6 +235,18 @@ export namespace net::telnet {
         ///@brief Unregisters handlers for an option.
         void unregister_option_handlers(option::id_num opt) { fsm_.unregister_option_handlers(opt); }
 
+        ///@brief Gets the option handlers, e.g. to share one stream's handlers with every other session.
+        [[nodiscard]] const typename fsm_type::option_handlers_type& option_handlers() const noexcept
+        {
+            return fsm_.option_handlers();
+        }
+
+        ///@brief Adopts a shared set of option handlers in place of this stream's own.
+        void set_option_handlers(typename fsm_type::option_handlers_type handlers) noexcept
+        {
+            fsm_.set_option_handlers(std::move(handlers));
+        }
+
         ///@brief Asynchronously requests or offers an option, sending IAC WILL/DO.
         template<typename CompletionToken>
         auto async_request_option(option::id_num opt, negotiation_direction direction, CompletionToken&& token);
@@ -170,6 +279,26 @@ export namespace net::telnet {
         template<MutableBufferSequence MBufSeq>
         std::size_t read_some(MBufSeq&& buffers, std::error_code& ec) noexcept;
 
+        ///@brief Asynchronously reads one or more complete lines into `lines`.
+        template<ReadToken CompletionToken>
+        auto async_read_line(frame_batch& lines, CompletionToken&& token);
+
+        ///@brief Synchronously reads one or more complete lines into `lines`.
+        std::size_t read_line(frame_batch& lines);
+
+        ///@brief Synchronously reads one or more complete lines into `lines`.
+        std::size_t read_line(frame_batch& lines, std::error_code& ec) noexcept;
+
+        ///@brief Asynchronously reads one or more complete IAC EOR-terminated records into `records`.
+        template<ReadToken CompletionToken>
+        auto async_read_record(frame_batch& records, CompletionToken&& token);
+
+        ///@brief Synchronously reads one or more complete IAC EOR-terminated records into `records`.
+        std::size_t read_record(frame_batch& records);
+
+        ///@brief Synchronously reads one or more complete IAC EOR-terminated records into `records`.
+        std::size_t read_record(frame_batch& records, std::error_code& ec) noexcept;
+
         ///@brief Asynchronously writes some data with Telnet-specific IAC escaping.
         template<ConstBufferSequence CBufSeq, WriteToken CompletionToken>
         auto async_write_some(const CBufSeq& data, CompletionToken&& token);
@@ -182,6 +311,18 @@ export namespace net::telnet {
         template<ConstBufferSequence CBufSeq>
         std::size_t write_some(const CBufSeq& data, std::error_code& ec) noexcept;
 
+        ///@brief Asynchronously writes some data with Telnet-specific IAC escaping, gathering slices of `data` instead of copying it.
+        template<ConstBufferSequence CBufSeq, WriteToken CompletionToken>
+        auto async_write_gather(const CBufSeq& data, CompletionToken&& token);
+
+        ///@brief Synchronously writes some data with Telnet-specific IAC escaping, gathering slices of `data` instead of copying it.
+        template<ConstBufferSequence CBufSeq>
+        std::size_t write_gather(const CBufSeq& data);
+
+        ///@brief Synchronously writes some data with Telnet-specific IAC escaping, gathering slices of `data` instead of copying it.
+        template<ConstBufferSequence CBufSeq>
+        std::size_t write_gather(const CBufSeq& data, std::error_code& ec) noexcept;
+
         ///@brief Asynchronously writes a pre-escaped buffer containing data and raw Telnet commands.
         template<ConstBufferSequence CBufSeq, WriteToken CompletionToken>
         auto async_write_raw(const CBufSeq& data, CompletionToken&& token);
@@ -194,6 +335,20 @@ export namespace net::telnet {
         template<ConstBufferSequence CBufSeq>
         std::size_t write_raw(const CBufSeq& data, std::error_code& ec) noexcept;
 
+        ///@brief Asynchronously writes a `broadcast_message`, queuing a reference to its shared escaped bytes.
+        template<WriteToken CompletionToken>
+        auto async_write_broadcast(const broadcast_message& message, CompletionToken&& token);
+
+        ///@brief Synchronously writes a `broadcast_message` from its shared escaped bytes.
+        std::size_t write_broadcast(const broadcast_message& message);
+
+        ///@brief Synchronously writes a `broadcast_message` from its shared escaped bytes.
+        std::size_t write_broadcast(const broadcast_message& message, std::error_code& ec) noexcept;
+
+        ///@brief Appends the escaped form of `data` to `escaped_data`, as a write in the given local BINARY mode escapes it.
+        template<ConstBufferSequence CBufSeq>
+        static void escape_output(std::vector<byte_t>& escaped_data, const CBufSeq& data, bool local_binary);
+
         ///@brief Asynchronously writes a Telnet command.
         template<WriteToken CompletionToken>
         auto async_write_command(telnet::command cmd, CompletionToken&& token);
@@ -236,9 +391,132 @@ export namespace net::telnet {
         ///@brief Synchronously sends Telnet Synch sequence (NUL bytes and IAC DM).
         std::size_t send_synch(std::error_code& ec) noexcept;
 
-        ///@brief Asynchronously waits (via 0-byte receive) for notification that OOB data is in the stream.
+        ///@brief Asynchronously starts MCCP compression of output, sending IAC SB MCCP2 (or MCCP3) IAC SE.
+        template<WriteToken CompletionToken>
+        auto async_start_compression(CompletionToken&& token);
+
+        ///@brief Synchronously starts MCCP compression of output, sending IAC SB MCCP2 (or MCCP3) IAC SE.
+        std::size_t start_compression();
+
+        ///@brief Synchronously starts MCCP compression of output, sending IAC SB MCCP2 (or MCCP3) IAC SE.
+        std::size_t start_compression(std::error_code& ec) noexcept;
+
+        ///@brief Asynchronously ends MCCP compression of output, sending the end of the compressed stream.
+        template<WriteToken CompletionToken>
+        auto async_stop_compression(CompletionToken&& token);
+
+        ///@brief Synchronously ends MCCP compression of output, sending the end of the compressed stream.
+        std::size_t stop_compression();
+
+        ///@brief Synchronously ends MCCP compression of output, sending the end of the compressed stream.
+        std::size_t stop_compression(std::error_code& ec) noexcept;
+
+        ///@brief Reports whether output is currently MCCP-compressed.
+        [[nodiscard]] bool is_output_compressed() const noexcept { return context_.deflater.active(); }
+
+        ///@brief Reports whether input is currently MCCP-compressed.
+        [[nodiscard]] bool is_input_compressed() const noexcept { return context_.inflater.active(); }
+
+        ///@brief Sets the configuration, handshake role, and expected server name of sessions started later by `start_implicit_tls` or START_TLS.
+        void set_tls_context(tls_context context, tls_role role, std::string peer_name = {})
+        {
+            context_.tls_config    = std::move(context);
+            context_.tls_side      = role;
+            context_.tls_peer_name = std::move(peer_name);
+        }
+
+        ///@brief Asynchronously starts TLS by sending IAC SB START_TLS FOLLOWS IAC SE.
+        template<WriteToken CompletionToken>
+        auto async_start_tls(CompletionToken&& token);
+
+        ///@brief Synchronously starts TLS by sending IAC SB START_TLS FOLLOWS IAC SE.
+        std::size_t start_tls();
+
+        ///@brief Synchronously starts TLS by sending IAC SB START_TLS FOLLOWS IAC SE.
+        std::size_t start_tls(std::error_code& ec) noexcept;
+
+        ///@brief Starts TLS in both directions at once, for a connection that carries TLS from its first byte.
+        void start_implicit_tls();
+
+        ///@brief Starts TLS in both directions at once, for a connection that carries TLS from its first byte.
+        void start_implicit_tls(std::error_code& ec) noexcept;
+
+        ///@brief Asynchronously ends TLS output by sending a close_notify alert behind every earlier write.
+        template<WriteToken CompletionToken>
+        auto async_stop_tls(CompletionToken&& token);
+
+        ///@brief Synchronously ends TLS output by sending a close_notify alert.
+        void stop_tls();
+
+        ///@brief Synchronously ends TLS output by sending a close_notify alert.
+        void stop_tls(std::error_code& ec) noexcept;
+
+        ///@brief Reports whether a TLS session protects input, output, or both.
+        [[nodiscard]] bool is_tls_active() const noexcept { return context_.tls.active(); }
+
+        ///@brief Reports whether the TLS handshake has completed.
+        [[nodiscard]] bool is_tls_established() const noexcept { return context_.tls.established(); }
+
+        ///@brief Asynchronously waits (via 0-byte receive) for notification that OOB data is in the stream; a no-op under `urgent_data_policy::at_mark`.
         void launch_wait_for_urgent_data();
 
+        ///@brief Holds queued writes until the matching `uncork`.
+        void cork() noexcept { output_processor_.cork(); }
+
+        ///@brief Releases one `cork`, flushing queued writes as a single gather write once fully uncorked.
+        void uncork() { output_processor_.uncork(); }
+
+        ///@brief Reports whether the outbound queue is currently corked.
+        [[nodiscard]] bool is_corked() const noexcept { return output_processor_.is_corked(); }
+
+        ///@brief Bounds the outbound queue, applying `policy` whenever it rises above `high_water` bytes until it drains to `low_water`.
+        void set_output_limits(std::size_t high_water, std::size_t low_water, slow_consumer_policy policy)
+        {
+            output_processor_.set_limits(high_water, low_water, policy);
+        }
+
+        ///@brief Gets the number of bytes queued or in flight on the outbound queue.
+        [[nodiscard]] std::size_t output_queue_depth() const noexcept { return output_processor_.depth(); }
+
+        ///@brief Reports whether the outbound queue has risen above its high-water mark and not yet drained to its low-water mark.
+        [[nodiscard]] bool is_output_congested() const noexcept { return output_processor_.is_congested(); }
+
+        ///@brief Pins every read from the next layer to `block_size` bytes.
+        void set_read_block_size(std::size_t block_size) noexcept { context_.read_tuner.set_limits(block_size, block_size); }
+
+        ///@brief Lets the read size adapt between `minimum` and `maximum` bytes.
+        void set_read_block_size(std::size_t minimum, std::size_t maximum) noexcept
+        {
+            context_.read_tuner.set_limits(minimum, maximum);
+        }
+
+        ///@brief Gets the number of bytes the next read from the next layer will request.
+        [[nodiscard]] std::size_t read_block_size() const noexcept { return context_.read_tuner.next_read_size(); }
+
+        ///@brief Gets a snapshot of this stream's counters; all zeros when `collect_statistics` is `false`.
+        [[nodiscard]] statistics_snapshot statistics() const noexcept { return statistics_.snapshot(); }
+
+        ///@brief Gets the id `statistics_aggregator::for_each` reports for this stream; 0 when `collect_statistics` is `false`.
+        [[nodiscard]] std::uint64_t statistics_id() const noexcept { return statistics_.id(); }
+
+        ///@brief Includes this stream's counters in `aggregator`'s totals until the stream is destroyed.
+        void aggregate_statistics(statistics_aggregator& aggregator = statistics_aggregator::process())
+        {
+            statistics_.attach(aggregator);
+        }
+
+        ///@brief Serializes the option states, the parser's partial command, and unread input, for `restore` by another process.
+        [[nodiscard]] std::vector<byte_t> snapshot() const;
+
+        ///@brief Serializes the option states, the parser's partial command, and unread input, for `restore` by another process.
+        [[nodiscard]] std::vector<byte_t> snapshot(std::error_code& ec) const noexcept;
+
+        ///@brief Rebuilds the session state from a `snapshot` without sending any negotiation.
+        void restore(std::span<const byte_t> image);
+
+        ///@brief Rebuilds the session state from a `snapshot` without sending any negotiation.
+        void restore(std::span<const byte_t> image, std::error_code& ec) noexcept;
+
     private:
         /**
          * @brief A private nested struct for holding processing context to share with `input_processor`.
@@ -278,11 +556,24 @@ export namespace net::telnet {
 
         public:
             side_buffer_type input_side_buffer;
-            side_buffer_type output_side_buffer;
             std::error_code deferred_transport_error;
             std::error_code deferred_processing_signal;
             urgent_data_tracker urgent_data_state;
             std::atomic<bool> waiting_for_urgent_data{false};
+            escape_buffer_pool escape_buffers;
+            gather_slice_pool gather_slices;
+            read_size_tuner read_tuner;
+            deflate_stream deflater;                  //Compresses output between MCCP start and stop
+            inflate_stream inflater;                  //Decompresses input from the peer's MCCP start to its stream end
+            side_buffer_type compressed_input_buffer; //Compressed bytes read but not yet inflated into `input_side_buffer`
+            tls_session tls;                          //Encrypts output and decrypts input once TLS starts in each direction
+            side_buffer_type tls_input_buffer;        //Ciphertext read but not yet decrypted
+            tls_context tls_config;                   //Set by `set_tls_context`
+            std::string tls_peer_name;                //Server name a client sends as SNI and verifies
+            tls_role tls_side      = tls_role::server;
+            bool tls_input_active  = false; //The peer's FOLLOWS (or implicit TLS) has passed; reads fill `tls_input_buffer`
+            bool tls_output_active = false; //Our FOLLOWS (or implicit TLS) has been written; writes are encrypted
+            bool tls_follows_sent  = false; //Our FOLLOWS is queued or written
         }; //struct context_type
 
         /**
@@ -300,11 +591,48 @@ export namespace net::telnet {
             template<typename Self>
             void operator()(Self& self, std::error_code ec_in = {}, std::size_t bytes_transferred = 0);
 
+            ///@brief Performs the whole read on the calling thread with blocking next-layer I/O.
+            std::size_t run_blocking(std::error_code& ec);
+
         private:
+            ///@brief Why `scan_side_buffer` stopped: a terminal signal or deferred error, an AO, or an FSM response to send.
+            struct scan_result {
+                std::error_code ec;
+                std::optional<typename fsm_type::processing_return_variant> response;
+                bool abort_output = false;
+                bool tls_follows  = false; //The peer's FOLLOWS arrived first, so answer with ours
+            }; //struct scan_result
+
+            ///@brief The subnegotiation handlers collected from one pass over buffered input, and the result that ended the pass.
+            struct subnegotiation_batch {
+                std::vector<awaitables::subnegotiation_awaitable> handlers;
+                std::optional<scan_result> stop; //Acted on once `handlers` have run
+            }; //struct subnegotiation_batch
+
+            ///@brief Feeds buffered input through the FSM into the user's buffer until it stops for `scan_result`.
+            scan_result scan_side_buffer();
+
+            ///@brief Acts on a held `subnegotiation_batch::stop` if there is one, else runs `scan_side_buffer`.
+            scan_result resume_scan();
+
+            ///@brief Switches input to the TLS session after the peer's FOLLOWS, then keeps scanning or asks for our FOLLOWS in reply.
+            scan_result start_tls_input();
+
+            ///@brief Moves subnegotiation handlers from `scan` and further scans into `batch_`, reporting whether any were collected.
+            bool collect_subnegotiations(scan_result& scan);
+
+            ///@brief Runs the handlers of a batch in order and frames their replies into one buffer, stopping at the first failure.
+            asio::awaitable<std::tuple<std::error_code, std::vector<byte_t>>>
+                run_subnegotiation_batch(std::vector<awaitables::subnegotiation_awaitable> handlers);
+
             ///@brief Handles processing of the `initializing` state.
             template<typename Self>
             void handle_processor_state_initializing(Self& self);
 
+            ///@brief Handles processing of the `awaiting_input` state.
+            template<typename Self>
+            void handle_processor_state_awaiting_input(Self& self, std::error_code ec_in = {});
+
             ///@brief Handles processing of the `reading` state.
             template<typename Self>
             void handle_processor_state_reading(Self& self, std::error_code ec_in = {}, std::size_t bytes_transferred = 0);
@@ -320,6 +648,15 @@ export namespace net::telnet {
             ///@brief Defers write errors for later reporting and logs multi-error pile-ups.
             void process_write_error(std::error_code ec);
 
+            ///@brief Appends the bytes of a negotiation reply to `replies_`, so the scan can continue past it; reports whether it was queued.
+            bool queue_negotiation_reply(const typename fsm_type::negotiation_response& response) noexcept;
+
+            ///@brief Queues the replies collected by the last pass on `output_processor_` as one write, deferring any write error.
+            void send_replies();
+
+            ///@brief Writes the replies collected by the last pass on the calling thread, deferring any write error.
+            void write_replies_blocking();
+
             ///@brief Handles processing_signal error codes from fsm_.process_byte, modifying the user buffer or urgent data state.
             void process_fsm_signals(std::error_code& signal_ec);
 
@@ -345,7 +682,39 @@ export namespace net::telnet {
                 Self&& self
             );
 
-            static constexpr std::size_t read_block_size = 1024;
+            ///@brief Handle the collected `batch_` by spawning one coroutine that runs every handler and writes their replies together.
+            template<typename Self>
+            void dispatch_subnegotiation_batch(Self&& self);
+
+            ///@brief Handle the collected `batch_` on the calling thread.
+            void do_blocking_subnegotiation_batch(std::error_code& ec);
+
+            ///@brief Handle a `negotiation_response` by writing the negotiation on the calling thread.
+            void do_blocking_response(typename stream::fsm_type::negotiation_response response, std::error_code& ec);
+
+            ///@brief Handle a `std::string` by writing raw data on the calling thread.
+            void do_blocking_response(const std::string& response, std::error_code& ec);
+
+            ///@brief Handle a `subnegotiation_awaitable` by awaiting it and writing the result on the calling thread.
+            void do_blocking_response(awaitables::subnegotiation_awaitable awaitable, std::error_code& ec);
+
+            ///@brief Handle any `tagged_awaitable` with optional `negotiation_response` on the calling thread.
+            template<typename Tag, typename T, typename Awaitable>
+            void do_blocking_response(
+                std::tuple<
+                    awaitables::tagged_awaitable<Tag, T, Awaitable>,
+                    std::optional<typename stream::fsm_type::negotiation_response>
+                > response,
+                std::error_code& ec
+            );
+
+            std::vector<byte_t> replies_; //Negotiation replies collected by the current pass, sent once it ends
+            bool read_issued_ = false; //Whether the pending `reading` transition follows a next-layer read (vs. buffered data)
+            bool input_ready_ = false; //Whether a lean-memory readiness wait has completed for the next read
+            bool blocking_    = false; //Whether `run_blocking` drives this processor, so no OOB wait may be armed
+
+            //Empty unless `batch_subnegotiations` is enabled.
+            [[no_unique_address]] std::conditional_t<policy_traits<ProtocolConfigT>::batch_subnegotiations, subnegotiation_batch, std::monostate> batch_;
 
             //NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members): The lifetime of the input_processor instance is bound to the lifetime of the parent stream object whose members are aliased here.
             stream& parent_stream_;
@@ -361,40 +730,432 @@ export namespace net::telnet {
 
             enum class state : std::uint8_t {
                 initializing,
+                awaiting_input,
                 reading,
                 processing,
                 done
             } state_;
         }; //class input_processor
 
-        ///@brief Asynchronously sends a single NUL byte, optionally as OOB.
-        template<WriteToken CompletionToken>
-        auto async_send_nul(bool urgent, CompletionToken&& token);
+        /**
+         * @brief A private nested class template splitting Telnet input into frames as `input_processor` delivers it.
+         * @remark Reads through `async_read_some` (or `read_some`) into the tail of a `frame_batch`, ending a frame wherever the FSM reports `Delimiter`.
+         * @see `async_read_line`, `async_read_record`
+         */
+        template<processing_signal Delimiter>
+        class frame_reader {
+        public:
+            ///@brief Constructs a `frame_reader` filling `batch` from the parent stream.
+            frame_reader(stream& parent_stream, frame_batch& batch) noexcept : parent_stream_(parent_stream), batch_(batch) {}
+
+            ///@brief Asynchronous operation handler for framed reads.
+            template<typename Self>
+            void operator()(Self& self, std::error_code ec_in = {}, std::size_t bytes_transferred = 0);
+
+            ///@brief Performs the whole framed read on the calling thread with blocking next-layer I/O.
+            std::size_t run_blocking(std::error_code& ec);
+
+        private:
+            ///@brief Grows the partial frame by up to `frame_read_chunk` bytes for the next read to fill.
+            asio::mutable_buffer read_buffer(std::error_code& ec);
+
+            ///@brief Keeps the `bytes_transferred` bytes read and applies the signal in `ec`, reporting whether the read is done.
+            bool absorb(std::error_code& ec, std::size_t bytes_transferred);
+
+            //NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members): The lifetime of the frame_reader instance is bound to the lifetime of the parent stream object and the caller's batch aliased here.
+            stream& parent_stream_;
+            frame_batch& batch_;
+            //NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
+
+            std::size_t read_offset_ = 0; //Size of `batch_.data_` before `read_buffer` grew it
+            std::size_t bytes_read_  = 0; //Data bytes every read so far has appended
+            bool started_            = false;
+        }; //class frame_reader
+
+        /**
+         * @brief A private nested class for serializing and coalescing Telnet output.
+         * @remark Queues every outbound write and issues at most one `asio::async_write` on `next_layer_` at a time, gathering all writes queued within one executor turn into that single call.
+         * @remark Counts the bytes of every queued and in-flight write against the marks set by `set_output_limits`, and applies the `slow_consumer_policy` when they rise above the high-water mark.
+         * @see `async_write_temp_buffer` for the only producer, `cork` and `uncork` for explicit batching
+         */
+        class output_processor {
+        public:
+            /**
+             * @typedef handler_type
+             * @brief Type-erased completion handler for a queued write.
+             */
+            using handler_type = asio::any_completion_handler<asio_completion_signature>;
+
+            ///@brief Constructs an `output_processor` bound to the parent stream.
+            explicit output_processor(stream& parent_stream) noexcept : parent_stream_(parent_stream) {}
+
+            ///@brief Type-erases `handler`, binding `asio::recycling_allocator` if it has no allocator of its own so the erased storage is recycled.
+            template<typename Handler>
+            [[nodiscard]] static handler_type make_handler(Handler&& handler)
+            {
+                if constexpr (std::same_as<asio::associated_allocator_t<std::decay_t<Handler>>, std::allocator<void>>) {
+                    return handler_type(
+                        asio::bind_allocator(asio::recycling_allocator<void>(), std::forward<Handler>(handler))
+                    );
+                } else {
+                    return handler_type(std::forward<Handler>(handler));
+                }
+            }
+
+            ///@brief Queues a pooled buffer (or slice list) and its completion handler, scheduling a flush; `droppable` marks application data.
+            template<typename T>
+            void enqueue(std::vector<T>&& buffer, handler_type handler, bool droppable = false);
+
+            ///@brief Queues a reference to shared, already-escaped application data and its completion handler, scheduling a flush.
+            void enqueue_shared(std::shared_ptr<const std::vector<byte_t>> bytes, handler_type handler);
+
+            ///@brief Queues a Telnet Synch sequence and its completion handler, scheduling a flush.
+            void enqueue_synch(handler_type handler);
+
+            ///@brief Queues the MCCP start sequence, after which queued writes are compressed, and its completion handler.
+            void enqueue_start_compression(std::vector<byte_t>&& start_sequence, handler_type handler);
+
+            ///@brief Queues the end of the compressed stream and its completion handler, scheduling a flush.
+            void enqueue_stop_compression(handler_type handler);
+
+            ///@brief Queues IAC SB START_TLS FOLLOWS IAC SE, after which queued writes are encrypted, and its completion handler.
+            void enqueue_start_tls(std::vector<byte_t>&& follows_sequence, handler_type handler);
+
+            ///@brief Queues the TLS close_notify and its completion handler, scheduling a flush.
+            void enqueue_stop_tls(handler_type handler);
+
+            ///@brief Schedules a flush for records the TLS session queued, or for writes its completed handshake released.
+            void notify_tls_output() { schedule_flush(); }
+
+            ///@brief Holds queued writes until the matching `uncork`.
+            void cork() noexcept { ++cork_depth_; }
+
+            ///@brief Releases one `cork`, scheduling a flush once fully uncorked.
+            void uncork();
+
+            ///@brief Reports whether the queue is currently corked.
+            [[nodiscard]] bool is_corked() const noexcept { return cork_depth_ > 0; }
+
+            ///@brief Reports whether no write is queued or in flight.
+            [[nodiscard]] bool is_idle() const noexcept { return !writing_ && pending_.empty(); }
+
+            ///@brief Sets the high-water and low-water marks and the policy applied above the high-water mark.
+            void set_limits(std::size_t high_water, std::size_t low_water, slow_consumer_policy policy);
+
+            ///@brief Gets the number of bytes queued or in flight.
+            [[nodiscard]] std::size_t depth() const noexcept { return depth_; }
+
+            ///@brief Reports whether the queue rose above the high-water mark and has not yet drained to the low-water mark.
+            [[nodiscard]] bool is_congested() const noexcept { return congested_; }
+
+            ///@brief Discards every queued application-data write that is not yet in flight, for Abort Output.
+            void discard_output();
+
+        private:
+            ///@brief What a queued write puts on the wire.
+            enum class write_kind : std::uint8_t {
+                data,              ///< `bytes` or `slices`
+                synch,             ///< The static Synch sequence
+                start_compression, ///< `bytes` holding IAC SB MCCP2/MCCP3 IAC SE; writes after it are compressed
+                stop_compression,  ///< The end of the compressed stream
+                start_tls,         ///< `bytes` holding IAC SB START_TLS FOLLOWS IAC SE; writes after it are encrypted
+                stop_tls           ///< The TLS close_notify alert; writes after it fail
+            };
+
+            ///@brief A queued write: owned bytes, a slice list, shared bytes, a Synch sequence, or an MCCP or TLS transition, plus its completion handler.
+            struct pending_write {
+                std::vector<byte_t> bytes;
+                std::vector<asio::const_buffer> slices;
+                handler_type handler;
+                write_kind kind = write_kind::data;
+                std::shared_ptr<const std::vector<byte_t>> shared; //Set for `enqueue_shared`; `bytes` and `slices` are then empty
+                std::size_t depth = 0;     //This write's share of `depth_`, fixed when it is queued
+                bool droppable    = false; //Application data that Abort Output or `slow_consumer_policy::drop_oldest` may discard
+            }; //struct pending_write
+
+            ///@brief A completion `slow_consumer_policy::block` holds until the queue drains to the low-water mark.
+            struct held_completion {
+                handler_type handler;
+                std::error_code ec;
+                std::size_t bytes = 0;
+            }; //struct held_completion
+
+            ///@brief Counts `write` toward `depth_`, appends it to `pending_`, applies the policy if it crossed the high-water mark, and schedules a flush.
+            void push(pending_write&& write);
+
+            ///@brief Discards the oldest queued application-data writes until `depth_` is at most `target`, failing each with `error::output_dropped`.
+            void drop_pending(std::size_t target);
+
+            ///@brief Fails every queued write with `error::slow_consumer`, defers that error to the next read, and closes the socket.
+            void disconnect();
+
+            ///@brief Clears congestion and posts every held completion once `depth_` is at most the low-water mark.
+            void relieve_congestion();
+
+            ///@brief Posts `handler` with `ec` and `bytes` to its associated executor, or to the stream's if it has none.
+            void post_completion(handler_type&& handler, const std::error_code& ec, std::size_t bytes);
+
+            ///@brief Returns the buffer or slice list of a finished or discarded write to its pool.
+            void release_buffer(pending_write& write) noexcept;
+
+            ///@brief Gets the number of uncompressed bytes `write` puts on the wire.
+            [[nodiscard]] std::size_t write_size(const pending_write& write) const noexcept;
+
+            ///@brief Reports whether batches are currently compressed.
+            [[nodiscard]] bool is_compressing() const noexcept { return parent_stream_.context_.deflater.active(); }
+
+            ///@brief Reports whether batches are currently encrypted.
+            [[nodiscard]] bool is_encrypting() const noexcept { return parent_stream_.context_.tls_output_active; }
+
+            ///@brief Reports whether a Synch must travel in-band, since an urgent byte would land inside the zlib stream or a TLS record.
+            [[nodiscard]] bool sends_synch_in_band() const noexcept { return is_compressing() || is_encrypting(); }
+
+            ///@brief Reports whether a write is queued or the TLS session holds records to send.
+            [[nodiscard]] bool has_output() const noexcept
+            {
+                return !pending_.empty() || (is_encrypting() && parent_stream_.context_.tls.has_output());
+            }
+
+            ///@brief Posts `flush` to the stream's executor unless a flush is already scheduled, in flight, or corked.
+            void schedule_flush();
+
+            ///@brief Gathers queued writes into one batch and writes it to `next_layer_`.
+            void flush();
+
+            ///@brief Sends the urgent prefix of the Synch sequence at the front of the queue.
+            void start_synch();
+
+            ///@brief Sends the bytes of the urgent prefix after the first `sent` with `message_out_of_band`.
+            void send_synch_prefix(std::size_t sent);
+
+            ///@brief Writes the in-band suffix of the Synch sequence once the urgent prefix is sent.
+            void continue_synch(const std::error_code& ec, std::size_t prefix_bytes);
+
+            ///@brief Compresses and flushes `batch_slices_` into `compressed_batch_` and writes it to `next_layer_`.
+            void write_compressed_batch();
+
+            ///@brief Writes the records the TLS session queued, ahead of any write not yet encrypted.
+            void write_tls_records();
+
+            ///@brief Writes `buffers` to `next_layer_`, encrypting them into `sealed_batch_` first while TLS output is active.
+            template<ConstBufferSequence Buffers, typename Handler>
+            void write_wire(const Buffers& buffers, Handler on_written);
+
+            ///@brief Finishes the compressed stream at the front of the queue and writes its trailer.
+            void finish_compression();
+
+            ///@brief Queues the close_notify of the TLS stop at the front of the queue and writes it.
+            void finish_tls();
+
+            ///@brief Completes every write in the finished batch and schedules the next flush.
+            void complete_batch(const std::error_code& ec, std::size_t bytes_written);
+
+            ///@brief Frees the reusable batch storage and output pools of an idle lean-memory stream.
+            void release_idle_memory() noexcept;
+
+            //NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members): The lifetime of the output_processor instance is bound to the lifetime of the parent stream object aliased here.
+            stream& parent_stream_;
+            //NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
+
+            reusable_queue<pending_write> pending_;
+            std::vector<pending_write> in_flight_;
+            std::vector<asio::const_buffer> batch_slices_;
+            std::vector<byte_t> compressed_batch_; //Reused output of `write_compressed_batch` and `finish_compression`
+            std::vector<byte_t> sealed_batch_;     //Reused ciphertext of `write_wire` and `write_tls_records`
+            std::vector<held_completion> held_;    //Completions `slow_consumer_policy::block` holds while congested
+            std::size_t cork_depth_      = 0;
+            std::size_t depth_           = 0;
+            std::size_t high_water_      = 0;
+            std::size_t low_water_       = 0;
+            slow_consumer_policy policy_ = slow_consumer_policy::unbounded;
+            bool flush_scheduled_        = false;
+            bool writing_                = false;
+            bool congested_              = false;
+        }; //class output_processor
 
         ///@brief Synchronously awaits the completion of an awaitable operation.
         template<typename Awaitable>
         static auto sync_await(Awaitable&& awaitable);
 
+        ///@brief Writes `data` to `next_layer_` on the calling thread, queuing behind any outstanding asynchronous writes.
+        template<ConstBufferSequence CBufSeq>
+        std::size_t write_blocking(const CBufSeq& data, std::error_code& ec) noexcept;
+
+        ///@brief Writes `data` to `next_layer_` with `asio::write`, compressing it first while `context_.deflater` is active.
+        template<ConstBufferSequence CBufSeq>
+        std::size_t write_next_layer(const CBufSeq& data, std::error_code& ec);
+
+        ///@brief Writes `data` to `next_layer_` with `asio::write`, encrypting it first while TLS output is active.
+        template<ConstBufferSequence CBufSeq>
+        std::size_t write_wire_blocking(const CBufSeq& data, std::error_code& ec);
+
+        ///@brief Encrypts each buffer of `data` with `context_.tls`, appending the records to `sealed`.
+        template<ConstBufferSequence CBufSeq>
+        std::error_code seal_output(const CBufSeq& data, std::vector<byte_t>& sealed) noexcept;
+
+        ///@brief Selects the option under which output may be compressed: `MCCP2` enabled locally, else `MCCP3` enabled remotely.
+        [[nodiscard]] std::optional<option::id_num> outbound_compression_option() const;
+
+        ///@brief Builds IAC SB `opt` IAC SE, after which the sender's bytes are compressed.
+        [[nodiscard]] static constexpr std::array<byte_t, 5> compression_start_sequence(option::id_num opt) noexcept
+        {
+            return {
+                std::to_underlying(telnet::command::iac),
+                std::to_underlying(telnet::command::sb),
+                std::to_underlying(opt),
+                std::to_underlying(telnet::command::iac),
+                std::to_underlying(telnet::command::se)
+            };
+        }
+
+        ///@brief Builds IAC SB START_TLS FOLLOWS IAC SE, after which the sender's bytes are TLS records.
+        [[nodiscard]] static constexpr std::array<byte_t, 6> start_tls_sequence() noexcept
+        {
+            return {
+                std::to_underlying(telnet::command::iac),
+                std::to_underlying(telnet::command::sb),
+                std::to_underlying(option::id_num::telnet_start_tls),
+                fsm_type::start_tls_follows,
+                std::to_underlying(telnet::command::iac),
+                std::to_underlying(telnet::command::se)
+            };
+        }
+
+        ///@brief Gets the buffer plaintext lands in: `context_.compressed_input_buffer` while inflating, else `context_.input_side_buffer`.
+        [[nodiscard]] side_buffer_type& plaintext_target() noexcept
+        {
+            return context_.inflater.active() ? context_.compressed_input_buffer : context_.input_side_buffer;
+        }
+
+        ///@brief Gets the buffer next-layer reads fill: `context_.tls_input_buffer` while decrypting, else `plaintext_target()`.
+        [[nodiscard]] side_buffer_type& read_target() noexcept
+        {
+            return context_.tls_input_active ? context_.tls_input_buffer : plaintext_target();
+        }
+
+        ///@brief Reports whether plaintext already received awaits the FSM, in `context_.input_side_buffer` or behind the inflater.
+        [[nodiscard]] bool has_buffered_input() const noexcept
+        {
+            return (context_.input_side_buffer.size() != 0) || (context_.compressed_input_buffer.size() != 0);
+        }
+
+        ///@brief Defers a write error to the next read, or logs it if an error is already deferred.
+        void defer_write_error(const std::error_code& ec) noexcept;
+
+        ///@brief Enters Synch mode if the `bytes_read` just committed to the side buffer stopped at the urgent mark, unless an OOB wait will report it.
+        void check_urgent_mark(std::size_t bytes_read) noexcept;
+
+        ///@brief Starts inflating input, moving the unprocessed bytes of `context_.input_side_buffer` behind the inflater.
+        std::error_code start_input_decompression() noexcept;
+
+        ///@brief Inflates up to `inflate_chunk_size` bytes of `context_.compressed_input_buffer` into `context_.input_side_buffer`.
+        std::error_code inflate_input() noexcept;
+
+        ///@brief Checks that our FOLLOWS may be sent: START_TLS enabled, a `tls_context` set, and MCCP inactive.
+        [[nodiscard]] std::error_code check_tls_start() const noexcept;
+
+        ///@brief Checks that the session holds no state a `snapshot` cannot carry: MCCP, TLS, queued output, a pending Synch, or a deferred error.
+        [[nodiscard]] std::error_code check_snapshot() const noexcept;
+
+        ///@brief Checks that a blocking call may wait for the output queue, which it cannot on a thread running the stream's executor.
+        [[nodiscard]] std::error_code check_queued_wait() noexcept;
+
+        ///@brief Opens `context_.tls` from the `set_tls_context` configuration unless a session is already open.
+        std::error_code start_tls_session() noexcept;
+
+        ///@brief Starts decrypting input, moving the unprocessed bytes of `context_.input_side_buffer` into `context_.tls_input_buffer`.
+        std::error_code start_input_decryption() noexcept;
+
+        ///@brief Starts encrypting output once our FOLLOWS is on the wire, queuing a client's ClientHello.
+        std::error_code start_output_encryption() noexcept;
+
+        ///@brief Decrypts up to `decrypt_chunk_size` bytes from `context_.tls_input_buffer` into `plaintext_target()`, advancing the handshake as needed.
+        std::error_code decrypt_input() noexcept;
+
+        ///@brief Runs `decrypt_input` and then `inflate_input`, peeling the TLS and MCCP layers off the bytes read.
+        std::error_code unwrap_input() noexcept;
+
+        ///@brief Writes the records the TLS session queued with `asio::write`, or leaves them to `output_processor_` if it is busy.
+        std::error_code write_tls_records() noexcept;
+
+        ///@brief Completes the TLS handshake on the calling thread with blocking next-layer I/O.
+        std::error_code handshake_blocking() noexcept;
+
+        ///@brief Frames and escapes a subnegotiation as IAC SB `opt` ... IAC SE in a buffer drawn from `context_.escape_buffers`.
+        std::tuple<std::error_code, std::vector<byte_t>>
+            frame_subnegotiation(const option& opt, const std::vector<byte_t>& subnegotiation_buffer) noexcept;
+
         ///@brief Escapes Telnet output data by duplicating 0xFF (IAC) bytes into a provided vector.
         template<ConstBufferSequence CBufSeq>
         std::tuple<std::error_code, std::vector<byte_t>&>
             escape_telnet_output(std::vector<byte_t>& escaped_data, const CBufSeq& data) const noexcept;
 
-        ///@brief Escapes Telnet output data by duplicating 0xFF (IAC) bytes.
+        ///@brief Escapes Telnet output data by duplicating 0xFF (IAC) bytes into a buffer drawn from `context_.escape_buffers`.
         template<ConstBufferSequence CBufSeq>
-        std::tuple<std::error_code, std::vector<byte_t>> escape_telnet_output(const CBufSeq& data) const noexcept;
+        std::tuple<std::error_code, std::vector<byte_t>> escape_telnet_output(const CBufSeq& data) noexcept;
 
-        ///@brief Asynchronously writes a temporary buffer to the next layer.
-        template<WriteToken CompletionToken>
-        auto async_write_temp_buffer(std::vector<byte_t>&& temp_buffer, CompletionToken&& token);
+        ///@brief Builds a scatter/gather list of slices of `data` with static escape sequences spliced in.
+        template<ConstBufferSequence CBufSeq>
+        std::tuple<std::error_code, std::vector<asio::const_buffer>&>
+            escape_telnet_output(std::vector<asio::const_buffer>& slices, const CBufSeq& data) const noexcept;
+
+        ///@brief Finds the next byte in [`first`, `last`) that output escaping rewrites, for one local BINARY mode.
+        template<bool LocalBinary>
+        [[nodiscard]] static const byte_t* find_escapable(const byte_t* first, const byte_t* last) noexcept;
+
+        ///@brief Appends the escaped form of `data` to `escaped_data` using the loop for one local BINARY mode.
+        template<bool LocalBinary, ConstBufferSequence CBufSeq>
+        static void escape_into(std::vector<byte_t>& escaped_data, const CBufSeq& data);
+
+        ///@brief Appends slices of `data` and static escape sequences to `slices` using the loop for one local BINARY mode.
+        template<bool LocalBinary, ConstBufferSequence CBufSeq>
+        static void escape_into(std::vector<asio::const_buffer>& slices, const CBufSeq& data);
+
+        ///@brief Gets the escaped bytes of `message` for the current local BINARY mode, escaping them if no stream has yet.
+        std::tuple<std::error_code, std::shared_ptr<const std::vector<byte_t>>>
+            broadcast_encoding(const broadcast_message& message) const noexcept;
+
+        ///@brief Asynchronously writes a temporary (pooled) buffer or slice list to the next layer; `Droppable` marks application data.
+        template<bool Droppable = false, typename T, WriteToken CompletionToken>
+        auto async_write_temp_buffer(std::vector<T>&& temp_buffer, CompletionToken&& token);
+
+        ///@brief The leading bytes of every `snapshot`: a tag and the stream-level format version.
+        static constexpr std::array<byte_t, 4> snapshot_header = {
+            static_cast<byte_t>('T'), static_cast<byte_t>('N'), static_cast<byte_t>('S'), 0x01
+        };
+
+        ///@brief Maximum slice count for `async_write_gather` before falling back to the copying escape path.
+        static constexpr std::size_t max_gather_slices = 64;
+
+        ///@brief Maximum bytes one `inflate_input` call adds to `context_.input_side_buffer`, bounding what a compressed burst can expand to.
+        static constexpr std::size_t inflate_chunk_size = 16384;
+
+        ///@brief Maximum bytes one `decrypt_input` call adds to `plaintext_target()`; one full TLS record.
+        static constexpr std::size_t decrypt_chunk_size = 16384;
+
+        ///@brief Buffers smaller than this are coalesced on the stack by `seal_output`, so escaped fragments share a TLS record.
+        static constexpr std::size_t seal_staging_size = 4096;
+
+        ///@brief Maximum bytes one `frame_reader` read appends to its `frame_batch`.
+        static constexpr std::size_t frame_read_chunk = 4096;
+
+        ///@brief The Synch bytes sent with `message_out_of_band`; only the final NUL is urgent.
+        static constexpr std::array<byte_t, 2> synch_urgent_prefix = {static_cast<byte_t>('\0'), static_cast<byte_t>('\0')};
+
+        ///@brief The Synch bytes written in-band after the urgent prefix.
+        static constexpr std::array<byte_t, 3> synch_suffix = {
+            static_cast<byte_t>('\0'), std::to_underlying(telnet::command::iac), std::to_underlying(telnet::command::dm)
+        };
 
         ///@brief Asynchronously reports an error via the completion token.
         template<WriteToken CompletionToken>
         auto async_report_error(std::error_code ec, CompletionToken&& token);
 
         next_layer_type next_layer_;
+        [[no_unique_address]] typename fsm_type::statistics_type statistics_; //Declared before `fsm_`, which points at it
         fsm_type fsm_; //FSM member to maintain state
         context_type context_;
+        output_processor output_processor_; //Serializes and coalesces all writes to next_layer_
     }; //class stream
 
     /**
@@ -436,6 +1197,19 @@ export namespace net::telnet {
      * @remark Forwards to `fsm_.unregister_option_handlers` to remove handlers for the specified option.
      * @see `:protocol_fsm` for `protocol_fsm`, `:options` for `option`, "net.telnet-stream-impl.cpp" for implementation
      */
+    /**
+     * @fn const typename fsm_type::option_handlers_type& stream::option_handlers() const noexcept
+     * @return Const reference to the handlers of `fsm_`.
+     * @remark Copying the result shares the handler table; it does not copy the handlers.
+     * @see `set_option_handlers`
+     */
+    /**
+     * @fn void stream::set_option_handlers(typename fsm_type::option_handlers_type handlers) noexcept
+     * @param handlers The handlers to adopt, typically `prototype.option_handlers()`.
+     * @remark Lets a server register its handlers once on a prototype stream and hand each accepted session the same table, instead of every session holding its own copy of every handler.
+     * @remark A later `register_option_handlers` or `unregister_option_handlers` on this stream unshares the table first, so per-session changes stay per-session.
+     * @note Not synchronized: copy from a prototype that no other thread is modifying.
+     */
     /**
      * @fn auto stream::async_request_option(option::id_num opt, negotiation_direction direction, CompletionToken&& token)
      * @tparam CompletionToken The type of completion token.
@@ -453,7 +1227,7 @@ export namespace net::telnet {
      * @param direction The negotiation direction (`LOCAL` for WILL, `REMOTE` for DO).
      * @return The number of bytes written (typically 3 for IAC WILL/DO + option).
      * @throws std::system_error If an error occurs (e.g., `telnet::error::internal_error`, `telnet::error::option_not_available`).
-     * @remark Uses RFC 1143 Q Method via `fsm_.request_option` to validate state and set pending flags, sending `IAC WILL` or `IAC DO` via `sync_await` on `async_request_option`.
+     * @remark Uses RFC 1143 Q Method via `fsm_.request_option` to validate state and set pending flags, sending `IAC WILL` or `IAC DO` with the blocking `write_negotiation`.
      * @see RFC 1143, :protocol_fsm for `request_option`, :options for `option::id_num`, :errors for error codes, :types for `negotiation_direction`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
@@ -462,8 +1236,8 @@ export namespace net::telnet {
      * @param direction The negotiation direction (`LOCAL` for WILL, `REMOTE` for DO).
      * @param[out] ec The error code to set on failure (e.g., `telnet::error::internal_error`, `telnet::error::option_not_available`).
      * @return The number of bytes written (typically 3 for IAC WILL/DO + option), or 0 on error.
-     * @remark Wraps the throwing `request_option` overload, catching exceptions to set `ec` with appropriate error codes.
-     * @remark Uses RFC 1143 Q Method via `fsm_.request_option` and `sync_await` on `async_request_option`.
+     * @remark Uses RFC 1143 Q Method via `fsm_.request_option`, writing `IAC WILL` or `IAC DO` with the blocking `write_negotiation` on the calling thread.
+     * @remark Catches exceptions to set `ec` with appropriate error codes; the throwing overload wraps this one.
      * @see RFC 1143, :protocol_fsm for `request_option`, :options for `option::id_num`, :errors for error codes, :types for `negotiation_direction`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
@@ -483,7 +1257,7 @@ export namespace net::telnet {
      * @param direction The negotiation direction (`LOCAL` for WONT, `REMOTE` for DONT).
      * @return The number of bytes written (typically 3 for IAC WONT/DONT + option).
      * @throws std::system_error If an error occurs (e.g., `telnet::error::internal_error`, `telnet::error::option_not_available`).
-     * @remark Uses RFC 1143 Q Method via `fsm_.disable_option` to validate state and set pending flags, sending `IAC WONT` or `IAC DONT` via `sync_await` on `async_disable_option`, awaiting disablement handlers if registered.
+     * @remark Uses RFC 1143 Q Method via `fsm_.disable_option` to validate state and set pending flags, sending `IAC WONT` or `IAC DONT` with the blocking `write_negotiation`, then running disablement handlers (via `sync_await`) if registered.
      * @see RFC 1143, :protocol_fsm for `disable_option`, :options for `option::id_num`, :errors for error codes, :types for `negotiation_direction`, :awaitables for `OptionDisablementAwaitable`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
@@ -492,8 +1266,8 @@ export namespace net::telnet {
      * @param direction The negotiation direction (`LOCAL` for WONT, `REMOTE` for DONT).
      * @param[out] ec The error code to set on failure (e.g., `telnet::error::internal_error`, `telnet::error::option_not_available`).
      * @return The number of bytes written (typically 3 for IAC WONT/DONT + option), or 0 on error.
-     * @remark Wraps the throwing `disable_option` overload, catching exceptions to set `ec` with appropriate error codes.
-     * @remark Uses RFC 1143 Q Method via `fsm_.disable_option` and `sync_await` on `async_disable_option`, awaiting disablement handlers if registered.
+     * @remark Uses RFC 1143 Q Method via `fsm_.disable_option`, writing `IAC WONT` or `IAC DONT` with the blocking `write_negotiation` and running disablement handlers (via `sync_await`) if registered.
+     * @remark Catches exceptions to set `ec` with appropriate error codes; the throwing overload wraps this one.
      * @see RFC 1143, :protocol_fsm for `disable_option`, :options for `option::id_num`, :errors for error codes, :types for `negotiation_direction`, :awaitables for `OptionDisablementAwaitable`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
@@ -513,8 +1287,8 @@ export namespace net::telnet {
      * @param buffers The mutable buffer sequence to read into.
      * @return The number of bytes read and processed.
      * @throws std::system_error If an error occurs, with the error code from the operation.
-     * @remark Directly returns the result of `sync_await` on the asynchronous `async_read_some` operation.
-     * @see `sync_await` for synchronous operation, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `input_processor::run_blocking` for synchronous operation, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @overload std::size_t stream::read_some(MBufSeq&& buffers, std::error_code& ec) noexcept
@@ -522,8 +1296,64 @@ export namespace net::telnet {
      * @param buffers The mutable buffer sequence to read into.
      * @param ec The error code to set on failure.
      * @return The number of bytes read and processed, or 0 on error.
-     * @remark Wraps the throwing `read_some` overload, catching exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
-     * @see `sync_await` for synchronous operation, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Drives `protocol_fsm` over blocking `next_layer_.read_some` calls on the calling thread via `input_processor::run_blocking`; no `io_context` or thread is created.
+     * @remark Unlike the throwing overload, returns the bytes delivered alongside a `processing_signal` in `ec`.
+     * @remark Registered handler coroutines triggered by the input still run via `sync_await`.
+     * @see `input_processor::run_blocking` for synchronous operation, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn auto stream::async_read_line(frame_batch& lines, CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param lines The batch to fill; frames it held from the previous framed read are discarded first.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token; the byte count is the number of data bytes read into `lines` (including each line's LF and any bytes EC or EL later erased), as `async_read_some` would report, while `lines.size()` counts the lines.
+     * @remark Splits input where the FSM reports `processing_signal::end_of_line`, so only an RFC 854 CR LF outside remote BINARY mode ends a line; each line excludes its CR LF.
+     * @remark Completes once at least one line is complete and no buffered input remains, so a burst of lines arrives in one completion.
+     * @remark EC and EL edit the line being received, even after a read boundary; any other `processing_signal` or error completes early with the lines so far and leaves the partial line in `lines`.
+     * @remark Completes with `std::errc::message_size` if a line reaches `lines.max_frame_size()` bytes; `frame_batch::clear` discards it.
+     * @see `frame_reader`, `frame_batch`, `async_read_record`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::read_line(frame_batch& lines)
+     * @param lines The batch to fill.
+     * @return The number of data bytes read into `lines`; `lines.size()` counts the lines.
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_read_line`, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::read_line(frame_batch& lines, std::error_code& ec) noexcept
+     * @param lines The batch to fill.
+     * @param ec The error code to set on failure.
+     * @return The number of data bytes read into `lines`, which may be non-zero alongside a `processing_signal` or transport error in `ec`; `lines.size()` counts the lines.
+     * @remark Runs `frame_reader::run_blocking` over `read_some` on the calling thread.
+     * @see `async_read_line`, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn auto stream::async_read_record(frame_batch& records, CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param records The batch to fill; frames it held from the previous framed read are discarded first.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token; the byte count is the number of data bytes read into `records`, as for `async_read_line`, while `records.size()` counts the records.
+     * @remark Splits input where the FSM reports `processing_signal::end_of_record` (IAC EOR, RFC 885); line ends stay inside records.
+     * @remark Otherwise behaves as `async_read_line`.
+     * @see `frame_reader`, `frame_batch`, `async_read_line`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::read_record(frame_batch& records)
+     * @param records The batch to fill.
+     * @return The number of data bytes read into `records`; `records.size()` counts the records.
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_read_record`, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::read_record(frame_batch& records, std::error_code& ec) noexcept
+     * @param records The batch to fill.
+     * @param ec The error code to set on failure.
+     * @return The number of data bytes read into `records`, which may be non-zero alongside a `processing_signal` or transport error in `ec`; `records.size()` counts the records.
+     * @remark Runs `frame_reader::run_blocking` over `read_some` on the calling thread.
+     * @see `async_read_record`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @fn auto stream::async_write_some(const CBufSeq& data, CompletionToken&& token)
@@ -542,8 +1372,8 @@ export namespace net::telnet {
      * @param data The data to write.
      * @return The number of bytes written.
      * @throws std::system_error If an error occurs, with the error code from the operation.
-     * @remark Directly returns the result of `sync_await` on the asynchronous `async_write_some` operation.
-     * @see `sync_await` for synchronous operation, `escape_telnet_output` for escaping details, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `write_blocking` for synchronous operation, `escape_telnet_output` for escaping details, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @overload std::size_t stream::write_some(const CBufSeq& data, std::error_code& ec) noexcept
@@ -551,8 +1381,41 @@ export namespace net::telnet {
      * @param data The data to write.
      * @param ec The error code to set on failure.
      * @return The number of bytes written, or 0 on error.
-     * @remark Wraps the throwing `write_some` overload, catching exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
-     * @see `sync_await` for synchronous operation, `escape_telnet_output` for escaping details, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Builds the same bytes as `async_write_some` and writes them with `write_blocking` on the calling thread; no `io_context` or thread is created.
+     * @remark Catches exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
+     * @see `write_blocking` for synchronous operation, `escape_telnet_output` for escaping details, `:errors` for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn auto stream::async_write_gather(const CBufSeq& data, CompletionToken&& token)
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @tparam CompletionToken The type of completion token.
+     * @param data The data to write (string or binary).
+     * @param token The completion token.
+     * @return Result type deduced from the completion token.
+     * @pre `data` MUST remain valid until the operation completes, as with `asio::async_write`.
+     * @remark Builds a list of slices pointing into `data` with static `IAC IAC`, `CR LF`, and `CR NUL` buffers spliced in via `escape_telnet_output`, then writes the list with a single gathering `asio::async_write` so the payload is never copied.
+     * @remark Falls back to `async_write_some` (contiguous copy) when escaping would produce more than `max_gather_slices` slices, since dense escapes make the gather list more expensive than a copy.
+     * @remark Returns `std::errc::not_enough_memory` or `telnet::error::internal_error` via `async_report_error` if building the slice list fails.
+     * @see `async_write_some` for the copying path, `escape_telnet_output` for escaping details, RFC 854 for IAC escaping, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::write_gather(const CBufSeq& data)
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @param data The data to write.
+     * @return The number of bytes written.
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `write_blocking` for synchronous operation, `async_write_gather` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::write_gather(const CBufSeq& data, std::error_code& ec) noexcept
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @param data The data to write.
+     * @param ec The error code to set on failure.
+     * @return The number of bytes written, or 0 on error.
+     * @remark Builds the same bytes as `async_write_gather` and writes them with `write_blocking` on the calling thread; no `io_context` or thread is created.
+     * @remark Catches exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
+     * @see `write_blocking` for synchronous operation, `async_write_gather` for details, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @fn auto stream::async_write_raw(const CBufSeq& data, CompletionToken&& token)
@@ -562,8 +1425,9 @@ export namespace net::telnet {
      * @param token The completion token.
      * @return Result type deduced from the completion token.
      * @pre The input buffer must be RFC 854 compliant: data bytes of 0xFF must be doubled as 0xFF 0xFF; command sequences (e.g., IAC GA) must be included as raw bytes.
-     * @remark Uses `asio::async_write` to transmit raw bytes to `next_layer_`, respecting protocol layering.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * @pre `data` MUST remain valid and unmodified until the completion handler runs, not merely until this call returns; only its buffer descriptors are queued, not its bytes.
+     * @note Because the write waits in `output_processor`'s queue, it may complete well after later writes are initiated: behind a `cork`, behind queued writes or a batch in flight, or behind a congested queue. Keep `data` alive for all of that.
+     * @remark Queues the buffers of `data` via `async_write_temp_buffer`, so raw writes are serialized and coalesced with all other output.
      * @see RFC 854 for rules on IAC escaping or command byte structuring, `:errors` for error codes, "net.telnet-stream-async-impl.cpp" for implementation
      */
     /**
@@ -573,7 +1437,7 @@ export namespace net::telnet {
      * @return The number of bytes written.
      * @throws std::system_error If an error occurs, with the error code from the operation.
      * @pre The input buffer must be RFC 854 compliant: data bytes of 0xFF must be doubled as 0xFF 0xFF; command sequences (e.g., IAC GA) must be included as raw bytes.
-     * @remark Wraps `async_write_raw` using `sync_await`, propagating exceptions.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
      * @remark Used for simple command responses like AYT (e.g., "[YES]\xFF\xF9" for [YES] IAC GA).
      * @remark No validation is performed; callers are responsible for ensuring RFC 854 compliance.
      * @see `async_write_raw` for async implementation, `:errors` for error codes, RFC 854 for IAC escaping, `:protocol_fsm` for AYT response configuration via `set_ayt_response`, "net.telnet-stream-sync-impl.cpp" for implementation
@@ -585,19 +1449,55 @@ export namespace net::telnet {
      * @param ec The error code to set on failure.
      * @return The number of bytes written, or 0 on error.
      * @pre The input buffer must be RFC 854 compliant: data bytes of 0xFF must be doubled as 0xFF 0xFF; command sequences (e.g., IAC GA) must be included as raw bytes.
-     * @remark Wraps throwing `write_raw`, converting exceptions to error codes (`std::system_error`, `not_enough_memory`, `internal_error`).
+     * @remark Writes `data` with `write_blocking` on the calling thread, converting exceptions to error codes (`std::system_error`, `not_enough_memory`, `internal_error`).
      * @remark Used for simple command responses like AYT (e.g., "[YES]\xFF\xF9" for [YES] IAC GA).
      * @remark No validation is performed; callers are responsible for ensuring RFC 854 compliance.
      * @see `write_raw` for throwing version, `async_write_raw` for async implementation, `:errors` for error codes, RFC 854 for IAC escaping, `:protocol_fsm` for AYT response configuration via `set_ayt_response`, "net.telnet-stream-sync-impl.cpp" for implementation
      */
+    /**
+     * @fn auto stream::async_write_broadcast(const broadcast_message& message, CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param message The message to write; the queued write holds a reference to it.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token.
+     * @remark Queues the encoding of `message` for this stream's local BINARY mode via `output_processor::enqueue_shared`, escaping it with `escape_into` only if no other stream has needed that mode yet.
+     * @remark Writes of one message to many streams therefore share a single escaped buffer; nothing is copied or drawn from `context_.escape_buffers`.
+     * @remark Returns `std::errc::not_enough_memory` or `telnet::error::internal_error` via `async_report_error` if escaping fails.
+     * @see `broadcast` for fanning one message out to many streams, `broadcast_encoding`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::write_broadcast(const broadcast_message& message)
+     * @param message The message to write.
+     * @return The number of bytes written.
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_write_broadcast`, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::write_broadcast(const broadcast_message& message, std::error_code& ec) noexcept
+     * @param message The message to write.
+     * @param ec The error code to set on failure.
+     * @return The number of bytes written, or 0 on error.
+     * @remark Writes the same shared encoding as `async_write_broadcast` with `write_blocking` on the calling thread.
+     * @see `async_write_broadcast`, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::escape_output(std::vector<byte_t>& escaped_data, const CBufSeq& data, bool local_binary)
+     * @tparam CBufSeq The type of constant buffer sequence to escape.
+     * @param escaped_data The vector to append the escaped data to.
+     * @param data The input data to escape.
+     * @param local_binary Whether to escape for local BINARY mode (IAC only) rather than text mode (IAC, CR, and LF).
+     * @throws std::bad_alloc If `escaped_data` cannot grow.
+     * @remark Runs the same `escape_into` loop as `write_some`, `async_write_some`, and the broadcast encodings, without a stream, FSM, or pooled buffer, so output can be pre-encoded and the loop itself measured; "bench/net.telnet-bench.cpp" times it this way.
+     * @see `escape_telnet_output` for the stream's own dispatch on its FSM's BINARY bit, RFC 854 for IAC escaping, "net.telnet-stream-impl.cpp" for implementation
+     */
     /**
      * @fn auto stream::async_write_command(telnet::command cmd, CompletionToken&& token)
      * @tparam CompletionToken The type of completion token.
      * @param cmd The `telnet::command` to send.
      * @param token The completion token.
      * @return Result type deduced from the completion token.
-     * @remark Constructs a 2-byte buffer with `{IAC, std::to_underlying(cmd)}` and writes it to `next_layer_` using `asio::async_write`.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * @remark Constructs a 2-byte pooled buffer with `{IAC, std::to_underlying(cmd)}` and queues it via `async_write_temp_buffer`.
      * @see `:types` for `telnet::command`, `:errors` for error codes, RFC 854 for command structure, "net.telnet-stream-async-impl.cpp" for implementation
      */
     /**
@@ -605,16 +1505,17 @@ export namespace net::telnet {
      * @param cmd The `telnet::command` to send.
      * @return The number of bytes written.
      * @throws std::system_error If an error occurs, with the error code from the operation.
-     * @remark Directly returns the result of `sync_await` on the asynchronous `async_write_command` operation.
-     * @see `sync_await` for synchronous operation, :types for `telnet::command`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `write_blocking` for synchronous operation, :types for `telnet::command`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @overload std::size_t stream::write_command(telnet::command cmd, std::error_code& ec) noexcept
      * @param cmd The `telnet::command` to send.
      * @param ec The error code to set on failure.
      * @return The number of bytes written, or 0 on error.
-     * @remark Wraps the throwing `write_command` overload, catching exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
-     * @see `sync_await` for synchronous operation, :types for `telnet::command`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Builds the same bytes as `async_write_command` and writes them with `write_blocking` on the calling thread; no `io_context` or thread is created.
+     * @remark Catches exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
+     * @see `write_blocking` for synchronous operation, :types for `telnet::command`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @fn auto stream::async_write_negotiation(typename fsm_type::negotiation_response response, CompletionToken&& token)
@@ -622,11 +1523,25 @@ export namespace net::telnet {
      * @param response The negotiation response to write.
      * @param token The completion token.
      * @return Result type deduced from the completion token.
-     * @remark Constructs a 3-byte buffer with `{IAC, std::to_underlying(cmd), std::to_underlying(opt)}` and writes it to `next_layer_` using `asio::async_write` if `cmd` is `WILL`, `WONT`, `DO`, or `DONT`.
-     * @remark Returns `telnet::error::invalid_negotiation` via `async_report_error` if `cmd` is not `WILL`, `WONT`, `DO`, or `DONT`.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * @remark Constructs a 3-byte pooled buffer with `{IAC, std::to_underlying(cmd), std::to_underlying(opt)}` and queues it via `async_write_temp_buffer`.
      * @see :types for `telnet::command`, :options for `option::id_num`, :errors for `invalid_negotiation`, RFC 855 for negotiation, "net.telnet-stream-async-impl.cpp" for implementation
      */
+    /**
+     * @fn std::size_t stream::write_negotiation(typename fsm_type::negotiation_response response)
+     * @param response The negotiation response to write.
+     * @return The number of bytes written (3).
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::write_negotiation(typename fsm_type::negotiation_response response, std::error_code& ec) noexcept
+     * @param response The negotiation response to write.
+     * @param[out] ec The error code to set on failure.
+     * @return The number of bytes written (3), or 0 on error.
+     * @remark Writes `{IAC, cmd, opt}` from a stack buffer with `write_blocking` on the calling thread.
+     * @see `write_blocking` for synchronous operation, RFC 855 for negotiation, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
     /**
      * @fn auto stream::async_write_subnegotiation(option opt, const std::vector<byte_t>& subnegotiation_buffer, CompletionToken&& token)
      * @tparam CompletionToken The type of completion token.
@@ -635,7 +1550,7 @@ export namespace net::telnet {
      * @param token The completion token.
      * @return Result type deduced from the completion token.
      * @remark Validates that `opt` supports subnegotiation via `opt.supports_subnegotiation()` and is enabled via `fsm_.is_enabled(opt)`.
-     * @remark Constructs a buffer by reserving space for `subnegotiation_buffer` plus 10% for escaping and 5 bytes (IAC SB, `opt`, IAC SE), appending IAC SB `opt`, escaping the subnegotiation data with `escape_telnet_output`, and appending IAC SE.
+     * @remark Constructs a buffer via `frame_subnegotiation` by reserving space for `subnegotiation_buffer` plus 10% for escaping and 5 bytes (IAC SB, `opt`, IAC SE), appending IAC SB `opt`, escaping the subnegotiation data with `escape_telnet_output`, and appending IAC SE.
      * @remark Returns `telnet::error::invalid_subnegotiation` if `opt` does not support subnegotiation, `telnet::error::option_not_available` if `opt` is not enabled, `std::errc::not_enough_memory` on allocation failure, or `telnet::error::internal_error` for other exceptions, all via `async_report_error`.
      * @note Subnegotiation overflow is handled by `protocol_fsm::process_byte` for incoming subnegotiations, not outgoing writes.
      * @see :options for `option` and `option::id_num`, :errors for error codes, `escape_telnet_output` for escaping, :protocol_fsm for `protocol_fsm`, RFC 855 for subnegotiation, "net.telnet-stream-async-impl.cpp" for implementation
@@ -646,8 +1561,8 @@ export namespace net::telnet {
      * @param subnegotiation_buffer The data buffer for the subnegotiation.
      * @return The number of bytes written.
      * @throws std::system_error If an error occurs, with the error code from the operation.
-     * @remark Directly returns the result of `sync_await` on the asynchronous `async_write_subnegotiation` operation.
-     * @see `sync_await` for synchronous operation, :options for `option` and `option::id_num`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `write_blocking` for synchronous operation, :options for `option` and `option::id_num`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @overload std::size_t stream::write_subnegotiation(option opt, const std::vector<byte_t>& subnegotiation_buffer, std::error_code& ec) noexcept
@@ -655,30 +1570,135 @@ export namespace net::telnet {
      * @param subnegotiation_buffer The data buffer for the subnegotiation.
      * @param ec The error code to set on failure.
      * @return The number of bytes written, or 0 on error.
-     * @remark Wraps the throwing `write_subnegotiation` overload, catching exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
-     * @see `sync_await` for synchronous operation, :options for `option` and `option::id_num`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
+     * @remark Builds the same bytes as `async_write_subnegotiation` and writes them with `write_blocking` on the calling thread; no `io_context` or thread is created.
+     * @remark Catches exceptions to set `ec` with appropriate error codes (e.g., `std::system_error`, `not_enough_memory`, `internal_error`).
+     * @see `write_blocking` for synchronous operation, :options for `option` and `option::id_num`, :errors for error codes, "net.telnet-stream-sync-impl.cpp" for implementation
      */
     /**
      * @fn void stream::launch_wait_for_urgent_data()
      * @remark Updated `context_.urgent_data_state` when OOB data is available, enabling Synch mode (RFC 854).
      * @remark Sets `context_.waiting_for_urgent_data` to `true` before `async_wait` and `false` on completion.
+     * @remark Compiles to nothing under `urgent_data_policy::at_mark`, which leaves no receive pending per stream and relies on `check_urgent_mark` instead.
      * @see `stream::context_type::urgent_data_state`, `stream::context_type::waiting_for_urgent_data`, RFC 854
      */
+    /**
+     * @fn void stream::cork() noexcept
+     * @remark Nests; each `cork` requires a matching `uncork`.
+     * @remark Writes initiated while corked are accepted and queued but not sent, so a burst (e.g., negotiation replies, a subnegotiation payload, and a prompt) leaves as one gather write.
+     * @see `output_processor::cork`, `uncork`
+     */
+    /**
+     * @fn void stream::uncork()
+     * @remark Schedules a flush of everything queued once the outermost `cork` is released; does nothing if not corked.
+     * @see `output_processor::uncork`, `cork`
+     */
+    /**
+     * @fn bool stream::is_corked() const noexcept
+     * @return `true` if at least one `cork` is outstanding.
+     */
+    /**
+     * @fn void stream::set_output_limits(std::size_t high_water, std::size_t low_water, slow_consumer_policy policy)
+     * @param high_water The queued-output byte count above which `policy` applies.
+     * @param low_water The byte count the queue must drain to before the stream stops being congested; clamped to `high_water`.
+     * @param policy What to do above `high_water`: hold data-write completions (`block`), discard the oldest queued application data (`drop_oldest`), or fail the queue and close the socket (`disconnect`).
+     * @remark Counts bytes before compression and encryption. Writes made while the queue is idle go straight to `next_layer_` on the calling thread and are never counted.
+     * @remark `block` only slows writers that wait for their completions; use `drop_oldest` or `disconnect` against fire-and-forget output such as `async_write_broadcast`.
+     * @remark Setting `slow_consumer_policy::unbounded` ends any congestion and posts every held completion.
+     * @see `output_queue_depth`, `is_output_congested`, `statistic::high_water_crossings`, `statistic::output_bytes_dropped`
+     */
+    /**
+     * @fn std::size_t stream::output_queue_depth() const noexcept
+     * @return The bytes of every queued and in-flight write, before compression and encryption.
+     */
+    /**
+     * @fn bool stream::is_output_congested() const noexcept
+     * @return `true` from the write that took the queue above the high-water mark until it next drains to the low-water mark.
+     */
+    /**
+     * @fn void stream::set_read_block_size(std::size_t block_size) noexcept
+     * @param block_size The fixed number of bytes to request per read.
+     * @remark Disables adaptation; equivalent to `set_read_block_size(block_size, block_size)`.
+     * @see `read_size_tuner`
+     */
+    /**
+     * @overload void stream::set_read_block_size(std::size_t minimum, std::size_t maximum) noexcept
+     * @param minimum The smallest read size.
+     * @param maximum The largest read size.
+     * @remark By default reads start at 1 KiB and adapt between 256 bytes and 64 KiB: they grow whenever a read fills the block and shrink after a run of reads that fill less than a quarter of it.
+     * @see `read_size_tuner`
+     */
+    /**
+     * @fn std::size_t stream::read_block_size() const noexcept
+     * @return The current adaptive (or fixed) read size.
+     */
+    /**
+     * @fn statistics_snapshot stream::statistics() const noexcept
+     * @return The current value of every `statistic` counter of this stream.
+     * @remark Safe to call from any thread while the stream is in use; each counter is a relaxed atomic.
+     * @remark A high `statistic::byte_wise_fsm_bytes` relative to `statistic::bytes_received` marks a peer driving the FSM off its fast path, e.g. with IAC floods.
+     * @see `:statistics` for `statistic`
+     */
+    /**
+     * @fn std::uint64_t stream::statistics_id() const noexcept
+     * @return This stream's `stream_statistics::id()`, unique within the process.
+     * @remark Record it next to the endpoint when the session starts to label the snapshots `statistics_aggregator::for_each` reports.
+     */
+    /**
+     * @fn void stream::aggregate_statistics(statistics_aggregator& aggregator)
+     * @param aggregator The aggregator to join (defaults to `statistics_aggregator::process()`).
+     * @remark Attaching locks the aggregator's mutex once; counting never touches it. On destruction the stream's final counts fold into the aggregator's totals.
+     * @remark Does nothing when `collect_statistics` is `false`.
+     * @note Call from the thread that owns the stream, not concurrently with its destruction.
+     */
+    /**
+     * @fn std::vector<byte_t> stream::snapshot() const
+     * @return The serialized session state.
+     * @throws std::system_error If the session cannot be snapshotted.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::vector<byte_t> stream::snapshot(std::error_code& ec) const noexcept
+     * @param[out] ec Set to `telnet::error::snapshot_unavailable` if MCCP or TLS is active, output is queued or in flight, a Synch is pending, or an error is deferred.
+     * @return `snapshot_header`, `protocol_fsm::save_state`'s image, and the unscanned bytes of `context_.input_side_buffer` behind a 32-bit little-endian length; empty on error.
+     * @remark A session between negotiations serializes to about 270 bytes, so tens of thousands of sessions hand off in a few megabytes.
+     * @remark Intended for hot reload and connection migration: send the socket's descriptor (with `SCM_RIGHTS` over a Unix-domain socket) and the snapshot to a new process, which adopts the descriptor into a fresh `stream` and calls `restore` before its first read.
+     * @note Call with no read or write outstanding; the stream must not be used afterwards, since bytes it reads later are not in the snapshot.
+     * @note MCCP and TLS are refused rather than serialized, since zlib and TLS session state cannot be exported portably; stop compression first, or hand off before START_TLS.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::restore(std::span<const byte_t> image)
+     * @param image A `snapshot` from a stream of the same `ProtocolConfigT`.
+     * @throws std::system_error If `image` is rejected or the stream cannot be restored.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::restore(std::span<const byte_t> image, std::error_code& ec) noexcept
+     * @param image A `snapshot` from a stream of the same `ProtocolConfigT`.
+     * @param[out] ec Set to `telnet::error::invalid_snapshot` if `image` is truncated, has trailing bytes, or fails `protocol_fsm::restore_state`; to `telnet::error::snapshot_unavailable` under the conditions `snapshot` refuses.
+     * @remark Replaces `fsm_`'s option states and partial command and `context_.input_side_buffer`'s contents; the next read scans the restored input before reading the socket.
+     * @remark Sends nothing: both ends keep the option states they already agreed, so the peer never observes the handoff.
+     * @remark Registered handlers are not part of the snapshot; register them on the new stream before calling `restore`. Enablement handlers are not rerun for restored options.
+     * @note Leaves the stream unchanged on error.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
     /**
      * @fn auto stream::async_send_synch(CompletionToken&& token)
      * @tparam CompletionToken The type of completion token.
      * @param token The completion token.
      * @return Result type deduced from the completion token.
-     * @remark Sends a Telnet Synch sequence (three NUL bytes, one as OOB, followed by IAC DM) to `next_layer_` using `async_send_nul` and `async_write_command`, as per RFC 854.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
+     * @remark Sends a Telnet Synch sequence (three NUL bytes, the second urgent, followed by IAC DM) as per RFC 854.
+     * @remark Queued through `output_processor_` like any other write, so the urgent send never interleaves with a batch on `next_layer_`; costs one `message_out_of_band` send (repeated only after a short send) plus one in-band write.
+     * @remark While output is compressed, only `synch_suffix` is sent, in-band inside the compressed batch, since an urgent byte would corrupt the zlib stream.
+     * @remark Allocation-free in steady state: the sequence is static, the queue entry reuses `reusable_queue` storage, and `output_processor::make_handler` erases the handler into recycled memory.
      * @note Used in response to `abort_output` to flush output and signal urgency, supporting client/server symmetry.
-     * @see `async_send_nul` for OOB sending, `async_write_command` for command writing, :types for `telnet::command`, :errors for error codes, RFC 854 for Synch procedure, "net.telnet-stream-async-impl.cpp" for implementation
+     * @see `output_processor::enqueue_synch` for the composed operation, :types for `telnet::command`, :errors for error codes, RFC 854 for Synch procedure, "net.telnet-stream-async-impl.cpp" for implementation
      */
     /**
      * @fn std::size_t stream::send_synch()
      * @return The number of bytes written.
      * @throws std::system_error If an error occurs, with the error code from the operation.
-     * @remark Directly returns the result of `sync_await` on the asynchronous `async_send_synch` operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
      * @note Used in response to `abort_output` to flush output and signal urgency, supporting client/server symmetry.
      * @see `async_send_synch` for async implementation, `sync_await` for synchronous operation, :types for `telnet::command`, :errors for error codes, RFC 854 for Synch procedure, "net.telnet-stream-sync-impl.cpp" for implementation
      */
@@ -686,10 +1706,146 @@ export namespace net::telnet {
      * @overload std::size_t stream::send_synch(std::error_code& ec) noexcept
      * @param[out] ec The error code to set on failure.
      * @return The number of bytes written, or 0 on error.
-     * @remark Wraps the throwing `send_synch` overload, catching exceptions to set `ec` with appropriate error codes (e.g., `asio::error::operation_not_supported`, `std::errc::not_enough_memory`, `telnet::error::internal_error`).
+     * @remark Sends `synch_urgent_prefix` with `message_out_of_band` and writes `synch_suffix` on the calling thread, or queues via `async_send_synch` and `sync_await` if asynchronous writes are outstanding.
+     * @remark While output is compressed, writes only `synch_suffix`, compressed and in-band, as `async_send_synch` does.
+     * @remark Catches exceptions to set `ec` with appropriate error codes (e.g., `asio::error::operation_not_supported`, `std::errc::not_enough_memory`, `telnet::error::internal_error`).
      * @note Used in response to `abort_output` to flush output and signal urgency, supporting client/server symmetry.
      * @see `async_send_synch` for async implementation, `sync_await` for synchronous operation, :types for `telnet::command`, :errors for error codes, RFC 854 for Synch procedure, "net.telnet-stream-sync-impl.cpp" for implementation
      */
+    /**
+     * @fn auto stream::async_start_compression(CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token.
+     * @remark Sends IAC SB MCCP2 IAC SE if `MCCP2` is enabled locally (the server side of MCCP2), else IAC SB MCCP3 IAC SE if `MCCP3` is enabled remotely (the client side of MCCP3), through `output_processor_`.
+     * @remark Writes queued before the call are sent uncompressed; writes queued after it are compressed into one persistent zlib stream, flushed with `Z_SYNC_FLUSH` once per write batch.
+     * @remark Completes immediately with no error and 0 bytes if output is already compressed.
+     * @remark Returns `telnet::error::option_not_available` via `async_report_error` if neither option is enabled in the sending direction, or `telnet::error::compression_error` in the handler if MCCP support is not compiled in.
+     * @note The `MCCP2`/`MCCP3` options must be registered with subnegotiation support to be negotiated; the application decides when to start compressing (typically from the option's enablement handler).
+     * @see `async_stop_compression`, `output_processor::enqueue_start_compression`, `:compression` for `deflate_stream`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::start_compression()
+     * @return The number of bytes written (5).
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_start_compression` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::start_compression(std::error_code& ec) noexcept
+     * @param[out] ec The error code to set on failure.
+     * @return The number of bytes written (5), or 0 on error or if output is already compressed.
+     * @remark Writes the start sequence uncompressed with `asio::write` and then starts `context_.deflater`, or queues via `async_start_compression` and `sync_await` if asynchronous writes are outstanding.
+     * @see `async_start_compression` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn auto stream::async_stop_compression(CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token; the byte count is always 0, as the stream trailer carries no payload.
+     * @remark Queues behind every earlier write, then finishes the zlib stream with `Z_FINISH` and writes its trailer; writes queued after it are sent uncompressed.
+     * @remark Completes with no error if output is not compressed.
+     * @note MCCP requires the sender to stop when the peer sends DONT MCCP2 (or WONT MCCP3); call this from that option's disablement handler.
+     * @see `async_start_compression`, `output_processor::enqueue_stop_compression`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::stop_compression()
+     * @return 0, as for `async_stop_compression`.
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_stop_compression` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload std::size_t stream::stop_compression(std::error_code& ec) noexcept
+     * @param[out] ec The error code to set on failure.
+     * @return 0, as for `async_stop_compression`.
+     * @remark Finishes `context_.deflater` and writes the trailer with `asio::write`, or queues via `async_stop_compression` and `sync_await` if asynchronous writes are outstanding.
+     * @see `async_stop_compression` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn bool stream::is_output_compressed() const noexcept
+     * @return `true` between the completion of a start of compression and the matching stop.
+     */
+    /**
+     * @fn bool stream::is_input_compressed() const noexcept
+     * @return `true` from the peer's IAC SB MCCP2 (or MCCP3) IAC SE until the peer ends its compressed stream.
+     * @remark Input decompression is automatic: `input_processor` switches to inflating on `processing_signal::compression_start` and back to plain Telnet when the zlib stream ends.
+     */
+    /**
+     * @fn void stream::set_tls_context(tls_context context, tls_role role, std::string peer_name)
+     * @param context The shared OpenSSL configuration; an empty context makes every start of TLS fail with `telnet::error::tls_error`.
+     * @param role Which end of the handshake this stream plays; under START_TLS the Telnet server is conventionally the TLS server.
+     * @param peer_name For a client, the server host name sent as SNI and verified against its certificate.
+     * @remark Affects only sessions started afterwards.
+     */
+    /**
+     * @fn auto stream::async_start_tls(CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param token The completion token, invoked with the error code and the bytes of the FOLLOWS sequence written.
+     * @return Result of `asio::async_initiate`, depending on the token type.
+     * @remark Queues the FOLLOWS sequence behind earlier asynchronous writes; once it is written every later write is encrypted, and writes are held until the handshake completes.
+     * @remark Input is decrypted from the peer's FOLLOWS on, which `input_processor` answers with ours automatically if we have not sent it, so only the initiating side calls this.
+     * @remark Completes at once with 0 bytes if our FOLLOWS was already sent.
+     * @remark Reports `telnet::error::option_not_available` unless START_TLS is enabled in either direction, and `telnet::error::tls_error` if no `tls_context` is set or MCCP is active in either direction.
+     * @see "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::start_tls()
+     * @return The bytes of the FOLLOWS sequence written.
+     * @throws std::system_error If the checks of `async_start_tls` fail, the write fails, or the session cannot start.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::start_tls(std::error_code& ec) noexcept
+     * @param[out] ec Set to the error, if any.
+     * @return The bytes of the FOLLOWS sequence written.
+     * @remark Writes the FOLLOWS sequence with `asio::write` when no asynchronous write is queued, else queues it via `async_start_tls` and waits as `write_blocking` does.
+     * @remark The handshake itself completes during later blocking reads and writes, or in `output_processor` once asynchronous reads run.
+     * @remark Until a read has consumed the peer's FOLLOWS, blocking writes fail with `telnet::error::tls_error` rather than block, since the handshake cannot proceed before it.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::start_implicit_tls()
+     * @throws std::system_error If the session cannot start.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::start_implicit_tls(std::error_code& ec) noexcept
+     * @param[out] ec Set to `telnet::error::tls_error` if no `tls_context` is set or MCCP is active, else to any error starting the session.
+     * @remark For listeners where TLS wraps the whole connection (e.g., port 992); call it before the first read or write so no plaintext crosses the wire.
+     * @remark A client's ClientHello is written by the first flush of `output_processor` or the first blocking write or read.
+     * @see "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn auto stream::async_stop_tls(CompletionToken&& token)
+     * @tparam CompletionToken The type of completion token.
+     * @param token The completion token.
+     * @return Result type deduced from the completion token; the byte count is always 0, as the alert carries no payload.
+     * @remark Queues behind every earlier write, including records the session queued, then has `tls_session::shutdown` queue close_notify and writes it; writes queued after it fail.
+     * @remark Completes with no error if our FOLLOWS was never sent; like every write it is held until the handshake completes, and fails with `telnet::error::tls_error` if the session never started.
+     * @remark Does not wait for the peer's close_notify, which a later read reports as `asio::error::eof`; close the socket after either.
+     * @see `async_start_tls`, `output_processor::enqueue_stop_tls`, "net.telnet-stream-async-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::stop_tls()
+     * @throws std::system_error If an error occurs, with the error code from the operation.
+     * @remark Wraps the `noexcept` overload, throwing if it sets `ec`.
+     * @see `async_stop_tls` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @overload void stream::stop_tls(std::error_code& ec) noexcept
+     * @param[out] ec The error code to set on failure.
+     * @remark Completes a pending handshake with `handshake_blocking`, then writes the close_notify with `asio::write`, or queues via `async_stop_tls` and `sync_await` if asynchronous writes are outstanding.
+     * @see `async_stop_tls` for details, "net.telnet-stream-sync-impl.cpp" for implementation
+     */
+    /**
+     * @fn bool stream::is_tls_active() const noexcept
+     * @return `true` once a TLS session has been opened, by either FOLLOWS or `start_implicit_tls`, even before its handshake completes.
+     */
+    /**
+     * @fn bool stream::is_tls_established() const noexcept
+     * @return `true` once the handshake completed; only then are queued writes released.
+     */
     /**
      * @fn stream::input_processor::input_processor(stream& parent_stream, stream::fsm_type& fsm, context_type& context, MutableBufferSequence buffers)
      * @param parent_stream Reference to the parent `stream` managing the connection.
@@ -711,6 +1867,65 @@ export namespace net::telnet {
      * @note Checks `done` state early to prevent reentrancy issues after completion.
      * @see :protocol_fsm for `protocol_fsm` processing, :errors for error codes, :options for `option::id_num`, RFC 854 for Telnet protocol, "net.telnet-stream-async-impl.cpp" for implementation
      */
+    /**
+     * @fn std::size_t stream::input_processor::run_blocking(std::error_code& ec)
+     * @param[out] ec Set to the terminal `processing_signal` or transport error, if any.
+     * @return The number of bytes delivered into the user's buffer.
+     * @remark Blocks on `next_layer().read_some` and answers FSM responses with the blocking writers, all on the calling thread.
+     * @remark Shares `scan_side_buffer`, `process_fsm_signals`, and `process_write_error` with the asynchronous path, so both yield identical bytes and signals.
+     * @remark Writes each pass's pipelined negotiation replies with `write_replies_blocking` before acting on why the pass stopped.
+     * @remark While input is compressed, reads fill `context_.compressed_input_buffer` and `inflate_input` feeds the FSM, as on the asynchronous path.
+     * @remark Arms no OOB wait, even under `urgent_data_policy::oob_wait`: a stream read only synchronously never has its executor run, so no receive is left pending and `check_urgent_mark` detects the Synch.
+     * @warning Must not run concurrently with an outstanding `async_read_some` on the same stream.
+     * @see `read_some`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn scan_result stream::input_processor::scan_side_buffer()
+     * @return Why processing stopped: `abort_output` set after an AO, an engaged `response` for the FSM to send, or otherwise `ec` holding the terminal signal or deferred transport error (empty when the input ran out or the user's buffer filled).
+     * @remark Consumes every byte it processed from `context_.input_side_buffer`, including the byte that produced the signal or response.
+     * @remark Does not stop for a plain `negotiation_response`: its reply is appended to `replies_` via `queue_negotiation_reply` and the scan continues, so a volley of negotiations costs one pass and one write.
+     * @remark On `processing_signal::compression_start`, moves the rest of the input behind the inflater via `start_input_decompression` and keeps scanning the inflated bytes; the signal never reaches the caller.
+     * @remark While `batch_` holds handlers, instead returns `processing_signal::compression_start` in `ec`, since inflating may compact the side buffer those handlers view; `resume_scan` starts the inflater once they have run.
+     * @remark Handles `processing_signal::tls_start` the same way, via `start_tls_input`.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn scan_result stream::input_processor::start_tls_input()
+     * @return Any error starting decryption; `tls_follows` set if our FOLLOWS is still unsent; otherwise a fresh `scan_side_buffer` result.
+     * @remark The caller answers `tls_follows` with `async_start_tls` (or `start_tls` when blocking) before reading on, as START_TLS requires both FOLLOWS before either side's handshake can finish.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn scan_result stream::input_processor::resume_scan()
+     * @return The held `batch_.stop`, or a fresh `scan_side_buffer` result.
+     * @remark Restores a held AO to `context_.deferred_processing_signal` and starts a held `compression_start` or `tls_start`, so each takes effect after the batch as it would have without it.
+     */
+    /**
+     * @fn bool stream::input_processor::collect_subnegotiations(scan_result& scan)
+     * @param[in,out] scan The result of the scan just run; left as the result that ended collection if no handler was collected.
+     * @return `true` if `batch_` now holds handlers, with the result that ended collection moved into `batch_.stop`.
+     * @remark Rescans after each `subnegotiation_awaitable`, so every complete subnegotiation already buffered joins the batch; any other result ends it.
+     * @remark Takes a stopping AO out of `context_.deferred_processing_signal` until `resume_scan`, so the read cannot report it before the Synch is sent.
+     */
+    /**
+     * @fn asio::awaitable<std::tuple<std::error_code, std::vector<byte_t>>> stream::input_processor::run_subnegotiation_batch(std::vector<awaitables::subnegotiation_awaitable> handlers)
+     * @param handlers The handlers in arrival order, owned by the coroutine frame.
+     * @return The first handler or framing error (`std::errc::not_enough_memory` or `telnet::error::internal_error` for non-system exceptions), if any, and every non-empty reply framed by `frame_subnegotiation` before it, in order, in one pooled buffer (empty if none).
+     * @remark Awaits the handlers in sequence, so a handler sees the effects of those before it, as without batching.
+     * @remark On a failure, later handlers are not run, but the replies already framed are still returned so the caller sends them before reporting the error, just as each would have been written before the failing handler ran without batching.
+     */
+    /**
+     * @fn void stream::input_processor::dispatch_subnegotiation_batch(Self&& self)
+     * @tparam Self The type of the composed operation.
+     * @param self The composed operation, resumed in `processing` once the batch and its single reply write complete.
+     * @remark One `co_spawn` and one queued write per batch, rather than one of each per subnegotiation.
+     * @remark If a handler fails, queues the replies framed before it and then completes with its error.
+     */
+    /**
+     * @fn void stream::input_processor::do_blocking_subnegotiation_batch(std::error_code& ec)
+     * @param[out] ec Set to a write error or, failing that, a handler error, if any.
+     * @remark Runs `run_subnegotiation_batch` with one `sync_await`, then writes the replies with `write_blocking`, including those framed before a failing handler.
+     */
     /**
      * @fn void stream::input_processor::complete(Self& self, const std::error_code& ec, std::size_t bytes_transferred)
      * @tparam Self The type of the coroutine self reference.
@@ -725,13 +1940,33 @@ export namespace net::telnet {
      * @param ec The error code to defer.
      * @remark Updates `context_.deferred_transport_error` with `ec` if no prior error exists, otherwise logs the new error using `protocol_config_type::log_error` with the prior error as context.
      * @pre `ec` is a write error from an asynchronous operation (e.g., `async_write_negotiation`).
+     * @remark Delegates to `stream::defer_write_error`.
      * @post If `context_.deferred_transport_error` was set, it is unchanged; otherwise, `context_.deferred_transport_error` is set to `ec`.
      * @see `:errors` for error codes, `:protocol_fsm` for `protocol_config_type`, "net.telnet-stream-impl.cpp" for implementation
      */
+    /**
+     * @fn bool stream::input_processor::queue_negotiation_reply(const typename fsm_type::negotiation_response& response) noexcept
+     * @param response The negotiation the FSM asked the stream to send.
+     * @return `true` if the three bytes were appended; `false` if `replies_` could not grow, in which case the scan returns `response` to be written on its own.
+     * @remark Draws `replies_` from `context_.escape_buffers` on the first reply of a pass, and counts `statistic::negotiations_answered`.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::input_processor::send_replies()
+     * @remark Does nothing if the pass queued no replies; otherwise hands `replies_` to `async_write_temp_buffer` without waiting for the write, so parsing resumes at once.
+     * @remark Called before acting on why a pass stopped, so the replies precede any Synch, response, or FOLLOWS that follows them in the input, and any write a completion handler issues.
+     * @remark The write's handler holds only the parent stream and defers a failure via `stream::defer_write_error`, since this `input_processor` may have completed by then.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::input_processor::write_replies_blocking()
+     * @remark Blocking counterpart of `send_replies` for `run_blocking`; writes `replies_` via `write_blocking` and defers a failure via `process_write_error`.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
     /**
      * @fn void stream::input_processor::process_fsm_signals(std::error_code& signal_ec)
      * @param[in,out] signal_ec The error code from `fsm_.process_byte`, cleared for handled `processing_signal` values.
-     * @remark Handles `processing_signal::carriage_return` by appending `\r` to the user buffer, `processing_signal::erase_character` by decrementing the write iterator if not at the buffer start, `processing_signal::erase_line` by resetting the write iterator to the buffer start, and `processing_signal::data_mark` by updating `context_.urgent_data_state` and relaunching urgent data wait.
+     * @remark Handles `processing_signal::carriage_return` by appending `\r` to the user buffer, `processing_signal::erase_character` by decrementing the write iterator if not at the buffer start, `processing_signal::erase_line` by resetting the write iterator to the buffer start, and `processing_signal::data_mark` by updating `context_.urgent_data_state` and, unless `run_blocking` drives the processor, relaunching urgent data wait.
      * @remark Unhandled signals (e.g., `processing_signal::abort_output`) are not cleared and propagate to the caller for higher-level notification.
      * @see `:errors` for `processing_signal`, `:protocol_fsm` for `protocol_fsm`, `:stream` for `context_type`, "net.telnet-stream-impl.cpp" for implementation, RFC 854 for Telnet protocol
      */
@@ -748,8 +1983,9 @@ export namespace net::telnet {
      * @tparam Self The type of the coroutine self reference.
      * @param response The string data to write (pre-escaped).
      * @param self The completion handler to forward.
-     * @remark Initiates an asynchronous write of raw data using `async_write_raw`, wrapping the string in a `std::shared_ptr<std::string>` for lifetime management.
-     * @see `:errors` for error codes, RFC 854 for IAC escaping, "net.telnet-stream-async-impl.cpp" for `async_write_raw`
+     * @remark Copies the string into a buffer drawn from `context_.escape_buffers` and queues it via `async_write_temp_buffer`, so the queue owns the bytes until the write completes.
+     * @remark Reports `std::errc::not_enough_memory` via `async_report_error` if the copy fails.
+     * @see `:errors` for error codes, RFC 854 for IAC escaping, "net.telnet-stream-async-impl.cpp" for `async_write_temp_buffer`
      */
     /**
      * @overload void stream::input_processor::do_response(awaitables::subnegotiation_awaitable awaitable, Self&& self)
@@ -772,55 +2008,485 @@ export namespace net::telnet {
      * @throws `std::system_error` for system errors, `telnet::error::internal_error` for unexpected exceptions.
      * @see `:awaitables` for `tagged_awaitable`, `:protocol_fsm` for `negotiation_response`, `:errors` for error codes, RFC 855 for negotiation, "net.telnet-stream-async-impl.cpp" for `async_write_negotiation`
      */
+    /**
+     * @fn void stream::input_processor::do_blocking_response(typename stream::fsm_type::negotiation_response response, std::error_code& ec)
+     * @param response The negotiation response to write.
+     * @param[out] ec Set to the write error, if any.
+     * @remark Blocking counterpart of `do_response` for `run_blocking`; writes via `write_negotiation`.
+     */
+    /**
+     * @overload void stream::input_processor::do_blocking_response(const std::string& response, std::error_code& ec)
+     * @param response The string data to write (pre-escaped).
+     * @param[out] ec Set to the write error, if any.
+     * @remark Writes straight from `response` via `write_blocking`; no pooled copy is needed.
+     */
+    /**
+     * @overload void stream::input_processor::do_blocking_response(awaitables::subnegotiation_awaitable awaitable, std::error_code& ec)
+     * @param awaitable The subnegotiation awaitable to process.
+     * @param[out] ec Set to the handler or write error, if any.
+     * @remark Runs the handler coroutine via `sync_await`, then writes any result via `write_subnegotiation`.
+     */
+    /**
+     * @overload void stream::input_processor::do_blocking_response(std::tuple<awaitables::tagged_awaitable<Tag, T, Awaitable>, std::optional<typename stream::fsm_type::negotiation_response>> response, std::error_code& ec)
+     * @tparam Tag The semantic tag for `tagged_awaitable`.
+     * @tparam T The underlying value type for `tagged_awaitable`.
+     * @tparam Awaitable The underlying Awaitable type for `tagged_awaitable`.
+     * @param response Tuple of awaitable and optional negotiation response.
+     * @param[out] ec Set to the handler or write error, if any.
+     * @remark Writes any negotiation response via `write_negotiation`, then runs the handler coroutine via `sync_await`.
+     */
+    /**
+     * @fn stream::frame_reader::frame_reader(stream& parent_stream, frame_batch& batch) noexcept
+     * @param parent_stream Reference to the parent `stream` read from.
+     * @param batch Reference to the caller's `frame_batch`, which must outlive the operation.
+     */
+    /**
+     * @fn void stream::frame_reader::operator()(Self& self, std::error_code ec_in, std::size_t bytes_transferred)
+     * @tparam Self The type of the composed asynchronous operation.
+     * @param self Reference to the composed operation.
+     * @param ec_in The error code or `processing_signal` from the previous `async_read_some`.
+     * @param bytes_transferred The bytes the previous `async_read_some` delivered.
+     * @remark On first entry, calls `frame_batch::start_batch`; thereafter `absorb`s each read and issues the next until `absorb` reports the read done.
+     * @remark Completes with the data bytes every read appended as the byte count, matching `async_read_some`; the frame count is `frame_batch::size`.
+     */
+    /**
+     * @fn std::size_t stream::frame_reader::run_blocking(std::error_code& ec)
+     * @param[out] ec Set to the error or `processing_signal` that ended the read early, if any.
+     * @return The number of data bytes every read appended.
+     * @remark Runs the same `read_buffer` -> read -> `absorb` cycle as `operator()`, with `read_some` in place of `async_read_some`.
+     */
+    /**
+     * @fn asio::mutable_buffer stream::frame_reader::read_buffer(std::error_code& ec)
+     * @param[out] ec Set to `std::errc::message_size` if the partial frame already fills `max_frame_size()`.
+     * @return The newly grown tail of the batch's storage.
+     * @remark Limits each read so the partial frame cannot outgrow `max_frame_size()`.
+     */
+    /**
+     * @fn bool stream::frame_reader::absorb(std::error_code& ec, std::size_t bytes_transferred)
+     * @param[in,out] ec The result of the read; cleared for every signal handled here.
+     * @param bytes_transferred The bytes the read appended.
+     * @return `true` if the operation should complete with `ec`.
+     * @remark `Delimiter` ends the partial frame; with `end_of_line`, its trailing LF is excluded. With `end_of_record`, `end_of_line` is kept as data.
+     * @remark `input_processor` reports EC and EL only when its own buffer is empty, so those reaching here edit bytes of the partial frame from earlier reads.
+     * @remark Adds `bytes_transferred` to `bytes_read_`.
+     * @remark Once a frame is complete, returns `true` as soon as `has_buffered_input` is `false`, batching every frame already received.
+     */
+    /**
+     * @fn stream::output_processor::output_processor(stream& parent_stream) noexcept
+     * @param parent_stream Reference to the parent `stream` whose `next_layer_` is written.
+     */
+    /**
+     * @fn void stream::output_processor::enqueue(std::vector<T>&& buffer, handler_type handler, bool droppable)
+     * @tparam T `byte_t` for an owned pooled buffer or `asio::const_buffer` for a pooled slice list.
+     * @param buffer The buffer (or slice list) to write; ownership passes to the queue until completion.
+     * @param handler The completion handler, invoked with the error code and the byte count of this write alone.
+     * @param droppable `true` for application data, which `discard_output` and `slow_consumer_policy::drop_oldest` may discard before it is sent.
+     * @remark Schedules a flush via `asio::post`, so every write queued before the executor next runs is coalesced into one batch.
+     * @warning Not internally synchronized; writes must be initiated from the stream's executor (or an implicit strand), as for any Asio I/O object.
+     * @see `async_write_temp_buffer`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_shared(std::shared_ptr<const std::vector<byte_t>> bytes, handler_type handler)
+     * @param bytes The escaped bytes to write, shared with other streams; the queue holds the reference until completion.
+     * @param handler The completion handler, invoked with the error code and the byte count of this write alone.
+     * @remark Batched and compressed like any other data write; on completion the reference is dropped rather than pooled.
+     * @remark Always droppable, since a broadcast is the output a stalled peer most often lets pile up.
+     * @see `async_write_broadcast`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_synch(handler_type handler)
+     * @param handler The completion handler, invoked with the error code and the number of Synch bytes written.
+     * @remark The Synch keeps its place in the queue: writes queued before it complete first, and writes queued after it wait for it.
+     * @remark Holds no buffer of its own; the bytes come from `synch_urgent_prefix` and `synch_suffix`.
+     * @see `async_send_synch`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_start_compression(std::vector<byte_t>&& start_sequence, handler_type handler)
+     * @param start_sequence The pooled IAC SB MCCP2/MCCP3 IAC SE buffer.
+     * @param handler The completion handler, invoked with the error code and the bytes of `start_sequence` written.
+     * @remark The start sequence ends its batch, and `complete_batch` starts `context_.deflater` once it has been written, so every later batch is compressed.
+     * @see `async_start_compression`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_stop_compression(handler_type handler)
+     * @param handler The completion handler, invoked with the error code and 0 bytes.
+     * @remark Runs alone via `finish_compression` when it reaches the front of the queue.
+     * @see `async_stop_compression`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_stop_tls(handler_type handler)
+     * @param handler The completion handler, invoked with the error code and 0 bytes.
+     * @remark Runs alone via `finish_tls` once the records queued ahead of it are written and the handshake has completed.
+     * @see `async_stop_tls`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::enqueue_start_tls(std::vector<byte_t>&& follows_sequence, handler_type handler)
+     * @param follows_sequence The pooled IAC SB START_TLS FOLLOWS IAC SE buffer.
+     * @param handler The completion handler, invoked with the error code and the bytes of `follows_sequence` written.
+     * @remark The FOLLOWS sequence ends its batch, and `complete_batch` starts output encryption once it has been written, so every later batch is encrypted.
+     * @see `async_start_tls`, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::output_processor::uncork()
+     * @remark Decrements the cork depth and schedules a flush when it reaches zero.
+     */
+    /**
+     * @fn void stream::output_processor::set_limits(std::size_t high_water, std::size_t low_water, slow_consumer_policy policy)
+     * @param high_water The byte count above which `policy` applies.
+     * @param low_water The byte count that ends congestion; clamped to `high_water`.
+     * @param policy The `slow_consumer_policy` to apply.
+     * @remark A queue already beyond the new high-water mark is handled at the next write queued; one at or below the new low-water mark, or a switch to `slow_consumer_policy::unbounded`, ends congestion at once.
+     */
+    /**
+     * @fn void stream::output_processor::discard_output()
+     * @remark Drops queued application data with `drop_pending(0)`; negotiations, commands, subnegotiations, Synchs, and MCCP or TLS transitions stay queued, as does the batch in flight.
+     * @remark Called when the peer sends IAC AO, before the Synch is queued, so the output the peer asked to abort never reaches it.
+     */
+    /**
+     * @fn void stream::output_processor::push(pending_write&& write)
+     * @param write The write to queue.
+     * @remark Records `write_size(write)` in `write.depth`, so `depth_` stays exact even if the Synch's size changes while it waits.
+     * @remark On crossing the high-water mark, counts `statistic::high_water_crossings` and then applies the policy: `drop_oldest` calls `drop_pending(low_water_)`, `disconnect` calls `disconnect`, and `block` leaves it to `complete_batch`.
+     */
+    /**
+     * @fn void stream::output_processor::drop_pending(std::size_t target)
+     * @param target The depth to drop down to.
+     * @remark Walks `pending_` from the front, skipping writes that are not droppable; the batch in flight is never touched.
+     * @remark Posts each dropped handler with `error::output_dropped` and 0 bytes, since it may run inside the initiating function of the write that crossed the mark.
+     * @remark Counts the dropped bytes in `statistic::output_bytes_dropped`.
+     */
+    /**
+     * @fn void stream::output_processor::disconnect()
+     * @remark Posts every queued and held handler with `error::slow_consumer`, defers that error through `stream::defer_write_error`, and closes `lowest_layer()`, which aborts the batch in flight and any pending read.
+     */
+    /**
+     * @fn void stream::output_processor::relieve_congestion()
+     * @remark Posts the held completions in the order their writes finished.
+     */
+    /**
+     * @fn handler_type stream::output_processor::make_handler(Handler&& handler)
+     * @tparam Handler The concrete completion handler type.
+     * @param handler The handler to erase.
+     * @return The erased handler.
+     * @remark `asio::any_completion_handler` allocates its storage through the handler's associated allocator; with the default `std::allocator` that is one heap allocation per write.
+     * @remark `asio::recycling_allocator` serves it from Asio's per-thread recycled handler memory instead, so together with `reusable_queue` a steady-state write allocates nothing. The binding forwards the associated executor and cancellation slot unchanged.
+     * @remark A handler that already names an allocator keeps it.
+     */
+    /**
+     * @fn void stream::output_processor::post_completion(handler_type&& handler, const std::error_code& ec, std::size_t bytes)
+     * @param handler The completion handler of a dropped, failed, or held write.
+     * @param ec The error code to complete it with.
+     * @param bytes The byte count to complete it with.
+     * @remark Used by `drop_pending`, `disconnect`, and `relieve_congestion`, which may run inside an initiating function and so must not invoke the handler directly.
+     */
+    /**
+     * @fn void stream::output_processor::release_buffer(pending_write& write) noexcept
+     * @param write The finished or discarded write.
+     * @remark Drops a shared reference rather than pooling it; a Synch or stop entry holds no buffer.
+     */
+    /**
+     * @fn void stream::output_processor::schedule_flush()
+     * @remark Deduplicates flush requests with `flush_scheduled_`; a flush is never posted while a batch is in flight or the queue is corked.
+     */
+    /**
+     * @fn void stream::output_processor::flush()
+     * @remark Moves queued writes into `in_flight_` until the batch would exceed `max_gather_slices` slices (always taking at least one write), then issues a single `asio::async_write` of the gathered slices.
+     * @remark Only one batch is ever in flight, so writes never overlap on `next_layer_`.
+     * @remark A Synch entry ends the batch before it; when it reaches the front of the queue it is started alone via `start_synch`.
+     * @remark While compressing, a Synch joins the batch as `synch_suffix` instead, the batch is written via `write_compressed_batch`, and a stop entry runs alone via `finish_compression`; a start entry always ends its batch.
+     * @remark While encrypting, records the TLS session queued go first via `write_tls_records`, nothing else is written until the handshake completes, a Synch travels in-band as while compressing, each batch is sealed by `write_wire`, and a TLS stop runs alone via `finish_tls`.
+     */
+    /**
+     * @fn std::size_t stream::output_processor::write_size(const pending_write& write) noexcept
+     * @param write The queued write.
+     * @return The byte count of `write`'s buffer, slice list, or Synch sequence (only `synch_suffix` while compressing or encrypting), before compression and encryption; 0 for a stop entry.
+     */
+    /**
+     * @fn void stream::output_processor::start_synch()
+     * @remark Moves the Synch entry to `in_flight_` and sends `synch_urgent_prefix` on `lowest_layer()` with `message_out_of_band`, so the TCP urgent pointer marks its final NUL.
+     */
+    /**
+     * @fn void stream::output_processor::send_synch_prefix(std::size_t sent)
+     * @param sent The bytes of `synch_urgent_prefix` already sent.
+     * @remark Each resend is itself out-of-band, so after a short send the urgent pointer still lands on the final NUL rather than on the first.
+     */
+    /**
+     * @fn void stream::output_processor::continue_synch(const std::error_code& ec, std::size_t prefix_bytes)
+     * @param ec The error code from the latest urgent send.
+     * @param prefix_bytes The bytes of `synch_urgent_prefix` sent so far.
+     * @remark Calls `send_synch_prefix` again until the whole prefix is sent, then writes `synch_suffix` to `next_layer_` and calls `complete_batch` with the combined byte count; on error, completes immediately.
+     * @remark Each step's handler captures at most `this` and a byte count, so both fit Asio's recycled handler memory.
+     */
+    /**
+     * @fn void stream::output_processor::write_compressed_batch()
+     * @remark Compresses every slice of `batch_slices_` into the reused `compressed_batch_`, ends it with one `Z_SYNC_FLUSH`, and writes it with a single `write_wire`.
+     * @remark Handlers see their uncompressed byte counts on success and 0 on error, since compressed bytes cannot be attributed to individual writes.
+     */
+    /**
+     * @fn void stream::output_processor::finish_compression()
+     * @remark Moves the stop entry to `in_flight_`, finishes `context_.deflater` into `compressed_batch_`, and writes the trailer; completes at once if output was not compressed.
+     */
+    /**
+     * @fn void stream::output_processor::finish_tls()
+     * @remark Moves the stop entry to `in_flight_`, has `tls_session::shutdown` queue close_notify, and writes it via `write_tls_records`; completes at once with the error if the session cannot shut down.
+     */
+    /**
+     * @fn void stream::output_processor::write_tls_records()
+     * @remark Moves the session's queued records (handshake messages, alerts, or replies OpenSSL produced while decrypting) into `sealed_batch_` and writes them with `asio::async_write`, then calls `complete_batch` with 0 bytes.
+     * @remark Runs as a batch of its own, so it never interleaves with a batch already in flight.
+     */
+    /**
+     * @fn void stream::output_processor::write_wire(const Buffers& buffers, Handler on_written)
+     * @tparam Buffers The type of constant buffer sequence to write.
+     * @tparam Handler A callable taking `(const std::error_code&, std::size_t)`.
+     * @param buffers The plaintext to send.
+     * @param on_written Invoked with the error code and the plaintext bytes written: all of `buffers` on success and 0 on error while encrypting, since record bytes cannot be attributed to plaintext.
+     * @remark Seals `buffers` with `stream::seal_output` into the reused `sealed_batch_`; a sealing failure invokes `on_written` without writing anything.
+     * @remark Counts the bytes actually written to `next_layer_` in `statistic::bytes_sent`.
+     */
+    /**
+     * @fn void stream::output_processor::complete_batch(const std::error_code& ec, std::size_t bytes_written)
+     * @param ec The error code from the batch write.
+     * @param bytes_written The total bytes written for the batch.
+     * @remark Returns each write's buffer to its pool in `context_`, schedules the next flush if writes are still queued, then dispatches each handler with its own share of `bytes_written`.
+     * @remark Starts `context_.deflater` after a successfully written start entry, and output encryption after a successfully written FOLLOWS entry, before the scheduled flush can run; a failure to start is reported to that entry's handler.
+     * @remark On error, bytes are attributed to writes in queue order, so the handler of a partially written write sees its partial count.
+     * @remark Under `slow_consumer_policy::block`, holds the completions of data writes while congested and calls `relieve_congestion` once the batch is subtracted from `depth_`.
+     * @remark Under `lean_memory`, also frees every reusable buffer via `release_idle_memory` when the queue is left idle.
+     */
+    /**
+     * @fn void stream::output_processor::release_idle_memory() noexcept
+     * @remark Frees `in_flight_`'s, `batch_slices_`'s, `compressed_batch_`'s, and `sealed_batch_`'s capacity and trims `context_.escape_buffers` and `context_.gather_slices`, so an idle session keeps no output storage.
+     * @remark Busy sessions never call it: a write queued by a completion handler keeps the storage for its batch.
+     */
     /**
      * @fn auto stream::sync_await(Awaitable&& awaitable)
      * @tparam Awaitable The type of awaitable to execute.
      * @param awaitable The awaitable to await.
      * @return The result of the awaitable operation.
-     * @remark Uses a temporary `io_context` and a `jthread` to run the awaitable, capturing its result or exception.
-     * @warning Incurs overhead from creating a new `io_context` and `jthread` per call, which may impact performance in high-frequency synchronous operations, though this is minimal compared to blocking network I/O latency. Synchronous I/O inherently scales poorly.
+     * @remark Runs the awaitable on a temporary `io_context` driven inline by the calling thread, capturing its result or exception; no thread is created.
+     * @remark Only used where a coroutine must run (registered option handlers) or a blocking write must queue behind outstanding asynchronous writes; plain synchronous reads and writes never reach it.
+     * @note Limitation: the temporary `io_context` runs only the coroutine's own work. An awaitable that waits on the stream's executor (the queued write in `write_blocking`) completes only if that executor is run by another thread, so `check_queued_wait` refuses it on that executor's own thread; a stream driven purely synchronously never takes that path, since its output queue is always idle.
+     * @warning Incurs the overhead of a new `io_context` per call.
      * @throws std::system_error If the operation fails with an error code.
      * @throws std::bad_alloc If memory allocation fails.
      * @throws std::exception For other unexpected errors.
      * @see "net.telnet-stream-sync-impl.cpp" for implementation
      */
+    /**
+     * @fn std::size_t stream::write_blocking(const CBufSeq& data, std::error_code& ec) noexcept
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @param data The bytes to write, already escaped and framed.
+     * @param[out] ec Set to the write error, if any.
+     * @return The number of bytes written.
+     * @remark Writes with `asio::write` on the calling thread when `output_processor_` is idle.
+     * @remark Otherwise queues via `async_write_raw` and waits with `sync_await`, so a blocking write never overtakes or interleaves with queued asynchronous output; that fallback needs the stream's executor to be running on another thread, as any pending asynchronous write already does, and fails with `std::errc::resource_deadlock_would_occur` (see `check_queued_wait`) when called on that thread.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::write_next_layer(const CBufSeq& data, std::error_code& ec)
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @param data The bytes to write, already escaped and framed.
+     * @param[out] ec Set to the write or compression error, if any.
+     * @return The number of uncompressed bytes of `data` written, or 0 on error.
+     * @throws std::bad_alloc If the pooled compression buffer cannot be acquired.
+     * @remark While compressing, deflates `data` into a buffer from `context_.escape_buffers` and ends it with `Z_SYNC_FLUSH`, exactly as one `output_processor` batch.
+     * @remark Writes through `write_wire_blocking`, so compressed output is also encrypted while TLS output is active.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::size_t stream::write_wire_blocking(const CBufSeq& data, std::error_code& ec)
+     * @tparam CBufSeq The type of constant buffer sequence to write.
+     * @param data The escaped and possibly compressed bytes to send.
+     * @param[out] ec Set to the write, handshake, or TLS error, if any.
+     * @return The bytes of `data` written: the wire bytes when unencrypted, all of `data` or 0 when encrypted.
+     * @throws std::bad_alloc If the pooled record buffer cannot be acquired.
+     * @remark Completes a pending handshake with `handshake_blocking` first, since records cannot be sealed before it finishes.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::seal_output(const CBufSeq& data, std::vector<byte_t>& sealed) noexcept
+     * @tparam CBufSeq The type of constant buffer sequence to encrypt.
+     * @param data The plaintext to encrypt.
+     * @param[in,out] sealed The vector to append records to; records the session queued earlier come first.
+     * @return Any error from `tls_session::encrypt`.
+     * @remark Encrypts buffers of at least `seal_staging_size` bytes in place and coalesces smaller runs into one record each, so a gathered batch of escaped fragments costs neither a record per fragment nor a copy of its large slices.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::optional<option::id_num> stream::outbound_compression_option() const
+     * @return `option::id_num::mccp2` if enabled locally, else `option::id_num::mccp3` if enabled remotely, else `std::nullopt`.
+     * @remark Both options are offered (WILL) by the server; MCCP2 is compressed by the server, which sees it enabled locally, and MCCP3 by the client, which sees it enabled remotely.
+     */
+    /**
+     * @fn std::array<byte_t, 5> stream::compression_start_sequence(option::id_num opt) noexcept
+     * @param opt `option::id_num::mccp2` or `option::id_num::mccp3`.
+     * @return The five bytes IAC SB `opt` IAC SE.
+     */
+    /**
+     * @fn std::array<byte_t, 6> stream::start_tls_sequence() noexcept
+     * @return The six bytes IAC SB START_TLS FOLLOWS IAC SE.
+     */
+    /**
+     * @fn side_buffer_type& stream::plaintext_target() noexcept
+     * @return The buffer `decrypt_input` fills, or the next-layer read fills when TLS input is inactive.
+     */
+    /**
+     * @fn side_buffer_type& stream::read_target() noexcept
+     * @return The buffer into which the next next-layer read should `prepare` and `commit`.
+     * @remark The inflater and decryption are only started or ended while no read is outstanding, so a read always commits to the buffer it prepared.
+     */
+    /**
+     * @fn bool stream::has_buffered_input() const noexcept
+     * @return `true` if a read would process bytes already received before touching the network.
+     * @remark Lets `frame_reader` batch every frame already received without reaching into `context_`.
+     */
+    /**
+     * @fn void stream::defer_write_error(const std::error_code& ec) noexcept
+     * @param ec The write error.
+     * @remark Sets `context_.deferred_transport_error` and counts `statistic::deferred_errors` if no error is deferred yet; otherwise logs `ec` with the deferred error as context.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn void stream::check_urgent_mark(std::size_t bytes_read) noexcept
+     * @param bytes_read The bytes the completed next-layer read committed.
+     * @remark A read stops at the urgent mark, but the urgent byte need not be the DM: RFC 854 peers mark the DM, while `send_synch` (like many servers) marks a NUL ahead of IAC DM. So every read pays for the `at_mark` ioctl, whatever byte it ended on.
+     * @remark Skipped while input is compressed or encrypted, since the raw bytes are not Telnet commands, and while Synch mode is already active.
+     * @remark Under `urgent_data_policy::oob_wait`, skipped while an OOB wait is armed; blocking reads arm none, so they always check.
+     * @remark Logs a failed `at_mark` and carries on without Synch mode, which costs only the discarding of data before the DM.
+     */
+    /**
+     * @fn std::error_code stream::start_input_decompression() noexcept
+     * @return `telnet::error::compression_error` if MCCP support is not compiled in, `std::errc::not_enough_memory` on allocation failure, otherwise any error from `inflate_input`.
+     * @remark Called by `input_processor::scan_side_buffer` right after consuming the `SE` that signalled `processing_signal::compression_start`.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::inflate_input() noexcept
+     * @return `telnet::error::compression_error` if the compressed stream is corrupt, `std::errc::not_enough_memory` on allocation failure, otherwise success.
+     * @remark Does nothing unless `context_.inflater` is active; runs once per call so a small compressed burst cannot expand into an unbounded `context_.input_side_buffer`.
+     * @remark When the peer ends its compressed stream, appends the bytes after the trailer to `context_.input_side_buffer` as plain Telnet.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::check_tls_start() const noexcept
+     * @return `telnet::error::option_not_available` unless START_TLS is enabled in either direction, `telnet::error::tls_error` if no `tls_context` is set or MCCP is active in either direction, otherwise success.
+     * @remark MCCP must start inside TLS, never around it, so a FOLLOWS is refused while compressing.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::check_snapshot() const noexcept
+     * @return `telnet::error::snapshot_unavailable` if MCCP is active in either direction, a TLS session is open or our FOLLOWS is queued, `output_processor_` is not idle, urgent data is pending, or a processing signal or transport error is deferred; otherwise success.
+     * @remark Shared by `snapshot` and `restore`, so a state that cannot be saved cannot be overwritten either.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::check_queued_wait() noexcept
+     * @return `std::errc::resource_deadlock_would_occur` if the calling thread is running the executor of `next_layer_`, otherwise success.
+     * @remark Called by `write_blocking`, `send_synch`, `start_compression`, `stop_compression`, `start_tls`, and `stop_tls` before they queue behind outstanding asynchronous writes with `sync_await`: only that executor flushes the queue, so a wait on its own thread would never return.
+     * @remark Recognizes executors with `running_in_this_thread` (e.g., `io_context::executor_type` and strands) and an `any_io_executor` wrapping an `io_context` executor; with any other executor it cannot tell, and lets the call wait.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::start_tls_session() noexcept
+     * @return Any error from `tls_session::start`.
+     */
+    /**
+     * @fn std::error_code stream::start_input_decryption() noexcept
+     * @return `telnet::error::tls_error` if no `tls_context` is set or input is compressed, `std::errc::not_enough_memory` on allocation failure, otherwise any error from `decrypt_input`.
+     * @remark Called by `input_processor::start_tls_input` right after consuming the `SE` of the peer's FOLLOWS, and by `start_implicit_tls` before any byte is read.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::start_output_encryption() noexcept
+     * @return Any error opening the session or from its first `tls_session::handshake`.
+     * @remark Called once our FOLLOWS has been written, by `output_processor::complete_batch` or `start_tls`, and by `start_implicit_tls`.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::decrypt_input() noexcept
+     * @return The OpenSSL error if a record or the handshake failed, `asio::error::eof` once the peer sent close_notify, `std::errc::not_enough_memory` on allocation failure, otherwise success.
+     * @remark Does nothing unless TLS input is active; runs once per call, as `inflate_input` does.
+     * @remark Tells `output_processor_` when the session queued records or the handshake completed, so replies go out and held writes are released.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::unwrap_input() noexcept
+     * @return The first error from `decrypt_input` or `inflate_input`.
+     * @remark Called wherever a read completes or buffered input is scanned, so records decrypt into the (possibly compressed) plaintext buffer before the inflater runs.
+     */
+    /**
+     * @fn std::error_code stream::write_tls_records() noexcept
+     * @return Any write error.
+     * @remark Lets blocking reads send the handshake messages and replies that decrypting produced; does nothing while TLS output is inactive.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::error_code stream::handshake_blocking() noexcept
+     * @return `telnet::error::tls_error` if the peer's FOLLOWS has not arrived, since its handshake records cannot be told from Telnet bytes before then; otherwise any read, write, or TLS error.
+     * @remark Refuses rather than waits for that FOLLOWS: reading for it here would consume Telnet input no read asked for.
+     * @warning Blocks the calling thread on `next_layer_` until the handshake completes.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::tuple<std::error_code, std::vector<byte_t>> stream::frame_subnegotiation(const option& opt, const std::vector<byte_t>& subnegotiation_buffer) noexcept
+     * @param opt The `option` for the subnegotiation.
+     * @param subnegotiation_buffer The data buffer for the subnegotiation.
+     * @return The error code and the framed buffer (empty on error).
+     * @remark Shared by `async_write_subnegotiation` and `write_subnegotiation`; see the former for the framing and error codes.
+     * @see "net.telnet-stream-impl.cpp" for implementation
+     */
     /**
      * @fn std::tuple<std::error_code, std::vector<byte_t>&> stream::escape_telnet_output(std::vector<byte_t>& escaped_data, const CBufSeq& data) const noexcept
      * @tparam CBufSeq The type of constant buffer sequence to escape.
      * @param escaped_data The vector to store the escaped data.
      * @param data The input data to escape.
      * @return A tuple containing the error code (empty on success) and a reference to the modified `escaped_data` vector.
-     * @remark Processes the byte sequence directly using `buffers_iterator` and appends to `escaped_data`, duplicating 0xFF (IAC) bytes and transforming LF to CR LF and CR to CR NUL as required by RFC 854.
+     * @remark Scans each contiguous buffer with the vectorized `byte_scan::find_first_of` kernel, bulk-appending plain runs to `escaped_data`, duplicating 0xFF (IAC) bytes and transforming LF to CR LF and CR to CR NUL as required by RFC 854.
+     * @remark Reads the FSM's cached local `BINARY` bit once per call and runs the `escape_into` loop specialized for that mode, so the inner loop never branches on it.
      * @remark Sets error code to `std::errc::not_enough_memory` on memory allocation failure or `telnet::error::internal_error` for unexpected exceptions.
      * @see :errors for error codes, RFC 854 for IAC escaping, "net.telnet-stream-impl.cpp" for implementation
      */
     /**
-     * @overload std::tuple<std::error_code, std::vector<byte_t>> stream::escape_telnet_output(const CBufSeq& data) const noexcept
+     * @overload std::tuple<std::error_code, std::vector<byte_t>> stream::escape_telnet_output(const CBufSeq& data) noexcept
      * @tparam CBufSeq The type of constant buffer sequence to escape.
      * @param data The input data to escape.
      * @return A tuple containing the error code (empty on success) and a vector containing the escaped data.
-     * @remark Reserves 10% extra capacity to accommodate escaping and delegates to the overload with a provided vector.
+     * @remark Acquires a vector from `context_.escape_buffers` with 10% extra capacity to accommodate escaping and delegates to the overload with a provided vector.
+     * @remark Allocates nothing in steady state once the pool holds a buffer large enough for the write; `async_write_temp_buffer` returns the vector to the pool on completion.
      * @remark Returns an empty vector with `std::errc::not_enough_memory` error on allocation failure or `telnet::error::internal_error` for unexpected exceptions.
      * @see `:errors` for error codes, RFC 854 for IAC escaping, "net.telnet-stream-impl.cpp" for implementation
      */
     /**
-     * @fn auto async_send_nul(bool urgent, CompletionToken&& token)
-     * @tparam CompletionToken The type of completion token.
-     * @param urgent Is this byte OOB/Urgent?
-     * @param token The completion token.
-     * @return Result type deduced from the completion token.
-     * @remark Uses `asio::async_send` to write a NUL byte (`'\0'`) with optional urgent flag.
-     * @see `async_send_synch`
+     * @overload std::tuple<std::error_code, std::vector<asio::const_buffer>&> stream::escape_telnet_output(std::vector<asio::const_buffer>& slices, const CBufSeq& data) const noexcept
+     * @tparam CBufSeq The type of constant buffer sequence to escape.
+     * @param slices The vector to receive the scatter/gather slices.
+     * @param data The input data to escape.
+     * @return A tuple containing the error code (empty on success) and a reference to the modified `slices` vector.
+     * @remark Appends one slice per plain run of `data` and one static 2-byte escape buffer (`IAC IAC`, `CR LF`, or `CR NUL`) per escapable byte, found with `byte_scan::find_first_of`.
+     * @remark The slices alias `data`, so `data` MUST outlive any write of `slices`.
+     * @remark Dispatches once per call to the `escape_into` loop specialized for local `BINARY` mode, as the copying overload does.
+     * @see `async_write_gather`, RFC 854 for IAC escaping, "net.telnet-stream-impl.cpp" for implementation
+     */
+    /**
+     * @fn std::tuple<std::error_code, std::shared_ptr<const std::vector<byte_t>>> stream::broadcast_encoding(const broadcast_message& message) const noexcept
+     * @param message The message to encode.
+     * @return A tuple containing the error code (empty on success) and the shared escaped bytes (null on error).
+     * @remark Reads the FSM's cached local `BINARY` bit and passes the matching `escape_into` loop to `broadcast_message::encoding`.
+     * @remark Sets error code to `std::errc::not_enough_memory` on memory allocation failure or `telnet::error::internal_error` for unexpected exceptions.
      */
     /**
-     * @fn auto stream::async_write_temp_buffer(std::vector<byte_t>&& temp_buffer, CompletionToken&& token)
+     * @fn auto stream::async_write_temp_buffer(std::vector<T>&& temp_buffer, CompletionToken&& token)
+     * @tparam Droppable `true` for application data, which Abort Output and `slow_consumer_policy::drop_oldest` may discard before it is sent.
+     * @tparam T `byte_t` for a contiguous escaped buffer or `asio::const_buffer` for a scatter/gather slice list.
      * @tparam CompletionToken The type of completion token.
-     * @param temp_buffer The temporary buffer to write.
+     * @param temp_buffer The temporary buffer (or slice list) to write.
      * @param token The completion token.
      * @return Result type deduced from the completion token.
-     * @remark Uses `asio::async_initiate` to write `temp_buffer` to `next_layer_` via `asio::async_write`, moving `temp_buffer` into a lambda to manage its lifetime.
-     * @remark Binds the operation to the stream’s executor using `asio::bind_executor`.
-     * @note Used by `async_write_some`, `async_write_command`, `async_write_negotiation`, and `async_write_subnegotiation` for writing prepared buffers.
+     * @remark Uses `asio::async_initiate` to move `temp_buffer` and the type-erased handler into `output_processor_`, the single path by which output reaches `next_layer_`.
+     * @remark `output_processor_` returns `temp_buffer` to `context_.escape_buffers` (or `context_.gather_slices`) on completion so its capacity is reused by the next write.
+     * @remark `output_processor::make_handler` erases the handler, preserving its associated executor and recycling the erased storage.
+     * @note Used by every write operation except `async_send_synch`, which queues through `output_processor::enqueue_synch`.
      * @see `async_write_some`, `async_write_command`, `async_write_negotiation`, `async_write_subnegotiation`, :errors for error codes, "net.telnet-stream-async-impl.cpp" for implementation
      */
     /**
@@ -0,0 +1,468 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-tls.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief TLS for Telnet streams: `tls_context`, the shared OpenSSL configuration, and `tls_session`, one session's record engine.
+ * @remark `tls_session` drives OpenSSL through a BIO that reads ciphertext from a span the caller lends it and appends ciphertext to a vector, so `:stream` decrypts records straight into its side buffer and encrypts escaped output straight from its write batch, with no intermediate stream buffer as `asio::ssl::stream` would add.
+ * @remark Built against OpenSSL when `NET_TELNET_WITH_TLS` is defined; otherwise a `tls_context` is never valid and `tls_session::start` fails with `telnet::error::tls_error`.
+ * @remark Kernel TLS offload is not used: OpenSSL only enables it on socket BIOs that perform the socket I/O themselves, which would take reads and writes away from Asio and from the stream's buffers.
+ *
+ * @see `:stream` for the TLS layer and START_TLS, the START_TLS Internet-Draft (draft-altman-telnet-starttls) for the `FOLLOWS` exchange, `:errors` for `telnet::error::tls_error`
+ */
+
+module; //Including Asio and OpenSSL in the Global Module Fragment since they are not importable.
+#if defined(NET_TELNET_WITH_TLS)
+    #include <asio.hpp>
+    #include <asio/ssl.hpp>
+    #include <openssl/bio.h>
+    #include <openssl/err.h>
+    #include <openssl/ssl.h>
+#endif
+
+//Module partition interface unit
+export module net.telnet:tls;
+
+import std; //NOLINT For std::error_code, std::span, std::vector, std::shared_ptr, std::string, std::size_t, std::min
+
+import :types;  ///< @see "net.telnet-types.cppm" for `byte_t` and `tls_role`
+import :errors; ///< @see "net.telnet-errors.cppm" for `telnet::error` codes
+
+export namespace net::telnet {
+    /**
+     * @brief A reference-counted handle to an OpenSSL context, shared by every stream using the same certificates and settings.
+     * @remark Configure the context through `asio::ssl::context` (certificates, verification, ciphers), then wrap it; a default-constructed `tls_context` is empty.
+     * @remark Shares one reference on the `SSL_CTX`, so it outlives the `asio::ssl::context`; callbacks installed through that object (e.g., `set_verify_callback`) still require it to outlive every session.
+     * @see `stream::set_tls_context`
+     */
+    class tls_context {
+    public:
+        tls_context() noexcept = default;
+
+#if defined(NET_TELNET_WITH_TLS)
+        ///@brief Shares the `SSL_CTX` of a configured `asio::ssl::context`.
+        explicit tls_context(asio::ssl::context& context)
+        {
+            SSL_CTX* handle = context.native_handle();
+            SSL_CTX_up_ref(handle);
+            handle_ = std::shared_ptr<SSL_CTX>(handle, &SSL_CTX_free); //Drops the reference again if allocation fails.
+        } //tls_context(asio::ssl::context&)
+
+        ///@brief Gets the shared `SSL_CTX`.
+        [[nodiscard]] SSL_CTX* native_handle() const noexcept { return handle_.get(); }
+#endif
+
+        ///@brief Reports whether sessions can be started from this context.
+        [[nodiscard]] bool valid() const noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            return static_cast<bool>(handle_);
+#else
+            return false;
+#endif
+        } //valid() const
+
+    private:
+#if defined(NET_TELNET_WITH_TLS)
+        std::shared_ptr<SSL_CTX> handle_;
+#endif
+    }; //class tls_context
+
+    /**
+     * @brief One TLS session, encrypting a stream's outbound bytes and decrypting its inbound bytes.
+     * @remark The OpenSSL state is allocated by `start` and freed by `end`, so a session that never starts TLS costs a few pointers.
+     * @remark Handshake records, and any record OpenSSL emits while decrypting (e.g., a TLS 1.3 KeyUpdate reply), collect in an internal queue that `take_output` or the next `encrypt` drains, so they reach the wire in the order OpenSSL produced them.
+     * @remark Neither copyable nor movable, since the BIO points back at the session.
+     * @see `:stream` for `input_processor` and `output_processor`
+     */
+    class tls_session {
+    public:
+        /**
+         * @brief The outcome of one `decrypt` call.
+         */
+        struct result {
+            std::error_code ec;       ///< Set if the handshake or a record failed, or `asio::error::eof` once the peer sent close_notify
+            std::size_t consumed = 0; ///< Ciphertext bytes read from the input
+            std::size_t produced = 0; ///< Plaintext bytes written to the output
+        }; //struct result
+
+        tls_session() noexcept = default;
+        tls_session(const tls_session&)            = delete;
+        tls_session& operator=(const tls_session&) = delete;
+        tls_session(tls_session&&)                 = delete;
+        tls_session& operator=(tls_session&&)      = delete;
+        ~tls_session() { end(); }
+
+        ///@brief Reports whether a session is open.
+        [[nodiscard]] bool active() const noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            return ssl_ != nullptr;
+#else
+            return false;
+#endif
+        } //active() const
+
+        ///@brief Reports whether the handshake has completed.
+        [[nodiscard]] bool established() const noexcept { return established_; }
+
+        ///@brief Reports whether records wait to be written to the peer.
+        [[nodiscard]] bool has_output() const noexcept { return !outbox_.empty(); }
+
+        ///@brief Opens a new session from `context` for one end of the handshake.
+        std::error_code start(const tls_context& context, tls_role role, const std::string& peer_name) noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (ssl_) {
+                return {};
+            }
+            if (!context.valid()) {
+                return make_error_code(error::tls_error);
+            }
+            BIO_METHOD* method = bio_method();
+            if (!method) {
+                return make_error_code(std::errc::not_enough_memory);
+            }
+            SSL* ssl = SSL_new(context.native_handle());
+            if (!ssl) {
+                return last_error();
+            }
+            BIO* bio = BIO_new(method);
+            if (!bio) {
+                SSL_free(ssl);
+                return make_error_code(std::errc::not_enough_memory);
+            }
+            BIO_set_data(bio, this);
+            SSL_set_bio(ssl, bio, bio); //One reference serves as both read and write BIO.
+            SSL_set_options(ssl, SSL_OP_NO_RENEGOTIATION); //So `encrypt` never has to wait for the peer.
+            if (role == tls_role::client) {
+                if (!peer_name.empty()
+                    && ((SSL_set_tlsext_host_name(ssl, peer_name.c_str()) != 1) || (SSL_set1_host(ssl, peer_name.c_str()) != 1))) {
+                    SSL_free(ssl);
+                    return last_error();
+                }
+                SSL_set_connect_state(ssl);
+            } else {
+                SSL_set_accept_state(ssl);
+            }
+            ssl_         = ssl;
+            sink_        = &outbox_;
+            established_ = false;
+            return {};
+#else
+            (void)context;
+            (void)role;
+            (void)peer_name;
+            return make_error_code(error::tls_error);
+#endif
+        } //start(const tls_context&, tls_role, const std::string&)
+
+        ///@brief Advances the handshake as far as the ciphertext received so far allows, queuing any records it produces.
+        std::error_code handshake() noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (!ssl_) {
+                return make_error_code(error::tls_error);
+            }
+            if (established_) {
+                return {};
+            }
+            const int rc = SSL_do_handshake(ssl_);
+            if (rc == 1) {
+                established_ = true;
+                return {};
+            }
+            return failure(rc);
+#else
+            return make_error_code(error::tls_error);
+#endif
+        } //handshake()
+
+        ///@brief Feeds `input` to the session and decrypts into `output` until either is exhausted, completing the handshake first if needed.
+        result decrypt(std::span<const byte_t> input, std::span<byte_t> output) noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (!ssl_) {
+                return {.ec = make_error_code(error::tls_error)};
+            }
+            input_ = input;
+            result outcome{};
+            if (!established_) {
+                outcome.ec = handshake();
+            }
+            while (established_ && !outcome.ec && (outcome.produced < output.size())) {
+                std::size_t bytes = 0;
+                if (SSL_read_ex(ssl_, output.data() + outcome.produced, output.size() - outcome.produced, &bytes) != 1) {
+                    outcome.ec = failure(0); //Success if OpenSSL only needs more ciphertext.
+                    break;
+                }
+                outcome.produced += bytes;
+            }
+            outcome.consumed = input.size() - input_.size();
+            input_           = {};
+            return outcome;
+#else
+            (void)input;
+            (void)output;
+            return {.ec = make_error_code(error::tls_error)};
+#endif
+        } //decrypt(std::span<const byte_t>, std::span<byte_t>)
+
+        ///@brief Encrypts `input`, appending any queued records and then the new ones to `output`.
+        std::error_code encrypt(std::span<const byte_t> input, std::vector<byte_t>& output) noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (!ssl_ || !established_) {
+                return make_error_code(error::tls_error);
+            }
+            if (auto ec = take_output(output); ec) {
+                return ec;
+            }
+            sink_ = &output;
+            std::error_code ec;
+            while (!input.empty()) {
+                std::size_t bytes = 0;
+                if (SSL_write_ex(ssl_, input.data(), input.size(), &bytes) != 1) {
+                    ec = failure(0);
+                    if (!ec) {
+                        ec = make_error_code(error::tls_error); //Renegotiation is disabled, so a write never waits.
+                    }
+                    break;
+                }
+                input = input.subspan(bytes);
+            }
+            sink_ = &outbox_;
+            return ec;
+#else
+            (void)input;
+            (void)output;
+            return make_error_code(error::tls_error);
+#endif
+        } //encrypt(std::span<const byte_t>, std::vector<byte_t>&)
+
+        ///@brief Appends the queued records to `output`, leaving the queue empty.
+        std::error_code take_output(std::vector<byte_t>& output) noexcept
+        {
+            try {
+                output.insert(output.end(), outbox_.begin(), outbox_.end());
+            } catch (const std::bad_alloc&) {
+                return make_error_code(std::errc::not_enough_memory);
+            } catch (const std::length_error&) {
+                return make_error_code(std::errc::not_enough_memory);
+            }
+            outbox_.clear();
+            return {};
+        } //take_output(std::vector<byte_t>&)
+
+        ///@brief Queues a close_notify alert for the outbox, after which the session encrypts nothing more.
+        std::error_code shutdown() noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (!ssl_ || !established_) {
+                return make_error_code(error::tls_error);
+            }
+            if ((SSL_get_shutdown(ssl_) & SSL_SENT_SHUTDOWN) != 0) {
+                return {};
+            }
+            const int rc = SSL_shutdown(ssl_);
+            if (rc >= 0) {
+                return {}; //0 while the peer's close_notify is outstanding, which is not awaited.
+            }
+            return failure(rc);
+#else
+            return make_error_code(error::tls_error);
+#endif
+        } //shutdown()
+
+        ///@brief Frees the OpenSSL state; call `shutdown` and send its record first for an orderly close.
+        void end() noexcept
+        {
+#if defined(NET_TELNET_WITH_TLS)
+            if (ssl_) {
+                SSL_free(ssl_);
+                ssl_ = nullptr;
+            }
+            input_        = {};
+            sink_         = nullptr;
+            write_failed_ = false;
+#endif
+            established_ = false;
+            std::vector<byte_t>{}.swap(outbox_);
+        } //end()
+
+    private:
+#if defined(NET_TELNET_WITH_TLS)
+        ///@brief Gets the process-wide BIO method routing OpenSSL's I/O through `input_` and `sink_`.
+        static BIO_METHOD* bio_method() noexcept
+        {
+            static BIO_METHOD* const method = [] {
+                BIO_METHOD* created = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "net.telnet");
+                if (created) {
+                    BIO_meth_set_read_ex(created, &bio_read);
+                    BIO_meth_set_write_ex(created, &bio_write);
+                    BIO_meth_set_ctrl(created, &bio_ctrl);
+                    BIO_meth_set_create(created, &bio_create);
+                }
+                return created;
+            }();
+            return method;
+        } //bio_method()
+
+        ///@brief Serves ciphertext from `input_`, asking OpenSSL to retry once it is exhausted.
+        static int bio_read(BIO* bio, char* data, std::size_t size, std::size_t* bytes_read) noexcept
+        {
+            auto* self = static_cast<tls_session*>(BIO_get_data(bio));
+            BIO_clear_retry_flags(bio);
+            if (self->input_.empty()) {
+                BIO_set_retry_read(bio);
+                *bytes_read = 0;
+                return 0;
+            }
+            const std::size_t bytes = std::min(size, self->input_.size());
+            std::memcpy(data, self->input_.data(), bytes);
+            self->input_ = self->input_.subspan(bytes);
+            *bytes_read  = bytes;
+            return 1;
+        } //bio_read(BIO*, char*, std::size_t, std::size_t*)
+
+        ///@brief Appends ciphertext to `*sink_`.
+        static int bio_write(BIO* bio, const char* data, std::size_t size, std::size_t* bytes_written) noexcept
+        {
+            auto* self = static_cast<tls_session*>(BIO_get_data(bio));
+            BIO_clear_retry_flags(bio);
+            try {
+                const auto* first = reinterpret_cast<const byte_t*>(data); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast): OpenSSL's bytes are `char`.
+                self->sink_->insert(self->sink_->end(), first, first + size);
+            } catch (...) {
+                self->write_failed_ = true;
+                *bytes_written      = 0;
+                return 0;
+            }
+            *bytes_written = size;
+            return 1;
+        } //bio_write(BIO*, const char*, std::size_t, std::size_t*)
+
+        ///@brief Accepts flushes, which are no-ops since nothing is buffered; declines every other control.
+        static long bio_ctrl(BIO* /*bio*/, int command, long /*larg*/, void* /*parg*/) noexcept
+        {
+            return (command == BIO_CTRL_FLUSH) ? 1 : 0;
+        } //bio_ctrl(BIO*, int, long, void*)
+
+        ///@brief Marks a new BIO initialized.
+        static int bio_create(BIO* bio) noexcept
+        {
+            BIO_set_init(bio, 1);
+            return 1;
+        } //bio_create(BIO*)
+
+        ///@brief Maps the `SSL_get_error` of a failed call returning `rc` to an error, or to success if OpenSSL only needs more ciphertext.
+        std::error_code failure(int rc) noexcept
+        {
+            switch (SSL_get_error(ssl_, rc)) {
+                case SSL_ERROR_WANT_READ:
+                    return {};
+                case SSL_ERROR_ZERO_RETURN:
+                    return asio::error::eof;
+                case SSL_ERROR_SYSCALL:
+                    if (std::exchange(write_failed_, false)) {
+                        return make_error_code(std::errc::not_enough_memory);
+                    }
+                    [[fallthrough]];
+                default:
+                    return last_error();
+            }
+        } //failure(int)
+
+        ///@brief Pops the oldest OpenSSL error as an `asio::error::get_ssl_category` code, leaving any others queued.
+        static std::error_code last_error() noexcept
+        {
+            const unsigned long code = ERR_get_error();
+            if (code == 0) {
+                return make_error_code(error::tls_error);
+            }
+            return {static_cast<int>(code), asio::error::get_ssl_category()};
+        } //last_error()
+
+        SSL* ssl_ = nullptr;
+        std::span<const byte_t> input_;      //Ciphertext lent by `decrypt` for the duration of the call
+        std::vector<byte_t>* sink_ = nullptr; //`outbox_`, or `encrypt`'s output during the call
+        bool write_failed_         = false;
+#endif
+        std::vector<byte_t> outbox_; //Records produced outside `encrypt`, oldest first
+        bool established_ = false;
+    }; //class tls_session
+
+    /**
+     * @fn tls_context::tls_context(asio::ssl::context& context)
+     * @param context A configured Asio SSL context; only its `SSL_CTX` is retained.
+     * @throws std::bad_alloc If the shared handle cannot be allocated.
+     * @remark Only available when `NET_TELNET_WITH_TLS` is defined.
+     */
+    /**
+     * @fn std::error_code tls_session::start(const tls_context& context, tls_role role, const std::string& peer_name) noexcept
+     *
+     * @param context The shared configuration.
+     * @param role Which end of the handshake to play.
+     * @param peer_name For a client, the server host name sent as SNI and checked against its certificate when `context` verifies peers; ignored if empty or for a server.
+     * @return `telnet::error::tls_error` if `context` is empty or TLS support is not compiled in, an `asio::error::get_ssl_category` code if OpenSSL fails, otherwise success.
+     *
+     * @remark Disables renegotiation for the session, so only the peer's records can make OpenSSL wait.
+     * @remark Does nothing if a session is already open.
+     */
+    /**
+     * @fn std::error_code tls_session::handshake() noexcept
+     *
+     * @return Success while the handshake merely awaits the peer's records; the OpenSSL error if it failed (e.g., certificate verification); `telnet::error::tls_error` if no session is open.
+     *
+     * @remark A client's first call queues its ClientHello; `decrypt` advances the handshake on its own afterwards.
+     */
+    /**
+     * @fn tls_session::result tls_session::decrypt(std::span<const byte_t> input, std::span<byte_t> output) noexcept
+     *
+     * @param input The ciphertext received from the peer; `bio_read` reads it in place.
+     * @param output The space to decrypt into, typically the prepared tail of the stream's side buffer.
+     * @return The bytes consumed and produced, and any error.
+     *
+     * @remark OpenSSL keeps a partial record it has consumed, so the caller drops `consumed` bytes even when nothing was produced.
+     * @remark Callers loop while `produced == output.size()`, since OpenSSL may hold further plaintext.
+     */
+    /**
+     * @fn std::error_code tls_session::encrypt(std::span<const byte_t> input, std::vector<byte_t>& output) noexcept
+     *
+     * @param input The escaped (and possibly compressed) Telnet bytes to send.
+     * @param[in,out] output The vector to append records to.
+     * @return `telnet::error::tls_error` before the handshake completes, `std::errc::not_enough_memory` if `output` cannot grow, the OpenSSL error on failure, otherwise success.
+     *
+     * @remark Drains queued records into `output` first, so records OpenSSL produced while decrypting precede the new ones.
+     */
+    /**
+     * @fn std::error_code tls_session::shutdown() noexcept
+     *
+     * @return `telnet::error::tls_error` if no session is open or its handshake has not completed, the OpenSSL error on failure, otherwise success.
+     *
+     * @remark The close_notify record lands in the outbox for `take_output`; later calls queue nothing and succeed.
+     * @remark Only our half closes: records the peer sends afterwards still decrypt, and its close_notify ends input with `asio::error::eof`.
+     */
+    /**
+     * @fn void tls_session::end() noexcept
+     *
+     * @remark Sends nothing, so a peer that has not yet seen `shutdown`'s close_notify cannot tell a truncation from a close.
+     * @remark Safe to call when no session is open; also called by the destructor.
+     */
+} //namespace net::telnet
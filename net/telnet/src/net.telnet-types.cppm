@@ -22,6 +22,8 @@
  * @brief Partition for Telnet protocol-related types.
  * @remark Defines `byte_t` type alias for the byte stream's underlying type.
  * @remark Defines `telnet::command` and `negotiation_direction` enumerations.
+ * @remark Defines `urgent_data_policy`, `tls_role`, and `slow_consumer_policy` enumerations for stream configuration.
+ * @remark Defines `log_level` and `log_traits`, which fills in the logging policy of configurations that do not declare one, and `policy_traits`, which does the same for their other compile-time policies.
  * @remark Defines custom formatters for `telnet::command` and `negotiation_direction` for use with `std::format`.
  *
  * @remark This module is fully inline.
@@ -30,7 +32,7 @@
 //Module partition interface unit
 export module net.telnet:types;
 
-import std;        //NOLINT For std::format, std::string_view, std::format_context
+import std;        //NOLINT For std::format, std::string_view, std::format_context, std::error_code
 import std.compat; //NOLINT For std::uint8_t
 
 export namespace net::telnet {
@@ -77,6 +79,141 @@ export namespace net::telnet {
         local, ///< Local side ("us", sends WILL/WONT, receives DO/DONT)
         remote ///< Remote side ("them", sends DO/DONT, receives WILL/WONT)
     }; //enum class NegotiationDirection
+
+    /**
+     * @brief Enumeration of log severities, in increasing order, for `ProtocolConfig::log`.
+     * @remark Compared against `ProtocolConfig::minimum_log_level` at compile time so that disabled levels are never formatted.
+     * @see `:protocol_config` for `default_protocol_fsm_config::log`, `:concepts` for `ProtocolFSMConfig`
+     */
+    enum class log_level : std::uint8_t {
+        trace,   ///< Byte-level tracing
+        debug,   ///< Benign peer behavior worth noting (e.g., redundant negotiation)
+        info,    ///< Notable state changes
+        warning, ///< Recoverable misbehavior
+        error,   ///< Failures and protocol violations
+        off      ///< Disables logging entirely when used as the minimum level
+    }; //enum class log_level
+
+    /**
+     * @brief Looks up the logging policy of a `ProtocolConfig`, supplying defaults for a configuration that declares none.
+     * @tparam ConfigT The configuration type.
+     * @remark A configuration written before `log_level` existed, with only `log_error`, still satisfies `ProtocolFSMConfig`; its errors are logged and everything below `log_level::info` is compiled out.
+ * @remark The only compile-time filter: `default_protocol_fsm_config::log` does not compare against `minimum_log_level`, so the library logs every message through `log_traits` and each configuration's own `minimum_log_level` decides what is compiled in.
+     * @see `:protocol_config` for `default_protocol_fsm_config::log`, `:concepts` for `ProtocolFSMConfig`
+     */
+    template<typename ConfigT>
+    struct log_traits {
+        ///@brief `ConfigT::minimum_log_level` if declared, otherwise `log_level::info`.
+        static constexpr log_level minimum_log_level = [] {
+            if constexpr (requires { static_cast<log_level>(ConfigT::minimum_log_level); }) {
+                return static_cast<log_level>(ConfigT::minimum_log_level);
+            } else {
+                return log_level::info;
+            }
+        }();
+
+        ///@brief Logs through `ConfigT::log<Level>` if declared, otherwise through `ConfigT::log_error`, unless `Level` is below `minimum_log_level`.
+        template<log_level Level, typename... Args>
+        static void log(const std::error_code& ec, std::format_string<std::remove_cvref_t<Args>...> fmt, Args&&... args)
+        {
+            if constexpr (Level < minimum_log_level) {
+                return;
+            } else if constexpr (requires { ConfigT::template log<Level>(ec, fmt, std::forward<Args>(args)...); }) {
+                ConfigT::template log<Level>(ec, fmt, std::forward<Args>(args)...);
+            } else {
+                ConfigT::log_error(ec, fmt, std::forward<Args>(args)...);
+            }
+        } //log(const std::error_code&, std::format_string<Args...>, Args&&...)
+    }; //struct log_traits
+
+    /**
+     * @fn template<log_level Level, typename ...Args> void log_traits::log(const std::error_code& ec, std::format_string<auto> fmt, Args&&... args)
+     *
+     * @tparam Level The severity of the message.
+     * @tparam Args Variadic argument type pack.
+     * @param ec The error code to log.
+     * @param fmt The format string for the message.
+     * @param args Arguments to format the message.
+     *
+     * @remark The level is compared first, at compile time, so a filtered-out call never formats its arguments, whichever configuration supplies it.
+     */
+
+    /**
+     * @brief Enumeration of ways a `stream` notices TCP urgent data, which begins an RFC 854 Synch.
+     * @remark Selected at compile time by `ProtocolConfig::urgent_data`.
+     * @see `:protocol_config` for `default_protocol_fsm_config::urgent_data`, `:stream` for `stream::launch_wait_for_urgent_data`
+     */
+    enum class urgent_data_policy : std::uint8_t {
+        oob_wait, ///< Keeps a zero-byte `message_out_of_band` receive pending on every stream
+        at_mark   ///< Asks the kernel (`sockatmark`) after every read whether it stopped at the urgent mark
+    }; //enum class urgent_data_policy
+
+    /**
+     * @brief Supplies the compile-time policy members of a protocol configuration, defaulting those `ConfigT` does not declare.
+     * @tparam ConfigT The protocol configuration.
+     * @remark The defaults are `default_protocol_fsm_config`'s, so a standalone configuration declares only the policies it changes.
+     * @see `:protocol_config` for `default_protocol_fsm_config`, `:concepts` for `ProtocolFSMConfig`, `log_traits` for the logging policy
+     */
+    template<typename ConfigT>
+    struct policy_traits {
+        ///@brief `ConfigT::lean_memory` if declared, otherwise `false`.
+        static constexpr bool lean_memory = [] {
+            if constexpr (requires { static_cast<bool>(ConfigT::lean_memory); }) {
+                return static_cast<bool>(ConfigT::lean_memory);
+            } else {
+                return false;
+            }
+        }();
+
+        ///@brief `ConfigT::collect_statistics` if declared, otherwise `true`.
+        static constexpr bool collect_statistics = [] {
+            if constexpr (requires { static_cast<bool>(ConfigT::collect_statistics); }) {
+                return static_cast<bool>(ConfigT::collect_statistics);
+            } else {
+                return true;
+            }
+        }();
+
+        ///@brief `ConfigT::batch_subnegotiations` if declared, otherwise `false`.
+        static constexpr bool batch_subnegotiations = [] {
+            if constexpr (requires { static_cast<bool>(ConfigT::batch_subnegotiations); }) {
+                return static_cast<bool>(ConfigT::batch_subnegotiations);
+            } else {
+                return false;
+            }
+        }();
+
+        ///@brief `ConfigT::urgent_data` if declared, otherwise `urgent_data_policy::oob_wait`.
+        static constexpr urgent_data_policy urgent_data = [] {
+            if constexpr (requires { static_cast<urgent_data_policy>(ConfigT::urgent_data); }) {
+                return static_cast<urgent_data_policy>(ConfigT::urgent_data);
+            } else {
+                return urgent_data_policy::oob_wait;
+            }
+        }();
+    }; //struct policy_traits
+
+    /**
+     * @brief Which end of the TLS handshake a stream plays.
+     * @remark Independent of the Telnet roles: under START_TLS either side may receive the first `FOLLOWS`, but the TLS client still sends the ClientHello.
+     * @see `:tls` for `tls_session`, `:stream` for `stream::set_tls_context`
+     */
+    enum class tls_role : std::uint8_t {
+        client, ///< Sends the ClientHello and verifies the server's certificate
+        server  ///< Answers the ClientHello with the certificate from its `tls_context`
+    }; //enum class tls_role
+
+    /**
+     * @brief What a `stream` does when its queued output rises above the high-water mark.
+     * @remark Set per stream with `stream::set_output_limits`. Only application data (`async_write_some`, `async_write_gather`, `async_write_broadcast`) is ever dropped; negotiations, commands, subnegotiations, and raw writes are always kept.
+     * @see `:stream` for `stream::set_output_limits` and `stream::output_queue_depth`
+     */
+    enum class slow_consumer_policy : std::uint8_t {
+        unbounded,   ///< Queues without limit; the marks are ignored
+        block,       ///< Holds the completion of each data write until the queue drains to the low-water mark
+        drop_oldest, ///< Discards the oldest queued application data until the queue is at the low-water mark
+        disconnect   ///< Fails every queued write with `error::slow_consumer` and closes the socket
+    }; //enum class slow_consumer_policy
 } //namespace net::telnet
 
 export namespace std {
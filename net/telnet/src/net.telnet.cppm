@@ -25,8 +25,12 @@
  *   - `:errors`       = Telnet-specific error codes.
  *   - `:concepts`     = Concepts for Telnet stream constraints and protocol finite state machine configuration.
  *   - `:options`      = Option management and factory functions.
+ *   - `:statistics`   = Per-stream statistics counters and their process-wide aggregator.
+ *   - `:broadcast`    = Shared messages escaped once and written to many streams.
  *   - `:protocol_fsm` = Telnet protocol state machine.
+ *   - `:tls`          = TLS contexts and the per-session record engine behind implicit TLS and START_TLS.
  *   - `:stream`       = Asynchronous and synchronous stream operations filtering Telnet data from the raw socket byte stream.
+ *   - `:server`       = Sharded multi-core TCP acceptor with one `io_context` per core.
  * @remark Provides a modular, thread-safe, and performance-optimized interface for Telnet protocol operations, supporting compile-time configuration and runtime extensibility.
  * @note Designed for integration with asynchronous I/O via Boost.Asio.
  * @remark Compile-time configuration is provided through a template parameter to `stream` (in `:stream`) that is used to instantiate its `ProtocolFSM` (in `:protocol_fsm`).
@@ -44,5 +48,9 @@ export import :errors;       ///< @see "net.telnet-errors.cppm"
 export import :concepts;     ///< @see "net.telnet-concepts.cppm"
 export import :options;      ///< @see "net.telnet-options.cppm"
 export import :awaitables;   ///< @see "net.telnet-awaitables.cppm"
+export import :statistics;   ///< @see "net.telnet-statistics.cppm"
+export import :broadcast;    ///< @see "net.telnet-broadcast.cppm"
 export import :protocol_fsm; ///< @see "net.telnet-protocol_fsm.cppm"
+export import :tls;          ///< @see "net.telnet-tls.cppm"
 export import :stream;       ///< @see "net.telnet-stream.cppm"
+export import :server;       ///< @see "net.telnet-server.cppm"
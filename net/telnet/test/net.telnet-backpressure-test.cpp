@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-backpressure-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks what each `slow_consumer_policy`, and Abort Output, does to writes queued behind a peer that has stopped reading.
+ * @remark The peer's receive buffer and the stream's send buffer are shrunk, so a first write far larger than both stays in flight until the peer drains it, and every later write queues behind it.
+ * @remark Each case records the order, error, byte count, and queue depth of every completion, and compares the bytes the peer finally reads.
+ *
+ * @see "net.telnet-stream-impl.cpp" for `output_processor::push`, `drop_pending`, `disconnect`, and `complete_batch`
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::string, std::optional, std::format, std::chrono
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::slow_consumer_policy;
+    using telnet::statistic;
+
+    using tcp_stream = telnet::stream<asio::ip::tcp::socket, testing::test_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief The size of the write that stalls; far more than the shrunken socket buffers on both ends hold.
+    constexpr std::size_t stall_size = 256 * 1024;
+
+    ///@brief The socket buffer size both ends ask for; the kernel may round it up, but not to anywhere near `stall_size`.
+    constexpr int socket_buffer_size = 4096;
+
+    ///@brief One write's completion, with the queue depth its handler saw.
+    struct completion {
+        char tag;
+        std::error_code ec;
+        std::size_t bytes;
+        std::size_t depth;
+    }; //struct completion
+
+    ///@brief A loopback pair whose raw peer socket does not read until `drain` is called.
+    struct stalled_loopback {
+        asio::io_context context;
+        asio::ip::tcp::socket peer{context};
+        std::optional<tcp_stream> stream;
+        std::vector<completion> completions;
+        std::vector<byte_t> received;
+        bool drained = false;
+
+        stalled_loopback()
+        {
+            asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+            peer.open(asio::ip::tcp::v4());
+            peer.set_option(asio::socket_base::receive_buffer_size(socket_buffer_size));
+            peer.set_option(asio::socket_base::out_of_band_inline(true));
+            peer.connect(acceptor.local_endpoint());
+            asio::ip::tcp::socket accepted = acceptor.accept();
+            accepted.set_option(asio::socket_base::send_buffer_size(socket_buffer_size));
+            stream.emplace(std::move(accepted));
+        } //stalled_loopback::stalled_loopback()
+
+        ///@brief Makes a completion handler that records `tag` in `completions`.
+        auto note(char tag)
+        {
+            return [this, tag](const std::error_code& ec, std::size_t bytes) {
+                completions.push_back(completion{tag, ec, bytes, stream->output_queue_depth()});
+            };
+        } //stalled_loopback::note(char)
+
+        ///@brief Writes `data` and runs the flush that starts it, checking that it is still in flight afterwards.
+        void stall(const std::string& data)
+        {
+            stream->async_write_some(asio::buffer(data), note(data.front()));
+            context.poll();
+            testing::expect(completions.empty(), "the first write stalls behind the peer");
+            testing::expect(stream->output_queue_depth() == data.size(), "the stalled write is counted in flight");
+        } //stalled_loopback::stall(const std::string&)
+
+        ///@brief Lets the peer read until the stream closes or `size` bytes have arrived.
+        void drain(std::size_t size)
+        {
+            asio::async_read(
+                peer,
+                asio::dynamic_buffer(received),
+                asio::transfer_exactly(size),
+                [this](const std::error_code& /*ec*/, std::size_t /*bytes*/) { drained = true; }
+            );
+        } //stalled_loopback::drain(std::size_t)
+
+        ///@brief Runs handlers until `done` holds or ten seconds pass, failing with `what` in the latter case.
+        template<typename Predicate>
+        void run_until(Predicate done, std::string_view what)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!done() && (std::chrono::steady_clock::now() < deadline)) {
+                if (context.stopped()) {
+                    context.restart();
+                }
+                context.run_one_for(std::chrono::milliseconds(50));
+            }
+            testing::expect(done(), what);
+        } //stalled_loopback::run_until(Predicate, std::string_view)
+
+        ///@brief Gets the tags of `completions`, in the order their handlers ran.
+        [[nodiscard]] std::string order() const
+        {
+            std::string tags;
+            for (const completion& done : completions) {
+                tags.push_back(done.tag);
+            }
+            return tags;
+        } //stalled_loopback::order() const
+
+        ///@brief Gets the completion recorded for `tag`.
+        [[nodiscard]] const completion& operator[](char tag) const
+        {
+            static const completion missing{'?', {}, 0, 0};
+            const auto it = std::ranges::find(completions, tag, &completion::tag);
+            testing::expect(it != completions.end(), std::format("write '{}' completes", tag));
+            return (it != completions.end()) ? *it : missing;
+        } //stalled_loopback::operator[](char) const
+    }; //struct stalled_loopback
+
+    ///@brief Gets `size` copies of `tag`, so the peer's bytes show which write they came from.
+    std::string payload(char tag, std::size_t size)
+    {
+        return std::string(size, tag);
+    } //payload(char, std::size_t)
+
+    /**
+     * @brief Under `block`, a data write's completion waits for the queue to drain to the low-water mark; under `unbounded`, it does not.
+     * @remark Nothing is dropped either way: every write completes in order, in full, and reaches the peer.
+     */
+    void test_block(slow_consumer_policy policy)
+    {
+        const bool blocking = (policy == slow_consumer_policy::block);
+        const std::string label = blocking ? "block" : "unbounded";
+        const std::string a = payload('a', stall_size);
+        const std::string b = payload('b', stall_size);
+        const std::string c = payload('c', stall_size);
+        const std::string d = payload('d', stall_size);
+
+        stalled_loopback pair;
+        pair.stream->set_output_limits(2 * stall_size, stall_size, policy);
+        pair.stall(a);
+        pair.stream->async_write_some(asio::buffer(b), pair.note('b'));
+        pair.stream->async_write_some(asio::buffer(c), pair.note('c'));
+        pair.stream->async_write_some(asio::buffer(d), pair.note('d'));
+        testing::expect(pair.stream->is_output_congested() == blocking, std::format("{}: congestion is reported", label));
+
+        pair.drain(4 * stall_size);
+        pair.run_until([&pair] { return pair.drained && (pair.completions.size() == 4); }, label + ": every write completes");
+
+        testing::expect_equal(pair.order(), std::string("abcd"), std::format("{}: writes complete in order", label));
+        for (const completion& done : pair.completions) {
+            testing::expect(!done.ec, std::format("{}: write '{}' succeeds, not: {}", label, done.tag, done.ec.message()));
+            testing::expect(done.bytes == stall_size, std::format("{}: write '{}' reports every byte", label, done.tag));
+        }
+        if (blocking) {
+            testing::expect(pair['a'].depth <= stall_size, "block: the first completion waits for the low-water mark");
+            testing::expect(!pair.stream->is_output_congested(), "block: congestion ends once the queue drains");
+        } else {
+            testing::expect(pair['a'].depth == 3 * stall_size, "unbounded: the first write completes with the rest queued");
+        }
+        testing::expect_equal(pair.received, testing::to_bytes(a + b + c + d), std::format("{}: the peer reads all", label));
+        testing::expect(
+            pair.stream->statistics()[statistic::high_water_crossings] == (blocking ? 1U : 0U),
+            std::format("{}: high-water crossings are counted", label)
+        );
+    } //test_block(slow_consumer_policy)
+
+    /**
+     * @brief Under `drop_oldest`, crossing the high-water mark fails the oldest queued data writes with `error::output_dropped` until the queue is at the low-water mark.
+     * @remark The write in flight and a command queued between the dropped writes are kept, and the peer reads them with the later write in order.
+     */
+    void test_drop_oldest()
+    {
+        const std::string a = payload('a', stall_size);
+        const std::string b = payload('b', stall_size / 2);
+        const std::string c = payload('c', stall_size / 2);
+        const std::string d = payload('d', stall_size / 2);
+
+        stalled_loopback pair;
+        pair.stream->set_output_limits(2 * stall_size, stall_size + (stall_size / 2), slow_consumer_policy::drop_oldest);
+        pair.stall(a);
+        pair.stream->async_write_some(asio::buffer(b), pair.note('b'));
+        pair.stream->async_write_command(command::nop, pair.note('n'));
+        pair.stream->async_write_some(asio::buffer(c), pair.note('c')); //Crosses the high-water mark: drops b, then c.
+        pair.stream->async_write_some(asio::buffer(d), pair.note('d'));
+        testing::expect(!pair.stream->is_output_congested(), "drop_oldest: dropping ends congestion at once");
+
+        std::vector<byte_t> expected = testing::to_bytes(a);
+        testing::append(expected, {iac, testing::byte_of(command::nop)});
+        testing::append(expected, d);
+        pair.drain(expected.size());
+        pair.run_until([&pair] { return pair.drained && (pair.completions.size() == 5); }, "drop_oldest: all writes complete");
+
+        testing::expect_equal(pair.order(), std::string("bcand"), "drop_oldest: dropped writes complete first");
+        const auto dropped = telnet::make_error_code(telnet::error::output_dropped);
+        for (const char tag : {'b', 'c'}) {
+            testing::expect(pair[tag].ec == dropped, std::format("drop_oldest: write '{}' is dropped", tag));
+            testing::expect(pair[tag].bytes == 0, std::format("drop_oldest: dropped write '{}' reports no bytes", tag));
+        }
+        for (const char tag : {'a', 'n', 'd'}) {
+            testing::expect(!pair[tag].ec, std::format("drop_oldest: write '{}' succeeds", tag));
+        }
+        testing::expect_equal(pair.received, expected, "drop_oldest: the peer reads the kept writes in order");
+        const telnet::statistics_snapshot counts = pair.stream->statistics();
+        testing::expect(counts[statistic::high_water_crossings] == 1, "drop_oldest: one high-water crossing");
+        testing::expect(counts[statistic::output_bytes_dropped] == (b.size() + c.size()), "drop_oldest: dropped bytes count");
+    } //test_drop_oldest()
+
+    /**
+     * @brief Under `disconnect`, crossing the high-water mark fails every queued write with `error::slow_consumer` and closes the socket.
+     * @remark The write in flight fails with the close, the peer sees the connection end, and a later write fails too.
+     */
+    void test_disconnect()
+    {
+        const std::string a = payload('a', stall_size);
+        const std::string b = payload('b', stall_size);
+        const std::string c = payload('c', stall_size);
+
+        stalled_loopback pair;
+        pair.stream->set_output_limits(2 * stall_size, stall_size, slow_consumer_policy::disconnect);
+        pair.stall(a);
+        pair.stream->async_write_some(asio::buffer(b), pair.note('b'));
+        pair.stream->async_write_some(asio::buffer(c), pair.note('c')); //Crosses the high-water mark.
+        testing::expect(!pair.stream->lowest_layer().is_open(), "disconnect: the socket is closed at once");
+
+        pair.drain(3 * stall_size);
+        pair.run_until([&pair] { return pair.drained && (pair.completions.size() == 3); }, "disconnect: every write completes");
+
+        const auto slow = telnet::make_error_code(telnet::error::slow_consumer);
+        testing::expect_equal(pair.order().substr(0, 2), std::string("bc"), "disconnect: queued writes fail first, in order");
+        for (const char tag : {'b', 'c'}) {
+            testing::expect(pair[tag].ec == slow, std::format("disconnect: write '{}' fails as a slow consumer", tag));
+            testing::expect(pair[tag].bytes == 0, std::format("disconnect: failed write '{}' reports no bytes", tag));
+        }
+        testing::expect(static_cast<bool>(pair['a'].ec), "disconnect: the write in flight fails with the close");
+        testing::expect(pair.received.size() < a.size(), "disconnect: the peer sees the connection end early");
+        testing::expect(pair.stream->statistics()[statistic::high_water_crossings] == 1, "disconnect: one high-water crossing");
+
+        const std::string e = "e";
+        pair.stream->async_write_some(asio::buffer(e), pair.note('e'));
+        pair.run_until([&pair] { return pair.completions.size() == 4; }, "disconnect: a later write completes");
+        testing::expect(static_cast<bool>(pair['e'].ec), "disconnect: a later write fails");
+    } //test_disconnect()
+
+    /**
+     * @brief Abort Output from the peer fails the queued data writes with `error::output_dropped` before the stalled write finishes.
+     * @remark The write in flight and a queued command are kept, the Synch answering the AO follows them, and the read reports `processing_signal::abort_output` once the Synch is written.
+     */
+    void test_abort_output()
+    {
+        const std::string a = payload('a', stall_size);
+        const std::string b = payload('b', 16);
+        const std::string c = payload('c', 16);
+
+        stalled_loopback pair;
+        pair.stall(a);
+        pair.stream->async_write_some(asio::buffer(b), pair.note('b'));
+        pair.stream->async_write_command(command::nop, pair.note('n'));
+        pair.stream->async_write_some(asio::buffer(c), pair.note('c'));
+
+        std::vector<byte_t> buffer(64);
+        std::error_code read_ec;
+        bool read_done = false;
+        const auto record_read = [&read_ec, &read_done](const std::error_code& ec, std::size_t /*bytes*/) {
+            read_ec   = ec;
+            read_done = true;
+        };
+        pair.stream->async_read_some(asio::buffer(buffer), record_read);
+        asio::write(pair.peer, asio::buffer(std::vector<byte_t>{iac, testing::byte_of(command::ao)}));
+
+        pair.run_until([&pair] { return pair.completions.size() == 2; }, "abort output: queued data is dropped");
+        testing::expect_equal(pair.order(), std::string("bc"), "abort output: only queued data completes early");
+        const auto dropped = telnet::make_error_code(telnet::error::output_dropped);
+        for (const char tag : {'b', 'c'}) {
+            testing::expect(pair[tag].ec == dropped, std::format("abort output: write '{}' is dropped", tag));
+        }
+        testing::expect(!read_done, "abort output: the read waits for its Synch");
+
+        std::vector<byte_t> expected = testing::to_bytes(a);
+        testing::append(expected, {iac, testing::byte_of(command::nop)});
+        testing::append(expected, {0, 0, 0, iac, testing::byte_of(command::dm)});
+        pair.drain(expected.size());
+        pair.run_until([&] { return pair.drained && read_done && (pair.completions.size() == 4); }, "abort output: rest runs");
+
+        testing::expect_equal(pair.order(), std::string("bcan"), "abort output: the kept writes complete in order");
+        for (const char tag : {'a', 'n'}) {
+            testing::expect(!pair[tag].ec, std::format("abort output: write '{}' succeeds", tag));
+        }
+        testing::expect(
+            read_ec == telnet::make_error_code(telnet::processing_signal::abort_output),
+            std::format("abort output: the read reports the AO, not: {}", read_ec.message())
+        );
+        testing::expect_equal(pair.received, expected, "abort output: the peer reads the kept writes, then the Synch");
+        testing::expect(
+            pair.stream->statistics()[statistic::output_bytes_dropped] == (b.size() + c.size()),
+            "abort output: dropped bytes are counted"
+        );
+    } //test_abort_output()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_block(slow_consumer_policy::unbounded);
+    test_block(slow_consumer_policy::block);
+    test_drop_oldest();
+    test_disconnect();
+    test_abort_output();
+    return testing::exit_status();
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-batch-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that `batch_subnegotiations` changes only how subnegotiation handlers are dispatched, not what they see or what reaches the peer.
+ * @remark A batching and a non-batching `stream` read the same session, blocking and asynchronous, at several read sizes; handlers, data, errors, and replies must match.
+ * @remark A handler that throws part way through a batch must not lose the replies of the handlers before it.
+ *
+ * @see "net.telnet-stream-impl.cpp" for `run_subnegotiation_batch`, "net.telnet-test_support.cppm" for the fixtures
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::tuple, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+    using testing::delivery;
+
+    ///@brief `test_config` with subnegotiation handlers batched.
+    class batch_config : public testing::test_config {
+    public:
+        static constexpr bool batch_subnegotiations = true;
+    }; //class batch_config
+
+    using plain_stream = telnet::stream<testing::memory_stream, testing::test_config>;
+    using batch_stream = telnet::stream<testing::memory_stream, batch_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief Builds the session: WILL GMCP and WILL MSDP, then runs of back-to-back payloads, one split by IAC NOP, between text.
+    std::vector<byte_t> session()
+    {
+        std::vector<byte_t> bytes{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)};
+        testing::append(bytes, {iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::msdp)});
+        testing::append(bytes, "hello\r\n");
+        for (const std::vector<byte_t>& frame :
+             {testing::framed(option::id_num::gmcp, testing::to_bytes("Core.Hello {}")),
+              testing::framed(option::id_num::msdp, std::vector<byte_t>{1, 'H', 'P', 2, iac, '9'}),
+              testing::framed(option::id_num::gmcp, {})}) {
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+        }
+        testing::append(bytes, "text between\r\n");
+        for (const std::vector<byte_t>& frame :
+             {testing::framed(option::id_num::gmcp, testing::to_bytes("Char.Vitals {}")),
+              std::vector<byte_t>{iac, testing::byte_of(command::nop)},
+              testing::framed(option::id_num::msdp, testing::to_bytes("\x01VAR\x02VAL"))}) {
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+        }
+        testing::append(bytes, "goodbye\r\n");
+        return bytes;
+    } //session()
+
+    ///@brief Everything one read of the session produced.
+    struct outcome {
+        std::vector<delivery> deliveries;
+        std::vector<byte_t> data;
+        std::vector<std::error_code> errors;
+        std::vector<byte_t> written;
+    }; //struct outcome
+
+    ///@brief Reads `input` through a fresh `Stream` in `chunk_size` reads, blocking or asynchronous, with `testing::record_and_echo` as every handler.
+    template<typename Stream>
+    outcome read_session(std::span<const byte_t> input, std::size_t chunk_size, bool async)
+    {
+        outcome result;
+        asio::io_context context;
+        Stream stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        testing::register_echo_handlers(stream, result.deliveries);
+        result.data = async ? testing::async_read_to_end(stream, context, chunk_size, &result.errors)
+                            : testing::read_to_end(stream, chunk_size, &result.errors);
+        result.written = stream.next_layer().written();
+        return result;
+    } //read_session(std::span<const byte_t>, std::size_t, bool)
+
+    ///@brief Compares batched against one-at-a-time dispatch for both read styles and several read sizes.
+    void test_batch_matches_unbatched()
+    {
+        const std::vector<byte_t> input = session();
+        for (const std::size_t chunk_size : {input.size(), 4096UZ, 64UZ, 7UZ, 1UZ}) {
+            for (const bool async : {false, true}) {
+                const std::string label = std::format("{}-byte {} reads", chunk_size, async ? "async" : "blocking");
+                const outcome expected  = read_session<plain_stream>(input, chunk_size, async);
+                const outcome actual    = read_session<batch_stream>(input, chunk_size, async);
+                testing::expect(expected.deliveries.size() == 5, label + ": every payload is delivered");
+                testing::expect(actual.deliveries == expected.deliveries, label + ": handlers see the same payloads");
+                testing::expect_equal(actual.data, expected.data, label + ": same data");
+                testing::expect_equal(actual.errors, expected.errors, label + ": same errors");
+                testing::expect_equal(actual.written, expected.written, label + ": same replies");
+            }
+        }
+    } //test_batch_matches_unbatched()
+
+    ///@brief Records like `testing::record_and_echo`, but fails on the payload "fail" instead of echoing it.
+    telnet::awaitables::subnegotiation_awaitable
+        record_and_fail(std::vector<delivery>* log, option opt, std::span<const byte_t> data)
+    {
+        log->push_back({opt.get_id(), {data.begin(), data.end()}});
+        if (std::ranges::equal(data, testing::to_bytes("fail"))) {
+            throw std::system_error(telnet::make_error_code(telnet::error::protocol_violation));
+        }
+        co_return std::tuple{opt, std::vector<byte_t>(data.begin(), data.end())};
+    } //record_and_fail(std::vector<delivery>*, option, std::span<const byte_t>)
+
+    ///@brief A batch whose third handler throws must still send the replies of the first two, then report the error.
+    void test_failing_handler()
+    {
+        const std::vector<byte_t> first  = testing::framed(option::id_num::gmcp, testing::to_bytes("first"));
+        const std::vector<byte_t> second = testing::framed(option::id_num::msdp, testing::to_bytes("second"));
+
+        std::vector<byte_t> input{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)};
+        testing::append(input, {iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::msdp)});
+        for (const std::vector<byte_t>& frame :
+             {first,
+              second,
+              testing::framed(option::id_num::gmcp, testing::to_bytes("fail")),
+              testing::framed(option::id_num::msdp, testing::to_bytes("after"))}) {
+            input.insert(input.end(), frame.begin(), frame.end());
+        }
+        testing::append(input, "done\r\n");
+
+        asio::io_context context;
+        batch_stream stream(testing::memory_stream{context, input, input.size()});
+        std::vector<delivery> deliveries;
+        for (const option::id_num id : {option::id_num::gmcp, option::id_num::msdp}) {
+            stream.register_option_handlers(
+                id,
+                std::nullopt,
+                std::nullopt,
+                [log = &deliveries](const option& opt, std::span<const byte_t> data) {
+                    return record_and_fail(log, opt, data);
+                }
+            );
+        }
+        std::vector<std::error_code> errors;
+        const std::vector<byte_t> data = testing::read_to_end(stream, input.size(), &errors);
+
+        const std::vector<byte_t>& written = stream.next_layer().written();
+        testing::expect(deliveries.size() >= 3, "the batch runs up to the failing handler");
+        testing::expect(!std::ranges::search(written, first).empty(), "the first handler's reply is sent");
+        testing::expect(!std::ranges::search(written, second).empty(), "the second handler's reply is sent");
+        testing::expect(
+            std::ranges::contains(errors, telnet::make_error_code(telnet::error::protocol_violation)),
+            "the handler's error is reported"
+        );
+        testing::expect_equal(data, testing::to_bytes("done\n"), "the data after the batch is still delivered");
+    } //test_failing_handler()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_batch_matches_unbatched();
+    test_failing_handler();
+    return testing::exit_status();
+}
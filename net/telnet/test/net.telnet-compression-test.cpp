@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-compression-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that an MCCP2 session delivers exactly what the same session sends uncompressed.
+ * @remark A server stream negotiates MCCP2, writes IAC-bearing text inside a compressed stream and plain text after it ends; a client stream reads the captured wire at several read sizes, blocking and asynchronous.
+ * @remark Built only with `NET_TELNET_WITH_MCCP`, since the inflater and deflater cannot start without zlib.
+ *
+ * @see "net.telnet-compression.cppm" for `deflate_stream` and `inflate_stream`, "net.telnet-stream-impl.cpp" for `inflate_input`
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::string, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief Room text repetitive enough to compress, with an IAC data byte in every line.
+    std::vector<byte_t> compressible_text()
+    {
+        std::vector<byte_t> text;
+        for (int line = 0; line < 200; ++line) {
+            testing::append(text, std::format("[{:03}] A rat scurries past your feet ", line));
+            text.push_back(iac);
+            testing::append(text, " and vanishes into a crack in the wall.\r\n");
+        }
+        return text;
+    } //compressible_text()
+
+    ///@brief Writes `data` with the blocking `write_some`, expecting all of it to be taken.
+    void send(stream_type& server, std::span<const byte_t> data, std::string_view what)
+    {
+        std::error_code ec;
+        const std::size_t bytes = server.write_some(asio::buffer(data.data(), data.size()), ec);
+        testing::expect(
+            !ec && (bytes == data.size()),
+            std::format("server writes {}: {} of {} bytes, {}", what, bytes, data.size(), ec.message())
+        );
+    } //send(stream_type&, std::span<const byte_t>, std::string_view)
+
+    ///@brief Runs the server side of the session after the peer's DO MCCP2 and returns everything it put on the wire.
+    std::vector<byte_t> serve(bool compress)
+    {
+        asio::io_context context;
+        stream_type server(testing::memory_stream{
+            context, {iac, testing::byte_of(command::do_opt), testing::byte_of(option::id_num::mccp2)}
+        });
+        testing::expect(testing::read_to_end(server, 64).empty(), "the server reads only negotiation");
+
+        std::error_code ec;
+        if (compress) {
+            static_cast<void>(server.start_compression(ec));
+            testing::expect(!ec, std::format("compression starts, not: {}", ec.message()));
+        }
+        send(server, compressible_text(), "room text");
+        if (compress) {
+            static_cast<void>(server.stop_compression(ec));
+            testing::expect(!ec, std::format("compression stops, not: {}", ec.message()));
+        }
+        send(server, testing::to_bytes("plain again\r\n"), "the tail");
+        return server.next_layer().written();
+    } //serve(bool)
+
+    ///@brief What the client made of a wire capture.
+    struct outcome {
+        std::vector<byte_t> data;
+        std::vector<byte_t> written;
+    }; //struct outcome
+
+    ///@brief Reads `wire` through a fresh client stream in `chunk_size` reads, blocking or asynchronous.
+    outcome receive(std::span<const byte_t> wire, std::size_t chunk_size, bool async)
+    {
+        asio::io_context context;
+        stream_type client(testing::memory_stream{context, {wire.begin(), wire.end()}, chunk_size});
+        outcome result;
+        result.data    = async ? testing::async_read_to_end(client, context, chunk_size)
+                               : testing::read_to_end(client, chunk_size);
+        result.written = client.next_layer().written();
+        return result;
+    } //receive(std::span<const byte_t>, std::size_t, bool)
+
+    ///@brief The compressed and plain captures must deliver the same bytes at every read size, and the compressed one must be smaller.
+    void test_round_trip()
+    {
+        const std::vector<byte_t> plain_wire      = serve(false);
+        const std::vector<byte_t> compressed_wire = serve(true);
+        testing::expect(
+            compressed_wire.size() < plain_wire.size(),
+            std::format("MCCP2 shrinks the session: {} bytes vs {}", compressed_wire.size(), plain_wire.size())
+        );
+
+        const outcome reference = receive(plain_wire, plain_wire.size(), false);
+        const std::vector<byte_t> do_mccp2{iac, testing::byte_of(command::do_opt), testing::byte_of(option::id_num::mccp2)};
+        testing::expect_equal(reference.written, do_mccp2, "the client accepts MCCP2");
+        for (const std::size_t chunk_size : {compressed_wire.size(), 4096UZ, 64UZ, 7UZ, 1UZ}) {
+            for (const bool async : {false, true}) {
+                const std::string label = std::format("{}-byte {} reads", chunk_size, async ? "async" : "blocking");
+                const outcome actual    = receive(compressed_wire, chunk_size, async);
+                testing::expect_equal(actual.data, reference.data, label + ": same data as uncompressed");
+                testing::expect_equal(actual.written, reference.written, label + ": same replies as uncompressed");
+            }
+        }
+    } //test_round_trip()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    telnet::default_protocol_fsm_config::registered_options.upsert(
+        option{option::id_num::mccp2, "MCCP2", option::always_accept, option::always_accept, /*subneg_supported=*/true}
+    );
+    test_round_trip();
+    return testing::exit_status();
+}
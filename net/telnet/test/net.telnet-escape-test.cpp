@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-escape-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks the vectorized `byte_scan` paths against byte-at-a-time references.
+ * @remark Output: `write_some`, `write_gather`, and `write_broadcast` must emit exactly `reference_escape` of the data, in text and BINARY mode, for every length and alignment around the SIMD block sizes and for buffer sequences split anywhere.
+ * @remark Input: the `process_span` fast path, and the data `stream::read_some` delivers, must match `process_byte` alone over the same random Telnet traffic at several read sizes.
+ *
+ * @see "net.telnet-byte_scan.cppm" for the kernels, "net.telnet-stream-impl.cpp" for `escape_into`, "net.telnet-test_support.cppm" for the fixtures
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::array, std::mt19937, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using fsm_type    = telnet::protocol_fsm<testing::test_config>;
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+
+    ///@brief Longer than two AVX2 blocks plus a tail, so every kernel width sees full blocks, a partial block, and the scalar tail.
+    constexpr std::size_t max_short_length = 80;
+
+    ///@brief Gets `length` random bytes where roughly one in `density` is IAC, CR, or LF.
+    std::vector<byte_t> random_payload(std::mt19937& rng, std::size_t length, unsigned density)
+    {
+        std::uniform_int_distribution<unsigned> pick(0, density - 1);
+        std::uniform_int_distribution<unsigned> any_byte(0, 255);
+        constexpr std::array<byte_t, 3> specials{testing::byte_of(command::iac), byte_t{'\r'}, byte_t{'\n'}};
+
+        std::vector<byte_t> payload(length);
+        for (byte_t& byte : payload) {
+            const unsigned choice = pick(rng);
+            byte = (choice < specials.size()) ? specials.at(choice) : static_cast<byte_t>(any_byte(rng));
+        }
+        return payload;
+    } //random_payload(std::mt19937&, std::size_t, unsigned)
+
+    ///@brief Gets `length` plain bytes with one `special` byte at `position`.
+    std::vector<byte_t> single_special(std::size_t length, std::size_t position, byte_t special)
+    {
+        std::vector<byte_t> payload(length, byte_t{'x'});
+        payload.at(position) = special;
+        return payload;
+    } //single_special(std::size_t, std::size_t, byte_t)
+
+    /**
+     * @brief Owns a stream over a `memory_stream`, optionally negotiated into local BINARY mode.
+     * @remark The negotiation is read synchronously; its WILL BINARY reply is checked and then forgotten.
+     */
+    class escape_fixture {
+    public:
+        explicit escape_fixture(bool binary) : stream_(testing::memory_stream{context_})
+        {
+            if (!binary) {
+                return;
+            }
+            const std::vector<byte_t> do_binary{
+                testing::byte_of(command::iac), testing::byte_of(command::do_opt), testing::byte_of(option::id_num::binary)
+            };
+            stream_.next_layer().feed(do_binary);
+            std::array<byte_t, 16> buffer{};
+            std::error_code ec;
+            static_cast<void>(stream_.read_some(asio::buffer(buffer), ec));
+            const std::vector<byte_t> will_binary{
+                testing::byte_of(command::iac), testing::byte_of(command::will_opt), testing::byte_of(option::id_num::binary)
+            };
+            testing::expect_equal(
+                stream_.next_layer().written(),
+                will_binary,
+                "IAC DO BINARY is answered with IAC WILL BINARY"
+            );
+            stream_.next_layer().clear_written();
+        }
+
+        stream_type& stream() noexcept { return stream_; }
+
+        ///@brief Takes what the stream has written since the last call.
+        std::vector<byte_t> take_written()
+        {
+            std::vector<byte_t> written = stream_.next_layer().written();
+            stream_.next_layer().clear_written();
+            return written;
+        } //escape_fixture::take_written()
+
+    private:
+        asio::io_context context_;
+        stream_type stream_;
+    }; //class escape_fixture
+
+    ///@brief Writes `payload`, as one buffer and as two buffers split at `split`, through every escaping path of `fixture`.
+    void check_escape(
+        escape_fixture& fixture,
+        std::span<const byte_t> payload,
+        std::size_t split,
+        bool binary,
+        std::string_view label
+    )
+    {
+        const std::vector<byte_t> expected = testing::reference_escape(payload, binary);
+        const asio::const_buffer whole(payload.data(), payload.size());
+        const std::array<asio::const_buffer, 2> halves{
+            asio::const_buffer(payload.data(), split), asio::const_buffer(payload.data() + split, payload.size() - split)
+        };
+        std::error_code ec;
+
+        static_cast<void>(fixture.stream().write_some(whole, ec));
+        testing::expect(!ec, std::format("{}: write_some succeeds", label));
+        testing::expect_equal(fixture.take_written(), expected, std::format("{}: write_some", label));
+
+        static_cast<void>(fixture.stream().write_some(halves, ec));
+        testing::expect(!ec, std::format("{}: split write_some succeeds", label));
+        testing::expect_equal(fixture.take_written(), expected, std::format("{}: write_some split at {}", label, split));
+
+        static_cast<void>(fixture.stream().write_gather(whole, ec));
+        testing::expect(!ec, std::format("{}: write_gather succeeds", label));
+        testing::expect_equal(fixture.take_written(), expected, std::format("{}: write_gather", label));
+
+        static_cast<void>(fixture.stream().write_gather(halves, ec));
+        testing::expect(!ec, std::format("{}: split write_gather succeeds", label));
+        testing::expect_equal(fixture.take_written(), expected, std::format("{}: write_gather split at {}", label, split));
+
+        static_cast<void>(fixture.stream().write_broadcast(telnet::broadcast_message(whole), ec));
+        testing::expect(!ec, std::format("{}: write_broadcast succeeds", label));
+        testing::expect_equal(fixture.take_written(), expected, std::format("{}: write_broadcast", label));
+    } //check_escape(escape_fixture&, std::span<const byte_t>, std::size_t, bool, std::string_view)
+
+    /**
+     * @brief Escapes one special byte at every position of every short length, at every alignment within a 64-byte window, then dense and sparse random payloads.
+     * @remark Covers a special byte in the first, middle, and last lane of each block and in the scalar tail.
+     */
+    void test_escaping(bool binary)
+    {
+        escape_fixture fixture(binary);
+        const std::string_view mode = binary ? "binary" : "text";
+        constexpr std::array<byte_t, 3> specials{testing::byte_of(command::iac), byte_t{'\r'}, byte_t{'\n'}};
+        std::vector<byte_t> storage(64 + max_short_length);
+
+        for (std::size_t length = 1; length <= max_short_length; ++length) {
+            for (std::size_t position = 0; position < length; ++position) {
+                for (const byte_t special : specials) {
+                    const std::vector<byte_t> payload = single_special(length, position, special);
+                    const std::size_t offset          = (length + position) % 64;
+                    std::ranges::copy(payload, storage.begin() + static_cast<std::ptrdiff_t>(offset));
+                    check_escape(
+                        fixture,
+                        std::span<const byte_t>(storage).subspan(offset, length),
+                        position,
+                        binary,
+                        std::format("{} length {} byte {:#04x} at {} offset {}", mode, length, special, position, offset)
+                    );
+                }
+            }
+        }
+
+        std::mt19937 rng(0x7E1E7); //NOLINT(cert-msc32-c, cert-msc51-cpp): A fixed seed keeps failures reproducible.
+        for (const std::size_t length : {0UZ, 15UZ, 16UZ, 17UZ, 31UZ, 32UZ, 33UZ, 63UZ, 64UZ, 65UZ, 1000UZ, 4097UZ}) {
+            for (const unsigned density : {2U, 16U, 1024U}) {
+                const std::vector<byte_t> payload = random_payload(rng, length, density);
+                check_escape(
+                    fixture,
+                    payload,
+                    length / 3,
+                    binary,
+                    std::format("{} random length {} density 1/{}", mode, length, density)
+                );
+            }
+        }
+    } //test_escaping(bool)
+
+    ///@brief Generates random Telnet traffic: text with CR NUL, CR LF, IAC IAC, IAC NOP, GMCP/MSDP negotiation and subnegotiations (some with IAC IAC), and signalling commands and a non-command byte after IAC.
+    std::vector<byte_t> random_traffic(std::mt19937& rng, std::size_t tokens)
+    {
+        constexpr byte_t iac  = testing::byte_of(command::iac);
+        constexpr byte_t sb   = testing::byte_of(command::sb);
+        constexpr byte_t se   = testing::byte_of(command::se);
+        constexpr byte_t gmcp = testing::byte_of(option::id_num::gmcp);
+        constexpr byte_t msdp = testing::byte_of(option::id_num::msdp);
+        //Commands that only signal, plus a byte that is not a command; DM is left out since `at_mark` would query the unconnected socket.
+        constexpr std::array<byte_t, 6> strays{
+            testing::byte_of(command::ga),
+            testing::byte_of(command::eor),
+            testing::byte_of(command::ec),
+            testing::byte_of(command::el),
+            testing::byte_of(command::brk),
+            byte_t{0x41}
+        };
+
+        std::uniform_int_distribution<unsigned> pick(0, 11);
+        std::uniform_int_distribution<unsigned> run_length(1, 300);
+        std::uniform_int_distribution<unsigned> printable(0x20, 0x7E);
+        std::uniform_int_distribution<std::size_t> stray(0, strays.size() - 1);
+
+        std::vector<byte_t> traffic;
+        for (std::size_t token = 0; token < tokens; ++token) {
+            switch (pick(rng)) {
+                case 0:
+                    testing::append(traffic, {byte_t{'\r'}, byte_t{'\0'}});
+                    break;
+                case 1:
+                    testing::append(traffic, {byte_t{'\r'}, byte_t{'\n'}});
+                    break;
+                case 2:
+                    testing::append(traffic, {iac, iac});
+                    break;
+                case 3:
+                    testing::append(traffic, {iac, testing::byte_of(command::nop)});
+                    break;
+                case 4:
+                    testing::append(traffic, {iac, testing::byte_of(command::will_opt), gmcp});
+                    break;
+                case 5:
+                    testing::append(traffic, {iac, testing::byte_of(command::do_opt), msdp});
+                    break;
+                case 6:
+                    testing::append(traffic, {iac, sb, gmcp});
+                    testing::append(traffic, "Core.Hello {}");
+                    testing::append(traffic, {iac, se});
+                    break;
+                case 7:
+                    testing::append(traffic, {iac, sb, msdp, 1});
+                    testing::append(traffic, "VAR");
+                    testing::append(traffic, {2, iac, iac, 'v', iac, se});
+                    break;
+                case 8:
+                    testing::append(traffic, {iac, strays.at(stray(rng))});
+                    break;
+                default: {
+                    const unsigned count = run_length(rng);
+                    for (unsigned index = 0; index < count; ++index) {
+                        traffic.push_back(static_cast<byte_t>(printable(rng)));
+                    }
+                    break;
+                }
+            }
+        }
+        return traffic;
+    } //random_traffic(std::mt19937&, std::size_t)
+
+    ///@brief Traces `input` through a fresh, handler-registered FSM in `chunk_size` pieces via `feed`.
+    template<typename Feed>
+    testing::fsm_trace trace(std::span<const byte_t> input, std::size_t chunk_size, Feed feed)
+    {
+        fsm_type fsm;
+        testing::register_ignoring_handlers(fsm);
+        testing::fsm_trace result;
+        testing::feed_in_chunks(fsm, input, chunk_size, result, feed);
+        return result;
+    } //trace(std::span<const byte_t>, std::size_t, Feed)
+
+    ///@brief Gets the data `stream::read_some` delivers from `input` served in `chunk_size` reads.
+    std::vector<byte_t> read_through_stream(std::span<const byte_t> input, std::size_t chunk_size)
+    {
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        testing::register_ignoring_handlers(stream);
+        return testing::read_to_end(stream, chunk_size);
+    } //read_through_stream(std::span<const byte_t>, std::size_t)
+
+    ///@brief Feeds the same random traffic through `process_byte`, the fast path, and `stream::read_some` at several read sizes.
+    void test_scanning()
+    {
+        std::mt19937 rng(0x5CA9); //NOLINT(cert-msc32-c, cert-msc51-cpp): A fixed seed keeps failures reproducible.
+        for (int round = 0; round < 8; ++round) {
+            const std::vector<byte_t> input = random_traffic(rng, 400);
+            for (const std::size_t chunk_size : {1UZ, 2UZ, 7UZ, 31UZ, 64UZ, 4096UZ}) {
+                const std::string label = std::format("traffic round {} in {}-byte reads", round, chunk_size);
+                const testing::fsm_trace reference =
+                    trace(input, chunk_size, [](fsm_type& fsm, std::span<const byte_t> chunk, testing::fsm_trace& out) {
+                        testing::feed_byte_wise(fsm, chunk, out);
+                    });
+                const testing::fsm_trace fast =
+                    trace(input, chunk_size, [](fsm_type& fsm, std::span<const byte_t> chunk, testing::fsm_trace& out) {
+                        testing::feed_fast_path(fsm, chunk, out);
+                    });
+                testing::expect_equal(
+                    fast.forwarded,
+                    reference.forwarded,
+                    label + ": fast path forwards what process_byte does"
+                );
+                testing::expect_equal(fast.events, reference.events, label + ": fast path reports what process_byte does");
+                testing::expect_equal(
+                    read_through_stream(input, chunk_size),
+                    reference.forwarded,
+                    label + ": stream::read_some delivers what process_byte forwards"
+                );
+            }
+        }
+    } //test_scanning()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_escaping(/*binary=*/false);
+    test_escaping(/*binary=*/true);
+    test_scanning();
+    return testing::exit_status();
+}
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-frame-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks `read_line` and `read_record`, synchronous and asynchronous, against the frames each session is known to hold.
+ * @remark Every read size must yield the same frames, the same partial frame, and a byte count equal to the data bytes `read_some` would deliver.
+ * @remark EC and EL must edit the frame being received even when a read boundary separates them from the bytes they erase.
+ *
+ * @see "net.telnet-stream-impl.cpp" for `frame_reader`, "net.telnet-test_support.cppm" for the fixtures
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::string, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief Which framed read to run.
+    enum class framing : std::uint8_t {
+        lines,
+        records
+    }; //enum class framing
+
+    ///@brief Everything a sequence of framed reads produced up to end of file.
+    struct framed_result {
+        std::vector<std::vector<byte_t>> frames;
+        std::vector<byte_t> partial;
+        std::size_t bytes = 0;
+    }; //struct framed_result
+
+    ///@brief Copies the frames of one completion into `result`, returning `false` once reading should stop.
+    bool collect(framed_result& result, const telnet::frame_batch& batch, const std::error_code& ec, std::size_t bytes)
+    {
+        result.bytes += bytes;
+        for (std::size_t index = 0; index < batch.size(); ++index) {
+            result.frames.emplace_back(batch[index].begin(), batch[index].end());
+        }
+        if (ec == asio::error::eof) {
+            result.partial.assign(batch.partial().begin(), batch.partial().end());
+            return false;
+        }
+        if (ec && (&ec.category() != &telnet::telnet_processing_signal_category::instance())) {
+            testing::expect(false, std::format("framed read stops only at end of input, not: {}", ec.message()));
+            return false;
+        }
+        return true;
+    } //collect(framed_result&, const frame_batch&, const std::error_code&, std::size_t)
+
+    ///@brief Reads `input` to end of file with the blocking framed read.
+    framed_result read_frames(std::span<const byte_t> input, std::size_t chunk_size, framing kind)
+    {
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        testing::register_ignoring_handlers(stream);
+        telnet::frame_batch batch;
+        framed_result result;
+
+        std::error_code ec;
+        std::size_t bytes = 0;
+        do {
+            bytes = (kind == framing::lines) ? stream.read_line(batch, ec) : stream.read_record(batch, ec);
+        } while (collect(result, batch, ec, bytes));
+        return result;
+    } //read_frames(std::span<const byte_t>, std::size_t, framing)
+
+    ///@brief Reissues the asynchronous framed read from each completion until `collect` says to stop.
+    struct async_collector {
+        stream_type* stream;
+        telnet::frame_batch* batch;
+        framed_result* result;
+        framing kind;
+
+        void start() const
+        {
+            if (kind == framing::lines) {
+                stream->async_read_line(*batch, *this);
+            } else {
+                stream->async_read_record(*batch, *this);
+            }
+        } //async_collector::start()
+
+        void operator()(std::error_code ec, std::size_t bytes) const
+        {
+            if (collect(*result, *batch, ec, bytes)) {
+                start();
+            }
+        } //async_collector::operator()(std::error_code, std::size_t)
+    }; //struct async_collector
+
+    ///@brief Reads `input` to end of file with the asynchronous framed read.
+    framed_result async_read_frames(std::span<const byte_t> input, std::size_t chunk_size, framing kind)
+    {
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        testing::register_ignoring_handlers(stream);
+        telnet::frame_batch batch;
+        framed_result result;
+
+        async_collector{&stream, &batch, &result, kind}.start();
+        context.run();
+        return result;
+    } //async_read_frames(std::span<const byte_t>, std::size_t, framing)
+
+    ///@brief Checks both framed reads of `input` at several read sizes against `frames`, `partial`, and `bytes`.
+    void check_session(
+        std::string_view name,
+        std::span<const byte_t> input,
+        framing kind,
+        const std::vector<std::vector<byte_t>>& frames,
+        std::span<const byte_t> partial,
+        std::optional<std::size_t> bytes
+    )
+    {
+        for (const std::size_t chunk_size : {1UZ, 2UZ, 7UZ, 64UZ, 4096UZ, input.size()}) {
+            for (const bool async : {false, true}) {
+                const std::string label = std::format("{} in {}-byte {} reads", name, chunk_size, async ? "async" : "blocking");
+                const framed_result result =
+                    async ? async_read_frames(input, chunk_size, kind) : read_frames(input, chunk_size, kind);
+                testing::expect(result.frames == frames, label + ": frames");
+                testing::expect_equal(result.partial, partial, label + ": partial frame");
+                if (bytes) {
+                    testing::expect(
+                        result.bytes == *bytes,
+                        std::format("{}: byte count {} (expected {})", label, result.bytes, *bytes)
+                    );
+                }
+            }
+        }
+    } //check_session(std::string_view, std::span<const byte_t>, framing, const std::vector<std::vector<byte_t>>&, std::span<const byte_t>, std::optional<std::size_t>)
+
+    ///@brief Lines with negotiation, NOP, and IAC IAC between and inside them, one longer than a read chunk, and a partial line left at end of file.
+    void test_lines()
+    {
+        const std::vector<std::vector<byte_t>> lines{
+            testing::to_bytes("look"),
+            {},
+            std::vector<byte_t>{'s', 'a', 'y', ' ', iac, ' ', 'h', 'i'},
+            testing::to_bytes("north"),
+            std::vector<byte_t>(5000, 'w'),
+            testing::to_bytes("x")
+        };
+        const std::vector<byte_t> partial = testing::to_bytes("unfinished");
+
+        std::vector<byte_t> input{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)};
+        std::size_t data_bytes = 0;
+        for (const std::vector<byte_t>& line : lines) {
+            for (const byte_t byte : line) {
+                input.push_back(byte);
+                if (byte == iac) {
+                    input.push_back(iac);
+                }
+                if (byte == 'r') {
+                    testing::append(input, {iac, testing::byte_of(command::nop)});
+                }
+            }
+            testing::append(input, "\r\n");
+            testing::append(input, {iac, testing::byte_of(command::do_opt), testing::byte_of(option::id_num::msdp)});
+            data_bytes += line.size() + 1; //The LF is delivered; the CR is not.
+        }
+        input.insert(input.end(), partial.begin(), partial.end());
+        data_bytes += partial.size();
+
+        check_session("lines", input, framing::lines, lines, partial, data_bytes);
+    } //test_lines()
+
+    ///@brief EC and EL inside lines, which 1- and 2-byte reads separate from the bytes they erase.
+    void test_line_editing()
+    {
+        std::vector<byte_t> input = testing::to_bytes("say hx");
+        testing::append(input, {iac, testing::byte_of(command::ec)});
+        testing::append(input, "i\r\njunk");
+        testing::append(input, {iac, testing::byte_of(command::el)});
+        testing::append(input, "north\r\n");
+
+        check_session(
+            "edited lines",
+            input,
+            framing::lines,
+            {testing::to_bytes("say hi"), testing::to_bytes("north")},
+            {},
+            std::nullopt
+        );
+    } //test_line_editing()
+
+    ///@brief Records after WILL END_OF_RECORD, including an empty record and one holding IAC IAC, and a partial record at end of file.
+    void test_records()
+    {
+        const std::vector<std::vector<byte_t>> records{
+            testing::to_bytes("first record"), {}, std::vector<byte_t>{'t', 'h', 'i', 'r', 'd', ' ', iac}
+        };
+        const std::vector<byte_t> partial = testing::to_bytes("cut short");
+
+        std::vector<byte_t> input{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::end_of_record)};
+        std::size_t data_bytes = 0;
+        for (const std::vector<byte_t>& record : records) {
+            for (const byte_t byte : record) {
+                input.push_back(byte);
+                if (byte == iac) {
+                    input.push_back(iac);
+                }
+            }
+            testing::append(input, {iac, testing::byte_of(command::eor)});
+            data_bytes += record.size();
+        }
+        input.insert(input.end(), partial.begin(), partial.end());
+        data_bytes += partial.size();
+
+        check_session("records", input, framing::records, records, partial, data_bytes);
+    } //test_records()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_lines();
+    test_line_editing();
+    test_records();
+    return testing::exit_status();
+}
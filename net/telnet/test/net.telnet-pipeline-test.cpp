@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-pipeline-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that pipelined negotiation replies and the output queue keep the peer's view of the session in order.
+ * @remark An opening volley read in one piece must be answered in one write, and in the order it was asked, by blocking and asynchronous reads alike; handler replies must fall between the negotiation replies around them.
+ * @remark Writes queued back to back, including a Synch, must reach a loopback peer in the order they were issued, and exactly as the same blocking writes do.
+ *
+ * @see "net.telnet-stream-impl.cpp" for `queue_negotiation_reply` and `output_processor`, "net.telnet-test_support.cppm" for the fixtures
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::string, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+    using tcp_stream  = telnet::stream<asio::ip::tcp::socket, testing::test_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief The first of the options IANA leaves unassigned, which every stream must refuse.
+    constexpr byte_t first_unassigned = 0xCA;
+
+    ///@brief What one read of a session produced.
+    struct outcome {
+        std::vector<byte_t> data;
+        std::vector<byte_t> written;
+        std::size_t write_calls = 0;
+    }; //struct outcome
+
+    ///@brief Reads `input` through a fresh `stream` in `chunk_size` reads, blocking or asynchronous, with `testing::record_and_echo` as every handler.
+    outcome read_session(std::span<const byte_t> input, std::size_t chunk_size, bool async)
+    {
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        std::vector<testing::delivery> deliveries;
+        testing::register_echo_handlers(stream, deliveries);
+
+        outcome result;
+        result.data        = async ? testing::async_read_to_end(stream, context, chunk_size)
+                                   : testing::read_to_end(stream, chunk_size);
+        result.written     = stream.next_layer().written();
+        result.write_calls = stream.next_layer().write_calls();
+        return result;
+    } //read_session(std::span<const byte_t>, std::size_t, bool)
+
+    ///@brief Twenty requests for unassigned options, alternating DO and WILL, must be refused in order, and in a single write when they arrive in a single read.
+    void test_opening_volley()
+    {
+        std::vector<byte_t> input;
+        std::vector<byte_t> refusals;
+        for (byte_t offset = 0; offset < 20; ++offset) {
+            const bool local = (offset % 2) == 0;
+            const auto id    = static_cast<byte_t>(first_unassigned + offset);
+            testing::append(input, {iac, testing::byte_of(local ? command::do_opt : command::will_opt), id});
+            testing::append(refusals, {iac, testing::byte_of(local ? command::wont_opt : command::dont_opt), id});
+        }
+        testing::append(input, "ready\r\n");
+
+        for (const std::size_t chunk_size : {input.size(), 7UZ, 1UZ}) {
+            for (const bool async : {false, true}) {
+                const std::string label = std::format("volley in {}-byte {} reads", chunk_size, async ? "async" : "blocking");
+                const outcome result    = read_session(input, chunk_size, async);
+                testing::expect_equal(result.written, refusals, label + ": refusals in request order");
+                testing::expect_equal(result.data, testing::to_bytes("ready\n"), label + ": data after the volley");
+                if (chunk_size == input.size()) {
+                    testing::expect(
+                        result.write_calls == 1,
+                        std::format("{}: one write for the volley, not {}", label, result.write_calls)
+                    );
+                }
+            }
+        }
+    } //test_opening_volley()
+
+    ///@brief Negotiation replies queued before a subnegotiation must be written before its handler's reply, and those after it after.
+    void test_replies_around_handlers()
+    {
+        const std::vector<byte_t> ping = testing::framed(option::id_num::gmcp, testing::to_bytes("Core.Ping"));
+        const std::vector<byte_t> vars = testing::framed(option::id_num::msdp, testing::to_bytes("\x01VAR\x02VAL"));
+
+        std::vector<byte_t> input{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)};
+        testing::append(input, {iac, testing::byte_of(command::do_opt), first_unassigned});
+        input.insert(input.end(), ping.begin(), ping.end());
+        testing::append(input, {iac, testing::byte_of(command::do_opt), static_cast<byte_t>(first_unassigned + 1)});
+        testing::append(input, {iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::msdp)});
+        input.insert(input.end(), vars.begin(), vars.end());
+        testing::append(input, "done\r\n");
+
+        std::vector<byte_t> expected{iac, testing::byte_of(command::do_opt), testing::byte_of(option::id_num::gmcp)};
+        testing::append(expected, {iac, testing::byte_of(command::wont_opt), first_unassigned});
+        expected.insert(expected.end(), ping.begin(), ping.end());
+        testing::append(expected, {iac, testing::byte_of(command::wont_opt), static_cast<byte_t>(first_unassigned + 1)});
+        testing::append(expected, {iac, testing::byte_of(command::do_opt), testing::byte_of(option::id_num::msdp)});
+        expected.insert(expected.end(), vars.begin(), vars.end());
+
+        for (const std::size_t chunk_size : {input.size(), 7UZ, 1UZ}) {
+            for (const bool async : {false, true}) {
+                const std::string label = std::format("{}-byte {} reads", chunk_size, async ? "async" : "blocking");
+                const outcome result    = read_session(input, chunk_size, async);
+                testing::expect_equal(result.written, expected, label + ": replies in the order they were asked for");
+                testing::expect_equal(result.data, testing::to_bytes("done\n"), label + ": data");
+            }
+        }
+    } //test_replies_around_handlers()
+
+    ///@brief A connected loopback pair: a `tcp_stream` and the raw peer socket, with urgent data left inline so it arrives in order.
+    struct loopback {
+        asio::io_context context;
+        asio::ip::tcp::socket peer{context};
+        std::optional<tcp_stream> stream;
+
+        loopback()
+        {
+            asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+            peer.connect(acceptor.local_endpoint());
+            peer.set_option(asio::socket_base::out_of_band_inline(true));
+            stream.emplace(acceptor.accept());
+        } //loopback::loopback()
+
+        ///@brief Shuts down the stream's sending side and returns everything the peer received.
+        std::vector<byte_t> received()
+        {
+            stream->lowest_layer().shutdown(asio::socket_base::shutdown_send);
+            std::vector<byte_t> bytes;
+            std::error_code ec;
+            asio::read(peer, asio::dynamic_buffer(bytes), ec);
+            testing::expect(ec == asio::error::eof, std::format("peer reads to end of stream, not: {}", ec.message()));
+            return bytes;
+        } //loopback::received()
+    }; //struct loopback
+
+    ///@brief Data, a negotiation, a Synch, a command, and more data, issued without waiting, must reach the peer in that order and as the blocking calls send them.
+    void test_queue_order()
+    {
+        const std::string before = "before\xFF";
+        const std::string after  = "after";
+        const tcp_stream::fsm_type::negotiation_response will_gmcp{
+            telnet::negotiation_direction::local, true, option::id_num::gmcp
+        };
+
+        std::vector<byte_t> expected = testing::to_bytes("before");
+        testing::append(expected, {iac, iac});
+        testing::append(expected, {iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)});
+        testing::append(expected, {0, 0, 0, iac, testing::byte_of(command::dm)});
+        testing::append(expected, {iac, testing::byte_of(command::ga)});
+        testing::append(expected, after);
+
+        {
+            loopback pair;
+            std::vector<std::size_t> completions;
+            std::vector<std::error_code> errors;
+            const auto note = [&completions, &errors](std::size_t step) {
+                return [&completions, &errors, step](const std::error_code& ec, std::size_t /*bytes*/) {
+                    completions.push_back(step);
+                    if (ec) {
+                        errors.push_back(ec);
+                    }
+                };
+            };
+            pair.stream->async_write_some(asio::buffer(before), note(0));
+            pair.stream->async_write_negotiation(will_gmcp, note(1));
+            pair.stream->async_send_synch(note(2));
+            pair.stream->async_write_command(command::ga, note(3));
+            pair.stream->async_write_some(asio::buffer(after), note(4));
+            pair.context.run();
+
+            testing::expect(errors.empty(), "queued writes succeed");
+            testing::expect_equal(completions, std::vector<std::size_t>{0, 1, 2, 3, 4}, "queued writes complete in order");
+            testing::expect_equal(pair.received(), expected, "queued writes reach the peer in order");
+        }
+        {
+            loopback pair;
+            std::error_code ec;
+            static_cast<void>(pair.stream->write_some(asio::buffer(before), ec));
+            testing::expect(!ec, "blocking data write succeeds");
+            static_cast<void>(pair.stream->write_negotiation(will_gmcp, ec));
+            testing::expect(!ec, "blocking negotiation succeeds");
+            static_cast<void>(pair.stream->send_synch(ec));
+            testing::expect(!ec, "blocking Synch succeeds");
+            static_cast<void>(pair.stream->write_command(command::ga, ec));
+            testing::expect(!ec, "blocking command succeeds");
+            static_cast<void>(pair.stream->write_some(asio::buffer(after), ec));
+            testing::expect(!ec, "blocking data write succeeds");
+            testing::expect_equal(pair.received(), expected, "blocking writes send what the queue does");
+        }
+    } //test_queue_order()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_opening_volley();
+    test_replies_around_handlers();
+    test_queue_order();
+    return testing::exit_status();
+}
@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-server-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that a sharded `server` hands each loopback connection to exactly one shard, runs its session there, and serves it.
+ * @remark Each session handler finds its shard by asking every shard's executor whether it is running on the calling thread, then greets the client with that shard's index.
+ * @remark `round_robin` and `least_loaded` must pick the shards they promise: in turn, and by fewest live sessions once one shard's session ends. `reuse_port` leaves the choice to the kernel, so only the handoff is checked.
+ * @remark Sessions are kept alive by the handlers until `end_sessions`, so the live-session counts `least_loaded` compares are under the test's control.
+ *
+ * @see "net.telnet-server.cppm" for `server`, `accept_next`, `next_shard`, and `launch`
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::string, std::mutex, std::shared_ptr, std::format, std::chrono, std::this_thread
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::accept_distribution;
+
+    using server_type = telnet::server<testing::test_config>;
+
+    constexpr std::size_t shard_count = 3;
+
+    ///@brief What one session handler saw on its thread.
+    struct handoff {
+        std::size_t shard;  ///< The first shard whose executor runs the handler's thread
+        std::size_t owners; ///< How many shards' executors run it; exactly 1 if the session is pinned
+    }; //struct handoff
+
+    ///@brief A running server whose handlers record each handoff, keep the session alive, and greet the client with the shard index.
+    class sharded_server {
+    public:
+        explicit sharded_server(accept_distribution distribution)
+            : server_(
+                  {asio::ip::address_v4::loopback(), 0},
+                  [this](std::shared_ptr<server_type::stream_type> session) { on_session(std::move(session)); },
+                  telnet::server_options{.shard_count = shard_count, .distribution = distribution}
+              )
+        {
+            server_.start();
+        } //sharded_server::sharded_server(accept_distribution)
+
+        sharded_server(const sharded_server&)            = delete;
+        sharded_server& operator=(const sharded_server&) = delete;
+
+        ///@brief Stops the shards before the sessions they ran are destroyed.
+        ~sharded_server()
+        {
+            server_.stop();
+            server_.join();
+            sessions_.clear();
+        } //sharded_server::~sharded_server()
+
+        [[nodiscard]] server_type& server() noexcept { return server_; }
+
+        ///@brief Connects a client, reads its greeting, and returns the shard index it names, or `shard_count` if none arrives.
+        std::size_t connect(asio::io_context& client_context, std::vector<asio::ip::tcp::socket>& clients)
+        {
+            auto& client = clients.emplace_back(client_context);
+            std::error_code ec;
+            client.connect(server_.local_endpoint(), ec);
+            testing::expect(!ec, std::format("client connects, not: {}", ec.message()));
+            std::string greeting;
+            asio::read_until(client, asio::dynamic_buffer(greeting), '\n', ec);
+            testing::expect(!ec, std::format("client is greeted, not: {}", ec.message()));
+            std::size_t shard = shard_count;
+            std::from_chars(greeting.data(), greeting.data() + greeting.size(), shard);
+            return shard;
+        } //sharded_server::connect(asio::io_context&, std::vector<asio::ip::tcp::socket>&)
+
+        ///@brief Gets every handoff recorded so far.
+        [[nodiscard]] std::vector<handoff> handoffs()
+        {
+            const std::scoped_lock lock(mutex_);
+            return handoffs_;
+        } //sharded_server::handoffs()
+
+        ///@brief Drops the sessions kept on `shard`, on that shard's thread, and waits until the shard counts none.
+        void end_sessions(std::size_t shard)
+        {
+            asio::post(server_.shard_context(shard), [this, shard] {
+                const std::scoped_lock lock(mutex_);
+                std::erase_if(sessions_, [shard](const auto& kept) { return kept.first == shard; });
+            });
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while ((server_.session_count(shard) != 0) && (std::chrono::steady_clock::now() < deadline)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            testing::expect(server_.session_count(shard) == 0, std::format("shard {} ends its session", shard));
+        } //sharded_server::end_sessions(std::size_t)
+
+    private:
+        ///@brief Runs on the shard thread `launch` posted to: records the handoff, keeps `session`, and greets the client.
+        void on_session(std::shared_ptr<server_type::stream_type> session)
+        {
+            handoff seen{shard_count, 0};
+            for (std::size_t i = 0; i < server_.shard_count(); ++i) {
+                if (server_.shard_context(i).get_executor().running_in_this_thread()) {
+                    seen.shard = (seen.owners == 0) ? i : seen.shard;
+                    ++seen.owners;
+                }
+            }
+            auto greeting = std::make_shared<std::string>(std::format("{}\r\n", seen.shard));
+            {
+                const std::scoped_lock lock(mutex_);
+                handoffs_.push_back(seen);
+                sessions_.emplace_back(seen.shard, session);
+            }
+            const auto greeted = [session, greeting](const std::error_code& ec, std::size_t /*bytes*/) {
+                testing::expect(!ec, std::format("session greets its client, not: {}", ec.message()));
+            };
+            session->async_write_some(asio::buffer(*greeting), greeted);
+        } //sharded_server::on_session(std::shared_ptr<server_type::stream_type>)
+
+        std::mutex mutex_;
+        std::vector<handoff> handoffs_;
+        std::vector<std::pair<std::size_t, std::shared_ptr<server_type::stream_type>>> sessions_;
+        server_type server_; //Declared last so its shards stop before the sessions above are destroyed
+    }; //class sharded_server
+
+    ///@brief Checks that every recorded handoff ran on exactly one shard, and that each shard counts the sessions it holds.
+    void expect_pinned(sharded_server& running, std::size_t expected_sessions, std::string_view label)
+    {
+        const std::vector<handoff> seen = running.handoffs();
+        testing::expect(seen.size() == expected_sessions, std::format("{}: every connection reaches a handler", label));
+        std::array<std::size_t, shard_count> per_shard{};
+        for (const handoff& each : seen) {
+            testing::expect(each.owners == 1, std::format("{}: a handler runs on exactly one shard", label));
+            if (each.shard < shard_count) {
+                ++per_shard[each.shard];
+            }
+        }
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            testing::expect(
+                running.server().session_count(i) <= per_shard[i],
+                std::format("{}: shard {} counts only the sessions it ran", label, i)
+            );
+        }
+    } //expect_pinned(sharded_server&, std::size_t, std::string_view)
+
+    /**
+     * @brief Opens one connection per shard, ends the session on shard 2, and opens two more.
+     * @remark Both policies fill the shards in order first. The shard for each connection is picked as the acceptor is re-armed after the one before, so the fourth goes to shard 0 under both; the fifth shows the policy: `round_robin` moves on to shard 1, `least_loaded` refills shard 2.
+     */
+    void test_shared_acceptor(accept_distribution distribution)
+    {
+        const bool least_loaded = (distribution == accept_distribution::least_loaded);
+        const std::string label = least_loaded ? "least_loaded" : "round_robin";
+        asio::io_context client_context;
+        std::vector<asio::ip::tcp::socket> clients;
+        sharded_server running(distribution);
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            const std::size_t shard = running.connect(client_context, clients);
+            testing::expect(shard == i, std::format("{}: connection {} goes to shard {}, not {}", label, i, i, shard));
+        }
+        running.end_sessions(2);
+        for (const std::size_t expected : {std::size_t{0}, least_loaded ? std::size_t{2} : std::size_t{1}}) {
+            const std::size_t shard = running.connect(client_context, clients);
+            testing::expect(shard == expected, std::format("{}: next goes to shard {}, not {}", label, expected, shard));
+        }
+        expect_pinned(running, shard_count + 2, label);
+        using counts = std::array<std::size_t, shard_count>;
+        const counts expected_counts = least_loaded ? counts{2, 1, 1} : counts{2, 2, 0};
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            testing::expect(
+                running.server().session_count(i) == expected_counts[i],
+                std::format("{}: shard {} counts {} live sessions", label, i, expected_counts[i])
+            );
+        }
+    } //test_shared_acceptor(accept_distribution)
+
+    ///@brief Under `reuse_port` each shard accepts for itself; however the kernel spreads the connections, each must be served by the shard that accepted it.
+    void test_reuse_port()
+    {
+        asio::io_context client_context;
+        std::vector<asio::ip::tcp::socket> clients;
+        sharded_server running(accept_distribution::reuse_port);
+        constexpr std::size_t connections = 4 * shard_count;
+        for (std::size_t i = 0; i < connections; ++i) {
+            testing::expect(running.connect(client_context, clients) < shard_count, "reuse_port: the greeting names a shard");
+        }
+        expect_pinned(running, connections, "reuse_port");
+    } //test_reuse_port()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_shared_acceptor(accept_distribution::round_robin);
+    test_shared_acceptor(accept_distribution::least_loaded);
+    test_reuse_port();
+    return testing::exit_status();
+}
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-snapshot-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that a restored session continues exactly as the one it was snapshotted from, and that malformed images change nothing.
+ * @remark The session is snapshotted after one read at every combination of read and buffer size, so images hold unscanned input, half-received subnegotiations, and partial commands.
+ * @remark Each rejected image must leave the FSM's own image, and the option registry, as they were, even when only the stream's input trailer is wrong.
+ *
+ * @see "net.telnet-protocol_fsm-impl.cpp" for `save_state` and `restore_state`, "net.telnet-stream-sync-impl.cpp" for `snapshot` and `restore`
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::string, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+    using testing::delivery;
+
+    using fsm_type    = telnet::protocol_fsm<testing::test_config>;
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief Offsets into a `save_state` image: the option records follow the version byte, then the parser fields and the payload length.
+    namespace offset {
+        constexpr std::size_t records        = 1;
+        constexpr std::size_t state          = records + 256;
+        constexpr std::size_t has_command    = state + 1;
+        constexpr std::size_t command_byte   = has_command + 1;
+        constexpr std::size_t has_option     = command_byte + 1;
+        constexpr std::size_t option_byte    = has_option + 1;
+        constexpr std::size_t payload_length = option_byte + 1;
+    } //namespace offset
+
+    ///@brief `protocol_state` values as `save_state` writes them.
+    namespace saved_state {
+        constexpr byte_t option_negotiation = 3;
+        constexpr byte_t subnegotiation     = 5;
+        constexpr byte_t out_of_range       = 7;
+    } //namespace saved_state
+
+    ///@brief Builds a session with negotiation, text, subnegotiations (one holding IAC IAC), and a command between them.
+    std::vector<byte_t> session()
+    {
+        std::vector<byte_t> bytes{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)};
+        testing::append(bytes, "first line of text\r\n");
+        for (const std::vector<byte_t>& frame :
+             {testing::framed(option::id_num::gmcp, testing::to_bytes(R"(Char.Vitals {"hp":10})")),
+              std::vector<byte_t>{iac, testing::byte_of(command::nop)},
+              testing::framed(option::id_num::gmcp, std::vector<byte_t>{'a', iac, 'b'})}) {
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+            testing::append(bytes, "more text\r\n");
+        }
+        testing::append(bytes, {iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::msdp)});
+        testing::append(bytes, "the end\r\n");
+        return bytes;
+    } //session()
+
+    ///@brief What a stream did after the snapshot.
+    struct outcome {
+        std::vector<delivery> deliveries;
+        std::vector<byte_t> data;
+        std::vector<byte_t> written;
+    }; //struct outcome
+
+    ///@brief Reads `stream` to the end, collecting what it delivers and writes from now on.
+    outcome finish(stream_type& stream, std::vector<delivery>& deliveries, std::size_t buffer_size)
+    {
+        deliveries.clear();
+        stream.next_layer().clear_written();
+        outcome result;
+        result.data       = testing::read_to_end(stream, buffer_size);
+        result.deliveries = deliveries;
+        result.written    = stream.next_layer().written();
+        return result;
+    } //finish(stream_type&, std::vector<delivery>&, std::size_t)
+
+    ///@brief Snapshots a session after its first read and checks that a fresh stream restored from it finishes the session as the original does.
+    void test_round_trip()
+    {
+        const std::vector<byte_t> input = session();
+        for (const std::size_t chunk_size : {1UZ, 2UZ, 7UZ, 32UZ, 4096UZ}) {
+            for (const std::size_t buffer_size : {1UZ, 5UZ, 64UZ}) {
+                const std::string label = std::format("{}-byte reads into {}-byte buffers", chunk_size, buffer_size);
+
+                asio::io_context context;
+                stream_type original(testing::memory_stream{context, input, chunk_size});
+                std::vector<delivery> original_deliveries;
+                testing::register_echo_handlers(original, original_deliveries);
+                std::vector<byte_t> first(buffer_size);
+                std::error_code ec;
+                static_cast<void>(original.read_some(asio::buffer(first), ec));
+                testing::expect(!ec, std::format("{}: first read succeeds, not: {}", label, ec.message()));
+
+                const std::vector<byte_t> image = original.snapshot(ec);
+                testing::expect(!ec, std::format("{}: snapshot succeeds, not: {}", label, ec.message()));
+                const auto rest = std::span<const byte_t>(input).subspan(original.next_layer().consumed());
+
+                stream_type restored(testing::memory_stream{context, {rest.begin(), rest.end()}, chunk_size});
+                std::vector<delivery> restored_deliveries;
+                testing::register_echo_handlers(restored, restored_deliveries);
+                restored.restore(image, ec);
+                testing::expect(!ec, std::format("{}: restore succeeds, not: {}", label, ec.message()));
+                testing::expect_equal(restored.snapshot(ec), image, label + ": the restored stream snapshots the same image");
+
+                const outcome expected = finish(original, original_deliveries, buffer_size);
+                const outcome actual   = finish(restored, restored_deliveries, buffer_size);
+                testing::expect(actual.deliveries == expected.deliveries, label + ": handlers see the same payloads");
+                testing::expect_equal(actual.data, expected.data, label + ": same data");
+                testing::expect_equal(actual.written, expected.written, label + ": same replies");
+            }
+        }
+    } //test_round_trip()
+
+    ///@brief Feeds `bytes` to `fsm` one at a time, discarding the results.
+    void feed(fsm_type& fsm, std::span<const byte_t> bytes)
+    {
+        for (const byte_t byte : bytes) {
+            static_cast<void>(fsm.process_byte(byte));
+        }
+    } //feed(fsm_type&, std::span<const byte_t>)
+
+    ///@brief Gets `fsm`'s `save_state` image.
+    std::vector<byte_t> image_of(const fsm_type& fsm)
+    {
+        std::vector<byte_t> image;
+        fsm.save_state(image);
+        return image;
+    } //image_of(const fsm_type&)
+
+    ///@brief Expects `restore_state` to reject `image` and leave `fsm` unchanged.
+    void expect_rejected(fsm_type& fsm, std::span<const byte_t> image, std::string_view what)
+    {
+        const std::vector<byte_t> before = image_of(fsm);
+        const auto [consumed, ec]        = fsm.restore_state(image);
+        testing::expect(ec == telnet::make_error_code(telnet::error::invalid_snapshot), std::format("rejects {}", what));
+        testing::expect(consumed == 0, std::format("consumes nothing of {}", what));
+        testing::expect_equal(image_of(fsm), before, std::format("{} leaves the FSM as it was", what));
+    } //expect_rejected(fsm_type&, std::span<const byte_t>, std::string_view)
+
+    ///@brief Malformed FSM images, each a valid image with one field broken or a state holding a field it never holds.
+    void test_fsm_rejections()
+    {
+        fsm_type source;
+        feed(source, std::vector<byte_t>{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::gmcp)});
+        const std::vector<byte_t> valid = image_of(source);
+
+        fsm_type target;
+        feed(target, std::vector<byte_t>{iac, testing::byte_of(command::will_opt), testing::byte_of(option::id_num::msdp)});
+        {
+            fsm_type copy;
+            const auto [consumed, ec] = copy.restore_state(valid);
+            testing::expect(!ec && (consumed == valid.size()), "accepts a valid image");
+            testing::expect_equal(image_of(copy), valid, "a restored FSM saves the image it was restored from");
+        }
+
+        const auto broken = [&valid](std::initializer_list<std::pair<std::size_t, byte_t>> changes) {
+            std::vector<byte_t> image = valid;
+            for (const auto& [at, value] : changes) {
+                image[at] = value;
+            }
+            return image;
+        };
+        const byte_t sb   = testing::byte_of(command::sb);
+        const byte_t gmcp = testing::byte_of(option::id_num::gmcp);
+
+        expect_rejected(target, std::span<const byte_t>(valid).first(valid.size() - 1), "a truncated image");
+        expect_rejected(target, broken({{0, fsm_type::state_format_version + 1}}), "an unknown version");
+        expect_rejected(target, broken({{offset::records + 0xD0, 0x01}}), "an unknown option recorded as enabled");
+        expect_rejected(target, broken({{offset::state, saved_state::out_of_range}}), "an out-of-range state");
+        expect_rejected(target, broken({{offset::has_command, 2}}), "a presence byte other than 0 or 1");
+        expect_rejected(
+            target,
+            broken({{offset::has_command, 1}, {offset::command_byte, testing::byte_of(command::will_opt)}}),
+            "a command in the normal state"
+        );
+        expect_rejected(
+            target,
+            broken({{offset::state, saved_state::option_negotiation}}),
+            "option negotiation without a command"
+        );
+        expect_rejected(
+            target,
+            broken({{offset::state, saved_state::option_negotiation},
+                    {offset::has_command, 1},
+                    {offset::command_byte, testing::byte_of(command::ga)}}),
+            "option negotiation after GA"
+        );
+        expect_rejected(
+            target,
+            broken({{offset::has_option, 1}, {offset::option_byte, gmcp}}),
+            "an option in the normal state"
+        );
+        expect_rejected(
+            target,
+            broken({{offset::state, saved_state::subnegotiation}, {offset::has_command, 1}, {offset::command_byte, sb}}),
+            "a subnegotiation without an option"
+        );
+        expect_rejected(
+            target,
+            broken({{offset::state, saved_state::subnegotiation},
+                    {offset::has_command, 1},
+                    {offset::command_byte, testing::byte_of(command::will_opt)},
+                    {offset::has_option, 1},
+                    {offset::option_byte, gmcp}}),
+            "a subnegotiation under WILL"
+        );
+        expect_rejected(target, broken({{offset::payload_length, 1}}), "a payload length past the end");
+
+        //An oversized payload for an option nobody registered must be refused before that option is memoized.
+        const auto unregistered = static_cast<option::id_num>(0xD1);
+        std::vector<byte_t> oversized = broken({
+            {offset::state, saved_state::subnegotiation},
+            {offset::has_command, 1},
+            {offset::command_byte, sb},
+            {offset::has_option, 1},
+            {offset::option_byte, testing::byte_of(unregistered)},
+            {offset::payload_length, 0x01},
+            {offset::payload_length + 1, 0x04}
+        });
+        oversized.resize(oversized.size() + option::default_max_subnegotiation_size + 1, 'x');
+        expect_rejected(target, oversized, "an oversized payload for an unregistered option");
+        testing::expect(
+            testing::test_config::registered_options.get(unregistered) == nullptr,
+            "a rejected image registers nothing"
+        );
+    } //test_fsm_rejections()
+
+    ///@brief Malformed stream images must be refused with `invalid_snapshot` and leave the stream's own snapshot unchanged.
+    void test_stream_rejections()
+    {
+        const std::vector<byte_t> input = session();
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, input, 16});
+        testing::register_ignoring_handlers(stream);
+        std::vector<byte_t> buffer(4);
+        std::error_code ec;
+        static_cast<void>(stream.read_some(asio::buffer(buffer), ec));
+        const std::vector<byte_t> valid = stream.snapshot(ec);
+        testing::expect(!ec, "snapshot succeeds");
+
+        const auto expect_refused = [&stream, &valid](std::span<const byte_t> image, std::string_view what) {
+            std::error_code restore_ec;
+            stream.restore(image, restore_ec);
+            testing::expect(
+                restore_ec == telnet::make_error_code(telnet::error::invalid_snapshot),
+                std::format("stream rejects {}", what)
+            );
+            std::error_code snapshot_ec;
+            testing::expect_equal(stream.snapshot(snapshot_ec), valid, std::format("{} leaves the stream as it was", what));
+        };
+
+        std::vector<byte_t> bad_header = valid;
+        bad_header[0] = 'X';
+        expect_refused(bad_header, "a bad header");
+        std::vector<byte_t> trailing = valid;
+        trailing.push_back('x');
+        expect_refused(trailing, "trailing bytes");
+        expect_refused(std::span<const byte_t>(valid).first(valid.size() - 1), "truncated input");
+    } //test_stream_rejections()
+
+    ///@brief Builds a stream image whose FSM is inside a subnegotiation of `unregistered`, followed by `input_length` and `input`.
+    std::vector<byte_t> mid_subnegotiation_image(
+        std::span<const byte_t> header,
+        option::id_num unregistered,
+        std::uint32_t input_length,
+        std::span<const byte_t> input
+    )
+    {
+        fsm_type fsm;
+        std::vector<byte_t> state = image_of(fsm);
+        state[offset::state]        = saved_state::subnegotiation;
+        state[offset::has_command]  = 1;
+        state[offset::command_byte] = testing::byte_of(command::sb);
+        state[offset::has_option]   = 1;
+        state[offset::option_byte]  = testing::byte_of(unregistered);
+
+        std::vector<byte_t> image(header.begin(), header.end());
+        image.insert(image.end(), state.begin(), state.end());
+        for (std::size_t shift = 0; shift < 32; shift += 8) {
+            image.push_back(static_cast<byte_t>(input_length >> shift));
+        }
+        image.insert(image.end(), input.begin(), input.end());
+        return image;
+    } //mid_subnegotiation_image(std::span<const byte_t>, option::id_num, std::uint32_t, std::span<const byte_t>)
+
+    ///@brief An image refused for its input trailer must not register the option its FSM image names, while the same image with a sound trailer does.
+    void test_trailer_rejection_registers_nothing()
+    {
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {}});
+        std::error_code ec;
+        const std::vector<byte_t> valid = stream.snapshot(ec);
+        testing::expect(!ec, "snapshot succeeds");
+        const auto header = std::span<const byte_t>(valid).first(4);
+        const std::vector<byte_t> input{'a', 'b'};
+
+        const auto rejected = static_cast<option::id_num>(0xD2);
+        for (const std::uint32_t claimed : {1U, 3U}) {
+            stream.restore(mid_subnegotiation_image(header, rejected, claimed, input), ec);
+            testing::expect(
+                ec == telnet::make_error_code(telnet::error::invalid_snapshot),
+                std::format("stream rejects an input length of {} for {} bytes", claimed, input.size())
+            );
+        }
+        std::vector<byte_t> corrupt = mid_subnegotiation_image(header, rejected, 2, input);
+        corrupt.resize(corrupt.size() - input.size() - 1);
+        stream.restore(corrupt, ec);
+        testing::expect(ec == telnet::make_error_code(telnet::error::invalid_snapshot), "stream rejects a truncated trailer");
+        testing::expect(
+            testing::test_config::registered_options.get(rejected) == nullptr,
+            "a rejected trailer registers nothing"
+        );
+
+        const auto accepted = static_cast<option::id_num>(0xD3);
+        stream.restore(mid_subnegotiation_image(header, accepted, 2, input), ec);
+        testing::expect(!ec, std::format("the same image with a sound trailer restores, not: {}", ec.message()));
+        testing::expect(
+            testing::test_config::registered_options.get(accepted) != nullptr,
+            "a restored subnegotiation registers its option"
+        );
+    } //test_trailer_rejection_registers_nothing()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_round_trip();
+    test_fsm_rejections();
+    test_stream_rejections();
+    test_trailer_rejection_registers_nothing();
+    return testing::exit_status();
+}
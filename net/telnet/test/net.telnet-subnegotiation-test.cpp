@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-subnegotiation-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that subnegotiations dispatched in place as spans reach handlers exactly as buffered ones do.
+ * @remark Whole reads take the `process_subnegotiation_span` path for plain payloads; 1-byte reads force every payload through `subnegotiation_buffer_`. Handlers must see the same options and payloads in the same order either way.
+ * @remark Through `stream`, each handler copies its span only when its coroutine runs, so this also checks the view stays valid until the awaitable completes, and echoes the payload so the framed replies can be compared.
+ *
+ * @see "net.telnet-protocol_fsm-impl.cpp" for `process_subnegotiation_span`, "net.telnet-test_support.cppm" for the fixtures
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::span, std::tuple, std::format
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+    using telnet::option;
+
+    using fsm_type    = telnet::protocol_fsm<testing::test_config>;
+    using stream_type = telnet::stream<testing::memory_stream, testing::test_config>;
+    using testing::delivery;
+
+    /**
+     * @brief Builds the session: WILL GMCP and WILL MSDP, then plain, empty, IAC-bearing, maximum-size, and oversized payloads between text.
+     * @remark The oversized payload is reported as an error and never delivered; the exchange after it shows both paths recover alike.
+     */
+    std::vector<byte_t> session()
+    {
+        const byte_t iac  = testing::byte_of(command::iac);
+        const byte_t will = testing::byte_of(command::will_opt);
+
+        std::vector<byte_t> bytes{iac, will, testing::byte_of(option::id_num::gmcp)};
+        testing::append(bytes, {iac, will, testing::byte_of(option::id_num::msdp)});
+        testing::append(bytes, "hello\r\n");
+        for (const std::vector<byte_t>& frame :
+             {testing::framed(option::id_num::gmcp, testing::to_bytes(R"(Char.Vitals {"hp":10,"mp":5})")),
+              testing::framed(option::id_num::gmcp, {}),
+              testing::framed(option::id_num::msdp, std::vector<byte_t>{1, 'H', 'P', 2, iac, '9'}),
+              testing::framed(option::id_num::gmcp, std::vector<byte_t>(option::default_max_subnegotiation_size, 'm')),
+              testing::framed(option::id_num::gmcp, std::vector<byte_t>(option::default_max_subnegotiation_size + 1, 'o')),
+              testing::framed(option::id_num::msdp, testing::to_bytes("\x01VAR\x02VAL"))}) {
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+            testing::append(bytes, "text between\r\n");
+        }
+        return bytes;
+    } //session()
+
+    ///@brief Everything one path produced: the handler deliveries, the FSM trace (only its data for `stream`, which answers signals itself), and the errors and replies of `stream`.
+    struct outcome {
+        std::vector<delivery> deliveries;
+        testing::fsm_trace trace;
+        std::vector<std::error_code> stream_errors;
+        std::vector<byte_t> written;
+    }; //struct outcome
+
+    ///@brief Feeds `input` to a fresh FSM in `chunk_size` pieces via `feed`, recording each handler call's payload at call time.
+    template<typename Feed>
+    outcome through_fsm(std::span<const byte_t> input, std::size_t chunk_size, Feed feed)
+    {
+        outcome result;
+        fsm_type fsm;
+        for (const option::id_num id : {option::id_num::gmcp, option::id_num::msdp}) {
+            fsm.register_option_handlers(
+                id,
+                std::nullopt,
+                std::nullopt,
+                [log = &result.deliveries](const option& opt, std::span<const byte_t> data) {
+                    log->push_back({opt.get_id(), {data.begin(), data.end()}});
+                    return testing::ignore_subnegotiation(opt, data);
+                }
+            );
+        }
+        testing::feed_in_chunks(fsm, input, chunk_size, result.trace, feed);
+        return result;
+    } //through_fsm(std::span<const byte_t>, std::size_t, Feed)
+
+    ///@brief Reads `input` through a fresh `stream` in `chunk_size` reads, with `testing::record_and_echo` as every handler.
+    outcome through_stream(std::span<const byte_t> input, std::size_t chunk_size)
+    {
+        outcome result;
+        asio::io_context context;
+        stream_type stream(testing::memory_stream{context, {input.begin(), input.end()}, chunk_size});
+        testing::register_echo_handlers(stream, result.deliveries);
+        result.trace.forwarded = testing::read_to_end(stream, chunk_size, &result.stream_errors);
+        result.written         = stream.next_layer().written();
+        return result;
+    } //through_stream(std::span<const byte_t>, std::size_t)
+
+    ///@brief Checks `actual` against `expected` for everything both recorded.
+    void expect_same(const outcome& actual, const outcome& expected, std::string_view label)
+    {
+        testing::expect(actual.deliveries == expected.deliveries, std::format("{}: handlers see the same payloads", label));
+        testing::expect_equal(actual.trace.forwarded, expected.trace.forwarded, std::format("{}: same data", label));
+        testing::expect_equal(actual.trace.events, expected.trace.events, std::format("{}: same events", label));
+        testing::expect_equal(actual.stream_errors, expected.stream_errors, std::format("{}: same stream errors", label));
+        testing::expect_equal(actual.written, expected.written, std::format("{}: same replies", label));
+    } //expect_same(const outcome&, const outcome&, std::string_view)
+
+    ///@brief Compares the span path against byte-wise buffering, in the FSM and through `stream`.
+    void test_span_matches_buffered()
+    {
+        const std::vector<byte_t> input = session();
+        const auto byte_wise = [](fsm_type& fsm, std::span<const byte_t> chunk, testing::fsm_trace& out) {
+            testing::feed_byte_wise(fsm, chunk, out);
+        };
+        const auto fast_path = [](fsm_type& fsm, std::span<const byte_t> chunk, testing::fsm_trace& out) {
+            testing::feed_fast_path(fsm, chunk, out);
+        };
+
+        const outcome reference = through_fsm(input, input.size(), byte_wise);
+        testing::expect(reference.deliveries.size() == 5, "every payload but the oversized one is delivered");
+        for (const std::size_t chunk_size : {input.size(), 4096UZ, 64UZ, 7UZ, 1UZ}) {
+            expect_same(
+                through_fsm(input, chunk_size, fast_path),
+                reference,
+                std::format("fast path in {}-byte pieces", chunk_size)
+            );
+        }
+
+        const outcome buffered = through_stream(input, 1);
+        testing::expect(buffered.deliveries == reference.deliveries, "stream in 1-byte reads delivers what process_byte does");
+        testing::expect_equal(buffered.trace.forwarded, reference.trace.forwarded, "stream in 1-byte reads forwards the data");
+        testing::expect(
+            std::ranges::contains(buffered.stream_errors, telnet::make_error_code(telnet::error::subnegotiation_overflow)),
+            "stream reports the oversized payload"
+        );
+        for (const std::size_t chunk_size : {input.size(), 4096UZ, 64UZ, 7UZ}) {
+            expect_same(through_stream(input, chunk_size), buffered, std::format("stream in {}-byte reads", chunk_size));
+        }
+    } //test_span_matches_buffered()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_span_matches_buffered();
+    return testing::exit_status();
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-synch-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that a stream honors a peer's Synch under either `urgent_data_policy`, whichever byte the peer marks urgent.
+ * @remark A loopback peer sends data, a Synch, then more data; the stream must discard what came before the DM and deliver the rest.
+ * @remark The peer is either raw socket sends marking the DM urgent, as RFC 854 describes, or this library's own `async_send_synch`, which marks a NUL before IAC DM.
+ * @remark Under `oob_wait`, a blocking read arms no OOB wait that nothing would run, and finds the urgent mark as `at_mark` does.
+ *
+ * @see "net.telnet-stream-impl.cpp" for `check_urgent_mark` and `input_processor::run_blocking`
+ */
+
+#include <asio.hpp>
+
+import std; //NOLINT For std::vector, std::string, std::string_view, std::array
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::command;
+
+    ///@brief `test_config` with the default `urgent_data_policy::oob_wait`.
+    class oob_wait_config : public testing::test_config {
+    public:
+        static constexpr telnet::urgent_data_policy urgent_data = telnet::urgent_data_policy::oob_wait;
+    }; //class oob_wait_config
+
+    constexpr byte_t iac = testing::byte_of(command::iac);
+
+    ///@brief Waits until the peer's urgent byte has arrived if `urgent`, so the first read stops at the urgent mark whatever the scheduling, then reads `stream` to the end.
+    template<typename Stream>
+    std::vector<byte_t> read_after_synch(Stream& stream, asio::io_context& context, bool urgent, bool async)
+    {
+        if (urgent) {
+            stream.lowest_layer().wait(asio::socket_base::wait_error); //POLLPRI
+        }
+        return async ? testing::async_read_to_end(stream, context, 64) : testing::read_to_end(stream, 64);
+    } //read_after_synch(Stream&, asio::io_context&, bool, bool)
+
+    ///@brief Sends `before` and an IAC, the DM (as urgent data when `urgent`), and `after` from a loopback peer, then reads the stream to the end with blocking reads.
+    template<typename Config>
+    std::vector<byte_t> read_synch(std::string_view before, std::string_view after, bool urgent)
+    {
+        asio::io_context context;
+        asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+        asio::ip::tcp::socket peer(context);
+        peer.connect(acceptor.local_endpoint());
+        telnet::stream<asio::ip::tcp::socket, Config> stream(acceptor.accept());
+
+        std::vector<byte_t> head = testing::to_bytes(before);
+        head.push_back(iac);
+        const std::array<byte_t, 1> data_mark{testing::byte_of(command::dm)};
+        asio::write(peer, asio::buffer(head));
+        peer.send(asio::buffer(data_mark), urgent ? asio::socket_base::message_out_of_band : 0);
+        asio::write(peer, asio::buffer(after));
+        peer.shutdown(asio::socket_base::shutdown_send);
+        return read_after_synch(stream, context, urgent, false);
+    } //read_synch(std::string_view, std::string_view, bool)
+
+    ///@brief Sends `before`, a Synch, and `after` through this library's own `async_send_synch` on a loopback peer stream, then reads the stream to the end.
+    template<typename Config>
+    std::vector<byte_t> read_library_synch(const std::string& before, const std::string& after, bool async)
+    {
+        asio::io_context context;
+        asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+        asio::ip::tcp::socket peer_socket(context);
+        peer_socket.connect(acceptor.local_endpoint());
+        telnet::stream<asio::ip::tcp::socket, Config> stream(acceptor.accept());
+        telnet::stream<asio::ip::tcp::socket, testing::test_config> peer(std::move(peer_socket));
+
+        std::vector<std::error_code> errors;
+        const auto note = [&errors](const std::error_code& ec, std::size_t /*bytes*/) {
+            if (ec) {
+                errors.push_back(ec);
+            }
+        };
+        peer.async_write_some(asio::buffer(before), note);
+        peer.async_send_synch(note);
+        peer.async_write_some(asio::buffer(after), note);
+        context.run();
+        context.restart();
+        testing::expect(errors.empty(), "the peer's Synch and data are sent");
+        peer.lowest_layer().shutdown(asio::socket_base::shutdown_send);
+        return read_after_synch(stream, context, true, async);
+    } //read_library_synch(const std::string&, const std::string&, bool)
+
+    ///@brief Both policies must discard the data before an urgent DM, and keep it before an in-band one.
+    void test_blocking_synch()
+    {
+        const std::vector<byte_t> kept = testing::to_bytes("kept\n");
+        testing::expect_equal(read_synch<testing::test_config>("discard me", "kept\r\n", true), kept, "at_mark: Synch");
+        testing::expect_equal(read_synch<oob_wait_config>("discard me", "kept\r\n", true), kept, "oob_wait: Synch");
+
+        const std::vector<byte_t> all = testing::to_bytes("discard mekept\n");
+        testing::expect_equal(read_synch<testing::test_config>("discard me", "kept\r\n", false), all, "at_mark: in-band DM");
+        testing::expect_equal(read_synch<oob_wait_config>("discard me", "kept\r\n", false), all, "oob_wait: in-band DM");
+    } //test_blocking_synch()
+
+    ///@brief A Synch from `async_send_synch`, whose urgent byte is a NUL rather than the DM, must discard the data before it too.
+    void test_library_synch()
+    {
+        const std::vector<byte_t> kept = testing::to_bytes("kept\n");
+        const std::string before       = "discard me";
+        const std::string after        = "kept\r\n";
+        testing::expect_equal(read_library_synch<testing::test_config>(before, after, false), kept, "at_mark: blocking reads");
+        testing::expect_equal(read_library_synch<testing::test_config>(before, after, true), kept, "at_mark: async reads");
+        testing::expect_equal(read_library_synch<oob_wait_config>(before, after, false), kept, "oob_wait: blocking reads");
+    } //test_library_synch()
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    test_blocking_synch();
+    test_library_synch();
+    return testing::exit_status();
+}
@@ -0,0 +1,558 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-test_support.cppm
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Shared fixtures for the net.telnet behavior tests: expectations, an in-memory next layer, and FSM tracing.
+ * @remark Each test executable compares two paths that must agree (e.g. a fast path and `process_byte` alone) over identical bytes, reporting every failed `expect` and exiting nonzero via `exit_status`.
+ *
+ * @see "test/CMakeLists.txt" for the registered tests, "bench/net.telnet-replay.cpp" for the same equivalence check over captures
+ */
+
+module; //Including Asio in the Global Module Fragment until importable header units are reliable.
+#include <asio.hpp>
+
+//Module interface unit
+export module net.telnet.test_support;
+
+import std; //NOLINT For std::vector, std::span, std::string, std::format, std::println, std::source_location
+
+import net.telnet; ///< @see "net.telnet.cppm"
+
+namespace net::telnet::testing::detail {
+    ///@brief The number of failed expectations so far.
+    std::size_t& failure_count() noexcept
+    {
+        static std::size_t failures = 0;
+        return failures;
+    } //failure_count()
+} //namespace net::telnet::testing::detail
+
+export namespace net::telnet::testing {
+    /**
+     * @brief The default configuration with logging compiled out and `urgent_data_policy::at_mark`.
+     * @remark Shares `registered_options` and the handlers with `default_protocol_fsm_config`.
+     * @remark `at_mark` leaves no out-of-band receive pending on the unconnected socket behind `memory_stream`.
+     */
+    class test_config : public default_protocol_fsm_config {
+    public:
+        static constexpr log_level minimum_log_level = log_level::off;
+
+        static constexpr urgent_data_policy urgent_data = urgent_data_policy::at_mark;
+    }; //class test_config
+
+    ///@brief Records a failed expectation unless `condition` holds, printing `what` and where it was checked.
+    void expect(bool condition, std::string_view what, std::source_location where = std::source_location::current())
+    {
+        if (condition) {
+            return;
+        }
+        ++detail::failure_count();
+        std::println(std::cerr, "{}:{}: FAILED: {}", where.file_name(), where.line(), what);
+    } //expect(bool, std::string_view, std::source_location)
+
+    ///@brief Records a failed expectation unless `actual` and `expected` hold equal elements, printing the first difference.
+    template<std::ranges::input_range Actual, std::ranges::input_range Expected>
+    void expect_equal(
+        const Actual& actual,
+        const Expected& expected,
+        std::string_view what,
+        std::source_location where = std::source_location::current()
+    )
+    {
+        const auto [actual_it, expected_it] = std::ranges::mismatch(actual, expected);
+        if ((actual_it == std::ranges::end(actual)) && (expected_it == std::ranges::end(expected))) {
+            return;
+        }
+        expect(
+            false,
+            std::format(
+                "{}: differs at element {} ({} elements, expected {})",
+                what,
+                std::ranges::distance(std::ranges::begin(actual), actual_it),
+                std::ranges::distance(actual),
+                std::ranges::distance(expected)
+            ),
+            where
+        );
+    } //expect_equal(const Actual&, const Expected&, std::string_view, std::source_location)
+
+    ///@brief Gets the exit status for `main`: 0 if every expectation held, else 1.
+    [[nodiscard]] int exit_status() noexcept
+    {
+        if (detail::failure_count() != 0) {
+            std::println(std::cerr, "{} expectation(s) failed", detail::failure_count());
+            return 1;
+        }
+        return 0;
+    } //exit_status()
+
+    ///@brief Copies `text` into a byte vector.
+    [[nodiscard]] std::vector<byte_t> to_bytes(std::string_view text)
+    {
+        return {text.begin(), text.end()};
+    } //to_bytes(std::string_view)
+
+    ///@brief Appends `more` to `bytes`.
+    void append(std::vector<byte_t>& bytes, std::initializer_list<byte_t> more)
+    {
+        bytes.insert(bytes.end(), more.begin(), more.end());
+    } //append(std::vector<byte_t>&, std::initializer_list<byte_t>)
+
+    ///@brief Appends `text` to `bytes`.
+    void append(std::vector<byte_t>& bytes, std::string_view text)
+    {
+        bytes.insert(bytes.end(), text.begin(), text.end());
+    } //append(std::vector<byte_t>&, std::string_view)
+
+    ///@brief The byte value of `cmd`.
+    [[nodiscard]] constexpr byte_t byte_of(command cmd) noexcept
+    {
+        return std::to_underlying(cmd);
+    } //byte_of(command)
+
+    ///@brief The byte value of `id`.
+    [[nodiscard]] constexpr byte_t byte_of(option::id_num id) noexcept
+    {
+        return std::to_underlying(id);
+    } //byte_of(option::id_num)
+
+    /**
+     * @brief Escapes `data` one byte at a time, as RFC 854 requires: the reference the vectorized escaper must match.
+     * @remark IAC becomes IAC IAC; outside BINARY mode, CR also becomes CR NUL and LF becomes CR LF.
+     */
+    [[nodiscard]] std::vector<byte_t> reference_escape(std::span<const byte_t> data, bool binary)
+    {
+        std::vector<byte_t> escaped;
+        for (const byte_t byte : data) {
+            if (byte == byte_of(command::iac)) {
+                append(escaped, {byte, byte});
+            } else if (!binary && (byte == '\r')) {
+                append(escaped, {byte_t{'\r'}, byte_t{'\0'}});
+            } else if (!binary && (byte == '\n')) {
+                append(escaped, {byte_t{'\r'}, byte_t{'\n'}});
+            } else {
+                escaped.push_back(byte);
+            }
+        }
+        return escaped;
+    } //reference_escape(std::span<const byte_t>, bool)
+
+    /**
+     * @brief An in-memory `LayerableSocketStream` that serves scripted input in reads of at most `chunk_size` bytes and records every write.
+     * @remark The lowest layer is an opened but unconnected `tcp::socket`, so socket options and `at_mark` have a real descriptor to act on.
+     * @remark Asynchronous operations complete through `asio::post`, so they only finish when the `io_context` runs.
+     * @remark Reads report `asio::error::eof` once the input is exhausted; `feed` adds more.
+     */
+    class memory_stream {
+    public:
+        using executor_type     = asio::io_context::executor_type;
+        using lowest_layer_type = asio::ip::tcp::socket;
+
+        ///@brief Opens the lowest layer on `context` and serves `input` at most `chunk_size` bytes per read.
+        memory_stream(asio::io_context& context, std::vector<byte_t> input = {}, std::size_t chunk_size = 4096)
+            : socket_(context, asio::ip::tcp::v4()), input_(std::move(input)), chunk_size_(std::max<std::size_t>(chunk_size, 1))
+        {}
+
+        executor_type get_executor() noexcept { return socket_.get_executor(); }
+
+        lowest_layer_type& lowest_layer() noexcept { return socket_; }
+
+        const lowest_layer_type& lowest_layer() const noexcept { return socket_; }
+
+        ///@brief Appends `more` to the input not yet read.
+        void feed(std::span<const byte_t> more) { input_.insert(input_.end(), more.begin(), more.end()); }
+
+        ///@brief Gets the number of input bytes reads have taken so far.
+        [[nodiscard]] std::size_t consumed() const noexcept { return read_offset_; }
+
+        ///@brief Changes the most bytes one read returns.
+        void set_chunk_size(std::size_t chunk_size) noexcept { chunk_size_ = std::max<std::size_t>(chunk_size, 1); }
+
+        ///@brief Gets every byte written so far, in order.
+        [[nodiscard]] const std::vector<byte_t>& written() const noexcept { return written_; }
+
+        ///@brief Gets the number of `write_some` calls (synchronous or not) so far.
+        [[nodiscard]] std::size_t write_calls() const noexcept { return write_calls_; }
+
+        ///@brief Forgets what was written so far.
+        void clear_written() noexcept
+        {
+            written_.clear();
+            write_calls_ = 0;
+        } //clear_written()
+
+        ///@brief Copies up to one chunk of the remaining input into `buffers`, or reports `asio::error::eof` once it is exhausted.
+        template<typename MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence& buffers, std::error_code& ec)
+        {
+            if (read_offset_ == input_.size()) {
+                ec = asio::error::eof;
+                return 0;
+            }
+            ec.clear();
+            const std::size_t available = std::min(chunk_size_, input_.size() - read_offset_);
+            const std::size_t bytes     = asio::buffer_copy(buffers, asio::buffer(input_.data() + read_offset_, available));
+            read_offset_ += bytes;
+            return bytes;
+        } //memory_stream::read_some(const MutableBufferSequence&, std::error_code&)
+
+        template<typename MutableBufferSequence>
+        std::size_t read_some(const MutableBufferSequence& buffers)
+        {
+            std::error_code ec;
+            const std::size_t bytes = read_some(buffers, ec);
+            if (ec) {
+                throw std::system_error(ec);
+            }
+            return bytes;
+        } //memory_stream::read_some(const MutableBufferSequence&)
+
+        ///@brief Records every byte of `buffers` and reports them all written.
+        template<typename ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence& buffers, std::error_code& ec)
+        {
+            ec.clear();
+            ++write_calls_;
+            const std::size_t offset = written_.size();
+            written_.resize(offset + asio::buffer_size(buffers));
+            return asio::buffer_copy(asio::buffer(written_.data() + offset, written_.size() - offset), buffers);
+        } //memory_stream::write_some(const ConstBufferSequence&, std::error_code&)
+
+        template<typename ConstBufferSequence>
+        std::size_t write_some(const ConstBufferSequence& buffers)
+        {
+            std::error_code ec;
+            return write_some(buffers, ec);
+        } //memory_stream::write_some(const ConstBufferSequence&)
+
+        template<typename MutableBufferSequence, typename CompletionToken>
+        auto async_read_some(const MutableBufferSequence& buffers, CompletionToken&& token)
+        {
+            return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+                [this](auto handler, const MutableBufferSequence& target) {
+                    std::error_code ec;
+                    const std::size_t bytes = read_some(target, ec);
+                    complete(std::move(handler), ec, bytes);
+                },
+                token,
+                buffers
+            );
+        } //memory_stream::async_read_some(const MutableBufferSequence&, CompletionToken&&)
+
+        template<typename ConstBufferSequence, typename CompletionToken>
+        auto async_write_some(const ConstBufferSequence& buffers, CompletionToken&& token)
+        {
+            return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+                [this](auto handler, const ConstBufferSequence& source) {
+                    std::error_code ec;
+                    const std::size_t bytes = write_some(source, ec);
+                    complete(std::move(handler), ec, bytes);
+                },
+                token,
+                buffers
+            );
+        } //memory_stream::async_write_some(const ConstBufferSequence&, CompletionToken&&)
+
+    private:
+        ///@brief Posts `handler` to its associated executor, so an asynchronous operation never completes inside its initiation.
+        template<typename Handler>
+        void complete(Handler handler, std::error_code ec, std::size_t bytes)
+        {
+            auto executor = asio::get_associated_executor(handler, socket_.get_executor());
+            asio::post(executor, asio::append(std::move(handler), ec, bytes));
+        } //memory_stream::complete(Handler, std::error_code, std::size_t)
+
+        lowest_layer_type socket_;
+        std::vector<byte_t> input_;
+        std::size_t read_offset_ = 0;
+        std::size_t chunk_size_;
+        std::vector<byte_t> written_;
+        std::size_t write_calls_ = 0;
+    }; //class memory_stream
+
+    static_assert(concepts::LayerableSocketStream<memory_stream>);
+
+    ///@brief A subnegotiation handler that accepts and ignores the payload.
+    awaitables::subnegotiation_awaitable ignore_subnegotiation(const option& /*opt*/, std::span<const byte_t> /*data*/)
+    {
+        co_return;
+    } //ignore_subnegotiation(const option&, std::span<const byte_t>)
+
+    ///@brief Registers `ignore_subnegotiation` for GMCP and MSDP on `target` (an FSM or a stream).
+    template<typename Target>
+    void register_ignoring_handlers(Target& target)
+    {
+        for (const option::id_num id : {option::id_num::gmcp, option::id_num::msdp}) {
+            target.register_option_handlers(id, std::nullopt, std::nullopt, &ignore_subnegotiation);
+        }
+    } //register_ignoring_handlers(Target&)
+
+    ///@brief Frames `payload` as IAC SB `id` ... IAC SE, doubling IAC in the payload.
+    std::vector<byte_t> framed(option::id_num id, std::span<const byte_t> payload)
+    {
+        std::vector<byte_t> bytes{byte_of(command::iac), byte_of(command::sb), byte_of(id)};
+        for (const byte_t byte : payload) {
+            bytes.push_back(byte);
+            if (byte == byte_of(command::iac)) {
+                bytes.push_back(byte);
+            }
+        }
+        append(bytes, {byte_of(command::iac), byte_of(command::se)});
+        return bytes;
+    } //framed(option::id_num, std::span<const byte_t>)
+
+    ///@brief One subnegotiation handler invocation: the option and a copy of the payload it was given.
+    struct delivery {
+        option::id_num id;
+        std::vector<byte_t> payload;
+
+        friend bool operator==(const delivery&, const delivery&) = default;
+    }; //struct delivery
+
+    ///@brief Records `data` in `log` when the coroutine runs and asks the stream to echo it back to the peer.
+    awaitables::subnegotiation_awaitable record_and_echo(std::vector<delivery>* log, option opt, std::span<const byte_t> data)
+    {
+        log->push_back({opt.get_id(), {data.begin(), data.end()}});
+        co_return std::tuple{opt, std::vector<byte_t>(data.begin(), data.end())};
+    } //record_and_echo(std::vector<delivery>*, option, std::span<const byte_t>)
+
+    ///@brief Registers `record_and_echo` into `log` for GMCP and MSDP on `target` (an FSM or a stream).
+    template<typename Target>
+    void register_echo_handlers(Target& target, std::vector<delivery>& log)
+    {
+        for (const option::id_num id : {option::id_num::gmcp, option::id_num::msdp}) {
+            target.register_option_handlers(
+                id,
+                std::nullopt,
+                std::nullopt,
+                [log = &log](const option& opt, std::span<const byte_t> data) { return record_and_echo(log, opt, data); }
+            );
+        }
+    } //register_echo_handlers(Target&, std::vector<delivery>&)
+
+    /**
+     * @brief Registers GMCP and MSDP (accepted both ways, with subnegotiation) and END_OF_RECORD, and silences the unknown-option and error callbacks, once.
+     * @remark Every configuration derived from `default_protocol_fsm_config` shares these registrations.
+     */
+    void prepare_options()
+    {
+        static const bool prepared = [] {
+            default_protocol_fsm_config::initialize();
+            for (const auto& [id, name] : {std::pair{option::id_num::gmcp, "GMCP"}, std::pair{option::id_num::msdp, "MSDP"}}) {
+                default_protocol_fsm_config::registered_options.upsert(
+                    option{id, name, option::always_accept, option::always_accept, /*subneg_supported=*/true}
+                );
+            }
+            default_protocol_fsm_config::registered_options.upsert(
+                option{option::id_num::end_of_record, "End of Record", option::always_accept, option::always_accept}
+            );
+            default_protocol_fsm_config::set_unknown_option_handler([](option::id_num /*id*/) {});
+            default_protocol_fsm_config::set_error_logger([](const std::error_code& /*ec*/, const std::string& /*msg*/) {});
+            return true;
+        }();
+        static_cast<void>(prepared);
+    } //prepare_options()
+
+    /**
+     * @brief Reads `stream` synchronously until end of file, returning every data byte delivered.
+     * @remark `processing_signal` results are stepped over. If `protocol_errors` is given, `telnet_error_category` errors are appended to it and stepped over too; any other error is a failed expectation.
+     */
+    template<typename Stream>
+    std::vector<byte_t>
+        read_to_end(Stream& stream, std::size_t buffer_size, std::vector<std::error_code>* protocol_errors = nullptr)
+    {
+        std::vector<byte_t> buffer(buffer_size);
+        std::vector<byte_t> delivered;
+
+        std::error_code ec;
+        while (true) {
+            const std::size_t bytes = stream.read_some(asio::buffer(buffer), ec);
+            delivered.insert(delivered.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(bytes));
+            if (ec && protocol_errors && (&ec.category() == &telnet_error_category::instance())) {
+                protocol_errors->push_back(ec);
+                continue;
+            }
+            if (ec && (&ec.category() != &telnet_processing_signal_category::instance())) {
+                break;
+            }
+        }
+        expect(ec == asio::error::eof, std::format("stream read stops only at end of input, not: {}", ec.message()));
+        return delivered;
+    } //read_to_end(Stream&, std::size_t, std::vector<std::error_code>*)
+
+    /**
+     * @brief Reads `stream` with chained `async_read_some` calls until end of file, running `context` until they finish, and returns every data byte delivered.
+     * @remark Steps over the same results as `read_to_end`.
+     */
+    template<typename Stream>
+    std::vector<byte_t> async_read_to_end(
+        Stream& stream,
+        asio::io_context& context,
+        std::size_t buffer_size,
+        std::vector<std::error_code>* protocol_errors = nullptr
+    )
+    {
+        struct reader {
+            Stream* stream;
+            std::vector<byte_t>* buffer;
+            std::vector<byte_t>* delivered;
+            std::vector<std::error_code>* protocol_errors;
+            std::error_code* final_ec;
+
+            void start() const { stream->async_read_some(asio::buffer(*buffer), *this); }
+
+            void operator()(std::error_code ec, std::size_t bytes) const
+            {
+                delivered->insert(delivered->end(), buffer->begin(), buffer->begin() + static_cast<std::ptrdiff_t>(bytes));
+                if (ec && protocol_errors && (&ec.category() == &telnet_error_category::instance())) {
+                    protocol_errors->push_back(ec);
+                } else if (ec && (&ec.category() != &telnet_processing_signal_category::instance())) {
+                    *final_ec = ec;
+                    return;
+                }
+                start();
+            }
+        }; //struct reader
+
+        std::vector<byte_t> buffer(buffer_size);
+        std::vector<byte_t> delivered;
+        std::error_code ec;
+        reader{&stream, &buffer, &delivered, protocol_errors, &ec}.start();
+        context.run();
+        context.restart();
+        expect(ec == asio::error::eof, std::format("stream read stops only at end of input, not: {}", ec.message()));
+        return delivered;
+    } //async_read_to_end(Stream&, asio::io_context&, std::size_t, std::vector<std::error_code>*)
+
+    /**
+     * @brief Everything an FSM path produced: the forwarded data, and each signal, error, or response tagged with the data offset it occurred at.
+     * @remark Two paths agree exactly when their traces compare equal.
+     */
+    struct fsm_trace {
+        std::vector<byte_t> forwarded;
+        std::vector<std::string> events;
+
+        friend bool operator==(const fsm_trace&, const fsm_trace&) = default;
+    }; //struct fsm_trace
+
+    ///@brief Describes a negotiation response as "negotiation(direction,enable,id)".
+    template<typename NegotiationResponse>
+    [[nodiscard]] std::string describe_negotiation(const NegotiationResponse& negotiation)
+    {
+        const auto& [direction, enable, id] = negotiation;
+        return std::format(
+            "negotiation({},{},{})",
+            std::to_underlying(direction),
+            enable,
+            static_cast<std::uint32_t>(std::to_underlying(id))
+        );
+    } //describe_negotiation(const NegotiationResponse&)
+
+    ///@brief Describes a signal or error together with the response returned with it, in a form that compares equal exactly when both do.
+    template<typename ResponseVariant>
+    [[nodiscard]] std::string describe(const std::error_code& ec, const std::optional<ResponseVariant>& response)
+    {
+        std::string text = ec ? std::format("{}:{}", ec.category().name(), ec.value()) : std::string{"ok"};
+        if (!response) {
+            return text;
+        }
+        switch (response->index()) {
+            case 0:
+                text += " " + describe_negotiation(std::get<0>(*response));
+                break;
+            case 1:
+                text += std::format(" write({})", std::get<1>(*response));
+                break;
+            case 2:
+                text += " enablement";
+                if (const auto& negotiation = std::get<1>(std::get<2>(*response))) {
+                    text += " " + describe_negotiation(*negotiation);
+                }
+                break;
+            case 3:
+                text += " disablement";
+                if (const auto& negotiation = std::get<1>(std::get<3>(*response))) {
+                    text += " " + describe_negotiation(*negotiation);
+                }
+                break;
+            default:
+                text += " subnegotiation";
+                break;
+        }
+        return text;
+    } //describe(const std::error_code&, const std::optional<ResponseVariant>&)
+
+    ///@brief Records one result of `fsm` in `trace`.
+    template<typename FSM>
+    void record_event(
+        fsm_trace& trace,
+        const std::error_code& ec,
+        const std::optional<typename FSM::processing_return_variant>& response
+    )
+    {
+        trace.events.push_back(std::format("@{} {}", trace.forwarded.size(), describe(ec, response)));
+    } //record_event(fsm_trace&, const std::error_code&, const std::optional<processing_return_variant>&)
+
+    ///@brief Feeds `input` to `fsm` one byte at a time: the reference behaviour.
+    template<typename FSM>
+    void feed_byte_wise(FSM& fsm, std::span<const byte_t> input, fsm_trace& trace)
+    {
+        for (const byte_t byte : input) {
+            auto [ec, forward, response] = fsm.process_byte(byte);
+            if (forward) {
+                trace.forwarded.push_back(byte);
+            }
+            if (ec || response) {
+                record_event<FSM>(trace, ec, response);
+            }
+        }
+    } //feed_byte_wise(FSM&, std::span<const byte_t>, fsm_trace&)
+
+    ///@brief Feeds `input` to `fsm` the way `input_processor` does: `process_span` runs, whole subnegotiations via `process_subnegotiation_span`, and `process_byte` for the rest.
+    template<typename FSM>
+    void feed_fast_path(FSM& fsm, std::span<const byte_t> input, fsm_trace& trace)
+    {
+        while (!input.empty()) {
+            if (const std::size_t run = fsm.process_span(input); run > 0) {
+                trace.forwarded.insert(trace.forwarded.end(), input.begin(), input.begin() + static_cast<std::ptrdiff_t>(run));
+                input = input.subspan(run);
+                continue;
+            }
+            if (auto [consumed, ec, response] = fsm.process_subnegotiation_span(input); consumed > 0) {
+                if (ec || response) {
+                    record_event<FSM>(trace, ec, response);
+                }
+                input = input.subspan(consumed);
+                continue;
+            }
+            feed_byte_wise(fsm, input.first(1), trace);
+            input = input.subspan(1);
+        }
+    } //feed_fast_path(FSM&, std::span<const byte_t>, fsm_trace&)
+
+    ///@brief Feeds `input` to `fsm` in pieces of at most `chunk_size` bytes through `feed`, as successive reads would.
+    template<typename FSM, typename Feed>
+    void feed_in_chunks(FSM& fsm, std::span<const byte_t> input, std::size_t chunk_size, fsm_trace& trace, Feed feed)
+    {
+        for (std::size_t offset = 0; offset < input.size(); offset += chunk_size) {
+            feed(fsm, input.subspan(offset, std::min(chunk_size, input.size() - offset)), trace);
+        }
+    } //feed_in_chunks(FSM&, std::span<const byte_t>, std::size_t, fsm_trace&, Feed)
+} //namespace net::telnet::testing
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2026 Jeremy Murphy and any Contributors
+/**
+ * @file net.telnet-tls-test.cpp
+ * @version 0.5.7
+ * @date October 14, 2026
+ *
+ * @copyright © 2026 Jeremy Murphy and any Contributors
+ * @par License: @parblock
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. @endparblock
+ *
+ * @brief Checks that two streams on a loopback connection complete a TLS handshake and exchange data through it, from the first byte and after a START_TLS upgrade.
+ * @remark The server presents a self-signed certificate made for the run, which the client trusts and verifies against "localhost".
+ * @remark Each conversation ends with close_notify both ways, so both ends read to end of stream.
+ * @remark Built only with `NET_TELNET_WITH_TLS`, since a `tls_context` cannot be made without OpenSSL.
+ *
+ * @see "net.telnet-tls.cppm" for `tls_session`, "net.telnet-stream-impl.cpp" for `decrypt_input` and `start_tls_input`
+ */
+
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+import std; //NOLINT For std::vector, std::string, std::optional, std::function, std::unique_ptr, std::format, std::chrono
+
+import net.telnet;              ///< @see "net.telnet.cppm"
+import net.telnet.test_support; ///< @see "net.telnet-test_support.cppm"
+
+namespace {
+    namespace telnet  = net::telnet;
+    namespace testing = net::telnet::testing;
+    using telnet::byte_t;
+    using telnet::option;
+
+    using tcp_stream = telnet::stream<asio::ip::tcp::socket, testing::test_config>;
+
+    ///@brief A server context holding a fresh self-signed certificate for "localhost", and a client context that trusts only it.
+    struct credentials {
+        asio::ssl::context server{asio::ssl::context::tls_server};
+        asio::ssl::context client{asio::ssl::context::tls_client};
+
+        credentials()
+        {
+            const std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(EVP_EC_gen("P-256"), &EVP_PKEY_free);
+            const std::unique_ptr<X509, decltype(&X509_free)> certificate(X509_new(), &X509_free);
+            testing::expect(key && certificate, "a key and certificate are allocated");
+            if (!key || !certificate) {
+                return;
+            }
+            X509_set_version(certificate.get(), 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(certificate.get()), 1);
+            X509_gmtime_adj(X509_getm_notBefore(certificate.get()), 0);
+            X509_gmtime_adj(X509_getm_notAfter(certificate.get()), 3600);
+            X509_set_pubkey(certificate.get(), key.get());
+            X509_NAME* name = X509_get_subject_name(certificate.get());
+            const auto* common_name = reinterpret_cast<const unsigned char*>("localhost");
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, common_name, -1, -1, 0);
+            X509_set_issuer_name(certificate.get(), name);
+            testing::expect(X509_sign(certificate.get(), key.get(), EVP_sha256()) > 0, "the certificate is signed");
+
+            testing::expect(
+                (SSL_CTX_use_certificate(server.native_handle(), certificate.get()) == 1)
+                    && (SSL_CTX_use_PrivateKey(server.native_handle(), key.get()) == 1),
+                "the server context takes the certificate"
+            );
+            testing::expect(
+                X509_STORE_add_cert(SSL_CTX_get_cert_store(client.native_handle()), certificate.get()) == 1,
+                "the client context trusts the certificate"
+            );
+            client.set_verify_mode(asio::ssl::verify_peer);
+        } //credentials::credentials()
+    }; //struct credentials
+
+    ///@brief A connected loopback pair of streams, configured as TLS server and verifying TLS client.
+    struct loopback {
+        asio::io_context context;
+        std::optional<tcp_stream> server;
+        std::optional<tcp_stream> client;
+
+        explicit loopback(credentials& keys)
+        {
+            asio::ip::tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+            asio::ip::tcp::socket socket(context);
+            socket.connect(acceptor.local_endpoint());
+            server.emplace(acceptor.accept());
+            client.emplace(std::move(socket));
+            server->set_tls_context(telnet::tls_context(keys.server), telnet::tls_role::server);
+            client->set_tls_context(telnet::tls_context(keys.client), telnet::tls_role::client, "localhost");
+        } //loopback::loopback(credentials&)
+    }; //struct loopback
+
+    ///@brief Checks whether `ec` is a `processing_signal`, which a read reports alongside data rather than as a failure.
+    bool is_signal(const std::error_code& ec)
+    {
+        return &ec.category() == &telnet::telnet_processing_signal_category::instance();
+    } //is_signal(const std::error_code&)
+
+    ///@brief What each end of an encrypted conversation received, and every error either end saw.
+    struct conversation {
+        std::vector<byte_t> at_server;
+        std::vector<byte_t> at_client;
+        bool client_established = false;
+        std::vector<std::error_code> errors;
+    }; //struct conversation
+
+    /**
+     * @brief Runs an encrypted conversation over `pair`, whose TLS session the caller has started or queued.
+     * @remark The server sends `to_client` at once; it is held until the handshake completes. Once the client has all of it, the client answers `to_server` and sends close_notify, and the server answers the close_notify with its own.
+     */
+    conversation
+        converse(loopback& pair, const std::string& to_client, const std::string& to_server, std::size_t expected_at_client)
+    {
+        conversation result;
+        const auto note = [&result](const std::error_code& ec, std::size_t /*bytes*/) {
+            if (ec) {
+                result.errors.push_back(ec);
+            }
+        };
+        int open_ends = 2;
+        asio::steady_timer deadline(pair.context, std::chrono::seconds(10));
+        deadline.async_wait([&pair, &result](const std::error_code& ec) {
+            if (!ec) {
+                result.errors.push_back(std::make_error_code(std::errc::timed_out));
+                pair.server->lowest_layer().close();
+                pair.client->lowest_layer().close();
+            }
+        });
+        const auto end_closed = [&open_ends, &deadline] {
+            if (--open_ends == 0) {
+                deadline.cancel();
+            }
+        };
+
+        std::vector<byte_t> server_buffer(64);
+        std::function<void()> read_server = [&] {
+            pair.server->async_read_some(asio::buffer(server_buffer), [&](const std::error_code& ec, std::size_t bytes) {
+                result.at_server.insert(result.at_server.end(), server_buffer.begin(), server_buffer.begin() + bytes);
+                if (ec == asio::error::eof) {
+                    pair.server->async_stop_tls([&note, &end_closed](const std::error_code& stop_ec, std::size_t written) {
+                        note(stop_ec, written);
+                        end_closed();
+                    });
+                } else if (ec && !is_signal(ec)) {
+                    result.errors.push_back(ec);
+                } else {
+                    read_server();
+                }
+            });
+        };
+
+        std::vector<byte_t> client_buffer(64);
+        bool answered = false;
+        std::function<void()> read_client = [&] {
+            pair.client->async_read_some(asio::buffer(client_buffer), [&](const std::error_code& ec, std::size_t bytes) {
+                result.at_client.insert(result.at_client.end(), client_buffer.begin(), client_buffer.begin() + bytes);
+                if (!answered && (result.at_client.size() >= expected_at_client)) {
+                    answered                  = true;
+                    result.client_established = pair.client->is_tls_established();
+                    pair.client->async_write_some(asio::buffer(to_server), note);
+                    pair.client->async_stop_tls(note);
+                }
+                if (ec == asio::error::eof) {
+                    end_closed();
+                } else if (ec && !is_signal(ec)) {
+                    result.errors.push_back(ec);
+                } else {
+                    read_client();
+                }
+            });
+        };
+
+        pair.server->async_write_some(asio::buffer(to_client), note);
+        read_server();
+        read_client();
+        pair.context.run();
+        pair.context.restart();
+        return result;
+    } //converse(loopback&, const std::string&, const std::string&, std::size_t)
+
+    ///@brief Checks one conversation's outcome under `label`.
+    void expect_conversation(const conversation& result, std::string_view label)
+    {
+        testing::expect(result.errors.empty(), std::format("{}: no errors, saw {}", label, result.errors.size()));
+        for (const std::error_code& ec : result.errors) {
+            testing::expect(false, std::format("{}: {}", label, ec.message()));
+        }
+        testing::expect(result.client_established, std::format("{}: the handshake completes before data arrives", label));
+        testing::expect_equal(result.at_client, testing::to_bytes("secret\n"), std::format("{}: client reads server", label));
+        testing::expect_equal(result.at_server, testing::to_bytes("reply\n"), std::format("{}: server reads client", label));
+    } //expect_conversation(const conversation&, std::string_view)
+
+    ///@brief Both ends protect the connection from its first byte, as on a port 992 listener.
+    void test_implicit_tls(credentials& keys)
+    {
+        loopback pair(keys);
+        std::error_code ec;
+        pair.server->start_implicit_tls(ec);
+        testing::expect(!ec, std::format("the server starts implicit TLS, not: {}", ec.message()));
+        pair.client->start_implicit_tls(ec);
+        testing::expect(!ec, std::format("the client starts implicit TLS, not: {}", ec.message()));
+        expect_conversation(converse(pair, "secret\r\n", "reply\r\n", 7), "implicit TLS");
+    } //test_implicit_tls(credentials&)
+
+    ///@brief Blocking reads until `size` data bytes have arrived, failing on any error but a `processing_signal`.
+    std::vector<byte_t> read_plain(tcp_stream& stream, std::size_t size)
+    {
+        std::vector<byte_t> buffer(64);
+        std::vector<byte_t> received;
+        while (received.size() < size) {
+            std::error_code ec;
+            const std::size_t bytes = stream.read_some(asio::buffer(buffer), ec);
+            received.insert(received.end(), buffer.begin(), buffer.begin() + bytes);
+            if (ec && !is_signal(ec)) {
+                testing::expect(false, std::format("plaintext read fails: {}", ec.message()));
+                break;
+            }
+        }
+        return received;
+    } //read_plain(tcp_stream&, std::size_t)
+
+    ///@brief The server negotiates START_TLS over plaintext, sends FOLLOWS, and the client's read answers it; data on both sides then travels encrypted.
+    void test_start_tls(credentials& keys)
+    {
+        loopback pair(keys);
+        std::error_code ec;
+        static_cast<void>(
+            pair.server->request_option(option::id_num::telnet_start_tls, telnet::negotiation_direction::remote, ec)
+        );
+        testing::expect(!ec, std::format("the server sends DO START_TLS, not: {}", ec.message()));
+        static_cast<void>(pair.server->write_some(asio::buffer(std::string("plain\r\n")), ec));
+        testing::expect(!ec, "the server writes plaintext");
+        testing::expect_equal(read_plain(*pair.client, 6), testing::to_bytes("plain\n"), "the client agrees, reads plaintext");
+        static_cast<void>(pair.client->write_some(asio::buffer(std::string("ok\r\n")), ec));
+        testing::expect(!ec, "the client writes plaintext");
+        testing::expect_equal(read_plain(*pair.server, 3), testing::to_bytes("ok\n"), "the server reads WILL and plaintext");
+
+        bool follows_sent = false;
+        pair.server->async_start_tls([&follows_sent](const std::error_code& follows_ec, std::size_t /*bytes*/) {
+            testing::expect(!follows_ec, std::format("the server sends FOLLOWS, not: {}", follows_ec.message()));
+            follows_sent = true;
+        });
+        expect_conversation(converse(pair, "secret\r\n", "reply\r\n", 7), "START_TLS");
+        testing::expect(follows_sent, "the server's FOLLOWS completes");
+    } //test_start_tls(credentials&)
+} //namespace
+
+int main()
+{
+    testing::prepare_options();
+    telnet::default_protocol_fsm_config::registered_options.upsert(
+        option{option::id_num::telnet_start_tls, "START_TLS", option::always_accept, option::always_accept, true}
+    );
+    credentials keys;
+    test_implicit_tls(keys);
+    test_start_tls(keys);
+    return testing::exit_status();
+}